@@ -148,6 +148,8 @@ static int DoShutdown()
             pDesktop.CloseWindow(pWindowManager.PointerFinder);
     }
 
+    // the thread pool may have been stopped before any pending progress files were written
+    ra::services::ServiceLocator::Get<ra::services::AchievementRuntime>().FlushProgressWrites();
     ra::services::ServiceLocator::GetMutable<ra::services::AchievementRuntime>().Shutdown();
 
     ra::services::Initialization::Shutdown();
@@ -6,6 +6,7 @@
 #include "RA_Resource.h"
 #include "RA_md5factory.h"
 
+#include "services\GameLibraryScanner.hh"
 #include "services\IConfiguration.hh"
 #include "services\IFileSystem.hh"
 #include "services\ServiceLocator.hh"
@@ -20,57 +21,16 @@ inline constexpr std::array<LPCTSTR, 4> COL_TITLE{_T("ID"), _T("Game Title"), _T
 inline constexpr std::array<int, 4> COL_SIZE{30, 230, 110, 170};
 inline constexpr auto bCancelScan = false;
 
-std::mutex mtx;
-
 // static
-std::deque<std::string> Dlg_GameLibrary::FilesToScan;
-std::map<std::string, std::string> Dlg_GameLibrary::Results;        //	filepath,md5
 std::map<std::string, std::string> Dlg_GameLibrary::VisibleResults; //	filepath,md5
 size_t Dlg_GameLibrary::nNumParsed = 0;
-bool Dlg_GameLibrary::ThreadProcessingAllowed = true;
-bool Dlg_GameLibrary::ThreadProcessingActive = false;
 
 Dlg_GameLibrary g_GameLibrary;
 
-bool ListFiles(std::string path, std::string mask, std::deque<std::string>& rFileListOut)
+static ra::services::GameLibraryScanner& GetScanner()
 {
-    std::stack<std::string> directories;
-    directories.push(path);
-
-    while (!directories.empty())
-    {
-        path = directories.top();
-        std::string spec = path + "\\" + mask;
-        directories.pop();
-
-        WIN32_FIND_DATA ffd;
-        HANDLE hFind = FindFirstFile(NativeStr(spec).c_str(), &ffd);
-        if (hFind == INVALID_HANDLE_VALUE)
-            return false;
-
-        do
-        {
-            std::string sFilename = ra::Narrow(ffd.cFileName);
-            if ((strcmp(sFilename.c_str(), ".") == 0) || (strcmp(sFilename.c_str(), "..") == 0))
-                continue;
-
-            if (ffd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
-                directories.push(path + "\\" + sFilename);
-            else
-                rFileListOut.push_front(path + "\\" + sFilename);
-        } while (FindNextFile(hFind, &ffd) != 0);
-
-        if (GetLastError() != ERROR_NO_MORE_FILES)
-        {
-            FindClose(hFind);
-            return false;
-        }
-
-        FindClose(hFind);
-        hFind = INVALID_HANDLE_VALUE;
-    }
-
-    return true;
+    static ra::services::GameLibraryScanner pScanner;
+    return pScanner;
 }
 
 namespace ra {
@@ -262,49 +222,6 @@ void Dlg_GameLibrary::ClearTitles() noexcept
     VisibleResults.clear();
 }
 
-// static
-void Dlg_GameLibrary::ThreadedScanProc()
-{
-    Dlg_GameLibrary::ThreadProcessingActive = true;
-
-    while (FilesToScan.size() > 0)
-    {
-        mtx.lock();
-        if (!Dlg_GameLibrary::ThreadProcessingAllowed)
-        {
-            mtx.unlock();
-            break;
-        }
-        mtx.unlock();
-
-        FILE* pf = nullptr;
-        if ((fopen_s(&pf, FilesToScan.front().c_str(), "rb") == 0) && pf)
-        {
-            // obtain file size:
-            fseek(pf, 0, SEEK_END);
-            const DWORD nSize = ftell(pf);
-            rewind(pf);
-
-            auto pBuf = std::make_unique<unsigned char[]>(6 * 1024 * 1024);
-
-            fread(pBuf.get(), sizeof(unsigned char), nSize, pf); // Check
-            Results.insert_or_assign(FilesToScan.front(), RAGenerateMD5(pBuf.get(), nSize));
-            pBuf.reset();
-
-            SendMessage(g_GameLibrary.GetHWND(), WM_TIMER, 0U, 0L);
-
-            fclose(pf);
-        }
-
-        mtx.lock();
-        FilesToScan.pop_front();
-        mtx.unlock();
-    }
-
-    Dlg_GameLibrary::ThreadProcessingActive = false;
-    ExitThread(0);
-}
-
 void Dlg_GameLibrary::ScanAndAddRomsRecursive(const std::string& sBaseDir)
 {
     char sSearchDir[2048];
@@ -401,28 +318,20 @@ void Dlg_GameLibrary::ReloadGameListData()
     TCHAR sROMDir[1024];
     GetDlgItemText(m_hDialogBox, IDC_RA_ROMDIR, sROMDir, 1024);
 
-    mtx.lock();
-    while (FilesToScan.size() > 0)
-        FilesToScan.pop_front();
-    mtx.unlock();
-
-    bool bOK = ListFiles(ra::Narrow(sROMDir), "*.bin", FilesToScan);
-    bOK |= ListFiles(ra::Narrow(sROMDir), "*.gen", FilesToScan);
-
-    if (bOK)
+    // only files that are new or have changed since the last scan will be hashed
+    GetScanner().Scan(ra::Widen(sROMDir), {L"bin", L"gen"}, []()
     {
-        std::thread scanner(&Dlg_GameLibrary::ThreadedScanProc);
-        scanner.detach();
-    }
+        SendMessage(g_GameLibrary.GetHWND(), WM_TIMER, 0U, 0L);
+    });
 }
 
 void Dlg_GameLibrary::RefreshList()
 {
-    std::map<std::string, std::string>::iterator iter = Results.begin();
-    while (iter != Results.end())
+    const auto mResults = GetScanner().GetResults();
+    for (const auto& iter : mResults)
     {
-        const std::string& filepath = iter->first;
-        const std::string& md5 = iter->second;
+        const std::string filepath = ra::Narrow(iter.first);
+        const std::string& md5 = iter.second;
 
         if (VisibleResults.find(filepath) == VisibleResults.end())
         {
@@ -440,7 +349,6 @@ void Dlg_GameLibrary::RefreshList()
                 VisibleResults[filepath] = md5; //	Copy to VisibleResults
             }
         }
-        iter++;
     }
 }
 
@@ -468,71 +376,13 @@ BOOL Dlg_GameLibrary::LaunchSelected()
 void Dlg_GameLibrary::LoadAll()
 {
     auto& pFileSystem = ra::services::ServiceLocator::Get<ra::services::IFileSystem>();
-    std::wstring sMyGameLibraryFile = pFileSystem.BaseDirectory() + RA_MY_GAME_LIBRARY_FILENAME;
-    {
-        std::scoped_lock lock{mtx};
-        std::ifstream ifile{sMyGameLibraryFile, std::ios::binary};
-        if (ifile.is_open())
-        {
-            std::streamsize nCharsRead1 = 0;
-            std::streamsize nCharsRead2 = 0;
-            do
-            {
-                nCharsRead1 = 0;
-                nCharsRead2 = 0;
-                std::array<char, 2048> fileBuf{};
-                std::array<char, 64> md5Buf{};
-
-                ifile.getline(fileBuf.data(), 2048);
-                nCharsRead1 = ifile.gcount();
-
-                if (nCharsRead1 > 0)
-                {
-                    ifile.getline(md5Buf.data(), 64);
-                    nCharsRead2 = ifile.gcount();
-                }
-
-                if (fileBuf.front() != '\0' && md5Buf.front() != '\0' && nCharsRead1 > 0 && nCharsRead2 > 0)
-                {
-                    // Add
-                    std::string file{fileBuf.data()};
-                    std::string md5{md5Buf.data()};
-
-                    Results.try_emplace(file, md5);
-                }
-
-            } while (nCharsRead1 > 0 && nCharsRead2 > 0);
-        }
-    }
+    GetScanner().LoadCache(pFileSystem.BaseDirectory() + RA_MY_GAME_LIBRARY_FILENAME);
 }
 
 void Dlg_GameLibrary::SaveAll()
 {
     auto& pFileSystem = ra::services::ServiceLocator::Get<ra::services::IFileSystem>();
-    std::wstring sMyGameLibraryFile = pFileSystem.BaseDirectory() + RA_MY_GAME_LIBRARY_FILENAME;
-
-    mtx.lock();
-    FILE* pf = nullptr;
-    _wfopen_s(&pf, sMyGameLibraryFile.c_str(), L"wb");
-    if (pf != nullptr)
-    {
-        std::map<std::string, std::string>::iterator iter = Results.begin();
-        while (iter != Results.end())
-        {
-            const std::string& sFilepath = iter->first;
-            const std::string& sMD5 = iter->second;
-
-            fwrite(sFilepath.c_str(), sizeof(char), strlen(sFilepath.c_str()), pf);
-            fwrite("\n", sizeof(char), 1, pf);
-            fwrite(sMD5.c_str(), sizeof(char), strlen(sMD5.c_str()), pf);
-            fwrite("\n", sizeof(char), 1, pf);
-
-            iter++;
-        }
-
-        fclose(pf);
-    }
-    mtx.unlock();
+    GetScanner().SaveCache(pFileSystem.BaseDirectory() + RA_MY_GAME_LIBRARY_FILENAME);
 }
 
 // static
@@ -639,11 +489,8 @@ INT_PTR CALLBACK Dlg_GameLibrary::GameLibraryProc(HWND hDlg, UINT uMsg, WPARAM w
                     }
 
                 case IDC_RA_RESCAN:
-                    ReloadGameListData();
-
-                    mtx.lock(); //?
                     SetDlgItemText(m_hDialogBox, IDC_RA_SCANNERFOUNDINFO, TEXT("Scanning..."));
-                    mtx.unlock();
+                    ReloadGameListData();
                     return FALSE;
 
                 case IDC_RA_PICKROMDIR:
@@ -682,8 +529,7 @@ INT_PTR CALLBACK Dlg_GameLibrary::GameLibraryProc(HWND hDlg, UINT uMsg, WPARAM w
             }
 
         case WM_PAINT:
-            if (nNumParsed != Results.size())
-                nNumParsed = Results.size();
+            nNumParsed = VisibleResults.size();
             return FALSE;
 
         case WM_CLOSE:
@@ -700,8 +546,8 @@ INT_PTR CALLBACK Dlg_GameLibrary::GameLibraryProc(HWND hDlg, UINT uMsg, WPARAM w
 
 void Dlg_GameLibrary::KillThread()
 {
-    Dlg_GameLibrary::ThreadProcessingAllowed = false;
-    while (Dlg_GameLibrary::ThreadProcessingActive)
+    GetScanner().Cancel();
+    while (GetScanner().IsScanning())
     {
         RA_LOG_INFO("Waiting for background scanner...");
         Sleep(200);
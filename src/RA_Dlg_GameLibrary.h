@@ -50,15 +50,9 @@ private:
     void RefreshList();
 
 private:
-    static std::deque<std::string> FilesToScan;
-    static std::map<std::string, std::string> Results;			//	filepath,md5 (parsed/persisted)
     static std::map<std::string, std::string> VisibleResults;	//	filepath,md5 (added to renderable)
     static size_t nNumParsed;
 
-    static void ThreadedScanProc();
-    static bool ThreadProcessingAllowed;
-    static bool ThreadProcessingActive;
-
 private:
     HWND m_hDialogBox{};
 
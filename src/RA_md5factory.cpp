@@ -5,86 +5,122 @@
 #include "services\IFileSystem.hh"
 #include "services\ServiceLocator.hh"
 
-#include <rcheevos/src/rhash/md5.h>
-
 namespace {
 constexpr static unsigned int MD5_STRING_LEN = 32;
 }
 
-std::string RAFormatMD5(const BYTE* digest)
-{
-    char buffer[33] = "";
-    Expects(digest != nullptr);
+namespace ra {
 
-    sprintf_s(buffer, MD5_STRING_LEN + 1,
-        "%02x%02x%02x%02x%02x%02x%02x%02x"
-        "%02x%02x%02x%02x%02x%02x%02x%02x",
-        digest[0], digest[1], digest[2], digest[3], digest[4], digest[5], digest[6], digest[7],
-        digest[8], digest[9], digest[10], digest[11], digest[12], digest[13], digest[14], digest[15]);
+static_assert(sizeof(md5_byte_t) == sizeof(uint8_t), "Must be equivalent for the MD5 to work!");
 
-    return std::string(buffer, 32);
+void MD5Hasher::Reset() noexcept
+{
+    md5_init(&m_pState);
 }
 
-std::string RAGenerateMD5(const std::string& sStringToMD5)
+void MD5Hasher::Append(const uint8_t* pData, size_t nSize) noexcept
 {
-    md5_state_t pms{};
-    md5_byte_t digest[16]{};
-
-    static_assert(sizeof(md5_byte_t) == sizeof(char), "Must be equivalent for the MD5 to work!");
-
-    const md5_byte_t* bytes;
-    GSL_SUPPRESS_TYPE1 bytes = reinterpret_cast<const md5_byte_t*>(sStringToMD5.c_str());
+    // md5_append takes an int, so very large spans have to be split up
+    constexpr size_t MAX_APPEND = 0x40000000;
+    while (nSize > MAX_APPEND)
+    {
+        md5_append(&m_pState, pData, gsl::narrow_cast<int>(MAX_APPEND));
+        pData += MAX_APPEND;
+        nSize -= MAX_APPEND;
+    }
 
-    md5_init(&pms);
-    md5_append(&pms, bytes, gsl::narrow_cast<int>(sStringToMD5.length()));
-    md5_finish(&pms, digest);
+    if (nSize > 0)
+        md5_append(&m_pState, pData, gsl::narrow_cast<int>(nSize));
+}
 
-    return RAFormatMD5(digest);
+void MD5Hasher::Append(const std::string& sData) noexcept
+{
+    const uint8_t* pBytes;
+    GSL_SUPPRESS_TYPE1 pBytes = reinterpret_cast<const uint8_t*>(sData.data());
+    Append(pBytes, sData.length());
 }
 
-std::string RAGenerateMD5(const BYTE* pRawData, size_t nDataLen)
+bool MD5Hasher::AppendFile(const std::wstring& sPath)
 {
-    md5_state_t pms;
-    md5_byte_t digest[16];
+    auto& pFileSystem = ra::services::ServiceLocator::Get<ra::services::IFileSystem>();
+    auto pFile = pFileSystem.OpenTextFile(sPath);
+    if (pFile == nullptr)
+        return false;
 
-    static_assert(sizeof(md5_byte_t) == sizeof(BYTE), "Must be equivalent for the MD5 to work!");
+    // the buffer is kept so subsequent calls don't have to allocate it again
+    if (m_vFileBuffer.size() < FILE_CHUNK_SIZE)
+        m_vFileBuffer.resize(FILE_CHUNK_SIZE);
 
-    md5_init(&pms);
-    md5_append(&pms, pRawData, gsl::narrow_cast<int>(nDataLen));
-    md5_finish(&pms, digest);
+    do
+    {
+        const size_t nBytes = pFile->GetBytes(m_vFileBuffer.data(), m_vFileBuffer.size());
+        if (nBytes == 0)
+            break;
 
-    return RAFormatMD5(digest);
+        Append(m_vFileBuffer.data(), nBytes);
+    } while (true);
+
+    return true;
 }
 
-std::string RAGenerateMD5(const std::vector<BYTE> DataIn)
+MD5Digest MD5Hasher::Finish() noexcept
 {
-    return RAGenerateMD5(DataIn.data(), DataIn.size());
+    MD5Digest pDigest{};
+    md5_finish(&m_pState, pDigest.data());
+    Reset();
+    return pDigest;
 }
 
-std::string RAGenerateFileMD5(const std::wstring& sPath)
+std::string FormatMD5(const MD5Digest& pDigest)
 {
-    md5_state_t pms{};
-    md5_byte_t digest[16]{};
+    return RAFormatMD5(pDigest.data());
+}
 
-    md5_byte_t bytes[4096]{};
-    static_assert(sizeof(md5_byte_t) == sizeof(uint8_t), "Must be equivalent for the MD5 to work!");
+} // namespace ra
 
-    auto& pFileSystem = ra::services::ServiceLocator::Get<ra::services::IFileSystem>();
-    auto pFile = pFileSystem.OpenTextFile(sPath);
-    if (pFile == nullptr)
-        return "";
+std::string RAFormatMD5(const BYTE* digest)
+{
+    Expects(digest != nullptr);
 
-    md5_init(&pms);
-    do
+    static constexpr std::array<char, 16> HEX_CHARS = {
+        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'
+    };
+
+    std::string sBuffer(MD5_STRING_LEN, '0');
+    for (size_t i = 0; i < 16; ++i)
     {
-        size_t nBytes = pFile->GetBytes(static_cast<uint8_t*>(bytes), sizeof(bytes));
-        if (nBytes == 0)
-            break;
+        const BYTE nByte = digest[i];
+        sBuffer.at(i * 2) = HEX_CHARS.at(nByte >> 4);
+        sBuffer.at(i * 2 + 1) = HEX_CHARS.at(nByte & 0x0F);
+    }
 
-        md5_append(&pms, bytes, gsl::narrow_cast<int>(nBytes));
-    } while (true);
-    md5_finish(&pms, digest);
+    return sBuffer;
+}
+
+std::string RAGenerateMD5(const std::string& sStringToMD5)
+{
+    ra::MD5Hasher pHasher;
+    pHasher.Append(sStringToMD5);
+    return ra::FormatMD5(pHasher.Finish());
+}
 
-    return RAFormatMD5(digest);
+std::string RAGenerateMD5(const BYTE* pRawData, size_t nDataLen)
+{
+    ra::MD5Hasher pHasher;
+    pHasher.Append(pRawData, nDataLen);
+    return ra::FormatMD5(pHasher.Finish());
 }
 
+std::string RAGenerateMD5(const std::vector<BYTE>& DataIn)
+{
+    return RAGenerateMD5(DataIn.data(), DataIn.size());
+}
+
+std::string RAGenerateFileMD5(const std::wstring& sPath)
+{
+    ra::MD5Hasher pHasher;
+    if (!pHasher.AppendFile(sPath))
+        return "";
+
+    return ra::FormatMD5(pHasher.Finish());
+}
@@ -2,9 +2,73 @@
 #define RA_MD5FACTORY_H
 #pragma once
 
+#include <rcheevos/src/rhash/md5.h>
+
+namespace ra {
+
+/// <summary>
+/// The raw 16-byte result of an MD5 calculation.
+/// </summary>
+using MD5Digest = std::array<uint8_t, 16>;
+
+/// <summary>
+/// Incrementally calculates an MD5 for data that is provided in one or more pieces.
+/// </summary>
+/// <remarks>
+/// A single instance can be reused for multiple calculations. <see cref="Finish" /> resets the state
+/// so the next call to <see cref="Append" /> starts a new calculation.
+/// </remarks>
+class MD5Hasher
+{
+public:
+    MD5Hasher() noexcept { Reset(); }
+
+    /// <summary>
+    /// Discards any data that has been appended.
+    /// </summary>
+    void Reset() noexcept;
+
+    /// <summary>
+    /// Adds a block of data to the calculation. The data is hashed in place (not copied).
+    /// </summary>
+    void Append(const uint8_t* pData, size_t nSize) noexcept;
+
+    /// <summary>
+    /// Adds a string to the calculation.
+    /// </summary>
+    void Append(const std::string& sData) noexcept;
+
+    /// <summary>
+    /// Adds the contents of a file to the calculation.
+    /// </summary>
+    /// <returns><c>true</c> if the file was read, <c>false</c> if it could not be opened.</returns>
+    bool AppendFile(const std::wstring& sPath);
+
+    /// <summary>
+    /// Completes the calculation and resets the hasher.
+    /// </summary>
+    MD5Digest Finish() noexcept;
+
+    /// <summary>
+    /// Size of the blocks read by <see cref="AppendFile" />.
+    /// </summary>
+    static constexpr size_t FILE_CHUNK_SIZE = 1024 * 1024;
+
+private:
+    md5_state_t m_pState{};
+    std::vector<uint8_t> m_vFileBuffer;
+};
+
+/// <summary>
+/// Converts a digest to a 32-character lowercase hex string.
+/// </summary>
+std::string FormatMD5(const MD5Digest& pDigest);
+
+} // namespace ra
+
 extern std::string RAGenerateMD5(const std::string& sStringToMD5);
 extern std::string RAGenerateMD5(const BYTE* pIn, size_t nLen);
-extern std::string RAGenerateMD5(const std::vector<BYTE> DataIn);
+extern std::string RAGenerateMD5(const std::vector<BYTE>& DataIn);
 
 extern std::string RAGenerateFileMD5(const std::wstring& sPath);
 
@@ -23,6 +23,9 @@ public:
             std::string Author;
         };
         std::vector<CodeNote> Notes;
+
+        // hash of the note content as provided by the server. see CodeNotesCache::HashNote
+        uint32_t Hash{ 0U };
     };
 
     struct Request : ApiRequestBase
@@ -0,0 +1,158 @@
+#include "CodeNotesCache.hh"
+
+#include "RA_StringUtils.h"
+
+namespace ra {
+namespace api {
+namespace impl {
+
+static constexpr char CACHE_SIGNATURE[4] = { 'R', 'A', 'C', 'N' };
+static constexpr size_t HEADER_SIZE = sizeof(CACHE_SIGNATURE) + 3 * sizeof(uint32_t); // signature, version, count, hash
+static constexpr size_t NOTE_HEADER_SIZE = 3 * sizeof(uint32_t); // address, author length, note length
+
+static constexpr uint32_t FNV_PRIME = 0x01000193;
+
+static uint32_t HashBytes(uint32_t nHash, _In_reads_(nBytes) const char* pBytes, size_t nBytes) noexcept
+{
+    for (size_t i = 0; i < nBytes; ++i)
+    {
+        nHash ^= gsl::narrow_cast<uint8_t>(pBytes[i]);
+        nHash *= FNV_PRIME;
+    }
+
+    return nHash;
+}
+
+static void PutUInt32(_Out_writes_(4) char* pBuffer, uint32_t nValue) noexcept
+{
+    // always little-endian, regardless of the platform
+    pBuffer[0] = gsl::narrow_cast<char>(nValue & 0xFF);
+    pBuffer[1] = gsl::narrow_cast<char>((nValue >> 8) & 0xFF);
+    pBuffer[2] = gsl::narrow_cast<char>((nValue >> 16) & 0xFF);
+    pBuffer[3] = gsl::narrow_cast<char>((nValue >> 24) & 0xFF);
+}
+
+static uint32_t GetUInt32(_In_reads_(4) const char* pBuffer) noexcept
+{
+    uint32_t nValue;
+    nValue = gsl::narrow_cast<uint8_t>(pBuffer[0]);
+    nValue |= gsl::narrow_cast<uint32_t>(gsl::narrow_cast<uint8_t>(pBuffer[1])) << 8;
+    nValue |= gsl::narrow_cast<uint32_t>(gsl::narrow_cast<uint8_t>(pBuffer[2])) << 16;
+    nValue |= gsl::narrow_cast<uint32_t>(gsl::narrow_cast<uint8_t>(pBuffer[3])) << 24;
+    return nValue;
+}
+
+uint32_t CodeNotesCache::HashNote(uint32_t nHash, ra::ByteAddress nAddress,
+                                  const char* sAuthor, size_t nAuthorLength,
+                                  const char* sNote, size_t nNoteLength) noexcept
+{
+    // the lengths are included so moving text between the author and the note changes the hash
+    char pBuffer[NOTE_HEADER_SIZE];
+    PutUInt32(&pBuffer[0], nAddress);
+    PutUInt32(&pBuffer[4], gsl::narrow_cast<uint32_t>(nAuthorLength));
+    PutUInt32(&pBuffer[8], gsl::narrow_cast<uint32_t>(nNoteLength));
+
+    nHash = HashBytes(nHash, pBuffer, sizeof(pBuffer));
+    nHash = HashBytes(nHash, sAuthor, nAuthorLength);
+    return HashBytes(nHash, sNote, nNoteLength);
+}
+
+void CodeNotesCache::WriteHeader(ra::services::TextWriter& pWriter, size_t nNotes, uint32_t nHash)
+{
+    char pBuffer[HEADER_SIZE];
+    memcpy(&pBuffer[0], CACHE_SIGNATURE, sizeof(CACHE_SIGNATURE));
+    PutUInt32(&pBuffer[4], FormatVersion);
+    PutUInt32(&pBuffer[8], gsl::narrow_cast<uint32_t>(nNotes));
+    PutUInt32(&pBuffer[12], nHash);
+    pWriter.Write(pBuffer, sizeof(pBuffer));
+}
+
+void CodeNotesCache::WriteNote(ra::services::TextWriter& pWriter, ra::ByteAddress nAddress,
+                               const char* sAuthor, size_t nAuthorLength,
+                               const char* sNote, size_t nNoteLength)
+{
+    char pBuffer[NOTE_HEADER_SIZE];
+    PutUInt32(&pBuffer[0], nAddress);
+    PutUInt32(&pBuffer[4], gsl::narrow_cast<uint32_t>(nAuthorLength));
+    PutUInt32(&pBuffer[8], gsl::narrow_cast<uint32_t>(nNoteLength));
+    pWriter.Write(pBuffer, sizeof(pBuffer));
+
+    pWriter.Write(sAuthor, nAuthorLength);
+    pWriter.Write(sNote, nNoteLength);
+}
+
+bool CodeNotesCache::Read(ra::services::TextReader& pReader, FetchCodeNotes::Response& pResponse)
+{
+    // read the whole file in one call. the records are parsed directly out of this buffer.
+    const auto nSize = pReader.GetSize();
+    if (nSize < HEADER_SIZE)
+        return false;
+
+    std::string sBuffer;
+    sBuffer.resize(nSize);
+    uint8_t* pBuffer;
+    GSL_SUPPRESS_TYPE1 pBuffer = reinterpret_cast<uint8_t*>(sBuffer.data());
+    pReader.SetPosition(0);
+    if (pReader.GetBytes(pBuffer, nSize) != nSize)
+        return false;
+
+    const char* pData = sBuffer.data();
+    if (memcmp(pData, CACHE_SIGNATURE, sizeof(CACHE_SIGNATURE)) != 0)
+        return false;
+
+    if (GetUInt32(&pData[4]) != FormatVersion)
+        return false;
+
+    const uint32_t nCount = GetUInt32(&pData[8]);
+    const uint32_t nExpectedHash = GetUInt32(&pData[12]);
+
+    // each record is at least NOTE_HEADER_SIZE bytes. don't trust a count that couldn't fit in the file
+    if (nCount > (nSize - HEADER_SIZE) / NOTE_HEADER_SIZE)
+        return false;
+
+    std::vector<FetchCodeNotes::Response::CodeNote> vNotes;
+    vNotes.reserve(nCount);
+
+    uint32_t nHash = EmptyHash;
+    std::string sNote;
+    size_t nOffset = HEADER_SIZE;
+    for (uint32_t i = 0; i < nCount; ++i)
+    {
+        if (nSize - nOffset < NOTE_HEADER_SIZE)
+            return false;
+
+        const char* pRecord = &pData[nOffset];
+        const auto nAddress = GetUInt32(pRecord);
+        const size_t nAuthorLength = GetUInt32(&pRecord[4]);
+        const size_t nNoteLength = GetUInt32(&pRecord[8]);
+        nOffset += NOTE_HEADER_SIZE;
+
+        if (nSize - nOffset < nAuthorLength || nSize - nOffset - nAuthorLength < nNoteLength)
+            return false;
+
+        const char* sAuthor = &pData[nOffset];
+        const char* sNoteText = &pData[nOffset + nAuthorLength];
+        nOffset += nAuthorLength + nNoteLength;
+
+        nHash = HashNote(nHash, nAddress, sAuthor, nAuthorLength, sNoteText, nNoteLength);
+
+        auto& pNote = vNotes.emplace_back();
+        pNote.Address = nAddress;
+        pNote.Author.assign(sAuthor, nAuthorLength);
+
+        sNote.assign(sNoteText, nNoteLength);
+        pNote.Note = ra::Widen(sNote);
+        ra::NormalizeLineEndings(pNote.Note);
+    }
+
+    if (nHash != nExpectedHash || nOffset != nSize)
+        return false;
+
+    pResponse.Notes.swap(vNotes);
+    pResponse.Hash = nHash;
+    return true;
+}
+
+} // namespace impl
+} // namespace api
+} // namespace ra
@@ -0,0 +1,69 @@
+#ifndef RA_API_CODE_NOTES_CACHE_HH
+#define RA_API_CODE_NOTES_CACHE_HH
+#pragma once
+
+#include "api\FetchCodeNotes.hh"
+
+#include "services\TextReader.hh"
+#include "services\TextWriter.hh"
+
+namespace ra {
+namespace api {
+namespace impl {
+
+/// <summary>
+/// Reads and writes the local copy of the code notes for a game.
+/// </summary>
+/// <remarks>
+/// The cache is a versioned binary file: a header containing the number of notes and a hash of
+/// their content, followed by length-prefixed records for each note. Notes are stored as provided
+/// by the server (UTF-8, line endings not normalized) so they can be written without conversion.
+/// </remarks>
+class CodeNotesCache
+{
+public:
+    /// <summary>
+    /// Incremented whenever the layout of the file changes. Files with any other version are ignored.
+    /// </summary>
+    static constexpr uint32_t FormatVersion = 1;
+
+    /// <summary>
+    /// The hash of an empty set of notes.
+    /// </summary>
+    static constexpr uint32_t EmptyHash = 0x811C9DC5;
+
+    /// <summary>
+    /// Adds a note to a running content hash.
+    /// </summary>
+    /// <param name="nHash">The hash of the preceding notes, or <see cref="EmptyHash" /> for the first note.</param>
+    static uint32_t HashNote(uint32_t nHash, ra::ByteAddress nAddress,
+                             _In_reads_(nAuthorLength) const char* sAuthor, size_t nAuthorLength,
+                             _In_reads_(nNoteLength) const char* sNote, size_t nNoteLength) noexcept;
+
+    /// <summary>
+    /// Writes the file header. Must be followed by exactly <paramref name="nNotes" /> calls to <see cref="WriteNote" />.
+    /// </summary>
+    static void WriteHeader(ra::services::TextWriter& pWriter, size_t nNotes, uint32_t nHash);
+
+    /// <summary>
+    /// Writes a single note record.
+    /// </summary>
+    static void WriteNote(ra::services::TextWriter& pWriter, ra::ByteAddress nAddress,
+                          _In_reads_(nAuthorLength) const char* sAuthor, size_t nAuthorLength,
+                          _In_reads_(nNoteLength) const char* sNote, size_t nNoteLength);
+
+    /// <summary>
+    /// Reads the cached notes into <paramref name="pResponse" />.
+    /// </summary>
+    /// <returns>
+    /// <c>true</c> if the notes were read. <c>false</c> if the file is from a different version, is truncated,
+    /// or its content does not match the hash in the header.
+    /// </returns>
+    static bool Read(ra::services::TextReader& pReader, FetchCodeNotes::Response& pResponse);
+};
+
+} // namespace impl
+} // namespace api
+} // namespace ra
+
+#endif // !RA_API_CODE_NOTES_CACHE_HH
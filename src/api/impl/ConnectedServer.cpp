@@ -1,5 +1,6 @@
 #include "ConnectedServer.hh"
 
+#include "CodeNotesCache.hh"
 #include "DisconnectedServer.hh"
 #include "RA_Defs.h"
 
@@ -53,6 +54,22 @@ _NODISCARD static bool HandleHttpError(_In_ const ra::services::Http::StatusCode
     return false;
 }
 
+// responses larger than this are truncated in the log. code notes and patch data can be several megabytes.
+static constexpr size_t MAX_LOGGED_RESPONSE_LENGTH = 4096;
+
+static void LogResponse([[maybe_unused]] _In_ const char* sApiName, [[maybe_unused]] _In_ const std::string& sContent)
+{
+    if (sContent.length() <= MAX_LOGGED_RESPONSE_LENGTH)
+    {
+        RA_LOG_INFO("-- %s Response: %s", sApiName, sContent);
+    }
+    else
+    {
+        RA_LOG_INFO("-- %s Response (%zu bytes): %s...", sApiName, sContent.length(),
+                    sContent.substr(0, MAX_LOGGED_RESPONSE_LENGTH));
+    }
+}
+
 _NODISCARD static bool GetJson([[maybe_unused]] _In_ const char* sApiName,
                                _In_ const ra::services::Http::Response& httpResponse,
                                _Inout_ ApiResponseBase& pResponse, _Out_ rapidjson::Document& pDocument)
@@ -71,7 +88,7 @@ _NODISCARD static bool GetJson([[maybe_unused]] _In_ const char* sApiName,
         return false;
     }
 
-    RA_LOG_INFO("-- %s Response: %s", sApiName, httpResponse.Content());
+    LogResponse(sApiName, httpResponse.Content());
 
     pDocument.Parse(httpResponse.Content());
     if (pDocument.HasParseError())
@@ -227,7 +244,7 @@ static bool DoRequestWithoutLog(const rc_api_request_t& api_request, _UNUSED con
         return false;
     }
 
-    RA_LOG_INFO("-- %s Response: %s", sApiName, pHttpResponse.Content());
+    LogResponse(sApiName, pHttpResponse.Content());
 
     switch (pHttpResponse.Content().at(0))
     {
@@ -557,22 +574,26 @@ FetchCodeNotes::Response ConnectedServer::FetchCodeNotes(const FetchCodeNotes::R
 
             if (ValidateResponse(nResult, api_response.response, FetchCodeNotes::Name(), httpResponse.StatusCode(), response))
             {
-                // store a copy in the cache for offline mode
+                response.Result = ApiResult::Success;
+
+                ProcessCodeNotes(response, &api_response);
+
+                // store a copy in the cache for offline mode. the notes are written directly from the
+                // parsed response so the body is never copied.
                 auto& pLocalStorage = ra::services::ServiceLocator::GetMutable<ra::services::ILocalStorage>();
                 auto pData = pLocalStorage.WriteText(ra::services::StorageItemType::CodeNotes, std::to_wstring(request.GameId));
                 if (pData != nullptr)
                 {
-                    std::string sContent(httpResponse.Content());
-                    auto nIndex = sContent.find('[');
-                    sContent.erase(0, nIndex);
-                    nIndex = sContent.find_last_of(']');
-                    sContent.erase(nIndex + 1);
-                    pData->Write(sContent);
-                }
-
-                response.Result = ApiResult::Success;
+                    CodeNotesCache::WriteHeader(*pData, api_response.num_notes, response.Hash);
 
-                ProcessCodeNotes(response, &api_response);
+                    const rc_api_code_note_t* note = api_response.notes;
+                    const rc_api_code_note_t* stop = api_response.notes + api_response.num_notes;
+                    for (; note < stop; ++note)
+                    {
+                        CodeNotesCache::WriteNote(*pData, note->address,
+                            note->author, strlen(note->author), note->note, strlen(note->note));
+                    }
+                }
             }
 
             rc_api_destroy_fetch_code_notes_response(&api_response);
@@ -596,8 +617,15 @@ void ConnectedServer::ProcessCodeNotes(FetchCodeNotes::Response& response, const
         static_cast<const rc_api_fetch_code_notes_response_t*>(api_response);
     const rc_api_code_note_t* note = fetch_code_notes_response->notes;
     const rc_api_code_note_t* stop = fetch_code_notes_response->notes + fetch_code_notes_response->num_notes;
+
+    response.Notes.reserve(response.Notes.size() + fetch_code_notes_response->num_notes);
+    response.Hash = CodeNotesCache::EmptyHash;
+
     for (; note < stop; ++note)
     {
+        response.Hash = CodeNotesCache::HashNote(response.Hash, note->address,
+            note->author, strlen(note->author), note->note, strlen(note->note));
+
         auto& pNote = response.Notes.emplace_back();
         pNote.Author = note->author;
         pNote.Address = note->address;
@@ -1,14 +1,12 @@
 #include "OfflineServer.hh"
 
-#include "RA_Json.h"
+#include "RA_StringUtils.h"
 
-#include "api\impl\ConnectedServer.hh"
+#include "api\impl\CodeNotesCache.hh"
 
 #include "services\ILocalStorage.hh"
 #include "services\ServiceLocator.hh"
 
-#include <rc_api_editor.h>
-
 namespace ra {
 namespace api {
 namespace impl {
@@ -16,7 +14,6 @@ namespace impl {
 FetchCodeNotes::Response OfflineServer::FetchCodeNotes(const FetchCodeNotes::Request& request)
 {
     FetchCodeNotes::Response response;
-    rapidjson::Document document;
 
     // see if the data is available in the cache
     auto& pLocalStorage = ra::services::ServiceLocator::GetMutable<ra::services::ILocalStorage>();
@@ -28,27 +25,16 @@ FetchCodeNotes::Response OfflineServer::FetchCodeNotes(const FetchCodeNotes::Req
         return response;
     }
 
-    std::string sNotes;
-    if (!pData->GetLine(sNotes)) // ASSERT: entire JSON block is a single line
+    if (!CodeNotesCache::Read(*pData, response))
     {
+        // file was written by an older version, or is damaged. it will be rewritten the next time
+        // the notes are fetched from the server.
         response.Result = ApiResult::Error;
-        response.ErrorMessage =
-            ra::StringPrintf("%s (%zu)", GetParseError_En(document.GetParseError()), document.GetErrorOffset());
-    }
-    else
-    {
-        response.Result = ApiResult::Success;
-        sNotes.insert(0, "{\"Success\": true,\"CodeNotes\":");
-        sNotes.push_back('}');
-
-        rc_api_fetch_code_notes_response_t api_response;
-        const auto nResult = rc_api_process_fetch_code_notes_response(&api_response, sNotes.c_str());
-        if (nResult == RC_OK)
-            ConnectedServer::ProcessCodeNotes(response, &api_response);
-
-        rc_api_destroy_fetch_code_notes_response(&api_response);
+        response.ErrorMessage = ra::StringPrintf("Cached code notes for game %u could not be read", request.GameId);
+        return response;
     }
 
+    response.Result = ApiResult::Success;
     return response;
 }
 
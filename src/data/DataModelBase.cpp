@@ -15,31 +15,16 @@ void DataModelBase::OnValueChanged(const BoolModelProperty::ChangeArgs& args)
             SetValue(IsModifiedProperty, m_pTransaction->IsModified());
         }
 
-        if (m_pUpdateTransaction)
+        if (m_pUpdateTransaction && m_pUpdateTransaction->m_nUpdateCount > 0)
         {
-            for (auto& pChange : m_pUpdateTransaction->m_vDelayedBoolChanges)
-            {
-                if (pChange.pProperty == &args.Property)
-                {
-                    pChange.tNewValue = args.tNewValue;
-                    return;
-                }
-            }
-
-            m_pUpdateTransaction->m_vDelayedBoolChanges.push_back({ &args.Property, args.tOldValue, args.tNewValue });
+            m_pUpdateTransaction->ValueChanged(m_pUpdateTransaction->m_vDelayedBoolChanges, args);
             return;
         }
     }
 
-    if (!m_vNotifyTargets.empty())
+    if (!m_vNotifyTargets.IsEmpty())
     {
-        // create a copy of the list of pointers in case it's modified by one of the callbacks
-        NotifyTargetSet vNotifyTargets(m_vNotifyTargets);
-        for (NotifyTarget* target : vNotifyTargets)
-        {
-            Expects(target != nullptr);
-            target->OnDataModelBoolValueChanged(args);
-        }
+        m_vNotifyTargets.Dispatch([&](NotifyTarget& pTarget) { pTarget.OnDataModelBoolValueChanged(args); });
     }
 
     ModelBase::OnValueChanged(args);
@@ -47,7 +32,7 @@ void DataModelBase::OnValueChanged(const BoolModelProperty::ChangeArgs& args)
 
 void DataModelBase::Transaction::ValueChanged(const BoolModelProperty::ChangeArgs& args)
 {
-    const IntModelProperty::ValueMap::const_iterator iter = m_mOriginalIntValues.find(args.Property.GetKey());
+    const IntValueMap::const_iterator iter = m_mOriginalIntValues.find(args.Property.GetKey());
     if (iter == m_mOriginalIntValues.end())
     {
         m_mOriginalIntValues.insert_or_assign(args.Property.GetKey(), static_cast<int>(args.tOldValue));
@@ -72,31 +57,16 @@ void DataModelBase::OnValueChanged(const StringModelProperty::ChangeArgs& args)
             SetValue(IsModifiedProperty, m_pTransaction->IsModified());
         }
 
-        if (m_pUpdateTransaction)
+        if (m_pUpdateTransaction && m_pUpdateTransaction->m_nUpdateCount > 0)
         {
-            for (auto& pChange : m_pUpdateTransaction->m_vDelayedStringChanges)
-            {
-                if (pChange.pProperty == &args.Property)
-                {
-                    pChange.tNewValue = args.tNewValue;
-                    return;
-                }
-            }
-
-            m_pUpdateTransaction->m_vDelayedStringChanges.push_back({ &args.Property, args.tOldValue, args.tNewValue });
+            m_pUpdateTransaction->ValueChanged(m_pUpdateTransaction->m_vDelayedStringChanges, args);
             return;
         }
     }
 
-    if (!m_vNotifyTargets.empty())
+    if (!m_vNotifyTargets.IsEmpty())
     {
-        // create a copy of the list of pointers in case it's modified by one of the callbacks
-        NotifyTargetSet vNotifyTargets(m_vNotifyTargets);
-        for (NotifyTarget* target : vNotifyTargets)
-        {
-            Expects(target != nullptr);
-            target->OnDataModelStringValueChanged(args);
-        }
+        m_vNotifyTargets.Dispatch([&](NotifyTarget& pTarget) { pTarget.OnDataModelStringValueChanged(args); });
     }
 
     ModelBase::OnValueChanged(args);
@@ -104,7 +74,7 @@ void DataModelBase::OnValueChanged(const StringModelProperty::ChangeArgs& args)
 
 void DataModelBase::Transaction::ValueChanged(const StringModelProperty::ChangeArgs& args)
 {
-    const StringModelProperty::ValueMap::const_iterator iter = m_mOriginalStringValues.find(args.Property.GetKey());
+    const StringValueMap::const_iterator iter = m_mOriginalStringValues.find(args.Property.GetKey());
     if (iter == m_mOriginalStringValues.end())
     {
         m_mOriginalStringValues.insert_or_assign(args.Property.GetKey(), args.tOldValue);
@@ -129,31 +99,16 @@ void DataModelBase::OnValueChanged(const IntModelProperty::ChangeArgs& args)
             SetValue(IsModifiedProperty, m_pTransaction->IsModified());
         }
 
-        if (m_pUpdateTransaction)
+        if (m_pUpdateTransaction && m_pUpdateTransaction->m_nUpdateCount > 0)
         {
-            for (auto& pChange : m_pUpdateTransaction->m_vDelayedIntChanges)
-            {
-                if (pChange.pProperty == &args.Property)
-                {
-                    pChange.tNewValue = args.tNewValue;
-                    return;
-                }
-            }
-
-            m_pUpdateTransaction->m_vDelayedIntChanges.push_back({ &args.Property, args.tOldValue, args.tNewValue });
+            m_pUpdateTransaction->ValueChanged(m_pUpdateTransaction->m_vDelayedIntChanges, args);
             return;
         }
     }
 
-    if (!m_vNotifyTargets.empty())
+    if (!m_vNotifyTargets.IsEmpty())
     {
-        // create a copy of the list of pointers in case it's modified by one of the callbacks
-        NotifyTargetSet vNotifyTargets(m_vNotifyTargets);
-        for (NotifyTarget* target : vNotifyTargets)
-        {
-            Expects(target != nullptr);
-            target->OnDataModelIntValueChanged(args);
-        }
+        m_vNotifyTargets.Dispatch([&](NotifyTarget& pTarget) { pTarget.OnDataModelIntValueChanged(args); });
     }
 
     ModelBase::OnValueChanged(args);
@@ -161,7 +116,7 @@ void DataModelBase::OnValueChanged(const IntModelProperty::ChangeArgs& args)
 
 void DataModelBase::Transaction::ValueChanged(const IntModelProperty::ChangeArgs& args)
 {
-    const IntModelProperty::ValueMap::const_iterator iter = m_mOriginalIntValues.find(args.Property.GetKey());
+    const IntValueMap::const_iterator iter = m_mOriginalIntValues.find(args.Property.GetKey());
     if (iter == m_mOriginalIntValues.end())
     {
         m_mOriginalIntValues.insert_or_assign(args.Property.GetKey(), args.tOldValue);
@@ -187,7 +142,7 @@ void DataModelBase::BeginUpdate()
 
 void DataModelBase::EndUpdate()
 {
-    if (m_pUpdateTransaction && --m_pUpdateTransaction->m_nUpdateCount == 0)
+    if (m_pUpdateTransaction && m_pUpdateTransaction->m_nUpdateCount > 0 && --m_pUpdateTransaction->m_nUpdateCount == 0)
     {
         std::unique_ptr<UpdateTransaction> pUpdateTransaction = std::move(m_pUpdateTransaction);
 
@@ -225,6 +180,13 @@ void DataModelBase::EndUpdate()
         }
 
         m_pEndUpdateChangeArgs = nullptr;
+
+        // keep the transaction for the next BeginUpdate unless one of the handlers already started a new update
+        if (m_pUpdateTransaction == nullptr)
+        {
+            pUpdateTransaction->Reset();
+            m_pUpdateTransaction = std::move(pUpdateTransaction);
+        }
     }
 }
 
@@ -281,7 +243,7 @@ void DataModelBase::Transaction::Revert(DataModelBase& pModel)
 {
     // swap out the map while we process it to prevent re-entrant calls to ValueChanged from
     // modifying it while we're iterating
-    IntModelProperty::ValueMap mOriginalIntValues;
+    IntValueMap mOriginalIntValues;
     mOriginalIntValues.swap(m_mOriginalIntValues);
     for (const auto& pPair : mOriginalIntValues)
     {
@@ -301,7 +263,7 @@ void DataModelBase::Transaction::Revert(DataModelBase& pModel)
         }
     }
 
-    StringModelProperty::ValueMap mOriginalStringValues;
+    StringValueMap mOriginalStringValues;
     mOriginalStringValues.swap(m_mOriginalStringValues);
     for (const auto& pPair : mOriginalStringValues)
     {
@@ -3,6 +3,8 @@
 #pragma once
 
 #include "ModelBase.hh"
+#include "NotifyTargetSet.hh"
+#include "PropertyKeyMap.hh"
 
 namespace ra {
 namespace data {
@@ -25,18 +27,18 @@ public:
         virtual void OnDataModelIntValueChanged([[maybe_unused]] const IntModelProperty::ChangeArgs& args) noexcept(false) {}
     };
 
-    void AddNotifyTarget(NotifyTarget& pTarget) noexcept { GSL_SUPPRESS_F6 m_vNotifyTargets.insert(&pTarget); }
+    void AddNotifyTarget(NotifyTarget& pTarget) noexcept { GSL_SUPPRESS_F6 m_vNotifyTargets.Add(pTarget); }
 
     void RemoveNotifyTarget(NotifyTarget& pTarget) noexcept
     {
 #ifdef RA_UTEST
         GSL_SUPPRESS_F6 Expects(!m_bDestructed);
 #endif
-        GSL_SUPPRESS_F6 m_vNotifyTargets.erase(&pTarget);
+        GSL_SUPPRESS_F6 m_vNotifyTargets.Remove(pTarget);
     }
 
 private:
-    using NotifyTargetSet = std::set<NotifyTarget*>;
+    using NotifyTargetSet = ra::data::NotifyTargetSet<NotifyTarget>;
 
     /// <summary>
     /// A collection of pointers to other objects. These are not allocated object and do not need to be free'd. It's
@@ -138,12 +140,15 @@ protected:
     class Transaction
     {
     public:
+        using IntValueMap = PropertyKeyMap<int>;
+        using StringValueMap = PropertyKeyMap<std::wstring>;
+
         /// <summary>
         /// Gets the value of the property prior to any changes made in the current transaction
         /// </summary>
         const bool* GetPreviousValue(const BoolModelProperty& pProperty) const
         {
-            const IntModelProperty::ValueMap::const_iterator iter = m_mOriginalIntValues.find(pProperty.GetKey());
+            const IntValueMap::const_iterator iter = m_mOriginalIntValues.find(pProperty.GetKey());
             GSL_SUPPRESS_TYPE1 return (iter != m_mOriginalIntValues.end()) ? reinterpret_cast<const bool*>(&iter->second) : nullptr;
         }
 
@@ -153,7 +158,7 @@ protected:
         /// </summary>
         const std::wstring* GetPreviousValue(const StringModelProperty& pProperty) const
         {
-            const StringModelProperty::ValueMap::const_iterator iter = m_mOriginalStringValues.find(pProperty.GetKey());
+            const StringValueMap::const_iterator iter = m_mOriginalStringValues.find(pProperty.GetKey());
             return (iter != m_mOriginalStringValues.end()) ? &iter->second : nullptr;
         }
 
@@ -163,7 +168,7 @@ protected:
         /// </summary>
         const int* GetPreviousValue(const IntModelProperty& pProperty) const
         {
-            const IntModelProperty::ValueMap::const_iterator iter = m_mOriginalIntValues.find(pProperty.GetKey());
+            const IntValueMap::const_iterator iter = m_mOriginalIntValues.find(pProperty.GetKey());
             return (iter != m_mOriginalIntValues.end()) ? &iter->second : nullptr;
         }
 
@@ -200,7 +205,7 @@ protected:
         /// <returns><c>true</c> if modified, <c>false</c> if not.</returns>
         bool IsModified(const BoolModelProperty& pProperty) const
         {
-            const IntModelProperty::ValueMap::const_iterator iter = m_mOriginalIntValues.find(pProperty.GetKey());
+            const IntValueMap::const_iterator iter = m_mOriginalIntValues.find(pProperty.GetKey());
             return (iter != m_mOriginalIntValues.end());
         }
 
@@ -211,7 +216,7 @@ protected:
         /// <returns><c>true</c> if modified, <c>false</c> if not.</returns>
         bool IsModified(const StringModelProperty& pProperty) const
         {
-            const StringModelProperty::ValueMap::const_iterator iter = m_mOriginalStringValues.find(pProperty.GetKey());
+            const StringValueMap::const_iterator iter = m_mOriginalStringValues.find(pProperty.GetKey());
             return (iter != m_mOriginalStringValues.end());
         }
 
@@ -222,7 +227,7 @@ protected:
         /// <returns><c>true</c> if modified, <c>false</c> if not.</returns>
         bool IsModified(const IntModelProperty& pProperty) const
         {
-            const IntModelProperty::ValueMap::const_iterator iter = m_mOriginalIntValues.find(pProperty.GetKey());
+            const IntValueMap::const_iterator iter = m_mOriginalIntValues.find(pProperty.GetKey());
             return (iter != m_mOriginalIntValues.end());
         }
 
@@ -235,8 +240,8 @@ protected:
         friend class DataModelCollectionBase;
 
     private:
-        StringModelProperty::ValueMap m_mOriginalStringValues;
-        IntModelProperty::ValueMap m_mOriginalIntValues;
+        StringValueMap m_mOriginalStringValues;
+        IntValueMap m_mOriginalIntValues;
 
 #ifdef _DEBUG
         /// <summary>
@@ -273,7 +278,10 @@ protected:
     /// Can be used in OnValueChanged overrides to determine if change notifications are disabled. If they are, OnValueChanged
     /// will be called again once the notifications are re-enabled, so processing should be delayed if this returns true.
     /// </remarks>
-    virtual bool IsUpdating() const noexcept(false) { return (m_pUpdateTransaction != nullptr); }
+    virtual bool IsUpdating() const noexcept(false)
+    {
+        return (m_pUpdateTransaction != nullptr && m_pUpdateTransaction->m_nUpdateCount > 0);
+    }
 
 private:
     void DiscardTransaction();
@@ -309,7 +317,36 @@ private:
         std::vector<DelayedChange<int>> m_vDelayedIntChanges;
         std::vector<DelayedChange<std::wstring>> m_vDelayedStringChanges;
         std::vector<DelayedChange<bool>> m_vDelayedBoolChanges;
+
+        // maps a property key to the index of its entry in the m_vDelayedXXXChanges vector for its type.
+        // the vectors themselves remain in the order the properties were first changed.
+        PropertyKeyMap<size_t> m_mDelayedChangeIndices;
+
+        template<class T>
+        void ValueChanged(std::vector<DelayedChange<T>>& vDelayedChanges, const typename ModelProperty<T>::ChangeArgs& args)
+        {
+            const auto pIter = m_mDelayedChangeIndices.find(args.Property.GetKey());
+            if (pIter != m_mDelayedChangeIndices.end())
+            {
+                vDelayedChanges.at(pIter->second).tNewValue = args.tNewValue;
+            }
+            else
+            {
+                m_mDelayedChangeIndices.insert_or_assign(args.Property.GetKey(), vDelayedChanges.size());
+                vDelayedChanges.push_back({ &args.Property, args.tOldValue, args.tNewValue });
+            }
+        }
+
+        void Reset() noexcept
+        {
+            m_vDelayedIntChanges.clear();
+            m_vDelayedStringChanges.clear();
+            m_vDelayedBoolChanges.clear();
+            m_mDelayedChangeIndices.clear();
+        }
     };
+
+    // the UpdateTransaction is kept after EndUpdate so its memory can be reused by the next BeginUpdate
     std::unique_ptr<UpdateTransaction> m_pUpdateTransaction;
     const void* m_pEndUpdateChangeArgs = nullptr;
 };
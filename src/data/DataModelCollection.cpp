@@ -5,114 +5,66 @@ namespace data {
 
 void DataModelCollectionBase::OnFrozen() noexcept
 {
-    m_vNotifyTargets.clear();
+    m_vNotifyTargets.Clear();
 }
 
 void DataModelCollectionBase::OnModelValueChanged(gsl::index nIndex,
                                                   const BoolModelProperty::ChangeArgs& args)
 {
-    // create a copy of the list of pointers in case it's modified by one of the callbacks
-    NotifyTargetSet vNotifyTargets(m_vNotifyTargets);
-    for (NotifyTarget* target : vNotifyTargets)
-    {
-        Expects(target != nullptr);
-        target->OnDataModelBoolValueChanged(nIndex, args);
-    }
+    m_vNotifyTargets.Dispatch([&](NotifyTarget& pTarget) { pTarget.OnDataModelBoolValueChanged(nIndex, args); });
 }
 
 void DataModelCollectionBase::OnModelValueChanged(gsl::index nIndex,
                                                   const StringModelProperty::ChangeArgs& args)
 {
-    // create a copy of the list of pointers in case it's modified by one of the callbacks
-    NotifyTargetSet vNotifyTargets(m_vNotifyTargets);
-    for (NotifyTarget* target : vNotifyTargets)
-    {
-        Expects(target != nullptr);
-        target->OnDataModelStringValueChanged(nIndex, args);
-    }
+    m_vNotifyTargets.Dispatch([&](NotifyTarget& pTarget) { pTarget.OnDataModelStringValueChanged(nIndex, args); });
 }
 
 void DataModelCollectionBase::OnModelValueChanged(gsl::index nIndex,
                                                   const IntModelProperty::ChangeArgs& args)
 {
-    // create a copy of the list of pointers in case it's modified by one of the callbacks
-    NotifyTargetSet vNotifyTargets(m_vNotifyTargets);
-    for (NotifyTarget* target : vNotifyTargets)
-    {
-        Expects(target != nullptr);
-        target->OnDataModelIntValueChanged(nIndex, args);
-    }
+    m_vNotifyTargets.Dispatch([&](NotifyTarget& pTarget) { pTarget.OnDataModelIntValueChanged(nIndex, args); });
 }
 
 void DataModelCollectionBase::OnBeginUpdate()
 {
-    // create a copy of the list of pointers in case it's modified by one of the callbacks
-    NotifyTargetSet vNotifyTargets(m_vNotifyTargets);
-    for (NotifyTarget* target : vNotifyTargets)
-    {
-        Expects(target != nullptr);
-        target->OnBeginDataModelCollectionUpdate();
-    }
+    m_vNotifyTargets.Dispatch([&](NotifyTarget& pTarget) { pTarget.OnBeginDataModelCollectionUpdate(); });
 }
 
 void DataModelCollectionBase::OnEndUpdate()
 {
-    // create a copy of the list of pointers in case it's modified by one of the callbacks
-    NotifyTargetSet vNotifyTargets(m_vNotifyTargets);
-    for (NotifyTarget* target : vNotifyTargets)
-    {
-        Expects(target != nullptr);
-        target->OnEndDataModelCollectionUpdate();
-    }
+    m_vNotifyTargets.Dispatch([&](NotifyTarget& pTarget) { pTarget.OnEndDataModelCollectionUpdate(); });
 }
 
 void DataModelCollectionBase::OnItemsRemoved(const std::vector<gsl::index>& vDeletedIndices)
 {
-    if (!m_vNotifyTargets.empty())
+    if (!m_vNotifyTargets.IsEmpty())
     {
-        // create a copy of the list of pointers in case it's modified by one of the callbacks
-        NotifyTargetSet vNotifyTargets(m_vNotifyTargets);
         for (auto nDeletedIndex : vDeletedIndices)
         {
-            for (NotifyTarget* target : vNotifyTargets)
-            {
-                Expects(target != nullptr);
-                target->OnDataModelRemoved(nDeletedIndex);
-            }
+            m_vNotifyTargets.Dispatch([&](NotifyTarget& pTarget) { pTarget.OnDataModelRemoved(nDeletedIndex); });
         }
     }
 }
 
 void DataModelCollectionBase::OnItemsAdded(const std::vector<gsl::index>& vNewIndices)
 {
-    if (!m_vNotifyTargets.empty())
+    if (!m_vNotifyTargets.IsEmpty())
     {
-        // create a copy of the list of pointers in case it's modified by one of the callbacks
-        NotifyTargetSet vNotifyTargets(m_vNotifyTargets);
         for (auto vNewIndex : vNewIndices)
         {
-            for (NotifyTarget* target : vNotifyTargets)
-            {
-                Expects(target != nullptr);
-                target->OnDataModelAdded(vNewIndex);
-            }
+            m_vNotifyTargets.Dispatch([&](NotifyTarget& pTarget) { pTarget.OnDataModelAdded(vNewIndex); });
         }
     }
 }
 
 void DataModelCollectionBase::OnItemsChanged(const std::vector<gsl::index>& vChangedIndices)
 {
-    if (!m_vNotifyTargets.empty())
+    if (!m_vNotifyTargets.IsEmpty())
     {
-        // create a copy of the list of pointers in case it's modified by one of the callbacks
-        NotifyTargetSet vNotifyTargets(m_vNotifyTargets);
         for (auto vChangedIndex : vChangedIndices)
         {
-            for (NotifyTarget* target : vNotifyTargets)
-            {
-                Expects(target != nullptr);
-                target->OnDataModelChanged(vChangedIndex);
-            }
+            m_vNotifyTargets.Dispatch([&](NotifyTarget& pTarget) { pTarget.OnDataModelChanged(vChangedIndex); });
         }
     }
 }
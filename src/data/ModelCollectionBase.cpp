@@ -7,12 +7,11 @@ ModelBase& ModelCollectionBase::AddItem(std::unique_ptr<ModelBase> vmViewModel)
 {
     assert(!IsFrozen());
 
-    // insert the new item at the end of the array (but before any deleted items)
     // add the item with a temporary index so we know to notify in UpdateIndices.
     // note that we don't call StartWatching here - there's no sense doing that
     // until the NotifyTarget has been notified that the item exists.
     vmViewModel->m_nCollectionIndex = -1;
-    auto& pItem = *m_vItems.emplace(m_vItems.begin() + m_nSize, std::move(vmViewModel));
+    auto& pItem = m_vItems.emplace_back(std::move(vmViewModel));
     ++m_nSize;
 
     if (m_nUpdateCount == 0)
@@ -27,25 +26,89 @@ void ModelCollectionBase::RemoveAt(gsl::index nIndex)
     {
         assert(!IsFrozen());
 
-        // move the item to the end of the array - we'll clean it up in UpdateIndices
-        if (nIndex != ra::to_signed(m_nSize) - 1)
-            MoveItemInternal(nIndex, m_nSize - 1);
+        // slots before the first empty slot map directly to indices. if the item is after an empty
+        // slot, collapse the empty slots so it can be found. removing items from the end of the list
+        // first (or via RemoveIf) never requires this.
+        if (ra::to_unsigned(nIndex) >= m_nFirstRemovedSlot)
+            CompactItems();
 
-        // store the old index so we can notify properly
-        auto& pItem = *m_vItems.at(m_nSize - 1);
-
-        // stop watching the item immediately
-        if (IsWatching())
-            StopWatching(pItem);
-
-        // update the size
-        --m_nSize;
+        RemoveItemInSlot(gsl::narrow_cast<size_t>(nIndex));
 
         if (m_nUpdateCount == 0)
             UpdateIndices();
     }
 }
 
+size_t ModelCollectionBase::RemoveIf(const std::function<bool(const ModelBase&)>& fPredicate)
+{
+    size_t nRemoved = 0;
+
+    BeginUpdate();
+
+    for (size_t nSlot = 0; nSlot < m_vItems.size(); ++nSlot)
+    {
+        const auto& pItem = m_vItems.at(nSlot);
+        if (pItem != nullptr && fPredicate(*pItem))
+        {
+            assert(!IsFrozen());
+
+            RemoveItemInSlot(nSlot);
+            ++nRemoved;
+        }
+    }
+
+    EndUpdate();
+
+    return nRemoved;
+}
+
+void ModelCollectionBase::RemoveItemInSlot(size_t nSlot)
+{
+    auto& pSlot = m_vItems.at(nSlot);
+
+    // stop watching the item immediately
+    if (IsWatching())
+        StopWatching(*pSlot);
+
+    // hold on to the item until UpdateIndices so we can notify properly. the slot is left empty.
+    m_vRemovedItems.push_back(std::move(pSlot));
+    m_nFirstRemovedSlot = std::min(m_nFirstRemovedSlot, nSlot);
+
+    // update the size
+    --m_nSize;
+}
+
+void ModelCollectionBase::CompactItems() noexcept
+{
+    if (m_nFirstRemovedSlot == NO_REMOVED_SLOT)
+        return;
+
+    // shift the remaining items into the empty slots, preserving their order
+    auto nWrite = m_nFirstRemovedSlot;
+    for (auto nRead = nWrite + 1; nRead < m_vItems.size(); ++nRead)
+    {
+        auto& pItem = m_vItems[nRead];
+        if (pItem != nullptr)
+            m_vItems[nWrite++] = std::move(pItem);
+    }
+
+    m_vItems.resize(nWrite);
+    m_nFirstRemovedSlot = NO_REMOVED_SLOT;
+}
+
+const ModelBase* ModelCollectionBase::FindModelAfterRemovedSlot(gsl::index nIndex) const
+{
+    auto nRemaining = nIndex - gsl::narrow_cast<gsl::index>(m_nFirstRemovedSlot);
+    for (auto nSlot = m_nFirstRemovedSlot + 1; nSlot < m_vItems.size(); ++nSlot)
+    {
+        const auto& pItem = m_vItems.at(nSlot);
+        if (pItem != nullptr && nRemaining-- == 0)
+            return pItem.get();
+    }
+
+    return nullptr;
+}
+
 void ModelCollectionBase::Clear()
 {
     assert(!IsFrozen());
@@ -56,6 +119,17 @@ void ModelCollectionBase::Clear()
     BeginUpdate();
 
     StopWatching();
+
+    // hold on to the items until UpdateIndices so we can notify properly. they're queued in reverse
+    // order so later indices are processed first.
+    for (auto pIter = m_vItems.rbegin(); pIter != m_vItems.rend(); ++pIter)
+    {
+        if (*pIter != nullptr)
+            m_vRemovedItems.push_back(std::move(*pIter));
+    }
+
+    m_vItems.clear();
+    m_nFirstRemovedSlot = NO_REMOVED_SLOT;
     m_nSize = 0;
 
     EndUpdate();
@@ -77,6 +151,7 @@ void ModelCollectionBase::MoveItem(gsl::index nIndex, gsl::index nNewIndex)
 
     assert(!IsFrozen());
 
+    CompactItems();
     MoveItemInternal(nIndex, nNewIndex);
 
     if (m_nUpdateCount == 0)
@@ -109,6 +184,7 @@ size_t ModelCollectionBase::ShiftItemsUp(const BoolModelProperty& pProperty)
     size_t nMatches = 0;
 
     BeginUpdate();
+    CompactItems();
 
     gsl::index nInsertAt = -1;
     for (gsl::index nIndex = 0; nIndex < ra::to_signed(m_nSize); ++nIndex)
@@ -142,6 +218,7 @@ size_t ModelCollectionBase::ShiftItemsDown(const BoolModelProperty& pProperty)
     size_t nMatches = 0;
 
     BeginUpdate();
+    CompactItems();
 
     gsl::index nInsertAt = -1;
     for (gsl::index nIndex = ra::to_signed(m_nSize) - 1; nIndex >= 0; --nIndex)
@@ -173,6 +250,7 @@ size_t ModelCollectionBase::ShiftItemsDown(const BoolModelProperty& pProperty)
 void ModelCollectionBase::Reverse()
 {
     BeginUpdate();
+    CompactItems();
 
     gsl::index nIndexFront = 0;
     gsl::index nIndexBack = m_nSize - 1;
@@ -192,7 +270,10 @@ void ModelCollectionBase::StartWatching() noexcept
 {
     gsl::index nIndex = 0;
     for (auto& pItem : m_vItems)
-        StartWatching(*pItem, nIndex++);
+    {
+        if (pItem != nullptr)
+            StartWatching(*pItem, nIndex++);
+    }
 }
 
 void ModelCollectionBase::StartWatching(ModelBase& pModel, gsl::index nIndex) noexcept
@@ -204,7 +285,10 @@ void ModelCollectionBase::StartWatching(ModelBase& pModel, gsl::index nIndex) no
 void ModelCollectionBase::StopWatching() noexcept
 {
     for (auto& pItem : m_vItems)
-        StopWatching(*pItem);
+    {
+        if (pItem != nullptr)
+            StopWatching(*pItem);
+    }
 }
 
 void ModelCollectionBase::StopWatching(ModelBase& pModel) noexcept
@@ -240,44 +324,61 @@ void ModelCollectionBase::UpdateIndices()
     const bool bWatching = IsWatching();
 
     // first pass, deal with removed items
-    if (m_vItems.size() > m_nSize)
+    if (!m_vRemovedItems.empty())
     {
-        // identify the deleted items
+        CompactItems();
+
+        // identify the deleted items. items that were added and removed while updates were suspended
+        // were never reported, so they don't need to be reported as removed either.
         std::vector<gsl::index> vDeletedIndices;
-        const auto nDeletedIndices = m_vItems.size() - m_nSize;
-        vDeletedIndices.reserve(nDeletedIndices);
+        vDeletedIndices.reserve(m_vRemovedItems.size());
 
-        for (gsl::index nIndex = m_vItems.size() - 1; nIndex >= gsl::narrow_cast<gsl::index>(m_nSize); --nIndex)
+        for (auto& pModel : m_vRemovedItems)
         {
-            auto& pModel = *m_vItems.at(nIndex);
-            OnBeforeItemRemoved(pModel);
-            vDeletedIndices.push_back(pModel.m_nCollectionIndex);
-        }
+            OnBeforeItemRemoved(*pModel);
 
-        // use a reversed list so later indices are removed first when the callbacks are called
-        std::sort(vDeletedIndices.rbegin(), vDeletedIndices.rend());
+            if (pModel->m_nCollectionIndex >= 0)
+                vDeletedIndices.push_back(pModel->m_nCollectionIndex);
+        }
 
         // remove the deleted items from the collection
-        m_vItems.erase(m_vItems.begin() + m_nSize, m_vItems.end());
+        m_vRemovedItems.clear();
 
-        // update the indices of any items after the deleted items so they don't also raise 'changed' events
-        for (auto& pItem : m_vItems)
+        if (!vDeletedIndices.empty())
         {
-            gsl::index nIndex = pItem->m_nCollectionIndex;
-            if (nIndex > vDeletedIndices.back())
+            std::sort(vDeletedIndices.begin(), vDeletedIndices.end());
+
+            // update the indices of any items after the deleted items so they don't also raise 'changed' events.
+            // walk the old indices once, counting the deleted items before each one.
+            const auto nLastDeletedIndex = vDeletedIndices.back();
+            std::vector<gsl::index> vShift(gsl::narrow_cast<size_t>(nLastDeletedIndex) + 1);
+            auto pDeletedIndex = vDeletedIndices.begin();
+            gsl::index nShift = 0;
+            for (gsl::index nIndex = 0; nIndex <= nLastDeletedIndex; ++nIndex)
             {
-                for (auto nDeletedIndex : vDeletedIndices)
+                while (pDeletedIndex != vDeletedIndices.end() && *pDeletedIndex < nIndex)
                 {
-                    if (nDeletedIndex < nIndex)
-                        --nIndex;
+                    ++pDeletedIndex;
+                    ++nShift;
                 }
 
-                pItem->m_nCollectionIndex = nIndex;
+                vShift.at(nIndex) = nShift;
             }
-        }
 
-        if (!vDeletedIndices.empty())
+            const auto nTotalShift = gsl::narrow_cast<gsl::index>(vDeletedIndices.size());
+            for (auto& pItem : m_vItems)
+            {
+                const gsl::index nIndex = pItem->m_nCollectionIndex;
+                if (nIndex > nLastDeletedIndex)
+                    pItem->m_nCollectionIndex = nIndex - nTotalShift;
+                else if (nIndex > 0)
+                    pItem->m_nCollectionIndex = nIndex - vShift.at(nIndex);
+            }
+
+            // use a reversed list so later indices are removed first when the callbacks are called
+            std::reverse(vDeletedIndices.begin(), vDeletedIndices.end());
             OnItemsRemoved(vDeletedIndices);
+        }
     }
 
     // second pass, deal with new items
@@ -334,7 +435,8 @@ void ModelCollectionBase::NotifyModelValueChanged(gsl::index nIndex, const BoolM
     if (nIndex < 0)
         return;
 
-    const auto nCollectionIndex = m_vItems.at(gsl::narrow_cast<size_t>(nIndex))->m_nCollectionIndex;
+    const auto* pModel = GetModelAt(nIndex);
+    const auto nCollectionIndex = (pModel != nullptr) ? pModel->m_nCollectionIndex : -1;
     if (IsUpdating())
     {
         // if updates are suspended, only raise events for items that haven't moved. OnItemsChanged events
@@ -357,7 +459,8 @@ void ModelCollectionBase::NotifyModelValueChanged(gsl::index nIndex, const Strin
     if (nIndex < 0)
         return;
 
-    const auto nCollectionIndex = m_vItems.at(gsl::narrow_cast<size_t>(nIndex))->m_nCollectionIndex;
+    const auto* pModel = GetModelAt(nIndex);
+    const auto nCollectionIndex = (pModel != nullptr) ? pModel->m_nCollectionIndex : -1;
     if (IsUpdating())
     {
         // if updates are suspended, only raise events for items that haven't moved. OnItemsChanged events
@@ -380,7 +483,8 @@ void ModelCollectionBase::NotifyModelValueChanged(gsl::index nIndex, const IntMo
     if (nIndex < 0)
         return;
 
-    const auto nCollectionIndex = m_vItems.at(gsl::narrow_cast<size_t>(nIndex))->m_nCollectionIndex;
+    const auto* pModel = GetModelAt(nIndex);
+    const auto nCollectionIndex = (pModel != nullptr) ? pModel->m_nCollectionIndex : -1;
     if (IsUpdating())
     {
         // if updates are suspended, only raise events for items that haven't moved. OnItemsChanged events
@@ -59,6 +59,13 @@ public:
     /// </summary>
     void RemoveAt(gsl::index nIndex);
 
+    /// <summary>
+    /// Removes all items matching the provided predicate.
+    /// </summary>
+    /// <param name="fPredicate">Returns <c>true</c> if the item should be removed. Must not modify the collection.</param>
+    /// <returns>The number of items that were removed.</returns>
+    size_t RemoveIf(const std::function<bool(const ModelBase&)>& fPredicate);
+
     /// <summary>
     /// Removes all items from the collection.
     /// </summary>
@@ -171,10 +178,16 @@ public:
     /// <returns>Index of the first matching item, <c>-1</c> if not found.</returns>
     gsl::index FindItemIndex(const IntModelProperty& pProperty, int nValue) const
     {
-        for (gsl::index nIndex = 0; nIndex < gsl::narrow<gsl::index>(m_nSize); ++nIndex)
+        gsl::index nIndex = 0;
+        for (const auto& pItem : m_vItems)
         {
-            if (m_vItems.at(nIndex)->GetValue(pProperty) == nValue)
+            if (pItem == nullptr) // removed while updates are suspended
+                continue;
+
+            if (pItem->GetValue(pProperty) == nValue)
                 return nIndex;
+
+            ++nIndex;
         }
 
         return -1;
@@ -188,10 +201,16 @@ public:
     /// <returns>Index of the first matching item, <c>-1</c> if not found.</returns>
     gsl::index FindItemIndex(const StringModelProperty& pProperty, const std::wstring& sValue) const
     {
-        for (gsl::index nIndex = 0; nIndex < gsl::narrow<gsl::index>(m_nSize); ++nIndex)
+        gsl::index nIndex = 0;
+        for (const auto& pItem : m_vItems)
         {
-            if (m_vItems.at(nIndex)->GetValue(pProperty) == sValue)
+            if (pItem == nullptr) // removed while updates are suspended
+                continue;
+
+            if (pItem->GetValue(pProperty) == sValue)
                 return nIndex;
+
+            ++nIndex;
         }
 
         return -1;
@@ -205,10 +224,16 @@ public:
     /// <returns>Index of the first matching item, <c>-1</c> if not found.</returns>
     gsl::index FindItemIndex(const BoolModelProperty& pProperty, bool bValue) const
     {
-        for (gsl::index nIndex = 0; nIndex < gsl::narrow<gsl::index>(m_nSize); ++nIndex)
+        gsl::index nIndex = 0;
+        for (const auto& pItem : m_vItems)
         {
-            if (m_vItems.at(nIndex)->GetValue(pProperty) == bValue)
+            if (pItem == nullptr) // removed while updates are suspended
+                continue;
+
+            if (pItem->GetValue(pProperty) == bValue)
                 return nIndex;
+
+            ++nIndex;
         }
 
         return -1;
@@ -251,7 +276,12 @@ protected:
     ModelBase* GetModelAt(gsl::index nIndex)
     {
         if (nIndex >= 0 && ra::to_unsigned(nIndex) < m_nSize)
+        {
+            if (ra::to_unsigned(nIndex) >= m_nFirstRemovedSlot)
+                CompactItems();
+
             return m_vItems.at(nIndex).get();
+        }
 
         return nullptr;
     }
@@ -259,7 +289,12 @@ protected:
     const ModelBase* GetModelAt(gsl::index nIndex) const
     {
         if (nIndex >= 0 && ra::to_unsigned(nIndex) < m_nSize)
-            return m_vItems.at(nIndex).get();
+        {
+            if (ra::to_unsigned(nIndex) < m_nFirstRemovedSlot)
+                return m_vItems.at(nIndex).get();
+
+            return FindModelAfterRemovedSlot(nIndex);
+        }
 
         return nullptr;
     }
@@ -270,6 +305,9 @@ protected:
 
 private:
     void UpdateIndices();
+    void RemoveItemInSlot(size_t nSlot);
+    void CompactItems() noexcept;
+    const ModelBase* FindModelAfterRemovedSlot(gsl::index nIndex) const;
     void StartWatching(ModelBase& pModel, gsl::index nIndex) noexcept;
     void StopWatching(ModelBase& pModel) noexcept;
 
@@ -283,7 +321,12 @@ private:
     unsigned int m_nUpdateCount = 0;
     size_t m_nSize = 0;
 
+    // items removed while updates are suspended leave an empty slot in m_vItems. the remaining items
+    // are shifted into the empty slots in a single pass when the update completes.
     std::vector<std::unique_ptr<ModelBase>> m_vItems;
+    std::vector<std::unique_ptr<ModelBase>> m_vRemovedItems;
+    static constexpr size_t NO_REMOVED_SLOT = std::numeric_limits<size_t>::max();
+    size_t m_nFirstRemovedSlot = NO_REMOVED_SLOT;
 };
 
 } // namespace data
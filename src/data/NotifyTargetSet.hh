@@ -0,0 +1,277 @@
+#ifndef RA_DATA_NOTIFY_TARGET_SET_H
+#define RA_DATA_NOTIFY_TARGET_SET_H
+#pragma once
+
+namespace ra {
+namespace data {
+
+/// <summary>
+/// Collection of pointers to objects that want to be told when something changes.
+/// </summary>
+/// <remarks>
+/// The first <typeparamref name="N" /> targets are stored inline, so most collections never allocate memory.
+/// Targets may be added or removed by a handler while a notification is being dispatched. A removed target
+/// leaves a tombstone behind, so indices remain stable, and will not be notified. An added target will not
+/// be notified until the next dispatch. Tombstones are discarded when the last active dispatch completes.
+/// Notifications may be dispatched from multiple threads. The slots are guarded by a mutex that is never held
+/// while a handler is running, so handlers on different threads may run concurrently.
+/// </remarks>
+template<class TTarget, size_t N = 4, class TAllocator = std::allocator<TTarget*>>
+class NotifyTargetSet
+{
+public:
+    GSL_SUPPRESS_F6 NotifyTargetSet() = default;
+
+    ~NotifyTargetSet() noexcept
+    {
+        // a handler destroyed the object that owns this collection. tell any outstanding dispatches to stop.
+        std::lock_guard<std::mutex> pGuard(m_oMutex);
+        for (auto* pDispatch = m_pDispatch; pDispatch != nullptr; pDispatch = pDispatch->pNext)
+            pDispatch->bDestroyed = true;
+    }
+
+    NotifyTargetSet(const NotifyTargetSet&) noexcept = delete;
+    NotifyTargetSet& operator=(const NotifyTargetSet&) noexcept = delete;
+
+    GSL_SUPPRESS_F6 NotifyTargetSet(NotifyTargetSet&& other) noexcept
+    {
+        std::lock_guard<std::mutex> pGuard(other.m_oMutex);
+        m_vInline = other.m_vInline;
+        m_vHeap = std::move(other.m_vHeap);
+        m_nSlots = other.m_nSlots;
+        m_nCount = other.m_nCount;
+        m_bOnHeap = other.m_bOnHeap;
+        other.Reset();
+        Compact();
+    }
+
+    GSL_SUPPRESS_F6 NotifyTargetSet& operator=(NotifyTargetSet&& other) noexcept
+    {
+        if (&other != this)
+        {
+            std::scoped_lock<std::mutex, std::mutex> pGuard(m_oMutex, other.m_oMutex);
+            m_vInline = other.m_vInline;
+            m_vHeap = std::move(other.m_vHeap);
+            m_nSlots = other.m_nSlots;
+            m_nCount = other.m_nCount;
+            m_bOnHeap = other.m_bOnHeap;
+            other.Reset();
+            Compact();
+        }
+
+        return *this;
+    }
+
+    /// <summary>
+    /// Determines whether there are any targets in the collection.
+    /// </summary>
+    GSL_SUPPRESS_F6 bool IsEmpty() const noexcept
+    {
+        std::lock_guard<std::mutex> pGuard(m_oMutex);
+        return m_nCount == 0;
+    }
+
+    /// <summary>
+    /// Gets the number of targets in the collection.
+    /// </summary>
+    GSL_SUPPRESS_F6 size_t Count() const noexcept
+    {
+        std::lock_guard<std::mutex> pGuard(m_oMutex);
+        return m_nCount;
+    }
+
+    /// <summary>
+    /// Adds a target to the collection. Does nothing if the target is already in the collection.
+    /// </summary>
+    void Add(TTarget& pTarget)
+    {
+        std::lock_guard<std::mutex> pGuard(m_oMutex);
+        TTarget** pSlots = Slots();
+        for (size_t i = 0; i < m_nSlots; ++i)
+        {
+            if (pSlots[i] == &pTarget)
+                return;
+        }
+
+        if (m_bOnHeap)
+        {
+            m_vHeap.push_back(&pTarget);
+        }
+        else if (m_nSlots < N)
+        {
+            gsl::at(m_vInline, m_nSlots) = &pTarget;
+        }
+        else
+        {
+            m_vHeap.reserve(N * 2);
+            m_vHeap.assign(m_vInline.begin(), m_vInline.end());
+            m_vHeap.push_back(&pTarget);
+            m_bOnHeap = true;
+        }
+
+        ++m_nSlots;
+        ++m_nCount;
+    }
+
+    /// <summary>
+    /// Removes a target from the collection. Does nothing if the target is not in the collection.
+    /// </summary>
+    GSL_SUPPRESS_F6 void Remove(TTarget& pTarget) noexcept
+    {
+        std::lock_guard<std::mutex> pGuard(m_oMutex);
+        TTarget** pSlots = Slots();
+        for (size_t i = 0; i < m_nSlots; ++i)
+        {
+            if (pSlots[i] == &pTarget)
+            {
+                pSlots[i] = nullptr;
+                --m_nCount;
+
+                if (m_pDispatch == nullptr)
+                    Compact();
+
+                return;
+            }
+        }
+    }
+
+    /// <summary>
+    /// Removes all targets from the collection.
+    /// </summary>
+    GSL_SUPPRESS_F6 void Clear() noexcept
+    {
+        std::lock_guard<std::mutex> pGuard(m_oMutex);
+        if (m_pDispatch != nullptr)
+        {
+            TTarget** pSlots = Slots();
+            for (size_t i = 0; i < m_nSlots; ++i)
+                pSlots[i] = nullptr;
+
+            m_nCount = 0;
+        }
+        else
+        {
+            m_vHeap.clear();
+            m_nSlots = m_nCount = 0;
+            m_bOnHeap = false;
+        }
+    }
+
+    /// <summary>
+    /// Calls <paramref name="fHandler" /> for each target in the collection.
+    /// </summary>
+    /// <remarks>
+    /// It is safe for the handler to add or remove targets, to dispatch another notification, or to destroy
+    /// the object that owns the collection. Other threads may add or remove targets, or dispatch their own
+    /// notifications, but must not destroy the collection while it is being dispatched.
+    /// </remarks>
+    template<typename THandler>
+    void Dispatch(const THandler& fHandler)
+    {
+        Frame pFrame(*this);
+
+        for (size_t i = 0; i < pFrame.nSlots; ++i)
+        {
+            TTarget* pTarget = nullptr;
+            {
+                std::lock_guard<std::mutex> pGuard(m_oMutex);
+                if (i >= m_nSlots)
+                    break;
+
+                pTarget = Slots()[i];
+            }
+
+            if (pTarget == nullptr)
+                continue;
+
+            fHandler(*pTarget);
+
+            if (pFrame.bDestroyed)
+                return;
+        }
+    }
+
+private:
+    // active dispatches are kept in a doubly linked list rather than a stack so dispatches on different threads
+    // can complete in any order
+    struct Frame
+    {
+        GSL_SUPPRESS_F6 explicit Frame(NotifyTargetSet& pSet) noexcept
+            : pOwner(pSet)
+        {
+            std::lock_guard<std::mutex> pGuard(pSet.m_oMutex);
+            pNext = pSet.m_pDispatch;
+            if (pNext != nullptr)
+                pNext->pPrevious = this;
+
+            pSet.m_pDispatch = this;
+            nSlots = pSet.m_nSlots;
+        }
+
+        GSL_SUPPRESS_F6 ~Frame() noexcept
+        {
+            if (!bDestroyed)
+            {
+                std::lock_guard<std::mutex> pGuard(pOwner.m_oMutex);
+                if (pPrevious != nullptr)
+                    pPrevious->pNext = pNext;
+                else
+                    pOwner.m_pDispatch = pNext;
+
+                if (pNext != nullptr)
+                    pNext->pPrevious = pPrevious;
+
+                if (pOwner.m_pDispatch == nullptr && pOwner.m_nCount != pOwner.m_nSlots)
+                    pOwner.Compact();
+            }
+        }
+
+        Frame(const Frame&) noexcept = delete;
+        Frame& operator=(const Frame&) noexcept = delete;
+        Frame(Frame&&) noexcept = delete;
+        Frame& operator=(Frame&&) noexcept = delete;
+
+        NotifyTargetSet& pOwner;
+        Frame* pPrevious = nullptr;
+        Frame* pNext = nullptr;
+        size_t nSlots = 0; // slots that existed when the dispatch started
+        bool bDestroyed = false;
+    };
+
+    TTarget** Slots() noexcept { return m_bOnHeap ? m_vHeap.data() : m_vInline.data(); }
+
+    void Compact() noexcept
+    {
+        TTarget** pSlots = Slots();
+        size_t nWrite = 0;
+        for (size_t i = 0; i < m_nSlots; ++i)
+        {
+            if (pSlots[i] != nullptr)
+                pSlots[nWrite++] = pSlots[i];
+        }
+
+        m_nSlots = nWrite;
+        if (m_bOnHeap)
+            m_vHeap.resize(nWrite);
+    }
+
+    void Reset() noexcept
+    {
+        m_vHeap.clear();
+        m_nSlots = m_nCount = 0;
+        m_bOnHeap = false;
+    }
+
+    std::array<TTarget*, N> m_vInline{};
+    std::vector<TTarget*, TAllocator> m_vHeap;
+    size_t m_nSlots = 0; // including tombstones
+    size_t m_nCount = 0; // excluding tombstones
+    bool m_bOnHeap = false;
+    Frame* m_pDispatch = nullptr; // guarded by m_oMutex
+    mutable std::mutex m_oMutex;
+};
+
+} // namespace data
+} // namespace ra
+
+#endif // !RA_DATA_NOTIFY_TARGET_SET_H
@@ -0,0 +1,92 @@
+#ifndef RA_DATA_PROPERTY_KEY_MAP_H
+#define RA_DATA_PROPERTY_KEY_MAP_H
+#pragma once
+
+namespace ra {
+namespace data {
+
+/// <summary>
+/// Map of <see cref="ModelPropertyBase::GetKey" /> to a value, stored as a vector sorted by key.
+/// </summary>
+/// <remarks>
+/// Models rarely track more than a handful of properties at once, so a binary search over contiguous memory
+/// is cheaper than walking a tree, and clearing the map keeps the memory around for the next use.
+/// Mirrors the subset of <c>std::map</c> used by the transactions. Unlike <c>std::map</c>, adding or removing
+/// an entry invalidates all iterators and pointers into the map.
+/// </remarks>
+template<class T>
+class PropertyKeyMap
+{
+public:
+    using value_type = std::pair<int, T>;
+    using iterator = typename std::vector<value_type>::iterator;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
+    bool empty() const noexcept { return m_vEntries.empty(); }
+    size_t size() const noexcept { return m_vEntries.size(); }
+
+    iterator begin() noexcept { return m_vEntries.begin(); }
+    iterator end() noexcept { return m_vEntries.end(); }
+    const_iterator begin() const noexcept { return m_vEntries.begin(); }
+    const_iterator end() const noexcept { return m_vEntries.end(); }
+
+    /// <summary>
+    /// Finds the entry for a key.
+    /// </summary>
+    /// <returns>Iterator to the entry, <c>end()</c> if not found.</returns>
+    iterator find(int nKey) noexcept
+    {
+        auto pIter = LowerBound(nKey);
+        return (pIter != m_vEntries.end() && pIter->first == nKey) ? pIter : m_vEntries.end();
+    }
+
+    /// <summary>
+    /// Finds the entry for a key.
+    /// </summary>
+    /// <returns>Iterator to the entry, <c>end()</c> if not found.</returns>
+    const_iterator find(int nKey) const noexcept
+    {
+        auto pIter = std::lower_bound(m_vEntries.begin(), m_vEntries.end(), nKey,
+            [](const value_type& pEntry, int nSearchKey) noexcept { return pEntry.first < nSearchKey; });
+        return (pIter != m_vEntries.end() && pIter->first == nKey) ? pIter : m_vEntries.end();
+    }
+
+    /// <summary>
+    /// Sets the value for a key, adding an entry if one doesn't already exist.
+    /// </summary>
+    void insert_or_assign(int nKey, const T& tValue)
+    {
+        auto pIter = LowerBound(nKey);
+        if (pIter != m_vEntries.end() && pIter->first == nKey)
+            pIter->second = tValue;
+        else
+            m_vEntries.emplace(pIter, nKey, tValue);
+    }
+
+    /// <summary>
+    /// Removes an entry.
+    /// </summary>
+    /// <returns>Iterator to the entry after the removed entry.</returns>
+    iterator erase(const_iterator pIter) { return m_vEntries.erase(pIter); }
+
+    /// <summary>
+    /// Removes all entries.
+    /// </summary>
+    void clear() noexcept { m_vEntries.clear(); }
+
+    void swap(PropertyKeyMap& other) noexcept { m_vEntries.swap(other.m_vEntries); }
+
+private:
+    iterator LowerBound(int nKey) noexcept
+    {
+        return std::lower_bound(m_vEntries.begin(), m_vEntries.end(), nKey,
+            [](const value_type& pEntry, int nSearchKey) noexcept { return pEntry.first < nSearchKey; });
+    }
+
+    std::vector<value_type> m_vEntries;
+};
+
+} // namespace data
+} // namespace ra
+
+#endif // !RA_DATA_PROPERTY_KEY_MAP_H
@@ -0,0 +1,133 @@
+#include "TrigramIndex.hh"
+
+#include "RA_StringUtils.h"
+
+namespace ra {
+namespace data {
+
+static constexpr uint64_t MakeTrigram(wchar_t c1, wchar_t c2, wchar_t c3) noexcept
+{
+    // 21 bits is enough for any unicode code point
+    return (gsl::narrow_cast<uint64_t>(gsl::narrow_cast<uint32_t>(c1) & 0x1FFFFF) << 42) |
+           (gsl::narrow_cast<uint64_t>(gsl::narrow_cast<uint32_t>(c2) & 0x1FFFFF) << 21) |
+           (gsl::narrow_cast<uint64_t>(gsl::narrow_cast<uint32_t>(c3) & 0x1FFFFF));
+}
+
+void TrigramIndex::GetTrigrams(const std::wstring& sLowerText, std::vector<uint64_t>& vTrigrams)
+{
+    vTrigrams.clear();
+    if (sLowerText.length() < 3)
+        return;
+
+    vTrigrams.reserve(sLowerText.length() - 2);
+    for (size_t i = 2; i < sLowerText.length(); ++i)
+        vTrigrams.push_back(MakeTrigram(sLowerText.at(i - 2), sLowerText.at(i - 1), sLowerText.at(i)));
+
+    std::sort(vTrigrams.begin(), vTrigrams.end());
+    vTrigrams.erase(std::unique(vTrigrams.begin(), vTrigrams.end()), vTrigrams.end());
+}
+
+void TrigramIndex::Clear() noexcept
+{
+    m_mText.clear();
+    m_mPostings.clear();
+}
+
+void TrigramIndex::Set(ra::ByteAddress nAddress, const std::wstring& sText)
+{
+    std::wstring sLowerText = sText;
+    ra::StringMakeLowercase(sLowerText);
+
+    auto pIter = m_mText.find(nAddress);
+    if (pIter != m_mText.end())
+    {
+        if (pIter->second == sLowerText)
+            return;
+
+        Remove(nAddress);
+    }
+
+    std::vector<uint64_t> vTrigrams;
+    GetTrigrams(sLowerText, vTrigrams);
+    for (const auto nTrigram : vTrigrams)
+    {
+        // when the index is built in address order, this is always an append
+        auto& vAddresses = m_mPostings[nTrigram];
+        if (vAddresses.empty() || vAddresses.back() < nAddress)
+            vAddresses.push_back(nAddress);
+        else
+            vAddresses.insert(std::lower_bound(vAddresses.begin(), vAddresses.end(), nAddress), nAddress);
+    }
+
+    m_mText.insert_or_assign(nAddress, std::move(sLowerText));
+}
+
+void TrigramIndex::Remove(ra::ByteAddress nAddress)
+{
+    const auto pIter = m_mText.find(nAddress);
+    if (pIter == m_mText.end())
+        return;
+
+    std::vector<uint64_t> vTrigrams;
+    GetTrigrams(pIter->second, vTrigrams);
+    for (const auto nTrigram : vTrigrams)
+    {
+        auto pPostings = m_mPostings.find(nTrigram);
+        if (pPostings == m_mPostings.end())
+            continue;
+
+        auto& vAddresses = pPostings->second;
+        const auto pAddress = std::lower_bound(vAddresses.begin(), vAddresses.end(), nAddress);
+        if (pAddress != vAddresses.end() && *pAddress == nAddress)
+            vAddresses.erase(pAddress);
+
+        if (vAddresses.empty())
+            m_mPostings.erase(pPostings);
+    }
+
+    m_mText.erase(pIter);
+}
+
+bool TrigramIndex::FindCandidates(const std::wstring& sLowerQuery, std::vector<ra::ByteAddress>& vCandidates) const
+{
+    vCandidates.clear();
+
+    std::vector<uint64_t> vTrigrams;
+    GetTrigrams(sLowerQuery, vTrigrams);
+    if (vTrigrams.empty())
+        return false;
+
+    std::vector<const std::vector<ra::ByteAddress>*> vPostings;
+    vPostings.reserve(vTrigrams.size());
+    for (const auto nTrigram : vTrigrams)
+    {
+        const auto pPostings = m_mPostings.find(nTrigram);
+        if (pPostings == m_mPostings.end())
+            return true; // no string contains this sequence
+
+        vPostings.push_back(&pPostings->second);
+    }
+
+    // start with the shortest list so every intersection is as small as possible
+    std::sort(vPostings.begin(), vPostings.end(),
+        [](const std::vector<ra::ByteAddress>* pLeft, const std::vector<ra::ByteAddress>* pRight) noexcept {
+            return pLeft->size() < pRight->size();
+        });
+
+    vCandidates = *vPostings.front();
+
+    std::vector<ra::ByteAddress> vIntersection;
+    for (size_t i = 1; i < vPostings.size() && !vCandidates.empty(); ++i)
+    {
+        const auto* pPostings = vPostings.at(i);
+        vIntersection.clear();
+        std::set_intersection(vCandidates.begin(), vCandidates.end(), pPostings->begin(), pPostings->end(),
+                              std::back_inserter(vIntersection));
+        vCandidates.swap(vIntersection);
+    }
+
+    return true;
+}
+
+} // namespace data
+} // namespace ra
@@ -0,0 +1,63 @@
+#ifndef RA_DATA_TRIGRAM_INDEX_H
+#define RA_DATA_TRIGRAM_INDEX_H
+#pragma once
+
+#include "data\Types.hh"
+
+namespace ra {
+namespace data {
+
+/// <summary>
+/// Case-insensitive substring index over a set of strings keyed by address.
+/// </summary>
+/// <remarks>
+/// Every three character sequence in each string is mapped to the sorted list of addresses whose
+/// string contains it. A query can then be narrowed to the addresses containing all of its
+/// sequences without scanning every string. Candidates still need to be verified against the
+/// full string as the sequences may not be adjacent.
+/// </remarks>
+class TrigramIndex
+{
+public:
+    /// <summary>
+    /// Gets the number of strings in the index.
+    /// </summary>
+    size_t Count() const noexcept { return m_mText.size(); }
+
+    /// <summary>
+    /// Removes all strings from the index.
+    /// </summary>
+    void Clear() noexcept;
+
+    /// <summary>
+    /// Adds or updates the string associated to an address.
+    /// </summary>
+    void Set(ra::ByteAddress nAddress, const std::wstring& sText);
+
+    /// <summary>
+    /// Removes the string associated to an address.
+    /// </summary>
+    void Remove(ra::ByteAddress nAddress);
+
+    /// <summary>
+    /// Finds the addresses whose strings may contain <paramref name="sLowerQuery" />.
+    /// </summary>
+    /// <param name="sLowerQuery">The lowercased text to find.</param>
+    /// <param name="vCandidates">Populated with the matching addresses, in ascending order.</param>
+    /// <returns>
+    /// <c>false</c> if the query is too short to be looked up in the index, in which case every string
+    /// must be checked.
+    /// </returns>
+    bool FindCandidates(const std::wstring& sLowerQuery, std::vector<ra::ByteAddress>& vCandidates) const;
+
+private:
+    static void GetTrigrams(const std::wstring& sLowerText, std::vector<uint64_t>& vTrigrams);
+
+    std::unordered_map<ra::ByteAddress, std::wstring> m_mText;
+    std::unordered_map<uint64_t, std::vector<ra::ByteAddress>> m_mPostings;
+};
+
+} // namespace data
+} // namespace ra
+
+#endif RA_DATA_TRIGRAM_INDEX_H
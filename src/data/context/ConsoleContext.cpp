@@ -59,6 +59,153 @@ ConsoleContext::ConsoleContext(ConsoleID nId) noexcept
             m_nMaxAddress = std::max(m_nMaxAddress, pRegion.end_address);
         }
     }
+
+    UpdateAddressTranslation();
+}
+
+void ConsoleContext::UpdateAddressTranslation()
+{
+    std::vector<AddressTranslationTable::Range> vByteToReal;
+    std::vector<AddressTranslationTable::Range> vRealToByte;
+    vByteToReal.reserve(m_vRegions.size());
+    vRealToByte.reserve(m_vRegions.size());
+
+    for (const auto& pRegion : m_vRegions)
+    {
+        if (pRegion.StartAddress <= pRegion.EndAddress)
+            vByteToReal.push_back({ pRegion.StartAddress, pRegion.EndAddress, pRegion.RealAddress });
+
+        // a real address is in the region if RealAddress < nRealAddress < RealAddress + (EndAddress - StartAddress).
+        // the arithmetic is 32-bit, so a region that wraps past the end of the address space doesn't match anything.
+        const ra::ByteAddress nRegionSize = pRegion.EndAddress - pRegion.StartAddress;
+        const ra::ByteAddress nRealEnd = pRegion.RealAddress + nRegionSize;
+        if (pRegion.RealAddress != 0xFFFFFFFF && nRealEnd > pRegion.RealAddress + 1)
+        {
+            vRealToByte.push_back({ pRegion.RealAddress + 1, nRealEnd - 1,
+                                    pRegion.StartAddress - pRegion.RealAddress });
+        }
+    }
+
+    m_pByteToReal.Build(vByteToReal);
+    m_pRealToByte.Build(vRealToByte);
+}
+
+void ConsoleContext::AddressTranslationTable::Build(const std::vector<Range>& vRanges)
+{
+    m_vRanges.clear();
+    m_vPages.clear();
+    m_nPageBase = 0;
+    m_nPageShift = 0;
+
+    // split the address space at every range boundary. each piece is then either entirely inside or
+    // entirely outside of each range, and is translated by the first range that contains it.
+    std::vector<uint64_t> vBoundaries;
+    vBoundaries.reserve(vRanges.size() * 2);
+    for (const auto& pRange : vRanges)
+    {
+        vBoundaries.push_back(pRange.nFirst);
+        vBoundaries.push_back(uint64_t{ pRange.nLast } + 1);
+    }
+
+    std::sort(vBoundaries.begin(), vBoundaries.end());
+    vBoundaries.erase(std::unique(vBoundaries.begin(), vBoundaries.end()), vBoundaries.end());
+
+    for (size_t i = 1; i < vBoundaries.size(); ++i)
+    {
+        const auto nFirst = gsl::narrow_cast<ra::ByteAddress>(vBoundaries.at(i - 1));
+        const auto nLast = gsl::narrow_cast<ra::ByteAddress>(vBoundaries.at(i) - 1);
+
+        for (const auto& pRange : vRanges)
+        {
+            if (pRange.nFirst <= nFirst && nFirst <= pRange.nLast)
+            {
+                // merge with the previous piece if it's adjacent and translated the same way
+                if (!m_vRanges.empty() && m_vRanges.back().nOffset == pRange.nOffset &&
+                    uint64_t{ m_vRanges.back().nLast } + 1 == nFirst)
+                {
+                    m_vRanges.back().nLast = nLast;
+                }
+                else
+                {
+                    m_vRanges.push_back({ nFirst, nLast, pRange.nOffset });
+                }
+
+                break;
+            }
+        }
+    }
+
+    if (m_vRanges.empty() || m_vRanges.size() >= MixedPage)
+        return;
+
+    // use the smallest pages that keep the table within MaxPages. if the pages would have to be too big,
+    // most of them would straddle a boundary, so just use the binary search.
+    const auto nBase = m_vRanges.front().nFirst;
+    const uint64_t nSpan = uint64_t{ m_vRanges.back().nLast } - nBase;
+    unsigned nShift = MinPageShift;
+    while ((nSpan >> nShift) >= MaxPages)
+        ++nShift;
+
+    if (nShift > MaxPageShift)
+        return;
+
+    m_nPageBase = nBase;
+    m_nPageShift = nShift;
+    m_vPages.assign(gsl::narrow_cast<size_t>(nSpan >> nShift) + 1, UnmappedPage);
+
+    const uint64_t nPageSize = uint64_t{ 1 } << nShift;
+    for (size_t nIndex = 0; nIndex < m_vRanges.size(); ++nIndex)
+    {
+        const auto& pRange = m_vRanges.at(nIndex);
+        const uint64_t nFirst = pRange.nFirst - nBase;
+        const uint64_t nLast = pRange.nLast - nBase;
+
+        for (auto nPage = nFirst >> nShift; nPage <= (nLast >> nShift); ++nPage)
+        {
+            const auto nPageFirst = nPage << nShift;
+            const auto nPageLast = nPageFirst + nPageSize - 1;
+
+            // a page only partially covered by this range is also partially covered by another range or a gap
+            auto& nEntry = m_vPages.at(gsl::narrow_cast<size_t>(nPage));
+            if (nPageFirst >= nFirst && nPageLast <= nLast)
+                nEntry = gsl::narrow_cast<uint16_t>(nIndex);
+            else
+                nEntry = MixedPage;
+        }
+    }
+}
+
+GSL_SUPPRESS_BOUNDS4
+bool ConsoleContext::AddressTranslationTable::Translate(ra::ByteAddress nAddress, ra::ByteAddress& nTranslated) const noexcept
+{
+    if (!m_vPages.empty())
+    {
+        // every range is covered by the page table, so anything outside of it is not mapped
+        if (nAddress < m_nPageBase)
+            return false;
+
+        const auto nPage = gsl::narrow_cast<size_t>(nAddress - m_nPageBase) >> m_nPageShift;
+        if (nPage >= m_vPages.size())
+            return false;
+
+        const auto nEntry = m_vPages[nPage];
+        if (nEntry == UnmappedPage)
+            return false;
+
+        if (nEntry != MixedPage)
+        {
+            nTranslated = nAddress + m_vRanges[nEntry].nOffset;
+            return true;
+        }
+    }
+
+    const auto pIter = std::lower_bound(m_vRanges.begin(), m_vRanges.end(), nAddress,
+        [](const Range& pRange, ra::ByteAddress nSearchAddress) noexcept { return pRange.nLast < nSearchAddress; });
+    if (pIter == m_vRanges.end() || pIter->nFirst > nAddress)
+        return false;
+
+    nTranslated = nAddress + pIter->nOffset;
+    return true;
 }
 
 const ConsoleContext::MemoryRegion* ConsoleContext::GetMemoryRegion(ra::ByteAddress nAddress) const
@@ -83,15 +230,9 @@ const ConsoleContext::MemoryRegion* ConsoleContext::GetMemoryRegion(ra::ByteAddr
 
 ra::ByteAddress ConsoleContext::ByteAddressFromRealAddress(ra::ByteAddress nRealAddress) const noexcept
 {
-    for (const auto& pRegion : m_vRegions)
-    {
-        if (pRegion.RealAddress < nRealAddress)
-        {
-            const auto nRegionSize = pRegion.EndAddress - pRegion.StartAddress;
-            if (nRealAddress < pRegion.RealAddress + nRegionSize)
-                return (nRealAddress - pRegion.RealAddress) + pRegion.StartAddress;
-        }
-    }
+    ra::ByteAddress nByteAddress = 0;
+    if (m_pRealToByte.Translate(nRealAddress, nByteAddress))
+        return nByteAddress;
 
     // additional mirror/shadow ram mappings not directly exposed by rc_console_memory_regions
     switch (m_nId)
@@ -149,11 +290,9 @@ ra::ByteAddress ConsoleContext::ByteAddressFromRealAddress(ra::ByteAddress nReal
 
 ra::ByteAddress ConsoleContext::RealAddressFromByteAddress(ra::ByteAddress nByteAddress) const noexcept
 {
-    for (const auto& pRegion : m_vRegions)
-    {
-        if (pRegion.EndAddress >= nByteAddress && pRegion.StartAddress <= nByteAddress)
-            return nByteAddress + pRegion.RealAddress;
-    }
+    ra::ByteAddress nRealAddress = 0;
+    if (m_pByteToReal.Translate(nByteAddress, nRealAddress))
+        return nRealAddress;
 
     return 0xFFFFFFFF;
 }
@@ -123,11 +123,69 @@ public:
     ra::ByteAddress MaxAddress() const noexcept { return m_nMaxAddress; }
 
 protected:
+    /// <summary>
+    /// Rebuilds the lookup tables used to convert between real and "RetroAchievements" addresses.
+    /// </summary>
+    /// <remarks>
+    /// Must be called whenever <see cref="m_vRegions" /> is modified.
+    /// </remarks>
+    void UpdateAddressTranslation();
+
     ConsoleID m_nId{};
     std::wstring m_sName;
 
     std::vector<MemoryRegion> m_vRegions;
     ra::ByteAddress m_nMaxAddress = 0;
+
+private:
+    /// <summary>
+    /// Maps ranges of addresses onto another address space.
+    /// </summary>
+    /// <remarks>
+    /// The ranges are stored as a sorted array of non-overlapping intervals, which can be binary searched.
+    /// If the intervals span a small enough address space, a page table is also built so most lookups can
+    /// be resolved with a single index. Pages that are not entirely covered by one interval fall back to
+    /// the binary search.
+    /// </remarks>
+    class AddressTranslationTable
+    {
+    public:
+        struct Range
+        {
+            ra::ByteAddress nFirst;
+            ra::ByteAddress nLast;
+            ra::ByteAddress nOffset; // added to an address in the range to translate it
+        };
+
+        /// <summary>
+        /// Builds the table.
+        /// </summary>
+        /// <param name="vRanges">
+        /// Ranges to map, in priority order. Where ranges overlap, the address is translated by the first.
+        /// </param>
+        void Build(const std::vector<Range>& vRanges);
+
+        /// <summary>
+        /// Translates an address.
+        /// </summary>
+        /// <returns><c>true</c> if the address was in a mapped range, <c>false</c> if not.</returns>
+        bool Translate(ra::ByteAddress nAddress, ra::ByteAddress& nTranslated) const noexcept;
+
+    private:
+        static constexpr uint16_t UnmappedPage = 0xFFFF;
+        static constexpr uint16_t MixedPage = 0xFFFE;
+        static constexpr unsigned MinPageShift = 8;
+        static constexpr unsigned MaxPageShift = 12;
+        static constexpr size_t MaxPages = 16384;
+
+        std::vector<Range> m_vRanges;
+        std::vector<uint16_t> m_vPages; // index into m_vRanges, or UnmappedPage/MixedPage
+        ra::ByteAddress m_nPageBase = 0;
+        unsigned m_nPageShift = 0;
+    };
+
+    AddressTranslationTable m_pByteToReal;
+    AddressTranslationTable m_pRealToByte;
 };
 
 } // namespace context
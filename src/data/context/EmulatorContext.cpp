@@ -650,6 +650,7 @@ void EmulatorContext::AddMemoryBlock(gsl::index nIndex, size_t nBytes,
         pBlock.read = pReader;
         pBlock.write = pWriter;
         pBlock.readBlock = nullptr;
+        pBlock.writeBlock = nullptr;
 
         m_nTotalMemorySize += nBytes;
 
@@ -664,6 +665,13 @@ void EmulatorContext::AddMemoryBlockReader(gsl::index nIndex,
         m_vMemoryBlocks.at(nIndex).readBlock = pReader;
 }
 
+void EmulatorContext::AddMemoryBlockWriter(gsl::index nIndex,
+    EmulatorContext::MemoryWriteBlockFunction* pWriter)
+{
+    if (nIndex < gsl::narrow_cast<gsl::index>(m_vMemoryBlocks.size()))
+        m_vMemoryBlocks.at(nIndex).writeBlock = pWriter;
+}
+
 void EmulatorContext::OnTotalMemorySizeChanged()
 {
     if (m_nTotalMemorySize <= 0x10000)
@@ -673,13 +681,7 @@ void EmulatorContext::OnTotalMemorySizeChanged()
     else
         m_fFormatAddress = FormatAddressLarge;
 
-    // create a copy of the list of pointers in case it's modified by one of the callbacks
-    NotifyTargetSet vNotifyTargets(m_vNotifyTargets);
-    for (NotifyTarget* target : vNotifyTargets)
-    {
-        Expects(target != nullptr);
-        target->OnTotalMemorySizeChanged();
-    }
+    m_vNotifyTargets.Dispatch([&](NotifyTarget& pTarget) { pTarget.OnTotalMemorySizeChanged(); });
 }
 
 bool EmulatorContext::HasInvalidRegions() const noexcept
@@ -906,19 +908,16 @@ void EmulatorContext::WriteMemoryByte(ra::ByteAddress nAddress, uint8_t nValue)
     {
         if (nBlockAddress < pBlock.size)
         {
-            if (!pBlock.write)
+            if (pBlock.write)
+                pBlock.write(nBlockAddress, nValue);
+            else if (pBlock.writeBlock)
+                pBlock.writeBlock(nBlockAddress, &nValue, 1);
+            else
                 return;
 
-            pBlock.write(nBlockAddress, nValue);
             m_bMemoryModified = true;
 
-            // create a copy of the list of pointers in case it's modified by one of the callbacks
-            NotifyTargetSet vNotifyTargets(m_vNotifyTargets);
-            for (NotifyTarget* target : vNotifyTargets)
-            {
-                Expects(target != nullptr);
-                target->OnByteWritten(nAddress, nValue);
-            }
+            m_vNotifyTargets.Dispatch([&](NotifyTarget& pTarget) { pTarget.OnByteWritten(nAddress, nValue); });
 
             return;
         }
@@ -927,24 +926,99 @@ void EmulatorContext::WriteMemoryByte(ra::ByteAddress nAddress, uint8_t nValue)
     }
 }
 
+_Use_decl_annotations_
+void EmulatorContext::WriteMemory(ra::ByteAddress nAddress, const uint8_t pBuffer[], size_t nCount) const
+{
+    Expects(pBuffer != nullptr || nCount == 0);
+
+    // bytes that have been written, but not yet reported to the notify targets
+    ra::ByteAddress nPendingAddress = nAddress;
+    const uint8_t* pPending = pBuffer;
+    size_t nPending = 0;
+
+    const auto fFlushPending = [&]() {
+        if (nPending > 0)
+        {
+            m_vNotifyTargets.Dispatch([&](NotifyTarget& pTarget) {
+                pTarget.OnBytesWritten(nPendingAddress, pPending, nPending);
+            });
+            nPending = 0;
+        }
+    };
+
+    auto nBlockAddress = nAddress;
+    for (const auto& pBlock : m_vMemoryBlocks)
+    {
+        if (nCount == 0)
+            break;
+
+        if (nBlockAddress >= pBlock.size)
+        {
+            nBlockAddress -= gsl::narrow_cast<ra::ByteAddress>(pBlock.size);
+            continue;
+        }
+
+        const size_t nToWrite = std::min(nCount, pBlock.size - nBlockAddress);
+        size_t nWritten = 0;
+
+        if (pBlock.writeBlock)
+        {
+            nWritten = pBlock.writeBlock(nBlockAddress, pBuffer, gsl::narrow_cast<uint32_t>(nToWrite));
+            nWritten = std::min(nWritten, nToWrite);
+        }
+        else if (pBlock.write)
+        {
+            auto nWriteAddress = nBlockAddress;
+            for (; nWritten < nToWrite; ++nWritten)
+                pBlock.write(nWriteAddress++, pBuffer[nWritten]);
+        }
+
+        if (nWritten > 0)
+        {
+            m_bMemoryModified = true;
+
+            if (nPending == 0)
+            {
+                nPendingAddress = nAddress;
+                pPending = pBuffer;
+            }
+
+            nPending += nWritten;
+        }
+
+        // if any part of the block couldn't be written, the pending range is no longer contiguous
+        if (nWritten < nToWrite)
+            fFlushPending();
+
+        nAddress += gsl::narrow_cast<ra::ByteAddress>(nToWrite);
+        pBuffer += nToWrite;
+        nCount -= nToWrite;
+        nBlockAddress = 0;
+    }
+
+    fFlushPending();
+}
+
 void EmulatorContext::WriteMemory(ra::ByteAddress nAddress, MemSize nSize, uint32_t nValue) const
 {
+    // multi-byte values are written as a single range so notify targets are only told about them once
+    std::array<uint8_t, 4> pBuffer{};
+
     switch (nSize)
     {
         case MemSize::EightBit:
             WriteMemoryByte(nAddress, nValue & 0xFF);
             return;
         case MemSize::SixteenBit:
-            WriteMemoryByte(nAddress, nValue & 0xFF);
-            nValue >>= 8;
-            WriteMemoryByte(++nAddress, nValue & 0xFF);
+            pBuffer.at(0) = nValue & 0xFF;
+            pBuffer.at(1) = (nValue >> 8) & 0xFF;
+            WriteMemory(nAddress, pBuffer.data(), 2);
             return;
         case MemSize::TwentyFourBit:
-            WriteMemoryByte(nAddress, nValue & 0xFF);
-            nValue >>= 8;
-            WriteMemoryByte(++nAddress, nValue & 0xFF);
-            nValue >>= 8;
-            WriteMemoryByte(++nAddress, nValue & 0xFF);
+            pBuffer.at(0) = nValue & 0xFF;
+            pBuffer.at(1) = (nValue >> 8) & 0xFF;
+            pBuffer.at(2) = (nValue >> 16) & 0xFF;
+            WriteMemory(nAddress, pBuffer.data(), 3);
             return;
         case MemSize::ThirtyTwoBit:
         case MemSize::Float:          // assumes the value has already been encoded into a 32-bit value
@@ -953,28 +1027,29 @@ void EmulatorContext::WriteMemory(ra::ByteAddress nAddress, MemSize nSize, uint3
         case MemSize::Double32BigEndian: // assumes the value has already been encoded into a 32-bit value
         case MemSize::MBF32:          // assumes the value has already been encoded into a 32-bit value
         case MemSize::MBF32LE: // assumes the value has already been encoded into a 32-bit value
-            WriteMemoryByte(nAddress, nValue & 0xFF);
-            nValue >>= 8;
-            WriteMemoryByte(++nAddress, nValue & 0xFF);
-            nValue >>= 8;
-            WriteMemoryByte(++nAddress, nValue & 0xFF);
-            nValue >>= 8;
-            WriteMemoryByte(++nAddress, nValue & 0xFF);
+            pBuffer.at(0) = nValue & 0xFF;
+            pBuffer.at(1) = (nValue >> 8) & 0xFF;
+            pBuffer.at(2) = (nValue >> 16) & 0xFF;
+            pBuffer.at(3) = (nValue >> 24) & 0xFF;
+            WriteMemory(nAddress, pBuffer.data(), 4);
             return;
         case MemSize::SixteenBitBigEndian:
-            WriteMemoryByte(nAddress, (nValue >> 8) & 0xFF);
-            WriteMemoryByte(++nAddress, nValue & 0xFF);
+            pBuffer.at(0) = (nValue >> 8) & 0xFF;
+            pBuffer.at(1) = nValue & 0xFF;
+            WriteMemory(nAddress, pBuffer.data(), 2);
             return;
         case MemSize::TwentyFourBitBigEndian:
-            WriteMemoryByte(nAddress, (nValue >> 16) & 0xFF);
-            WriteMemoryByte(++nAddress, (nValue >> 8) & 0xFF);
-            WriteMemoryByte(++nAddress, nValue & 0xFF);
+            pBuffer.at(0) = (nValue >> 16) & 0xFF;
+            pBuffer.at(1) = (nValue >> 8) & 0xFF;
+            pBuffer.at(2) = nValue & 0xFF;
+            WriteMemory(nAddress, pBuffer.data(), 3);
             return;
         case MemSize::ThirtyTwoBitBigEndian:
-            WriteMemoryByte(nAddress, (nValue >> 24) & 0xFF);
-            WriteMemoryByte(++nAddress, (nValue >> 16) & 0xFF);
-            WriteMemoryByte(++nAddress, (nValue >> 8) & 0xFF);
-            WriteMemoryByte(++nAddress, nValue & 0xFF);
+            pBuffer.at(0) = (nValue >> 24) & 0xFF;
+            pBuffer.at(1) = (nValue >> 16) & 0xFF;
+            pBuffer.at(2) = (nValue >> 8) & 0xFF;
+            pBuffer.at(3) = nValue & 0xFF;
+            WriteMemory(nAddress, pBuffer.data(), 4);
             return;
         case MemSize::BitCount:
             return;
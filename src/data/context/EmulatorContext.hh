@@ -4,6 +4,7 @@
 
 #include "RAInterface\RA_Emulators.h"
 
+#include "data\NotifyTargetSet.hh"
 #include "data\Types.hh"
 #include "ra_fwd.h"
 
@@ -179,6 +180,7 @@ public:
     typedef uint8_t(MemoryReadFunction)(uint32_t nAddress);
     typedef uint32_t(MemoryReadBlockFunction)(uint32_t nAddress, uint8_t* pBuffer, uint32_t nBytes);
     typedef void (MemoryWriteFunction)(uint32_t nAddress, uint8_t nValue);
+    typedef uint32_t(MemoryWriteBlockFunction)(uint32_t nAddress, const uint8_t* pBuffer, uint32_t nBytes);
 
     /// <summary>
     /// Specifies functions to read and write memory in the emulator.
@@ -190,6 +192,11 @@ public:
     /// </summary>
     void AddMemoryBlockReader(gsl::index nIndex, MemoryReadBlockFunction* pReader);
 
+    /// <summary>
+    /// Specifies functions to write chunks of memory in the emulator.
+    /// </summary>
+    void AddMemoryBlockWriter(gsl::index nIndex, MemoryWriteBlockFunction* pWriter);
+
     /// <summary>
     /// Clears all registered memory blocks so they can be rebuilt.
     /// </summary>
@@ -235,6 +242,15 @@ public:
     /// </summary>
     void WriteMemory(ra::ByteAddress nAddress, MemSize nSize, uint32_t nValue) const;
 
+    /// <summary>
+    /// Writes a range of memory to the emulator.
+    /// </summary>
+    /// <remarks>
+    /// Notify targets are told about the write once for each contiguous range of writable memory, rather than
+    /// once per byte.
+    /// </remarks>
+    void WriteMemory(ra::ByteAddress nAddress, _In_reads_(nCount) const uint8_t pBuffer[], size_t nCount) const;
+
     class DispatchesReadMemory
     {
     protected:
@@ -278,14 +294,23 @@ public:
 
         virtual void OnTotalMemorySizeChanged() noexcept(false) {}
         virtual void OnByteWritten(ra::ByteAddress, uint8_t) noexcept(false) {}
+
+        /// <summary>
+        /// Called when a range of memory is written. By default, calls <see cref="OnByteWritten" /> for each byte.
+        /// </summary>
+        virtual void OnBytesWritten(ra::ByteAddress nAddress, _In_reads_(nCount) const uint8_t pBytes[], size_t nCount) noexcept(false)
+        {
+            for (size_t i = 0; i < nCount; ++i)
+                OnByteWritten(nAddress++, pBytes[i]);
+        }
     };
 
-    void AddNotifyTarget(NotifyTarget& pTarget) noexcept { GSL_SUPPRESS_F6 m_vNotifyTargets.insert(&pTarget); }
-    void RemoveNotifyTarget(NotifyTarget& pTarget) noexcept { GSL_SUPPRESS_F6 m_vNotifyTargets.erase(&pTarget); }
+    void AddNotifyTarget(NotifyTarget& pTarget) noexcept { GSL_SUPPRESS_F6 m_vNotifyTargets.Add(pTarget); }
+    void RemoveNotifyTarget(NotifyTarget& pTarget) noexcept { GSL_SUPPRESS_F6 m_vNotifyTargets.Remove(pTarget); }
 
 private:
-    using NotifyTargetSet = std::set<NotifyTarget*>;
-    NotifyTargetSet m_vNotifyTargets;
+    using NotifyTargetSet = ra::data::NotifyTargetSet<NotifyTarget>;
+    mutable NotifyTargetSet m_vNotifyTargets; // WriteMemoryByte is const
 
 protected:
     void UpdateUserAgent();
@@ -315,6 +340,7 @@ protected:
         MemoryReadFunction* read;
         MemoryWriteFunction* write;
         MemoryReadBlockFunction* readBlock;
+        MemoryWriteBlockFunction* writeBlock;
     };
 
     std::vector<MemoryBlock> m_vMemoryBlocks;
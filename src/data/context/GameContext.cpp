@@ -250,6 +250,7 @@ void GameContext::EndLoadGame(int nResult, bool bWasPaused, bool bShowSoftcoreWa
                 [this](ra::ByteAddress nAddress, const std::wstring& sNewNote) {
                     OnCodeNoteChanged(nAddress, sNewNote);
                 },
+                [this]() { OnCodeNotesReloaded(); },
                 [this]() { EndLoad(); });
 
             m_vAssets.Append(std::move(pCodeNotes));
@@ -606,37 +607,19 @@ uint32_t GameContext::GetGameId(uint32_t nSubsetId) const noexcept
 
 void GameContext::OnBeforeActiveGameChanged()
 {
-    // create a copy of the list of pointers in case it's modified by one of the callbacks
-    NotifyTargetSet vNotifyTargets(m_vNotifyTargets);
-    for (NotifyTarget* target : vNotifyTargets)
-    {
-        Expects(target != nullptr);
-        target->OnBeforeActiveGameChanged();
-    }
+    m_vNotifyTargets.Dispatch([&](NotifyTarget& pTarget) { pTarget.OnBeforeActiveGameChanged(); });
 }
 
 void GameContext::OnActiveGameChanged()
 {
-    // create a copy of the list of pointers in case it's modified by one of the callbacks
-    NotifyTargetSet vNotifyTargets(m_vNotifyTargets);
-    for (NotifyTarget* target : vNotifyTargets)
-    {
-        Expects(target != nullptr);
-        target->OnActiveGameChanged();
-    }
+    m_vNotifyTargets.Dispatch([&](NotifyTarget& pTarget) { pTarget.OnActiveGameChanged(); });
 }
 
 void GameContext::BeginLoad()
 {
     if (m_nLoadCount.fetch_add(1) == 0)
     {
-        // create a copy of the list of pointers in case it's modified by one of the callbacks
-        NotifyTargetSet vNotifyTargets(m_vNotifyTargets);
-        for (NotifyTarget* target : vNotifyTargets)
-        {
-            Expects(target != nullptr);
-            target->OnBeginGameLoad();
-        }
+        m_vNotifyTargets.Dispatch([&](NotifyTarget& pTarget) { pTarget.OnBeginGameLoad(); });
     }
 }
 
@@ -647,13 +630,7 @@ void GameContext::EndLoad()
         for (gsl::index nIndex = 0; nIndex < gsl::narrow_cast<gsl::index>(m_vAssets.Count()); ++nIndex)
             m_vAssets.GetItemAt(nIndex)->Validate();
 
-        // create a copy of the list of pointers in case it's modified by one of the callbacks
-        NotifyTargetSet vNotifyTargets(m_vNotifyTargets);
-        for (NotifyTarget* target : vNotifyTargets)
-        {
-            Expects(target != nullptr);
-            target->OnEndGameLoad();
-        }
+        m_vNotifyTargets.Dispatch([&](NotifyTarget& pTarget) { pTarget.OnEndGameLoad(); });
     }
 }
 
@@ -671,18 +648,17 @@ void GameContext::DoFrame()
 
 void GameContext::OnCodeNoteChanged(ra::ByteAddress nAddress, const std::wstring& sNewNote)
 {
-    if (!m_vNotifyTargets.empty())
+    if (!m_vNotifyTargets.IsEmpty())
     {
-        // create a copy of the list of pointers in case it's modified by one of the callbacks
-        NotifyTargetSet vNotifyTargets(m_vNotifyTargets);
-        for (NotifyTarget* target : vNotifyTargets)
-        {
-            Expects(target != nullptr);
-            target->OnCodeNoteChanged(nAddress, sNewNote);
-        }
+        m_vNotifyTargets.Dispatch([&](NotifyTarget& pTarget) { pTarget.OnCodeNoteChanged(nAddress, sNewNote); });
     }
 }
 
+void GameContext::OnCodeNotesReloaded()
+{
+    m_vNotifyTargets.Dispatch([&](NotifyTarget& pTarget) { pTarget.OnCodeNotesReloaded(); });
+}
+
 } // namespace context
 } // namespace data
 } // namespace ra
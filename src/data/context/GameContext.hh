@@ -4,6 +4,8 @@
 
 #include "GameAssets.hh"
 
+#include "data\NotifyTargetSet.hh"
+
 #include <string>
 #include <atomic>
 
@@ -150,10 +152,11 @@ public:
         virtual void OnBeginGameLoad() noexcept(false) {}
         virtual void OnEndGameLoad() noexcept(false) {}
         virtual void OnCodeNoteChanged(ra::ByteAddress, const std::wstring&) noexcept(false) {}
+        virtual void OnCodeNotesReloaded() noexcept(false) {}
     };
 
-    void AddNotifyTarget(NotifyTarget& pTarget) noexcept { GSL_SUPPRESS_F6 m_vNotifyTargets.insert(&pTarget); }
-    void RemoveNotifyTarget(NotifyTarget& pTarget) noexcept { GSL_SUPPRESS_F6 m_vNotifyTargets.erase(&pTarget); }
+    void AddNotifyTarget(NotifyTarget& pTarget) noexcept { GSL_SUPPRESS_F6 m_vNotifyTargets.Add(pTarget); }
+    void RemoveNotifyTarget(NotifyTarget& pTarget) noexcept { GSL_SUPPRESS_F6 m_vNotifyTargets.Remove(pTarget); }
 
     void DoFrame();
 
@@ -192,7 +195,7 @@ public:
     uint32_t GetGameId(uint32_t nSubsetId) const noexcept;
 
 private:
-    using NotifyTargetSet = std::set<NotifyTarget*>;
+    using NotifyTargetSet = ra::data::NotifyTargetSet<NotifyTarget>;
     void FinishLoadGame(int nResult, const char* sErrorMessage, bool bWasPaused);
     void MigrateSubsetUserFiles();
 
@@ -204,6 +207,7 @@ protected:
     void OnBeforeActiveGameChanged();
     void OnActiveGameChanged();
     void OnCodeNoteChanged(ra::ByteAddress nAddress, const std::wstring& sNewNote);
+    void OnCodeNotesReloaded();
     void BeginLoad();
     void EndLoad();
 
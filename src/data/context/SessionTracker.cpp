@@ -30,16 +30,50 @@ void SessionTracker::Initialize(const std::string& sUsername)
     SortSessions();
 }
 
+// once the file has this many more entries than games, it's rewritten with one entry per game
+constexpr size_t COMPACTION_THRESHOLD = 64;
+
+static uint32_t CalculateCRC32(const char* pData, size_t nLength) noexcept
+{
+    static const auto pTable = []() noexcept
+    {
+        std::array<uint32_t, 256> pTable{};
+        for (uint32_t i = 0; i < 256; ++i)
+        {
+            uint32_t nValue = i;
+            for (int j = 0; j < 8; ++j)
+                nValue = (nValue & 1) ? (nValue >> 1) ^ 0xEDB88320 : (nValue >> 1);
+
+            pTable.at(i) = nValue;
+        }
+        return pTable;
+    }();
+
+    uint32_t nCRC = 0xFFFFFFFF;
+    for (size_t i = 0; i < nLength; ++i)
+    {
+        GSL_SUPPRESS_BOUNDS4 const auto nByte = static_cast<uint8_t>(pData[i]);
+        nCRC = pTable.at((nCRC ^ nByte) & 0xFF) ^ (nCRC >> 8);
+    }
+
+    return ~nCRC;
+}
+
 void SessionTracker::LoadSessions()
 {
     m_vGameStats.clear();
+    m_mGameStatsIndex.clear();
 
     auto& pLocalStorage = ra::services::ServiceLocator::GetMutable<ra::services::ILocalStorage>();
     auto pStatsFile = pLocalStorage.ReadText(ra::services::StorageItemType::SessionStats, m_sUsername);
 
     if (pStatsFile != nullptr)
     {
+        size_t nValidLines = 0;
+        bool bNeedsCompaction = false;
+
         // line format: <gameid>:<sessionstart>:<sessionlength>:<checksum>
+        // checksum is an 8 character CRC32. older files used a two character checksum derived from the MD5.
         std::string sLine;
         while (pStatsFile->GetLine(sLine))
         {
@@ -47,52 +81,146 @@ void SessionTracker::LoadSessions()
 
             const auto nGameId = pTokenizer.ReadNumber();
             if (!pTokenizer.Consume(':'))
+            {
+                bNeedsCompaction = true;
                 continue;
+            }
 
             const auto nSessionStart = pTokenizer.ReadNumber();
             if (!pTokenizer.Consume(':'))
+            {
+                bNeedsCompaction = true;
                 continue;
+            }
 
             const auto nSessionLength = pTokenizer.ReadNumber();
             if (!pTokenizer.Consume(':'))
+            {
+                bNeedsCompaction = true;
                 continue;
+            }
+
+            const auto nChecksumStart = pTokenizer.CurrentPosition();
+            const auto nChecksumLength = sLine.length() - nChecksumStart;
+            bool bValid = false;
+            if (nChecksumLength == 8)
+            {
+                char* pEnd = nullptr;
+                const auto nExpected = std::strtoul(pTokenizer.GetPointer(nChecksumStart), &pEnd, 16);
+                bValid = (*pEnd == '\0' && nExpected == CalculateCRC32(sLine.c_str(), nChecksumStart));
+            }
+            else if (nChecksumLength == 2)
+            {
+                // legacy entry. these will be converted to the new format when the file is compacted
+                const BYTE* pLine;
+                GSL_SUPPRESS_TYPE1{ pLine = reinterpret_cast<const BYTE*>(sLine.c_str()); }
+                const auto md5 = RAGenerateMD5(pLine, nChecksumStart);
+                bValid = (pTokenizer.Consume(md5.front()) && pTokenizer.Consume(md5.back()));
+                bNeedsCompaction = true;
+            }
+
+            if (!bValid)
+            {
+                // corrupt or partially written entry - it will be discarded when the file is compacted
+                bNeedsCompaction = true;
+                continue;
+            }
 
-
-            const BYTE* pLine;
-            GSL_SUPPRESS_TYPE1{ pLine = reinterpret_cast<const BYTE*>(sLine.c_str()); }
-            const auto md5 = RAGenerateMD5(pLine, pTokenizer.CurrentPosition());
-            if (pTokenizer.Consume(md5.front()) && pTokenizer.Consume(md5.back()))
-                AddSession(nGameId, nSessionStart, std::chrono::seconds(nSessionLength));
+            AddSession(nGameId, nSessionStart, std::chrono::seconds(nSessionLength));
+            ++nValidLines;
         }
 
         m_nFileWritePosition = pStatsFile->GetPosition();
+
+        if (bNeedsCompaction || nValidLines >= m_vGameStats.size() + COMPACTION_THRESHOLD)
+        {
+            pStatsFile.reset();
+            CompactSessions();
+        }
     }
 }
 
-void SessionTracker::AddSession(unsigned int nGameId, time_t tSessionStart, std::chrono::seconds tSessionDuration)
+void SessionTracker::CompactSessions()
 {
-    auto pIter = m_vGameStats.begin();
-    while (pIter != m_vGameStats.end() && pIter->GameId != nGameId)
-        ++pIter;
+    // write the compacted data to a temporary item and swap it in when complete so the history isn't lost
+    // if the write is interrupted.
+    auto& pLocalStorage = ra::services::ServiceLocator::GetMutable<ra::services::ILocalStorage>();
+    const std::wstring sTempKey = m_sUsername + L".tmp";
+    auto pStatsFile = pLocalStorage.WriteText(ra::services::StorageItemType::SessionStats, sTempKey);
+    if (pStatsFile == nullptr)
+    {
+        RA_LOG_WARN("Could not compact session stats");
+        return;
+    }
 
-    if (pIter == m_vGameStats.end())
+    // the per-game totals are written as a single entry for each game. the entry has the same format as a
+    // session, so loading the file and adding the entries together produces the same totals. games without
+    // any playtime are still written so LastSessionStart is preserved for the recently played ordering.
+    for (const auto& pGameStats : m_vGameStats)
     {
-        m_vGameStats.emplace_back();
-        pIter = m_vGameStats.end() - 1;
-        pIter->GameId = nGameId;
+        const auto tLastSessionStart = std::chrono::system_clock::to_time_t(pGameStats.LastSessionStart);
+        pStatsFile->WriteLine(FormatSessionStats(pGameStats.GameId, tLastSessionStart, pGameStats.TotalPlayTime));
     }
 
-    pIter->LastSessionStart = std::chrono::system_clock::from_time_t(tSessionStart);
-    pIter->TotalPlayTime += tSessionDuration;
+    const auto nFileWritePosition = pStatsFile->GetPosition();
+    pStatsFile.reset();
+
+    if (!pLocalStorage.Move(ra::services::StorageItemType::SessionStats, sTempKey, m_sUsername))
+    {
+        RA_LOG_WARN("Could not replace session stats with compacted data");
+        pLocalStorage.Delete(ra::services::StorageItemType::SessionStats, sTempKey);
+        return;
+    }
+
+    m_nFileWritePosition = nFileWritePosition;
+
+    RA_LOG_INFO("Compacted session stats for %zu games", m_vGameStats.size());
+}
+
+SessionTracker::GameStats& SessionTracker::GetGameStats(unsigned int nGameId)
+{
+    const auto pIter = m_mGameStatsIndex.find(nGameId);
+    if (pIter != m_mGameStatsIndex.end())
+        return m_vGameStats.at(pIter->second);
+
+    m_mGameStatsIndex.emplace(nGameId, m_vGameStats.size());
+    auto& pGameStats = m_vGameStats.emplace_back();
+    pGameStats.GameId = nGameId;
+    return pGameStats;
+}
+
+void SessionTracker::AddSession(unsigned int nGameId, time_t tSessionStart, std::chrono::seconds tSessionDuration)
+{
+    auto& pGameStats = GetGameStats(nGameId);
+    pGameStats.LastSessionStart = std::chrono::system_clock::from_time_t(tSessionStart);
+    pGameStats.TotalPlayTime += tSessionDuration;
 }
 
 void SessionTracker::SortSessions()
 {
     // move most recently played items to the front of the list
-    std::sort(m_vGameStats.begin(), m_vGameStats.end(), [](const GameStats& left, const GameStats& right)
+    std::stable_sort(m_vGameStats.begin(), m_vGameStats.end(), [](const GameStats& left, const GameStats& right)
     {
         return (right.LastSessionStart < left.LastSessionStart);
     });
+
+    for (size_t nIndex = 0; nIndex < m_vGameStats.size(); ++nIndex)
+        m_mGameStatsIndex.insert_or_assign(m_vGameStats.at(nIndex).GameId, nIndex);
+}
+
+void SessionTracker::MoveToFront(unsigned int nGameId)
+{
+    const auto pIter = m_mGameStatsIndex.find(nGameId);
+    if (pIter == m_mGameStatsIndex.end() || pIter->second == 0)
+        return;
+
+    // shift everything before the item down one slot and put the item at the front
+    const auto nIndex = pIter->second;
+    const auto pStart = m_vGameStats.begin();
+    std::rotate(pStart, pStart + gsl::narrow_cast<std::ptrdiff_t>(nIndex), pStart + gsl::narrow_cast<std::ptrdiff_t>(nIndex) + 1);
+
+    for (size_t i = 0; i <= nIndex; ++i)
+        m_mGameStatsIndex.insert_or_assign(m_vGameStats.at(i).GameId, i);
 }
 
 void SessionTracker::BeginSession(unsigned int nGameId)
@@ -115,8 +243,7 @@ void SessionTracker::BeginSession(unsigned int nGameId)
     {
         // make sure a persisted play entry exists for the game and is first in the list
         AddSession(nGameId, m_tSessionStart, std::chrono::seconds(0));
-        if (m_vGameStats.begin()->GameId != nGameId)
-            SortSessions();
+        MoveToFront(nGameId);
     }
 }
 
@@ -172,18 +299,19 @@ std::streampos SessionTracker::WriteSessionStats(std::chrono::seconds tSessionDu
     auto& pLocalStorage = ra::services::ServiceLocator::GetMutable<ra::services::ILocalStorage>();
     auto pStatsFile = pLocalStorage.AppendText(ra::services::StorageItemType::SessionStats, m_sUsername);
 
-    auto nSessionDuration = tSessionDuration.count();
-    auto sLine = ra::StringPrintf("%u:%ll:%ll:", m_nCurrentGameId, m_tSessionStart, nSessionDuration);
-    const auto sMD5 = RAGenerateMD5(sLine);
-    sLine.push_back(sMD5.front());
-    sLine.push_back(sMD5.back());
-
     pStatsFile->SetPosition(m_nFileWritePosition);
-    pStatsFile->WriteLine(sLine);
+    pStatsFile->WriteLine(FormatSessionStats(m_nCurrentGameId, m_tSessionStart, tSessionDuration));
 
     return pStatsFile->GetPosition();
 }
 
+std::string SessionTracker::FormatSessionStats(unsigned int nGameId, time_t tSessionStart, std::chrono::seconds tSessionDuration)
+{
+    auto sLine = ra::StringPrintf("%u:%ll:%ll:", nGameId, tSessionStart, tSessionDuration.count());
+    sLine.append(ra::StringPrintf("%08x", CalculateCRC32(sLine.c_str(), sLine.length())));
+    return sLine;
+}
+
 std::chrono::seconds SessionTracker::GetTotalPlaytime(unsigned int nGameId) const
 {
     std::chrono::seconds tPlaytime(0);
@@ -198,14 +326,9 @@ std::chrono::seconds SessionTracker::GetTotalPlaytime(unsigned int nGameId) cons
     }
 
     // add any prior session durations
-    for (const auto& pGameStats : m_vGameStats)
-    {
-        if (pGameStats.GameId == nGameId)
-        {
-            tPlaytime += pGameStats.TotalPlayTime;
-            break;
-        }
-    }
+    const auto pIter = m_mGameStatsIndex.find(nGameId);
+    if (pIter != m_mGameStatsIndex.end())
+        tPlaytime += m_vGameStats.at(pIter->second).TotalPlayTime;
 
     return tPlaytime;
 }
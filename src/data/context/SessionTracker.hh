@@ -67,11 +67,18 @@ protected:
 
 private:
     void SortSessions();
+    void MoveToFront(unsigned int nGameId);
+    GameStats& GetGameStats(unsigned int nGameId);
+    void CompactSessions();
+
+    static std::string FormatSessionStats(unsigned int nGameId, time_t tSessionStart, std::chrono::seconds tSessionDuration);
 
     std::chrono::steady_clock::time_point m_tpSessionStart{};
     time_t m_tSessionStart{};
 
+    // most recently played first
     std::vector<GameStats> m_vGameStats;
+    std::unordered_map<unsigned int, size_t> m_mGameStatsIndex;
 
     std::streamoff m_nFileWritePosition{};
 };
@@ -230,7 +230,7 @@ void AchievementModel::HandleStateChanged(AssetState nOldState, AssetState nNewS
     if (!bIsActive && bWasActive)
     {
         Expects(m_pAchievement->trigger != nullptr);
-        m_pCapturedTriggerHits.Capture(m_pAchievement->trigger, GetTrigger());
+        m_pCapturedTriggerHits.Capture(m_pAchievement->trigger, GetAssetDefinitionFingerprint(m_pTrigger));
 
         if (m_pAchievement->trigger->state == RC_TRIGGER_STATE_PRIMED)
         {
@@ -1,5 +1,7 @@
 #include "AssetModelBase.hh"
 
+#include "CapturedTriggerHits.hh"
+
 namespace ra {
 namespace data {
 namespace models {
@@ -298,6 +300,16 @@ bool AssetModelBase::IsUpdating() const
 
 void AssetModelBase::OnValueChanged(const IntModelProperty::ChangeArgs& args)
 {
+    // the definition version changes when the definition changes or a transaction is reverted
+    for (const auto* pAsset : m_vAssetDefinitions)
+    {
+        if (args.Property == *pAsset->m_pProperty)
+        {
+            pAsset->m_bFingerprintValid = false;
+            break;
+        }
+    }
+
     DataModelBase::OnValueChanged(args);
 }
 
@@ -386,7 +398,8 @@ AssetChanges AssetModelBase::GetAssetDefinitionState(const AssetDefinition& pAss
 
 void AssetModelBase::UpdateAssetDefinitionVersion(const AssetDefinition& pAsset, AssetChanges nState)
 {
-    // DJB2 hash the definition
+    // DJB2 hash the definition. the version may not change if the hashes collide, so explicitly discard the fingerprint
+    pAsset.m_bFingerprintValid = false;
     const auto& sDefinition = GetAssetDefinition(pAsset, nState);
     int nHash = ra::StringHash(sDefinition);
 
@@ -418,6 +431,17 @@ const std::string& AssetModelBase::GetAssetDefinition(const AssetDefinition& pAs
     }
 }
 
+uint64_t AssetModelBase::GetAssetDefinitionFingerprint(const AssetDefinition& pAsset) const
+{
+    if (!pAsset.m_bFingerprintValid)
+    {
+        pAsset.m_nFingerprint = CapturedTriggerHits::GetFingerprint(GetAssetDefinition(pAsset));
+        pAsset.m_bFingerprintValid = true;
+    }
+
+    return pAsset.m_nFingerprint;
+}
+
 const std::string& AssetModelBase::GetLocalAssetDefinition(const AssetDefinition& pAsset) const noexcept
 {
     if (pAsset.m_bLocalModified)
@@ -327,6 +327,10 @@ protected:
         std::string m_sLocalDefinition;
         std::string m_sCurrentDefinition;
         bool m_bLocalModified = false;
+
+        // cached result of GetAssetDefinitionFingerprint
+        mutable uint64_t m_nFingerprint = 0;
+        mutable bool m_bFingerprintValid = false;
     };
 
     std::vector<AssetDefinition*> m_vAssetDefinitions;
@@ -342,6 +346,12 @@ protected:
     void SetAssetDefinition(AssetDefinition& pAsset, const std::string& sValue);
     const std::string& GetLocalAssetDefinition(const AssetDefinition& pAsset) const noexcept;
 
+    /// <summary>
+    /// Gets the <see cref="CapturedTriggerHits::GetFingerprint" /> of the current definition. The fingerprint is
+    /// cached until the definition changes.
+    /// </summary>
+    uint64_t GetAssetDefinitionFingerprint(const AssetDefinition& pAsset) const;
+
     bool GetLocalValue(const BoolModelProperty& pProperty) const;
     const std::wstring& GetLocalValue(const StringModelProperty& pProperty) const;
     int GetLocalValue(const IntModelProperty& pProperty) const;
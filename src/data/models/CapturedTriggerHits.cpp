@@ -1,53 +1,116 @@
 #include "CapturedTriggerHits.hh"
 
-#include "RA_md5factory.h"
+#include "ra_utility.h"
 
 namespace ra {
 namespace data {
 namespace models {
 
-static void CaptureCondSetHitCounts(const rc_condset_t* pCondSet, std::vector<unsigned>& vCapturedHitCounts)
+// constants from xxHash64
+static constexpr uint64_t PRIME64_1 = 0x9E3779B185EBCA87ULL;
+static constexpr uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+static constexpr uint64_t PRIME64_3 = 0x165667B19E3779F9ULL;
+static constexpr uint64_t PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+static constexpr uint64_t PRIME64_5 = 0x27D4EB2F165667C5ULL;
+
+static constexpr uint64_t RotateLeft(uint64_t nValue, int nBits) noexcept
+{
+    return (nValue << nBits) | (nValue >> (64 - nBits));
+}
+
+uint64_t CapturedTriggerHits::GetFingerprint(const std::string& sDefinition) noexcept
+{
+    // this is the xxHash64 tail processing and avalanche applied to the entire string, which is identical
+    // to xxHash64 (with a seed of 0) for strings shorter than 32 characters. the four-lane striping that
+    // xxHash64 uses for longer strings isn't worth the complexity for the length of most definitions.
+    const auto* pData = sDefinition.data();
+    const auto* pEnd = pData + sDefinition.length();
+    uint64_t nHash = PRIME64_5 + sDefinition.length();
+
+    for (; pEnd - pData >= 8; pData += 8)
+    {
+        uint64_t nValue;
+        memcpy(&nValue, pData, sizeof(nValue));
+        nHash ^= RotateLeft(nValue * PRIME64_2, 31) * PRIME64_1;
+        nHash = RotateLeft(nHash, 27) * PRIME64_1 + PRIME64_4;
+    }
+
+    if (pEnd - pData >= 4)
+    {
+        uint32_t nValue;
+        memcpy(&nValue, pData, sizeof(nValue));
+        nHash ^= nValue * PRIME64_1;
+        nHash = RotateLeft(nHash, 23) * PRIME64_2 + PRIME64_3;
+        pData += 4;
+    }
+
+    for (; pData < pEnd; ++pData)
+    {
+        nHash ^= static_cast<uint8_t>(*pData) * PRIME64_5;
+        nHash = RotateLeft(nHash, 11) * PRIME64_1;
+    }
+
+    nHash ^= nHash >> 33;
+    nHash *= PRIME64_2;
+    nHash ^= nHash >> 29;
+    nHash *= PRIME64_3;
+    nHash ^= nHash >> 32;
+    return nHash;
+}
+
+static size_t CountConditions(const rc_condset_t* pCondSet) noexcept
+{
+    size_t nCount = 0;
+    for (const rc_condition_t* pCondition = pCondSet->conditions; pCondition != nullptr; pCondition = pCondition->next)
+        ++nCount;
+
+    return nCount;
+}
+
+static size_t CountConditions(const rc_trigger_t* pTrigger) noexcept
+{
+    size_t nCount = 0;
+    if (pTrigger->requirement)
+        nCount += CountConditions(pTrigger->requirement);
+
+    for (const rc_condset_t* pCondSet = pTrigger->alternative; pCondSet; pCondSet = pCondSet->next)
+        nCount += CountConditions(pCondSet);
+
+    return nCount;
+}
+
+static void CaptureCondSetHitCounts(const rc_condset_t* pCondSet, std::vector<unsigned>& vCapturedHitCounts, gsl::index& nIndex)
 {
     const rc_condition_t* pCondition = pCondSet->conditions;
     while (pCondition != nullptr)
     {
-        vCapturedHitCounts.push_back(pCondition->current_hits);
+        vCapturedHitCounts.at(nIndex++) = pCondition->current_hits;
         pCondition = pCondition->next;
     }
 }
 
 static void CaptureHitCounts(const rc_trigger_t* pTrigger, std::vector<unsigned>& vCapturedHitCounts)
 {
+    gsl::index nIndex = 0;
     if (pTrigger->requirement)
-        CaptureCondSetHitCounts(pTrigger->requirement, vCapturedHitCounts);
+        CaptureCondSetHitCounts(pTrigger->requirement, vCapturedHitCounts, nIndex);
 
     const rc_condset_t* pCondSet = pTrigger->alternative;
     while (pCondSet)
     {
-        CaptureCondSetHitCounts(pCondSet, vCapturedHitCounts);
+        CaptureCondSetHitCounts(pCondSet, vCapturedHitCounts, nIndex);
         pCondSet = pCondSet->next;
     }
 }
 
 static void RestoreCondSetHitCounts(rc_condset_t* pCondSet, const std::vector<unsigned>& vCapturedHitCounts, gsl::index& nIndex)
 {
-    if (vCapturedHitCounts.empty())
-    {
-        rc_condition_t* pCondition = pCondSet->conditions;
-        while (pCondition != nullptr)
-        {
-            pCondition->current_hits = 0;
-            pCondition = pCondition->next;
-        }
-    }
-    else
+    rc_condition_t* pCondition = pCondSet->conditions;
+    while (pCondition != nullptr)
     {
-        rc_condition_t* pCondition = pCondSet->conditions;
-        while (pCondition != nullptr)
-        {
-            pCondition->current_hits = vCapturedHitCounts.at(nIndex++);
-            pCondition = pCondition->next;
-        }
+        // if nothing was captured, or the definition doesn't match what was captured, reset the hit counts
+        pCondition->current_hits = (ra::to_unsigned(nIndex) < vCapturedHitCounts.size()) ? vCapturedHitCounts.at(nIndex++) : 0;
+        pCondition = pCondition->next;
     }
 }
 
@@ -65,23 +128,21 @@ static void RestoreHitCounts(rc_trigger_t* pTrigger, const std::vector<unsigned>
     }
 }
 
-void CapturedTriggerHits::Capture(const rc_trigger_t* pTrigger, const std::string& sTrigger)
+void CapturedTriggerHits::Capture(const rc_trigger_t* pTrigger, uint64_t nFingerprint)
 {
-    m_vCapturedHitCounts.clear();
+    m_nCapturedFingerprint = nFingerprint;
+    m_bCaptured = true;
 
-    m_sCapturedHitsMD5 = RAGenerateMD5(sTrigger);
+    // count the conditions first so the array is only allocated once
+    m_vCapturedHitCounts.resize(pTrigger->has_hits ? CountConditions(pTrigger) : 0);
 
     if (pTrigger->has_hits)
         CaptureHitCounts(pTrigger, m_vCapturedHitCounts);
 }
 
-bool CapturedTriggerHits::Restore(rc_trigger_t* pTrigger, const std::string& sTrigger) const
+bool CapturedTriggerHits::Restore(rc_trigger_t* pTrigger, uint64_t nFingerprint) const
 {
-    if (m_sCapturedHitsMD5.empty())
-        return false;
-
-    const auto sCapturedHitsMD5 = RAGenerateMD5(sTrigger);
-    if (sCapturedHitsMD5 != m_sCapturedHitsMD5)
+    if (!m_bCaptured || nFingerprint != m_nCapturedFingerprint)
         return false;
 
     RestoreHitCounts(pTrigger, m_vCapturedHitCounts);
@@ -90,23 +151,26 @@ bool CapturedTriggerHits::Restore(rc_trigger_t* pTrigger, const std::string& sTr
     return true;
 }
 
-void CapturedTriggerHits::Capture(const rc_value_t* pValue, const std::string& sValue)
+void CapturedTriggerHits::Capture(const rc_value_t* pValue, uint64_t nFingerprint)
 {
-    m_vCapturedHitCounts.clear();
+    m_nCapturedFingerprint = nFingerprint;
+    m_bCaptured = true;
 
-    m_sCapturedHitsMD5 = RAGenerateMD5(sValue);
+    // count the conditions first so the array is only allocated once
+    size_t nCount = 0;
+    for (const auto* conditions = pValue->conditions; conditions; conditions = conditions->next)
+        nCount += CountConditions(conditions);
+
+    m_vCapturedHitCounts.resize(nCount);
 
+    gsl::index nIndex = 0;
     for (const auto* conditions = pValue->conditions; conditions; conditions = conditions->next)
-        CaptureCondSetHitCounts(conditions, m_vCapturedHitCounts);
+        CaptureCondSetHitCounts(conditions, m_vCapturedHitCounts, nIndex);
 }
 
-bool CapturedTriggerHits::Restore(rc_value_t* pValue, const std::string& sValue) const
+bool CapturedTriggerHits::Restore(rc_value_t* pValue, uint64_t nFingerprint) const
 {
-    if (m_sCapturedHitsMD5.empty())
-        return false;
-
-    const auto sCapturedHitsMD5 = RAGenerateMD5(sValue);
-    if (sCapturedHitsMD5 != m_sCapturedHitsMD5)
+    if (!m_bCaptured || nFingerprint != m_nCapturedFingerprint)
         return false;
 
     gsl::index nIndex = 0;
@@ -119,7 +183,8 @@ bool CapturedTriggerHits::Restore(rc_value_t* pValue, const std::string& sValue)
 void CapturedTriggerHits::Reset() noexcept
 {
     m_vCapturedHitCounts.clear();
-    m_sCapturedHitsMD5.clear();
+    m_nCapturedFingerprint = 0;
+    m_bCaptured = false;
 }
 
 } // namespace models
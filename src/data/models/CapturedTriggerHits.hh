@@ -9,17 +9,30 @@ namespace models {
 class CapturedTriggerHits
 {
 public:
-    void Capture(const rc_trigger_t* pTrigger, const std::string& sTrigger);
-    bool Restore(rc_trigger_t* pTrigger, const std::string& sTrigger) const;
+    /// <summary>
+    /// Gets a fingerprint of a trigger or value definition for identifying the definition the hits were captured from.
+    /// </summary>
+    /// <remarks>
+    /// Not suitable for anything security related. Only used to detect if the definition has changed.
+    /// </remarks>
+    static uint64_t GetFingerprint(const std::string& sDefinition) noexcept;
 
-    void Capture(const rc_value_t* pValue, const std::string& sValue);
-    bool Restore(rc_value_t* pValue, const std::string& sValue) const;
+    void Capture(const rc_trigger_t* pTrigger, const std::string& sTrigger) { Capture(pTrigger, GetFingerprint(sTrigger)); }
+    void Capture(const rc_trigger_t* pTrigger, uint64_t nFingerprint);
+    bool Restore(rc_trigger_t* pTrigger, const std::string& sTrigger) const { return Restore(pTrigger, GetFingerprint(sTrigger)); }
+    bool Restore(rc_trigger_t* pTrigger, uint64_t nFingerprint) const;
+
+    void Capture(const rc_value_t* pValue, const std::string& sValue) { Capture(pValue, GetFingerprint(sValue)); }
+    void Capture(const rc_value_t* pValue, uint64_t nFingerprint);
+    bool Restore(rc_value_t* pValue, const std::string& sValue) const { return Restore(pValue, GetFingerprint(sValue)); }
+    bool Restore(rc_value_t* pValue, uint64_t nFingerprint) const;
 
     void Reset() noexcept;
 
 private:
     std::vector<unsigned> m_vCapturedHitCounts;
-    std::string m_sCapturedHitsMD5;
+    uint64_t m_nCapturedFingerprint = 0;
+    bool m_bCaptured = false;
 };
 
 } // namespace models
@@ -96,30 +96,8 @@ void CodeNoteModel::UpdateRawPointerValue(ra::ByteAddress nAddress, const ra::da
     if (m_pPointerData == nullptr)
         return;
 
-    m_pPointerData->PointerRead = true;
-
     const uint32_t nValue = pEmulatorContext.ReadMemory(nAddress, GetMemSize());
-    if (nValue != m_pPointerData->RawPointerValue)
-    {
-        m_pPointerData->RawPointerValue = nValue;
-
-        const auto nNewAddress = (m_pPointerData->OffsetType == PointerData::OffsetType::Converted)
-            ? ConvertPointer(nValue) : nValue;
-
-        const auto nOldAddress = m_pPointerData->PointerAddress;
-        if (nNewAddress != nOldAddress)
-        {
-            m_pPointerData->PointerAddress = nNewAddress;
-            if (fNoteMovedCallback)
-            {
-                for (const auto& pNote : m_pPointerData->OffsetNotes)
-                {
-                    if (!pNote.IsPointer())
-                        fNoteMovedCallback(nOldAddress + pNote.GetAddress(), nNewAddress + pNote.GetAddress(), pNote);
-                }
-            }
-        }
-    }
+    SetRawPointerValue(nValue, fNoteMovedCallback);
 
     if (m_pPointerData->HasPointers)
     {
@@ -134,6 +112,50 @@ void CodeNoteModel::UpdateRawPointerValue(ra::ByteAddress nAddress, const ra::da
     }
 }
 
+bool CodeNoteModel::SetRawPointerValue(uint32_t nValue, const NoteMovedFunction& fNoteMovedCallback)
+{
+    if (m_pPointerData == nullptr)
+        return false;
+
+    m_pPointerData->PointerRead = true;
+
+    if (nValue == m_pPointerData->RawPointerValue)
+        return false;
+
+    m_pPointerData->RawPointerValue = nValue;
+
+    const auto nNewAddress = (m_pPointerData->OffsetType == PointerData::OffsetType::Converted)
+        ? ConvertPointer(nValue) : nValue;
+
+    const auto nOldAddress = m_pPointerData->PointerAddress;
+    if (nNewAddress == nOldAddress)
+        return false;
+
+    m_pPointerData->PointerAddress = nNewAddress;
+    if (fNoteMovedCallback)
+    {
+        for (const auto& pNote : m_pPointerData->OffsetNotes)
+        {
+            if (!pNote.IsPointer())
+                fNoteMovedCallback(nOldAddress + pNote.GetAddress(), nNewAddress + pNote.GetAddress(), pNote);
+        }
+    }
+
+    return true;
+}
+
+void CodeNoteModel::EnumerateNestedPointerNotes(std::function<void(CodeNoteModel&)> fCallback)
+{
+    if (m_pPointerData == nullptr || !m_pPointerData->HasPointers)
+        return;
+
+    for (auto& pNote : m_pPointerData->OffsetNotes)
+    {
+        if (pNote.IsPointer())
+            fCallback(pNote);
+    }
+}
+
 const CodeNoteModel* CodeNoteModel::GetPointerNoteAtOffset(int nOffset) const
 {
     if (m_pPointerData == nullptr)
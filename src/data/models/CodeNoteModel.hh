@@ -45,6 +45,17 @@ public:
     typedef std::function<void(ra::ByteAddress nOldAddress, ra::ByteAddress nNewAddress, const CodeNoteModel&)> NoteMovedFunction;
     void UpdateRawPointerValue(ra::ByteAddress nAddress, const ra::data::context::EmulatorContext& pEmulatorContext, NoteMovedFunction fNoteMovedCallback);
 
+    /// <summary>
+    /// Updates the captured pointer value without updating any nested pointers.
+    /// </summary>
+    /// <returns><c>true</c> if the address being pointed at changed.</returns>
+    bool SetRawPointerValue(uint32_t nValue, const NoteMovedFunction& fNoteMovedCallback);
+
+    /// <summary>
+    /// Calls <paramref name="fCallback" /> for each offset note that is also a pointer.
+    /// </summary>
+    void EnumerateNestedPointerNotes(std::function<void(CodeNoteModel&)> fCallback);
+
     bool GetPreviousAddress(ra::ByteAddress nBeforeAddress, ra::ByteAddress& nPreviousAddress) const;
     bool GetNextAddress(ra::ByteAddress nAfterAddress, ra::ByteAddress& nNextAddress) const;
 
@@ -5,11 +5,18 @@
 #include "api\DeleteCodeNote.hh"
 #include "api\FetchCodeNotes.hh"
 #include "api\UpdateCodeNote.hh"
+#include "api\impl\CodeNotesCache.hh"
+#include "api\impl\OfflineServer.hh"
 
 #include "data\context\ConsoleContext.hh"
 #include "data\context\EmulatorContext.hh"
 #include "data\context\UserContext.hh"
 
+#include "services\ILocalStorage.hh"
+#include "services\IThreadPool.hh"
+#include "services\ServiceLocator.hh"
+
+#include "ui\IDesktop.hh"
 #include "ui\viewmodels\MessageBoxViewModel.hh"
 
 namespace ra {
@@ -22,20 +29,100 @@ CodeNotesModel::CodeNotesModel() noexcept
     GSL_SUPPRESS_F6 SetName(L"Code Notes");
 }
 
-void CodeNotesModel::Refresh(unsigned int nGameId, CodeNoteChangedFunction fCodeNoteChanged, std::function<void()> callback)
+// number of notes to parse per thread pool task when building a large batch of notes
+static constexpr size_t CODE_NOTE_PARSE_CHUNK_SIZE = 512;
+
+struct CodeNoteParseState
+{
+    const std::vector<ra::api::FetchCodeNotes::Response::CodeNote>* pSource = nullptr;
+    std::vector<std::unique_ptr<CodeNoteModel>> vNotes;
+    size_t nChunks = 0;
+    std::atomic<size_t> nNextChunk{ 0 };
+
+    std::mutex oMutex;
+    std::condition_variable cvChunkCompleted;
+    size_t nCompletedChunks = 0;
+};
+
+static void ParseCodeNoteChunks(CodeNoteParseState& pState)
 {
+    // claim chunks until there are none left. a task that starts after all of the chunks
+    // have been claimed exits without touching pSource, which may no longer exist.
+    size_t nChunk = 0;
+    while ((nChunk = pState.nNextChunk.fetch_add(1)) < pState.nChunks)
+    {
+        const auto& vSource = *pState.pSource;
+        const auto nStart = nChunk * CODE_NOTE_PARSE_CHUNK_SIZE;
+        const auto nEnd = std::min(nStart + CODE_NOTE_PARSE_CHUNK_SIZE, vSource.size());
+        for (auto nIndex = nStart; nIndex < nEnd; ++nIndex)
+        {
+            const auto& pSourceNote = vSource.at(nIndex);
+            auto pNote = std::make_unique<CodeNoteModel>();
+            pNote->SetAuthor(pSourceNote.Author);
+            pNote->SetAddress(pSourceNote.Address);
+            pNote->SetNote(pSourceNote.Note);
+            pState.vNotes.at(nIndex) = std::move(pNote);
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(pState.oMutex);
+            ++pState.nCompletedChunks;
+        }
+        pState.cvChunkCompleted.notify_all();
+    }
+}
+
+static std::vector<std::unique_ptr<CodeNoteModel>> BuildCodeNoteModels(
+    const std::vector<ra::api::FetchCodeNotes::Response::CodeNote>& vNotes)
+{
+    auto pState = std::make_shared<CodeNoteParseState>();
+    pState->pSource = &vNotes;
+    pState->vNotes.resize(vNotes.size());
+    pState->nChunks = (vNotes.size() + CODE_NOTE_PARSE_CHUNK_SIZE - 1) / CODE_NOTE_PARSE_CHUNK_SIZE;
+
+    if (pState->nChunks > 1 && ra::services::ServiceLocator::Exists<ra::services::IThreadPool>())
+    {
+        const auto nThreads = std::max(std::thread::hardware_concurrency(), 1U);
+        const auto nHelpers = std::min(pState->nChunks - 1, size_t{ nThreads } - 1);
+
+        auto& pThreadPool = ra::services::ServiceLocator::GetMutable<ra::services::IThreadPool>();
+        for (size_t i = 0; i < nHelpers; ++i)
+            pThreadPool.RunAsync([pState]() { ParseCodeNoteChunks(*pState); });
+    }
+
+    // the current thread also processes chunks, so this never waits on a task that
+    // hasn't started (which could deadlock if called from a thread pool thread).
+    ParseCodeNoteChunks(*pState);
+
+    {
+        std::unique_lock<std::mutex> lock(pState->oMutex);
+        pState->cvChunkCompleted.wait(lock, [&pState]() noexcept {
+            return pState->nCompletedChunks == pState->nChunks;
+        });
+    }
+
+    return std::move(pState->vNotes);
+}
+
+void CodeNotesModel::Refresh(unsigned int nGameId, CodeNoteChangedFunction fCodeNoteChanged,
+                             CodeNotesReloadedFunction fCodeNotesReloaded, std::function<void()> callback)
+{
+    ++m_nRefreshId;
     m_nGameId = nGameId;
     m_vCodeNotes.clear();
     m_bHasPointers = false;
+    m_bPointerSlotsDirty = true;
 
     if (nGameId == 0)
     {
         m_fCodeNoteChanged = nullptr;
+        m_fCodeNotesReloaded = nullptr;
         callback();
         return;
     }
 
     m_fCodeNoteChanged = fCodeNoteChanged;
+    m_fCodeNotesReloaded = fCodeNotesReloaded;
 
     if (callback == nullptr) // unit test workaround to avoid server call
         return;
@@ -45,57 +132,121 @@ void CodeNotesModel::Refresh(unsigned int nGameId, CodeNoteChangedFunction fCode
         m_bRefreshing = true;
     }
 
+    // if there's a local copy of the notes, use it immediately. the server response will only be
+    // used to update whatever has changed since the local copy was written.
+    uint32_t nCachedHash = 0;
+    const bool bLoadedFromCache = LoadCachedCodeNotes(nGameId, nCachedHash);
+    if (bLoadedFromCache)
+    {
+        SetValue(ra::data::models::AssetModelBase::ChangesProperty,
+                 m_mOriginalCodeNotes.empty() ?
+                     ra::etoi(ra::data::models::AssetChanges::None) :
+                     ra::etoi(ra::data::models::AssetChanges::Unpublished));
+
+        if (m_fCodeNotesReloaded != nullptr)
+            m_fCodeNotesReloaded();
+
+        // the cached notes are usable, so local changes don't have to wait for the server. MergeCodeNotes
+        // will keep any changes made before the server responds.
+        EndRefresh();
+
+        callback();
+
+        // the offline server would just return the same notes again
+        const auto& pServer = ra::services::ServiceLocator::Get<ra::api::IServer>();
+        if (dynamic_cast<const ra::api::impl::OfflineServer*>(&pServer) != nullptr)
+            return;
+    }
+
     ra::api::FetchCodeNotes::Request request;
     request.GameId = nGameId;
-    request.CallAsync([this, callback](const ra::api::FetchCodeNotes::Response& response)
+    request.CallAsync([this, pAsyncHandle = CreateAsyncHandle(), nRefreshId = m_nRefreshId, callback, bLoadedFromCache,
+                       nCachedHash](const ra::api::FetchCodeNotes::Response& response)
     {
-        if (response.Failed())
+        if (bLoadedFromCache)
         {
-            ra::ui::viewmodels::MessageBoxViewModel::ShowErrorMessage(L"Failed to download code notes",
-                ra::Widen(response.ErrorMessage));
+            // the cached notes are already in use. apply the changes on the UI thread so the notes aren't
+            // rebuilt while something else is looking at them.
+            ra::services::ServiceLocator::Get<ra::ui::IDesktop>().InvokeOnUIThread(
+                [this, pAsyncHandle, nRefreshId, nCachedHash, response]()
+            {
+                ra::data::AsyncKeepAlive pKeepAlive(*pAsyncHandle);
+                if (pAsyncHandle->IsDestroyed() || nRefreshId != m_nRefreshId)
+                    return;
+
+                if (response.Failed())
+                    RA_LOG_WARN("Failed to refresh code notes: %s", response.ErrorMessage);
+                else if (response.Hash != nCachedHash)
+                    MergeCodeNotes(BuildCodeNoteModels(response.Notes));
+            });
+            return;
         }
-        else
+
         {
-            for (const auto& pNote : response.Notes)
+            ra::data::AsyncKeepAlive pKeepAlive(*pAsyncHandle);
+
+            // if the model was destroyed or refreshed again (i.e. the game changed), the response is stale
+            if (!pAsyncHandle->IsDestroyed() && nRefreshId == m_nRefreshId)
             {
+                if (response.Failed())
                 {
-                    std::unique_lock<std::mutex> lock(m_oMutex);
-                    const auto pIter = m_mOriginalCodeNotes.find(pNote.Address);
-                    if (pIter != m_mOriginalCodeNotes.end())
-                    {
-                        pIter->second.first = pNote.Author;
-                        pIter->second.second = pNote.Note;
-                        continue;
-                    }
+                    ra::ui::viewmodels::MessageBoxViewModel::ShowErrorMessage(L"Failed to download code notes",
+                        ra::Widen(response.ErrorMessage));
                 }
+                else
+                {
+                    AddCodeNotes(BuildCodeNoteModels(response.Notes));
 
-                AddCodeNote(pNote.Address, pNote.Author, pNote.Note);
-            }
-        }
-
-        std::map<ra::ByteAddress, std::wstring> mPendingCodeNotes;
-        {
-            std::unique_lock<std::mutex> lock(m_oMutex);
-            mPendingCodeNotes.swap(m_mPendingCodeNotes);
-            m_bRefreshing = false;
-        }
+                    SetValue(ra::data::models::AssetModelBase::ChangesProperty,
+                             m_mOriginalCodeNotes.empty() ?
+                                 ra::etoi(ra::data::models::AssetChanges::None) :
+                                 ra::etoi(ra::data::models::AssetChanges::Unpublished));
 
-        for (const auto pNote : mPendingCodeNotes)
-            SetCodeNote(pNote.first, pNote.second);
+                    if (m_fCodeNotesReloaded != nullptr)
+                        m_fCodeNotesReloaded();
+                }
 
-        for (const auto& pNote : m_vCodeNotes)
-        {
-            if (pNote->IsPointer())
-            {
-                m_bHasPointers = true;
-                break;
+                EndRefresh();
             }
         }
 
+        // always notify the caller that the load has completed, even if the result was discarded
         callback();
     });
 }
 
+bool CodeNotesModel::LoadCachedCodeNotes(unsigned int nGameId, uint32_t& nHash)
+{
+    if (!ra::services::ServiceLocator::Exists<ra::services::ILocalStorage>())
+        return false;
+
+    auto& pLocalStorage = ra::services::ServiceLocator::GetMutable<ra::services::ILocalStorage>();
+    auto pData = pLocalStorage.ReadText(ra::services::StorageItemType::CodeNotes, std::to_wstring(nGameId));
+    if (pData == nullptr)
+        return false;
+
+    ra::api::FetchCodeNotes::Response response;
+    if (!ra::api::impl::CodeNotesCache::Read(*pData, response))
+        return false;
+
+    AddCodeNotes(BuildCodeNoteModels(response.Notes));
+    nHash = response.Hash;
+    return true;
+}
+
+void CodeNotesModel::EndRefresh()
+{
+    std::map<ra::ByteAddress, std::wstring> mPendingCodeNotes;
+    {
+        std::unique_lock<std::mutex> lock(m_oMutex);
+        mPendingCodeNotes.swap(m_mPendingCodeNotes);
+        m_bRefreshing = false;
+    }
+
+    for (const auto pNote : mPendingCodeNotes)
+        SetCodeNote(pNote.first, pNote.second);
+}
+
 GSL_SUPPRESS_R30 // left has to be a const ref to the unique_ptr because the function is used in lower_bound
 GSL_SUPPRESS_R32 // left has to be a const ref to the unique_ptr because the function is used in lower_bound
 static int CompareNoteAddresses(const std::unique_ptr<CodeNoteModel>& left,
@@ -119,9 +270,20 @@ void CodeNotesModel::AddCodeNote(ra::ByteAddress nAddress, const std::string& sA
         std::unique_lock<std::mutex> lock(m_oMutex);
         auto iter = std::lower_bound(m_vCodeNotes.begin(), m_vCodeNotes.end(), nAddress, CompareNoteAddresses);
         if (iter != m_vCodeNotes.end() && (*iter)->GetAddress() == note->GetAddress())
+        {
             iter->swap(note);
+
+            // note now points at the replaced note
+            if (bIsPointer || note->IsPointer())
+                m_bPointerSlotsDirty = true;
+        }
         else
+        {
             m_vCodeNotes.insert(iter, std::move(note));
+
+            if (bIsPointer)
+                m_bPointerSlotsDirty = true;
+        }
     }
 
     OnCodeNoteChanged(nAddress, sNote);
@@ -129,6 +291,176 @@ void CodeNotesModel::AddCodeNote(ra::ByteAddress nAddress, const std::string& sA
     // CodeNoteChanged events for indirect child notes will be raised by first call to DoFrame
 }
 
+static void SortCodeNotes(std::vector<std::unique_ptr<CodeNoteModel>>& vNotes)
+{
+    // server provides the notes in address order, so this is normally a single pass
+    const auto CompareNotes = [](const std::unique_ptr<CodeNoteModel>& left, const std::unique_ptr<CodeNoteModel>& right) noexcept {
+        return left->GetAddress() < right->GetAddress();
+    };
+    if (!std::is_sorted(vNotes.begin(), vNotes.end(), CompareNotes))
+        std::stable_sort(vNotes.begin(), vNotes.end(), CompareNotes);
+}
+
+void CodeNotesModel::AddCodeNotes(std::vector<std::unique_ptr<CodeNoteModel>>&& vNotes)
+{
+    SortCodeNotes(vNotes);
+
+    std::unique_lock<std::mutex> lock(m_oMutex);
+
+    std::vector<std::unique_ptr<CodeNoteModel>> vMerged;
+    vMerged.reserve(m_vCodeNotes.size() + vNotes.size());
+
+    auto pExisting = m_vCodeNotes.begin();
+    auto pOriginal = m_mOriginalCodeNotes.begin();
+    bool bHasPointers = false;
+
+    for (auto pIter = vNotes.begin(); pIter != vNotes.end(); ++pIter)
+    {
+        const auto nAddress = (*pIter)->GetAddress();
+
+        // if there are multiple notes for an address, keep the last one
+        const auto pNext = pIter + 1;
+        if (pNext != vNotes.end() && (*pNext)->GetAddress() == nAddress)
+            continue;
+
+        // if the note has been modified locally, just update the original value
+        while (pOriginal != m_mOriginalCodeNotes.end() && pOriginal->first < nAddress)
+            ++pOriginal;
+        if (pOriginal != m_mOriginalCodeNotes.end() && pOriginal->first == nAddress)
+        {
+            pOriginal->second.first = (*pIter)->GetAuthor();
+            pOriginal->second.second = (*pIter)->GetNote();
+            continue;
+        }
+
+        while (pExisting != m_vCodeNotes.end() && (*pExisting)->GetAddress() < nAddress)
+        {
+            bHasPointers |= (*pExisting)->IsPointer();
+            vMerged.push_back(std::move(*pExisting++));
+        }
+
+        // new note replaces existing note
+        if (pExisting != m_vCodeNotes.end() && (*pExisting)->GetAddress() == nAddress)
+            ++pExisting;
+
+        bHasPointers |= (*pIter)->IsPointer();
+        vMerged.push_back(std::move(*pIter));
+    }
+
+    for (; pExisting != m_vCodeNotes.end(); ++pExisting)
+    {
+        bHasPointers |= (*pExisting)->IsPointer();
+        vMerged.push_back(std::move(*pExisting));
+    }
+
+    m_vCodeNotes.swap(vMerged);
+    m_bHasPointers = bHasPointers;
+    m_bPointerSlotsDirty = true;
+}
+
+void CodeNotesModel::MergeCodeNotes(std::vector<std::unique_ptr<CodeNoteModel>>&& vNotes)
+{
+    SortCodeNotes(vNotes);
+
+    std::vector<std::pair<ra::ByteAddress, std::wstring>> vChangedNotes;
+    {
+        std::unique_lock<std::mutex> lock(m_oMutex);
+
+        std::vector<std::unique_ptr<CodeNoteModel>> vMerged;
+        vMerged.reserve(std::max(m_vCodeNotes.size(), vNotes.size()));
+
+        auto pExisting = m_vCodeNotes.begin();
+        auto pOriginal = m_mOriginalCodeNotes.begin();
+        bool bHasPointers = false;
+        bool bPointersChanged = false;
+
+        // returns true if the note has been modified locally, in which case the server value is
+        // captured as the original value and the local value is kept.
+        const auto IsModified = [this, &pOriginal](ra::ByteAddress nAddress, const CodeNoteModel* pServerNote) {
+            while (pOriginal != m_mOriginalCodeNotes.end() && pOriginal->first < nAddress)
+                ++pOriginal;
+            if (pOriginal == m_mOriginalCodeNotes.end() || pOriginal->first != nAddress)
+                return false;
+
+            pOriginal->second.first = pServerNote ? pServerNote->GetAuthor() : std::string();
+            pOriginal->second.second = pServerNote ? pServerNote->GetNote() : std::wstring();
+            return true;
+        };
+
+        // notes that are no longer on the server are removed
+        const auto KeepOrRemoveExisting = [&]() {
+            auto& pNote = *pExisting++;
+            if (IsModified(pNote->GetAddress(), nullptr))
+            {
+                bHasPointers |= pNote->IsPointer();
+                vMerged.push_back(std::move(pNote));
+            }
+            else
+            {
+                bPointersChanged |= pNote->IsPointer();
+                vChangedNotes.emplace_back(pNote->GetAddress(), std::wstring());
+            }
+        };
+
+        for (auto pIter = vNotes.begin(); pIter != vNotes.end(); ++pIter)
+        {
+            const auto nAddress = (*pIter)->GetAddress();
+
+            // if there are multiple notes for an address, keep the last one
+            const auto pNext = pIter + 1;
+            if (pNext != vNotes.end() && (*pNext)->GetAddress() == nAddress)
+                continue;
+
+            while (pExisting != m_vCodeNotes.end() && (*pExisting)->GetAddress() < nAddress)
+                KeepOrRemoveExisting();
+
+            const bool bExists = (pExisting != m_vCodeNotes.end() && (*pExisting)->GetAddress() == nAddress);
+            if (IsModified(nAddress, pIter->get()))
+            {
+                if (bExists)
+                {
+                    bHasPointers |= (*pExisting)->IsPointer();
+                    vMerged.push_back(std::move(*pExisting++));
+                }
+                continue;
+            }
+
+            if (bExists)
+            {
+                auto& pNote = *pExisting++;
+                if (pNote->GetNote() == (*pIter)->GetNote())
+                {
+                    // unchanged. keep the existing note so any pointer state is preserved
+                    if (pNote->GetAuthor() != (*pIter)->GetAuthor())
+                        pNote->SetAuthor((*pIter)->GetAuthor());
+
+                    bHasPointers |= pNote->IsPointer();
+                    vMerged.push_back(std::move(pNote));
+                    continue;
+                }
+
+                bPointersChanged |= pNote->IsPointer();
+            }
+
+            bPointersChanged |= (*pIter)->IsPointer();
+            bHasPointers |= (*pIter)->IsPointer();
+            vChangedNotes.emplace_back(nAddress, (*pIter)->GetNote());
+            vMerged.push_back(std::move(*pIter));
+        }
+
+        while (pExisting != m_vCodeNotes.end())
+            KeepOrRemoveExisting();
+
+        m_vCodeNotes.swap(vMerged);
+        m_bHasPointers = bHasPointers;
+        if (bPointersChanged)
+            m_bPointerSlotsDirty = true;
+    }
+
+    for (const auto& pChange : vChangedNotes)
+        OnCodeNoteChanged(pChange.first, pChange.second);
+}
+
 void CodeNotesModel::OnCodeNoteChanged(ra::ByteAddress nAddress, const std::wstring& sNewNote)
 {
     SetValue(ra::data::models::AssetModelBase::ChangesProperty,
@@ -342,6 +674,9 @@ void CodeNotesModel::SetCodeNote(ra::ByteAddress nAddress, const std::wstring& s
             {
                 // note didn't originally exist, don't keep a modification record if the
                 // changes were discarded.
+                if ((*pIter)->IsPointer())
+                    m_bPointerSlotsDirty = true;
+
                 m_vCodeNotes.erase(pIter);
                 OnCodeNoteChanged(nAddress, sNote);
                 return;
@@ -493,39 +828,77 @@ void CodeNotesModel::EnumerateCodeNotes(std::function<bool(ra::ByteAddress nAddr
     }
 }
 
+void CodeNotesModel::BuildPointerSlots()
+{
+    std::unique_lock<std::mutex> lock(m_oMutex);
+
+    m_vPointerSlots.clear();
+    for (auto& pNote : m_vCodeNotes)
+    {
+        if (pNote->IsPointer())
+            AddPointerSlots(*pNote, pNote->GetAddress(), NO_PARENT, 0);
+    }
+
+    m_bPointerSlotsDirty = false;
+}
+
+void CodeNotesModel::AddPointerSlots(CodeNoteModel& pNote, ra::ByteAddress nAddress, size_t nParentIndex, ra::ByteAddress nParentAddress)
+{
+    const auto nIndex = m_vPointerSlots.size();
+    auto& pSlot = m_vPointerSlots.emplace_back();
+    pSlot.pNote = &pNote;
+    pSlot.nAddress = nAddress;
+    pSlot.nSize = pNote.GetMemSize();
+    pSlot.nParentIndex = nParentIndex;
+    pSlot.nParentAddress = nParentAddress;
+
+    const auto nPointerAddress = pNote.GetPointerAddress();
+    pNote.EnumerateNestedPointerNotes([this, nIndex, nPointerAddress](CodeNoteModel& pNestedNote) {
+        AddPointerSlots(pNestedNote, nPointerAddress + pNestedNote.GetAddress(), nIndex, nPointerAddress);
+    });
+}
+
 void CodeNotesModel::DoFrame()
 {
     if (!m_bHasPointers)
         return;
 
+    if (m_bPointerSlotsDirty)
+        BuildPointerSlots();
+
     const auto& pEmulatorContext = ra::services::ServiceLocator::Get<ra::data::context::EmulatorContext>();
 
-    for (auto& pCodeNote : m_vCodeNotes)
+    CodeNoteModel::NoteMovedFunction fNoteMoved, fNoteFirstRead;
+    if (m_fCodeNoteChanged)
+    {
+        fNoteMoved = [this](ra::ByteAddress nOldAddress, ra::ByteAddress nNewAddress, const CodeNoteModel& pOffsetNote) {
+            const auto* pNote = FindCodeNoteModel(nOldAddress, false);
+            m_fCodeNoteChanged(nOldAddress, pNote ? pNote->GetNote() : L"");
+            m_fCodeNoteChanged(nNewAddress, pOffsetNote.GetNote());
+        };
+
+        // pointer hasn't been read before, only raise event for new address
+        fNoteFirstRead = [this](ra::ByteAddress, ra::ByteAddress nNewAddress, const CodeNoteModel& pOffsetNote) {
+            m_fCodeNoteChanged(nNewAddress, pOffsetNote.GetNote());
+        };
+    }
+
+    for (auto& pSlot : m_vPointerSlots)
     {
-        if (pCodeNote->IsPointer())
+        if (pSlot.nParentIndex != NO_PARENT)
         {
-            if (!m_fCodeNoteChanged)
-            {
-                pCodeNote->UpdateRawPointerValue(pCodeNote->GetAddress(), pEmulatorContext, nullptr);
-            }
-            else if (pCodeNote->HasRawPointerValue())
-            {
-                pCodeNote->UpdateRawPointerValue(pCodeNote->GetAddress(), pEmulatorContext,
-                    [this](ra::ByteAddress nOldAddress, ra::ByteAddress nNewAddress, const CodeNoteModel& pOffsetNote) {
-                        const auto* pNote = FindCodeNoteModel(nOldAddress, false);
-                        m_fCodeNoteChanged(nOldAddress, pNote ? pNote->GetNote() : L"");
-                        m_fCodeNoteChanged(nNewAddress, pOffsetNote.GetNote());
-                    });
-            }
-            else
+            // parents are processed before their children. only recalculate the address of
+            // the nested pointer if the parent pointer changed.
+            const auto nParentAddress = m_vPointerSlots.at(pSlot.nParentIndex).pNote->GetPointerAddress();
+            if (nParentAddress != pSlot.nParentAddress)
             {
-                // pointer hasn't been read before, only raise event for new address
-                pCodeNote->UpdateRawPointerValue(pCodeNote->GetAddress(), pEmulatorContext,
-                    [this](ra::ByteAddress, ra::ByteAddress nNewAddress, const CodeNoteModel& pOffsetNote) {
-                        m_fCodeNoteChanged(nNewAddress, pOffsetNote.GetNote());
-                    });
+                pSlot.nParentAddress = nParentAddress;
+                pSlot.nAddress = nParentAddress + pSlot.pNote->GetAddress();
             }
         }
+
+        const auto nValue = pEmulatorContext.ReadMemory(pSlot.nAddress, pSlot.nSize);
+        pSlot.pNote->SetRawPointerValue(nValue, pSlot.pNote->HasRawPointerValue() ? fNoteMoved : fNoteFirstRead);
     }
 }
 
@@ -543,7 +916,12 @@ void CodeNotesModel::SetServerCodeNote(ra::ByteAddress nAddress, const std::wstr
     if (pIter2 != m_vCodeNotes.end() && (*pIter2)->GetAddress() == nAddress && (*pIter2)->GetNote() == sNote)
     {
         if (sNote.empty())
+        {
+            if ((*pIter2)->IsPointer())
+                m_bPointerSlotsDirty = true;
+
             m_vCodeNotes.erase(pIter2);
+        }
 
         if (m_mOriginalCodeNotes.empty())
             SetValue(ra::data::models::AssetModelBase::ChangesProperty, ra::etoi(ra::data::models::AssetChanges::None));
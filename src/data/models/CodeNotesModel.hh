@@ -6,17 +6,22 @@
 
 #include "CodeNoteModel.hh"
 
+#include "data\AsyncObject.hh"
+
 #include "data/Types.hh"
 
 namespace ra {
 namespace data {
 namespace models {
 
-class CodeNotesModel : public AssetModelBase
+class CodeNotesModel : public AssetModelBase, protected ra::data::AsyncObject
 {
 public:
 	CodeNotesModel() noexcept;
-	~CodeNotesModel() = default;
+	~CodeNotesModel()
+	{
+		ra::data::AsyncObject::BeginDestruction();
+	}
 	CodeNotesModel(const CodeNotesModel&) noexcept = delete;
 	CodeNotesModel& operator=(const CodeNotesModel&) noexcept = delete;
 	CodeNotesModel(CodeNotesModel&&) noexcept = delete;
@@ -25,14 +30,25 @@ public:
     bool IsShownInList() const noexcept override { return false; }
 
     typedef std::function<void(ra::ByteAddress nAddress, const std::wstring& sNewNote)> CodeNoteChangedFunction;
+    typedef std::function<void()> CodeNotesReloadedFunction;
 
     /// <summary>
     /// Repopulates with code notes from the server.
     /// </summary>
     /// <param name="nGameId">Unique identifier of the game to load code notes for.</param>
     /// <param name="fCodeNoteChanged">Callback to call when a code note is changed.</param>
+    /// <param name="fCodeNotesReloaded">
+    /// Callback to call once after the notes from the server have been loaded. <paramref name="fCodeNoteChanged" />
+    /// is not called for the individual notes in the server response.
+    /// </param>
     /// <param name="callback">Callback to call when the loading completes.</param>
-    void Refresh(unsigned int nGameId, CodeNoteChangedFunction fCodeNoteChanged, std::function<void()> callback);
+    /// <remarks>
+    /// If the notes are available in the local cache, they are loaded (and <paramref name="callback" /> is called)
+    /// before this returns. The server is still queried, but only notes that differ from the cached copy are
+    /// updated, and <paramref name="fCodeNoteChanged" /> is called for each of them.
+    /// </remarks>
+    void Refresh(unsigned int nGameId, CodeNoteChangedFunction fCodeNoteChanged,
+                 CodeNotesReloadedFunction fCodeNotesReloaded, std::function<void()> callback);
 
     /// <summary>
     /// Returns the note associated with the specified address.
@@ -201,6 +217,27 @@ public:
 
 protected:
     void AddCodeNote(ra::ByteAddress nAddress, const std::string& sAuthor, const std::wstring& sNote);
+
+    /// <summary>
+    /// Merges a batch of notes into the collection. Notes that have local modifications update the
+    /// original (server) value of the modified note instead.
+    /// </summary>
+    /// <remarks>
+    /// Does not raise any change events. Notes at the same address as an existing note replace the
+    /// existing note. If multiple notes in the batch have the same address, the last one is kept.
+    /// </remarks>
+    void AddCodeNotes(std::vector<std::unique_ptr<CodeNoteModel>>&& vNotes);
+
+    /// <summary>
+    /// Replaces the collection with a new set of notes from the server, raising change events only for
+    /// notes that were added, changed, or removed.
+    /// </summary>
+    /// <remarks>
+    /// Unchanged notes are kept as-is. Notes that have local modifications update the original (server)
+    /// value of the modified note instead.
+    /// </remarks>
+    void MergeCodeNotes(std::vector<std::unique_ptr<CodeNoteModel>>&& vNotes);
+
     void OnCodeNoteChanged(ra::ByteAddress nAddress, const std::wstring& sNewNote);
 
     std::vector<std::unique_ptr<CodeNoteModel>> m_vCodeNotes;
@@ -212,11 +249,34 @@ protected:
 
     unsigned int m_nGameId = 0;
     bool m_bHasPointers = false;
+    bool m_bPointerSlotsDirty = true;
     bool m_bRefreshing = false;
+    unsigned int m_nRefreshId = 0; // identifies the most recent call to Refresh so stale responses can be ignored
 
     CodeNoteChangedFunction m_fCodeNoteChanged;
+    CodeNotesReloadedFunction m_fCodeNotesReloaded;
 
 private:
+    static constexpr size_t NO_PARENT = ~size_t{ 0 };
+
+    // a pointer value that has to be read each frame. nested pointers are stored after their
+    // parent, so reading the slots in order always reads a parent before its children.
+    struct PointerSlot
+    {
+        CodeNoteModel* pNote = nullptr;
+        ra::ByteAddress nAddress = 0;              // address the pointer value is read from
+        MemSize nSize = MemSize::Unknown;          // size of the pointer value
+        size_t nParentIndex = NO_PARENT;           // index of the slot for the containing pointer
+        ra::ByteAddress nParentAddress = 0;        // address the parent pointed at when nAddress was calculated
+    };
+    std::vector<PointerSlot> m_vPointerSlots;
+
+    bool LoadCachedCodeNotes(unsigned int nGameId, uint32_t& nHash);
+    void EndRefresh();
+
+    void BuildPointerSlots();
+    void AddPointerSlots(CodeNoteModel& pNote, ra::ByteAddress nAddress, size_t nParentIndex, ra::ByteAddress nParentAddress);
+
     static std::wstring BuildCodeNoteSized(ra::ByteAddress nAddress, unsigned nCheckBytes, ra::ByteAddress nNoteAddress, const CodeNoteModel& pNote);
 
     mutable std::mutex m_oMutex;
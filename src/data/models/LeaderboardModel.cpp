@@ -200,10 +200,10 @@ void LeaderboardModel::HandleStateChanged(AssetState nOldState, AssetState nNewS
         const auto* pLeaderboard = m_pLeaderboard->lboard;
         if (pLeaderboard != nullptr)
         {
-            m_pCapturedStartTriggerHits.Capture(&pLeaderboard->start, GetStartTrigger());
-            m_pCapturedSubmitTriggerHits.Capture(&pLeaderboard->submit, GetSubmitTrigger());
-            m_pCapturedCancelTriggerHits.Capture(&pLeaderboard->cancel, GetCancelTrigger());
-            m_pCapturedValueDefinitionHits.Capture(&pLeaderboard->value, GetValueDefinition());
+            m_pCapturedStartTriggerHits.Capture(&pLeaderboard->start, GetAssetDefinitionFingerprint(m_pStartTrigger));
+            m_pCapturedSubmitTriggerHits.Capture(&pLeaderboard->submit, GetAssetDefinitionFingerprint(m_pSubmitTrigger));
+            m_pCapturedCancelTriggerHits.Capture(&pLeaderboard->cancel, GetAssetDefinitionFingerprint(m_pCancelTrigger));
+            m_pCapturedValueDefinitionHits.Capture(&pLeaderboard->value, GetAssetDefinitionFingerprint(m_pValueDefinition));
 
             if (pLeaderboard->state == RC_LBOARD_STATE_STARTED)
             {
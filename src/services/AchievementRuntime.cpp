@@ -925,6 +925,8 @@ public:
 
 void AchievementRuntime::SyncAssets()
 {
+    InvalidateProgressSnapshot();
+
     if (m_pClientSynchronizer == nullptr)
         m_pClientSynchronizer.reset(new ClientSynchronizer());
     m_pClientSynchronizer->SyncAssets(GetClient());
@@ -932,12 +934,16 @@ void AchievementRuntime::SyncAssets()
 
 void AchievementRuntime::AttachMemory(void* pMemory)
 {
+    InvalidateProgressSnapshot();
+
     if (m_pClientSynchronizer != nullptr)
         m_pClientSynchronizer->AttachMemory(pMemory);
 }
 
 bool AchievementRuntime::DetachMemory(void* pMemory) noexcept
 {
+    InvalidateProgressSnapshot();
+
     if (m_pClientSynchronizer != nullptr)
         return m_pClientSynchronizer->DetachMemory(pMemory);
 
@@ -1015,6 +1021,8 @@ void AchievementRuntime::RaiseClientEvent(rc_client_achievement_info_t& pAchieve
 
 void AchievementRuntime::UpdateActiveAchievements() noexcept
 {
+    InvalidateProgressSnapshot();
+
     auto* client = GetClient();
     if (client->game)
     {
@@ -1027,6 +1035,8 @@ void AchievementRuntime::UpdateActiveAchievements() noexcept
 
 void AchievementRuntime::UpdateActiveLeaderboards() noexcept
 {
+    InvalidateProgressSnapshot();
+
     auto* client = GetClient();
     if (client->game)
     {
@@ -1066,6 +1076,8 @@ rc_lboard_t* AchievementRuntime::GetLeaderboardDefinition(ra::LeaderboardID nId)
 
 void AchievementRuntime::ReleaseLeaderboardTracker(ra::LeaderboardID nId) noexcept
 {
+    InvalidateProgressSnapshot();
+
     auto* pClient = GetClient();
     rc_client_leaderboard_info_t* leaderboard = GetLeaderboardInfo(pClient, nId);
     if (leaderboard)
@@ -1102,14 +1114,34 @@ std::wstring AchievementRuntime::GetRichPresenceDisplayString() const
             m_nRichPresenceErrorLine, rc_error_str(m_nRichPresenceParseResult));
     }
 
-    if (!HasRichPresence())
-        return L"No Rich Presence defined.";
+    const void* pGame = GetClient()->game;
+    const uint32_t nFrameCount = m_nFrameCount;
+    const uint32_t nStateVersion = m_nRichPresenceStateVersion;
 
-    char sRichPresence[256];
-    if (rc_client_get_rich_presence_message(GetClient(), sRichPresence, sizeof(sRichPresence)) > 0)
-        return ra::Widen(sRichPresence);
+    std::lock_guard<std::mutex> lock(m_pRichPresenceCache.m_oMutex);
+    if (!m_pRichPresenceCache.m_bValid || m_pRichPresenceCache.m_nFrameCount != nFrameCount ||
+        m_pRichPresenceCache.m_nStateVersion != nStateVersion || m_pRichPresenceCache.m_pGame != pGame)
+    {
+        if (!HasRichPresence())
+        {
+            m_pRichPresenceCache.m_sDisplayString = L"No Rich Presence defined.";
+        }
+        else
+        {
+            char sRichPresence[256];
+            if (rc_client_get_rich_presence_message(GetClient(), sRichPresence, sizeof(sRichPresence)) > 0)
+                m_pRichPresenceCache.m_sDisplayString = ra::Widen(sRichPresence);
+            else
+                m_pRichPresenceCache.m_sDisplayString.clear();
+        }
+
+        m_pRichPresenceCache.m_pGame = pGame;
+        m_pRichPresenceCache.m_nFrameCount = nFrameCount;
+        m_pRichPresenceCache.m_nStateVersion = nStateVersion;
+        m_pRichPresenceCache.m_bValid = true;
+    }
 
-    return L"";
+    return m_pRichPresenceCache.m_sDisplayString;
 }
 
 bool AchievementRuntime::ActivateRichPresence(const std::string& sScript)
@@ -1140,6 +1172,9 @@ bool AchievementRuntime::ActivateRichPresence(const std::string& sScript)
 
     rc_mutex_unlock(&GetClient()->state.mutex);
 
+    InvalidateRichPresenceDisplayString();
+    InvalidateProgressSnapshot();
+
     return (m_nRichPresenceParseResult == RC_OK);
 }
 
@@ -1449,8 +1484,12 @@ void AchievementRuntime::ChangeMediaCallback(int nResult, const char* sErrorMess
 
 void AchievementRuntime::UnloadGame() noexcept
 {
+    InvalidateProgressSnapshot();
+
     rc_client_unload_game(GetClient());
     m_pClientSynchronizer.reset();
+    m_mPendingTrackerUpdates.clear();
+    m_mTrackerDisplayText.clear();
     s_mAchievementPopups.clear();
 }
 
@@ -1532,7 +1571,7 @@ static void RaisePauseOnChangeEvents(std::vector<rc_client_achievement_info_t*>&
         if (pAchievement != nullptr && pAchievement->trigger && !pAchievement->trigger->has_hits)
         {
             auto& pFrameEventQueue = ra::services::ServiceLocator::GetMutable<ra::services::FrameEventQueue>();
-            pFrameEventQueue.QueuePauseOnReset(ra::Widen(pAchievement->public_.title));
+            pFrameEventQueue.QueuePauseOnReset(pAchievement->public_.id);
         }
     }
 }
@@ -1565,25 +1604,29 @@ static void RaisePauseOnChangeEvents(
                 if ((nPauseOnReset & ra::data::models::LeaderboardModel::LeaderboardParts::Start) !=
                     ra::data::models::LeaderboardModel::LeaderboardParts::None)
                 {
-                    pFrameEventQueue.QueuePauseOnReset(ra::StringPrintf(L"Start: %s", pair.first->public_.title));
+                    pFrameEventQueue.QueuePauseOnReset(pair.first->public_.id,
+                        ra::data::models::LeaderboardModel::LeaderboardParts::Start);
                 }
 
                 if ((nPauseOnReset & ra::data::models::LeaderboardModel::LeaderboardParts::Cancel) !=
                     ra::data::models::LeaderboardModel::LeaderboardParts::None)
                 {
-                    pFrameEventQueue.QueuePauseOnReset(ra::StringPrintf(L"Cancel: %s", pair.first->public_.title));
+                    pFrameEventQueue.QueuePauseOnReset(pair.first->public_.id,
+                        ra::data::models::LeaderboardModel::LeaderboardParts::Cancel);
                 }
 
                 if ((nPauseOnReset & ra::data::models::LeaderboardModel::LeaderboardParts::Submit) !=
                     ra::data::models::LeaderboardModel::LeaderboardParts::None)
                 {
-                    pFrameEventQueue.QueuePauseOnReset(ra::StringPrintf(L"Submit: %s", pair.first->public_.title));
+                    pFrameEventQueue.QueuePauseOnReset(pair.first->public_.id,
+                        ra::data::models::LeaderboardModel::LeaderboardParts::Submit);
                 }
 
                 if ((nPauseOnReset & ra::data::models::LeaderboardModel::LeaderboardParts::Value) !=
                     ra::data::models::LeaderboardModel::LeaderboardParts::None)
                 {
-                    pFrameEventQueue.QueuePauseOnReset(ra::StringPrintf(L"Value: %s", pair.first->public_.title));
+                    pFrameEventQueue.QueuePauseOnReset(pair.first->public_.id,
+                        ra::data::models::LeaderboardModel::LeaderboardParts::Value);
                 }
             }
         }
@@ -1611,19 +1654,22 @@ static void RaisePauseOnChangeEvents(
                 if ((nPauseOnTrigger & ra::data::models::LeaderboardModel::LeaderboardParts::Start) !=
                     ra::data::models::LeaderboardModel::LeaderboardParts::None)
                 {
-                    pFrameEventQueue.QueuePauseOnTrigger(ra::StringPrintf(L"Start: %s", pair.first->public_.title));
+                    pFrameEventQueue.QueuePauseOnTrigger(pair.first->public_.id,
+                        ra::data::models::LeaderboardModel::LeaderboardParts::Start);
                 }
 
                 if ((nPauseOnTrigger & ra::data::models::LeaderboardModel::LeaderboardParts::Cancel) !=
                     ra::data::models::LeaderboardModel::LeaderboardParts::None)
                 {
-                    pFrameEventQueue.QueuePauseOnTrigger(ra::StringPrintf(L"Cancel: %s", pair.first->public_.title));
+                    pFrameEventQueue.QueuePauseOnTrigger(pair.first->public_.id,
+                        ra::data::models::LeaderboardModel::LeaderboardParts::Cancel);
                 }
 
                 if ((nPauseOnTrigger & ra::data::models::LeaderboardModel::LeaderboardParts::Submit) !=
                     ra::data::models::LeaderboardModel::LeaderboardParts::None)
                 {
-                    pFrameEventQueue.QueuePauseOnTrigger(ra::StringPrintf(L"Submit: %s", pair.first->public_.title));
+                    pFrameEventQueue.QueuePauseOnTrigger(pair.first->public_.id,
+                        ra::data::models::LeaderboardModel::LeaderboardParts::Submit);
                 }
             }
         }
@@ -1637,6 +1683,7 @@ void AchievementRuntime::DoFrame()
     if (m_bPaused)
     {
         rc_client_idle(GetClient());
+        InvalidateProgressSnapshot();
         return;
     }
 
@@ -1646,12 +1693,17 @@ void AchievementRuntime::DoFrame()
 
     PrepareForPauseOnChangeEvents(GetClient(), vAchievementsWithHits, mLeaderboardsWithHits, mActiveLeaderboards);
 
+    m_bProcessingFrame = true;
     rc_client_do_frame(GetClient());
+    m_bProcessingFrame = false;
+    ++m_nFrameCount;
 
     if (!vAchievementsWithHits.empty())
         RaisePauseOnChangeEvents(vAchievementsWithHits);
     if (!mLeaderboardsWithHits.empty() || !mActiveLeaderboards.empty())
         RaisePauseOnChangeEvents(mLeaderboardsWithHits, mActiveLeaderboards);
+
+    FlushTrackerUpdates();
 }
 
 void AchievementRuntime::Idle() const noexcept
@@ -1715,7 +1767,7 @@ static void HandleAchievementTriggeredEvent(const rc_client_achievement_t& pAchi
     if (vmAchievement->IsPauseOnTrigger())
     {
         auto& pFrameEventQueue = ra::services::ServiceLocator::GetMutable<ra::services::FrameEventQueue>();
-        pFrameEventQueue.QueuePauseOnTrigger(vmAchievement->GetName());
+        pFrameEventQueue.QueuePauseOnTrigger(vmAchievement->GetID());
     }
 
     const auto& pConfiguration = ra::services::ServiceLocator::Get<ra::services::IConfiguration>();
@@ -2116,31 +2168,70 @@ static void HandleLeaderboardSubmittedEvent(const rc_client_leaderboard_t& pLead
     // no popup shown here, the scoreboard will be shown instead
 }
 
-static void HandleLeaderboardTrackerUpdateEvent(const rc_client_leaderboard_tracker_t& pTracker)
+void AchievementRuntime::UpdateTrackerDisplayText(uint32_t nTrackerId, const char* sDisplay)
 {
+    if (m_bProcessingFrame && IsOnDoFrameThread())
+    {
+        // several leaderboards can share a tracker. only display the last value from the frame.
+        m_mPendingTrackerUpdates[nTrackerId] = sDisplay;
+        return;
+    }
+
     auto& pOverlayManager = ra::services::ServiceLocator::GetMutable<ra::ui::viewmodels::OverlayManager>();
-    auto* pScoreTracker = pOverlayManager.GetScoreTracker(pTracker.id);
-    if (pScoreTracker)
-        pScoreTracker->SetDisplayText(ra::Widen(pTracker.display));
+    auto* pScoreTracker = pOverlayManager.GetScoreTracker(nTrackerId);
+    if (!pScoreTracker)
+        return;
+
+    // don't convert and push the text if the popup is already displaying it
+    auto& pDisplayText = m_mTrackerDisplayText[nTrackerId];
+    if (pDisplayText.pPopup == pScoreTracker && pDisplayText.sDisplay == sDisplay)
+        return;
+
+    pDisplayText.pPopup = pScoreTracker;
+    pDisplayText.sDisplay = sDisplay;
+    pScoreTracker->SetDisplayText(ra::Widen(sDisplay));
 }
 
-static void HandleLeaderboardTrackerShowEvent(const rc_client_leaderboard_tracker_t& pTracker)
+void AchievementRuntime::ShowTracker(uint32_t nTrackerId, const char* sDisplay)
 {
+    // the show event has the current value. discard anything queued earlier in the frame
+    m_mPendingTrackerUpdates.erase(nTrackerId);
+    m_mTrackerDisplayText.erase(nTrackerId);
+
     const auto& pConfiguration = ra::services::ServiceLocator::Get<ra::services::IConfiguration>();
     if (pConfiguration.GetPopupLocation(ra::ui::viewmodels::Popup::LeaderboardTracker) !=
         ra::ui::viewmodels::PopupLocation::None &&
         pConfiguration.IsFeatureEnabled(ra::services::Feature::Leaderboards))
     {
         auto& pOverlayManager = ra::services::ServiceLocator::GetMutable<ra::ui::viewmodels::OverlayManager>();
-        auto& pScoreTracker = pOverlayManager.AddScoreTracker(pTracker.id);
-        pScoreTracker.SetDisplayText(ra::Widen(pTracker.display));
+        auto& pScoreTracker = pOverlayManager.AddScoreTracker(nTrackerId);
+        pScoreTracker.SetDisplayText(ra::Widen(sDisplay));
+
+        auto& pDisplayText = m_mTrackerDisplayText[nTrackerId];
+        pDisplayText.pPopup = &pScoreTracker;
+        pDisplayText.sDisplay = sDisplay;
     }
 }
 
-static void HandleLeaderboardTrackerHideEvent(const rc_client_leaderboard_tracker_t& pTracker)
+void AchievementRuntime::HideTracker(uint32_t nTrackerId)
 {
+    m_mPendingTrackerUpdates.erase(nTrackerId);
+    m_mTrackerDisplayText.erase(nTrackerId);
+
     auto& pOverlayManager = ra::services::ServiceLocator::GetMutable<ra::ui::viewmodels::OverlayManager>();
-    pOverlayManager.RemoveScoreTracker(pTracker.id);
+    pOverlayManager.RemoveScoreTracker(nTrackerId);
+}
+
+void AchievementRuntime::FlushTrackerUpdates()
+{
+    if (m_mPendingTrackerUpdates.empty())
+        return;
+
+    std::map<uint32_t, std::string> mPendingTrackerUpdates;
+    mPendingTrackerUpdates.swap(m_mPendingTrackerUpdates);
+
+    for (const auto& pUpdate : mPendingTrackerUpdates)
+        UpdateTrackerDisplayText(pUpdate.first, pUpdate.second.c_str());
 }
 
 static void HandleLeaderboardScoreboardEvent(const rc_client_leaderboard_scoreboard_t& pScoreboard,
@@ -2292,15 +2383,18 @@ void AchievementRuntime::EventHandler(const rc_client_event_t* pEvent, rc_client
     switch (pEvent->type)
     {
         case RC_CLIENT_EVENT_LEADERBOARD_TRACKER_UPDATE:
-            HandleLeaderboardTrackerUpdateEvent(*pEvent->leaderboard_tracker);
+            ra::services::ServiceLocator::GetMutable<AchievementRuntime>().UpdateTrackerDisplayText(
+                pEvent->leaderboard_tracker->id, pEvent->leaderboard_tracker->display);
             break;
 
         case RC_CLIENT_EVENT_LEADERBOARD_TRACKER_SHOW:
-            HandleLeaderboardTrackerShowEvent(*pEvent->leaderboard_tracker);
+            ra::services::ServiceLocator::GetMutable<AchievementRuntime>().ShowTracker(
+                pEvent->leaderboard_tracker->id, pEvent->leaderboard_tracker->display);
             break;
 
         case RC_CLIENT_EVENT_LEADERBOARD_TRACKER_HIDE:
-            HandleLeaderboardTrackerHideEvent(*pEvent->leaderboard_tracker);
+            ra::services::ServiceLocator::GetMutable<AchievementRuntime>().HideTracker(
+                pEvent->leaderboard_tracker->id);
             break;
 
         case RC_CLIENT_EVENT_ACHIEVEMENT_CHALLENGE_INDICATOR_SHOW:
@@ -2366,6 +2460,8 @@ void AchievementRuntime::EventHandler(const rc_client_event_t* pEvent, rc_client
 void AchievementRuntime::ResetRuntime() noexcept
 {
     rc_client_reset(GetClient());
+    InvalidateRichPresenceDisplayString();
+    InvalidateProgressSnapshot();
 }
 
 static void ProcessStateString(Tokenizer& pTokenizer, unsigned int nId, rc_trigger_t* pTrigger,
@@ -2693,6 +2789,9 @@ static bool LoadProgressV2(rc_client_t* pClient, ra::services::TextReader& pFile
 
 bool AchievementRuntime::LoadProgressFromFile(const char* sLoadStateFilename)
 {
+    InvalidateRichPresenceDisplayString();
+    InvalidateProgressSnapshot();
+
     if (sLoadStateFilename == nullptr)
     {
         rc_client_deserialize_progress(GetClient(), nullptr);
@@ -2702,6 +2801,27 @@ bool AchievementRuntime::LoadProgressFromFile(const char* sLoadStateFilename)
     std::string sContents;
 
     std::wstring sAchievementStateFile = ra::Widen(sLoadStateFilename) + L".rap";
+
+    // if the file hasn't been written yet, use the data that's waiting to be written
+    std::shared_ptr<const std::string> pPendingData;
+    {
+        std::lock_guard<std::mutex> lock(m_pProgressWriteQueue->m_oMutex);
+        const auto pIter = m_pProgressWriteQueue->m_mPendingWrites.find(sAchievementStateFile);
+        if (pIter != m_pProgressWriteQueue->m_mPendingWrites.end())
+            pPendingData = pIter->second.pData;
+    }
+
+    if (pPendingData != nullptr)
+    {
+        GSL_SUPPRESS_TYPE1 const auto* pData = reinterpret_cast<const uint8_t*>(pPendingData->data());
+        if (rc_client_deserialize_progress(GetClient(), pData) == RC_OK)
+        {
+            RA_LOG_INFO("Runtime state loaded from %s (pending write)", sLoadStateFilename);
+        }
+
+        return true;
+    }
+
     const auto& pFileSystem = ra::services::ServiceLocator::Get<ra::services::IFileSystem>();
     auto pFile = pFileSystem.OpenTextFile(sAchievementStateFile);
     if (pFile == nullptr || !pFile->GetLine(sContents))
@@ -2743,6 +2863,9 @@ bool AchievementRuntime::LoadProgressFromFile(const char* sLoadStateFilename)
 
 bool AchievementRuntime::LoadProgressFromBuffer(const uint8_t* pBuffer)
 {
+    InvalidateRichPresenceDisplayString();
+    InvalidateProgressSnapshot();
+
     if (rc_client_deserialize_progress(GetClient(), pBuffer) == RC_OK)
     {
         RA_LOG_INFO("Runtime state loaded from buffer");
@@ -2751,40 +2874,182 @@ bool AchievementRuntime::LoadProgressFromBuffer(const uint8_t* pBuffer)
     return true;
 }
 
+std::shared_ptr<const std::string> AchievementRuntime::SerializeProgress(size_t nSize) const
+{
+    auto pSerialized = std::make_shared<std::string>();
+    pSerialized->resize(nSize);
+    GSL_SUPPRESS_TYPE1 const auto pData = reinterpret_cast<uint8_t*>(pSerialized->data());
+    rc_client_serialize_progress(GetClient(), pData);
+    return pSerialized;
+}
+
+std::shared_ptr<const std::string> AchievementRuntime::GetProgressSnapshot() const noexcept
+{
+    // the snapshot is only valid if nothing could have changed since it was captured
+    if (m_pProgressSnapshot.m_pData == nullptr || m_pProgressSnapshot.m_nFrameCount != m_nFrameCount ||
+        m_pProgressSnapshot.m_nStateVersion != m_nProgressStateVersion ||
+        m_pProgressSnapshot.m_pGame != GetClient()->game)
+    {
+        return nullptr;
+    }
+
+    return m_pProgressSnapshot.m_pData;
+}
+
+void AchievementRuntime::SetProgressSnapshot(std::shared_ptr<const std::string> pData) const noexcept
+{
+    m_pProgressSnapshot.m_pData = std::move(pData);
+    m_pProgressSnapshot.m_pGame = GetClient()->game;
+    m_pProgressSnapshot.m_nFrameCount = m_nFrameCount;
+    m_pProgressSnapshot.m_nStateVersion = m_nProgressStateVersion;
+}
+
 void AchievementRuntime::SaveProgressToFile(const char* sSaveStateFilename) const
 {
     if (sSaveStateFilename == nullptr)
         return;
 
+    // capture the state now - it will have changed by the time the background thread runs.
+    // if the state was captured by a size query and hasn't changed, use that instead.
+    std::shared_ptr<const std::string> pSerialized;
+    {
+        std::lock_guard<std::mutex> lock(m_pProgressSnapshot.m_oMutex);
+        pSerialized = GetProgressSnapshot();
+        m_pProgressSnapshot.m_pData.reset();
+    }
+
+    if (pSerialized == nullptr)
+        pSerialized = SerializeProgress(rc_client_progress_size(GetClient()));
+
     std::wstring sAchievementStateFile = ra::Widen(sSaveStateFilename) + L".rap";
-    auto pFile = ra::services::ServiceLocator::Get<ra::services::IFileSystem>().CreateTextFile(sAchievementStateFile);
-    if (pFile == nullptr)
+
+    uint32_t nGeneration = 0;
     {
-        RA_LOG_WARN("Could not write %s", sAchievementStateFile);
-        return;
+        std::lock_guard<std::mutex> lock(m_pProgressWriteQueue->m_oMutex);
+        nGeneration = ++m_pProgressWriteQueue->m_nGeneration;
+
+        // if a previous write for the file hasn't happened yet, it's replaced by this one
+        auto& pPendingWrite = m_pProgressWriteQueue->m_mPendingWrites[sAchievementStateFile];
+        pPendingWrite.pData = std::move(pSerialized);
+        pPendingWrite.nGeneration = nGeneration;
     }
 
-    const auto nSize = rc_client_progress_size(GetClient());
-    std::string sSerialized;
-    sSerialized.resize(nSize);
-    GSL_SUPPRESS_TYPE1 const auto pData = reinterpret_cast<uint8_t*>(sSerialized.data());
-    rc_client_serialize_progress(GetClient(), pData);
-    pFile->Write(sSerialized);
+    ra::services::ServiceLocator::GetMutable<ra::services::IThreadPool>().RunAsync(
+        [pQueue = m_pProgressWriteQueue, sAchievementStateFile, nGeneration]()
+        {
+            WriteProgressFile(*pQueue, sAchievementStateFile, nGeneration);
+        });
+
+    RA_LOG_INFO("Runtime state captured for %s", sSaveStateFilename);
+}
+
+void AchievementRuntime::WriteProgressFile(ProgressWriteQueue& pQueue, const std::wstring& sPath, uint32_t nGeneration)
+{
+    std::lock_guard<std::mutex> lockWrite(pQueue.m_oWriteMutex);
+
+    std::shared_ptr<const std::string> pData;
+    {
+        std::lock_guard<std::mutex> lock(pQueue.m_oMutex);
+        const auto pIter = pQueue.m_mPendingWrites.find(sPath);
+
+        // if the entry is missing, it was already written. if the generation doesn't match,
+        // the file was saved again and the newer task will write it.
+        if (pIter == pQueue.m_mPendingWrites.end() || pIter->second.nGeneration != nGeneration)
+            return;
+
+        pData = pIter->second.pData;
+    }
+
+    WriteProgressFile(sPath, *pData);
+
+    {
+        std::lock_guard<std::mutex> lock(pQueue.m_oMutex);
+        const auto pIter = pQueue.m_mPendingWrites.find(sPath);
+        if (pIter != pQueue.m_mPendingWrites.end() && pIter->second.nGeneration == nGeneration)
+            pQueue.m_mPendingWrites.erase(pIter);
+    }
+}
+
+bool AchievementRuntime::WriteProgressFile(const std::wstring& sPath, const std::string& sData)
+{
+    const auto& pFileSystem = ra::services::ServiceLocator::Get<ra::services::IFileSystem>();
 
-    RA_LOG_INFO("Runtime state written to %s", sSaveStateFilename);
+    const std::wstring sTempPath = sPath + L".tmp";
+    {
+        auto pFile = pFileSystem.CreateTextFile(sTempPath);
+        if (pFile == nullptr)
+        {
+            RA_LOG_WARN("Could not write %s", ra::Narrow(sTempPath).c_str());
+            return false;
+        }
+
+        pFile->Write(sData);
+    }
+
+    // the rename replaces the old file in a single operation, so a crash while writing
+    // leaves the previous file intact instead of a truncated one
+    if (!pFileSystem.MoveFile(sTempPath, sPath))
+    {
+        RA_LOG_WARN("Could not replace %s", ra::Narrow(sPath).c_str());
+        pFileSystem.DeleteFile(sTempPath);
+        return false;
+    }
+
+    RA_LOG_INFO("Runtime state written to %s", ra::Narrow(sPath).c_str());
+    return true;
+}
+
+void AchievementRuntime::FlushProgressWrites() const
+{
+    std::lock_guard<std::mutex> lockWrite(m_pProgressWriteQueue->m_oWriteMutex);
+
+    std::map<std::wstring, PendingProgressWrite> mPendingWrites;
+    {
+        std::lock_guard<std::mutex> lock(m_pProgressWriteQueue->m_oMutex);
+        mPendingWrites.swap(m_pProgressWriteQueue->m_mPendingWrites);
+    }
+
+    // any queued tasks for these files will find nothing to write
+    for (const auto& pIter : mPendingWrites)
+        WriteProgressFile(pIter.first, *pIter.second.pData);
 }
 
 int AchievementRuntime::SaveProgressToBuffer(uint8_t* pBuffer, int nBufferSize) const
 {
+    std::lock_guard<std::mutex> lock(m_pProgressSnapshot.m_oMutex);
+
+    // if the state was captured when the caller asked for the size, and hasn't changed, use it
+    const auto pSnapshot = GetProgressSnapshot();
+    if (pSnapshot != nullptr)
+    {
+        const int nSize = gsl::narrow_cast<int>(pSnapshot->size());
+        if (nSize <= nBufferSize)
+        {
+            memcpy(pBuffer, pSnapshot->data(), pSnapshot->size());
+            m_pProgressSnapshot.m_pData.reset();
+            RA_LOG_INFO("Runtime state written to buffer (%d/%d bytes, captured)", nSize, nBufferSize);
+        }
+
+        return nSize;
+    }
+
     const int nSize = gsl::narrow_cast<int>(rc_client_progress_size(GetClient()));
     if (nSize <= nBufferSize)
     {
         rc_client_serialize_progress(GetClient(), pBuffer);
+        m_pProgressSnapshot.m_pData.reset();
         RA_LOG_INFO("Runtime state written to buffer (%d/%d bytes)", nSize, nBufferSize);
     }
-    else if (nBufferSize > 0) // 0 size buffer indicates caller is asking for size, don't log - we'll capture the actual save soon.
+    else
     {
-        RA_LOG_WARN("Runtime state not written to buffer (%d/%d bytes)", nSize, nBufferSize);
+        // the caller will most likely allocate a larger buffer and call again immediately. capture the
+        // state now so it doesn't have to be serialized again.
+        SetProgressSnapshot(SerializeProgress(nSize));
+
+        if (nBufferSize > 0) // 0 size buffer indicates caller is asking for size, don't log - we'll capture the actual save soon.
+        {
+            RA_LOG_WARN("Runtime state not written to buffer (%d/%d bytes)", nSize, nBufferSize);
+        }
     }
 
     return nSize;
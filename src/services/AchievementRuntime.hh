@@ -98,6 +98,10 @@ public:
     /// <summary>
     /// Gets the current rich presence display string.
     /// </summary>
+    /// <remarks>
+    /// The string is only evaluated once per frame. Additional calls before the next frame is processed
+    /// return the cached value.
+    /// </remarks>
     std::wstring GetRichPresenceDisplayString() const;
 
     void InvalidateAddress(ra::ByteAddress nAddress) noexcept;
@@ -107,6 +111,11 @@ public:
     /// </summary>
     void DoFrame();
 
+    /// <summary>
+    /// Gets the number of frames that have been processed.
+    /// </summary>
+    uint32_t GetFrameCount() const noexcept { return m_nFrameCount; }
+
     /// <summary>
     /// Processes stuff not related to a frame.
     /// </summary>
@@ -130,8 +139,17 @@ public:
     /// Writes HitCount data for active achievements to a save state file.
     /// </summary>
     /// <param name="sLoadStateFilename">The name of the save state file.</param>
+    /// <remarks>
+    /// The data is captured immediately, but written to disk on a background thread. The file is written
+    /// to a temporary location and renamed so a partially written file never replaces a good one.
+    /// </remarks>
     void SaveProgressToFile(const char* sSaveStateFilename) const;
 
+    /// <summary>
+    /// Synchronously writes any progress files that are still waiting to be written by the background thread.
+    /// </summary>
+    void FlushProgressWrites() const;
+
     /// <summary>
     /// Writes HitCount data for active achievements to a buffer.
     /// </summary>
@@ -142,6 +160,10 @@ public:
     /// nBufferSize - in which case the caller should allocate the specified amount
     /// and call again.
     /// </returns>
+    /// <remarks>
+    /// If the buffer is too small, the data is captured immediately and kept until the next save. If nothing
+    /// has changed by then, the captured data is used instead of serializing the state again.
+    /// </remarks>
     int SaveProgressToBuffer(uint8_t* pBuffer, int nBufferSize) const;
 
     /// <summary>
@@ -221,6 +243,80 @@ private:
     int m_nRichPresenceParseResult = RC_OK;
     int m_nRichPresenceErrorLine = 0;
 
+    std::atomic<uint32_t> m_nFrameCount{ 0 };
+
+    // incremented whenever the rich presence state changes outside of a frame (new script, state restored)
+    std::atomic<uint32_t> m_nRichPresenceStateVersion{ 0 };
+    void InvalidateRichPresenceDisplayString() noexcept { ++m_nRichPresenceStateVersion; }
+
+    struct RichPresenceDisplayStringCache
+    {
+        std::mutex m_oMutex;
+        std::wstring m_sDisplayString;
+        const void* m_pGame = nullptr;
+        uint32_t m_nFrameCount = 0;
+        uint32_t m_nStateVersion = 0;
+        bool m_bValid = false;
+    };
+    mutable RichPresenceDisplayStringCache m_pRichPresenceCache;
+
+    // incremented whenever the progress state changes outside of a frame (state restored, assets changed)
+    std::atomic<uint32_t> m_nProgressStateVersion{ 0 };
+    void InvalidateProgressSnapshot() noexcept { ++m_nProgressStateVersion; }
+
+    struct ProgressSnapshot
+    {
+        std::mutex m_oMutex;
+        std::shared_ptr<const std::string> m_pData;
+        const void* m_pGame = nullptr;
+        uint32_t m_nFrameCount = 0;
+        uint32_t m_nStateVersion = 0;
+    };
+    mutable ProgressSnapshot m_pProgressSnapshot;
+
+    std::shared_ptr<const std::string> SerializeProgress(size_t nSize) const;
+    std::shared_ptr<const std::string> GetProgressSnapshot() const noexcept; // m_pProgressSnapshot.m_oMutex must be held
+    void SetProgressSnapshot(std::shared_ptr<const std::string> pData) const noexcept; // m_pProgressSnapshot.m_oMutex must be held
+
+    // leaderboard tracker updates raised while processing a frame are held until the frame completes
+    // so only the last value for each tracker is displayed
+    bool m_bProcessingFrame = false;
+    std::map<uint32_t, std::string> m_mPendingTrackerUpdates;
+
+    struct TrackerDisplayText
+    {
+        const void* pPopup = nullptr;
+        std::string sDisplay;
+    };
+    std::map<uint32_t, TrackerDisplayText> m_mTrackerDisplayText;
+
+    void UpdateTrackerDisplayText(uint32_t nTrackerId, const char* sDisplay);
+    void ShowTracker(uint32_t nTrackerId, const char* sDisplay);
+    void HideTracker(uint32_t nTrackerId);
+    void FlushTrackerUpdates();
+
+    struct PendingProgressWrite
+    {
+        std::shared_ptr<const std::string> pData;
+        uint32_t nGeneration = 0;
+    };
+
+    struct ProgressWriteQueue
+    {
+        std::mutex m_oMutex;
+        std::map<std::wstring, PendingProgressWrite> m_mPendingWrites;
+        uint32_t m_nGeneration = 0;
+
+        // held while a file is being written so writes to the same file can't interleave
+        std::mutex m_oWriteMutex;
+    };
+
+    // shared with the background tasks so they can complete even if the runtime is destroyed
+    std::shared_ptr<ProgressWriteQueue> m_pProgressWriteQueue = std::make_shared<ProgressWriteQueue>();
+
+    static void WriteProgressFile(ProgressWriteQueue& pQueue, const std::wstring& sPath, uint32_t nGeneration);
+    static bool WriteProgressFile(const std::wstring& sPath, const std::string& sData);
+
     static void LogMessage(const char* sMessage, const rc_client_t* pClient);
     static uint32_t ReadMemory(uint32_t nAddress, uint8_t* pBuffer, uint32_t nBytes, rc_client_t* pClient);
     static void ServerCallAsync(const rc_api_request_t* pRequest, rc_client_server_callback_t fCallback,
@@ -80,6 +80,7 @@ public:
                                             AchievementRuntimeExports::ReadMemoryByte,
                                             AchievementRuntimeExports::WriteMemoryByte);
             pEmulatorContext.AddMemoryBlockReader(0, AchievementRuntimeExports::ReadMemoryBlock);
+            pEmulatorContext.AddMemoryBlockWriter(0, AchievementRuntimeExports::WriteMemoryBlock);
         }
     }
 
@@ -496,19 +497,28 @@ public:
 
     static size_t progress_size()
     {
+        // capture the state now so the serialize_progress call that follows doesn't have to serialize it again
         const auto& pClient = ra::services::ServiceLocator::Get<ra::services::AchievementRuntime>();
-        return rc_client_progress_size(pClient.GetClient());
+        return gsl::narrow_cast<size_t>(pClient.SaveProgressToBuffer(nullptr, 0));
     }
 
     static int serialize_progress(uint8_t* buffer, size_t buffer_size)
     {
         const auto& pClient = ra::services::ServiceLocator::Get<ra::services::AchievementRuntime>();
-        return rc_client_serialize_progress_sized(pClient.GetClient(), buffer, buffer_size);
+        if (pClient.GetClient()->game == nullptr)
+            return RC_NO_GAME_LOADED;
+
+        const auto nBufferSize = gsl::narrow_cast<int>(std::min(buffer_size, size_t{ INT_MAX }));
+        if (pClient.SaveProgressToBuffer(buffer, nBufferSize) > nBufferSize)
+            return RC_INSUFFICIENT_BUFFER;
+
+        return RC_OK;
     }
 
     static int deserialize_progress(const uint8_t* buffer, size_t buffer_size)
     {
         auto& pClient = ra::services::ServiceLocator::GetMutable<ra::services::AchievementRuntime>();
+        pClient.InvalidateProgressSnapshot();
         return rc_client_deserialize_progress_sized(pClient.GetClient(), buffer, buffer_size);
     }
 
@@ -832,6 +842,18 @@ private:
             s_callbacks.write_memory_handler(address, &value, 1, s_callbacks.write_memory_client);
     }
 
+    static uint32_t WriteMemoryBlock(uint32_t address, const uint8_t* buffer, uint32_t num_bytes) noexcept(false)
+    {
+        // the handler doesn't modify the buffer, it just isn't declared const
+        if (s_callbacks.write_memory_handler)
+        {
+            GSL_SUPPRESS_TYPE3
+            s_callbacks.write_memory_handler(address, const_cast<uint8_t*>(buffer), num_bytes, s_callbacks.write_memory_client);
+        }
+
+        return num_bytes;
+    }
+
     static uint32_t ReadMemoryBlock(uint32_t address, uint8_t* buffer, uint32_t num_bytes) noexcept(false)
     {
         if (s_callbacks.read_memory_handler)
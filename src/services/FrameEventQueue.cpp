@@ -3,43 +3,253 @@
 #include "RA_Defs.h"
 #include "RA_StringUtils.h"
 
+#include "data\context\GameContext.hh"
+
 #include "ui\viewmodels\MessageBoxViewModel.hh"
 #include "ui\viewmodels\WindowManager.hh"
 
 namespace ra {
 namespace services {
 
+FrameEventQueue::FrameEventQueue(size_t nCapacity)
+{
+    // capacity must be a power of two so positions can be mapped to cells with a mask
+    size_t nCells = 2;
+    while (nCells < nCapacity)
+        nCells <<= 1;
+
+    m_pCells = std::make_unique<Cell[]>(nCells);
+    for (size_t i = 0; i < nCells; ++i)
+        m_pCells[i].nSequence.store(i, std::memory_order_relaxed);
+
+    m_nMask = nCells - 1;
+}
+
+FrameEventQueue::~FrameEventQueue() noexcept
+{
+    DiscardPendingEvents();
+}
+
+void FrameEventQueue::Enqueue(Event&& pEvent)
+{
+    // each cell's sequence is equal to the position that may next be written to it, and one more than that
+    // position once the event has been written. claim a position by advancing m_nEnqueuePosition, then
+    // publish the event by advancing the sequence.
+    auto nPosition = m_nEnqueuePosition.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        auto& pCell = m_pCells[nPosition & m_nMask];
+        const auto nSequence = pCell.nSequence.load(std::memory_order_acquire);
+        const auto nDiff = static_cast<intptr_t>(nSequence) - static_cast<intptr_t>(nPosition);
+        if (nDiff == 0)
+        {
+            if (m_nEnqueuePosition.compare_exchange_weak(nPosition, nPosition + 1, std::memory_order_relaxed))
+            {
+                pCell.pEvent = std::move(pEvent);
+                pCell.nSequence.store(nPosition + 1, std::memory_order_release);
+                return;
+            }
+
+            // another thread claimed the position. nPosition was updated by compare_exchange_weak.
+        }
+        else if (nDiff < 0)
+        {
+            // ring buffer is full. push the event onto the overflow stack.
+            auto* pNode = new OverflowNode;
+            pNode->pEvent = std::move(pEvent);
+            pNode->pNext = m_pOverflow.load(std::memory_order_relaxed);
+            while (!m_pOverflow.compare_exchange_weak(pNode->pNext, pNode,
+                                                      std::memory_order_release, std::memory_order_relaxed))
+            {
+                // pNode->pNext was updated by compare_exchange_weak
+            }
+
+            m_nOverflowCount.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        else
+        {
+            // another thread claimed the position and wrote to it. try again with the new position.
+            nPosition = m_nEnqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool FrameEventQueue::TryDequeue(Event& pEvent) noexcept
+{
+    auto& pCell = m_pCells[m_nDequeuePosition & m_nMask];
+    if (pCell.nSequence.load(std::memory_order_acquire) != m_nDequeuePosition + 1)
+        return false; // empty, or the producer hasn't finished writing the event
+
+    pEvent = std::move(pCell.pEvent);
+
+    // make the cell available for the next time around the ring
+    pCell.nSequence.store(m_nDequeuePosition + m_nMask + 1, std::memory_order_release);
+    ++m_nDequeuePosition;
+    return true;
+}
+
+FrameEventQueue::OverflowNode* FrameEventQueue::TakeOverflow() noexcept
+{
+    // the stack is newest first. reverse it so events are processed in the order they were queued.
+    auto* pNode = m_pOverflow.exchange(nullptr, std::memory_order_acquire);
+    OverflowNode* pFirst = nullptr;
+    while (pNode)
+    {
+        auto* pNext = pNode->pNext;
+        pNode->pNext = pFirst;
+        pFirst = pNode;
+        pNode = pNext;
+    }
+
+    return pFirst;
+}
+
+void FrameEventQueue::ForEachPendingEvent(const std::function<void(const Event&)>& fHandler) const
+{
+    for (size_t nPosition = m_nDequeuePosition; nPosition - m_nDequeuePosition <= m_nMask; ++nPosition)
+    {
+        const auto& pCell = m_pCells[nPosition & m_nMask];
+        if (pCell.nSequence.load(std::memory_order_acquire) != nPosition + 1)
+            break;
+
+        fHandler(pCell.pEvent);
+    }
+
+    std::vector<const OverflowNode*> vOverflow;
+    for (const auto* pNode = m_pOverflow.load(std::memory_order_acquire); pNode; pNode = pNode->pNext)
+        vOverflow.push_back(pNode);
+
+    for (auto pIter = vOverflow.rbegin(); pIter != vOverflow.rend(); ++pIter)
+        fHandler((*pIter)->pEvent);
+}
+
+void FrameEventQueue::DiscardPendingEvents() noexcept
+{
+    Event pEvent;
+    while (TryDequeue(pEvent))
+        pEvent = {};
+
+    auto* pNode = TakeOverflow();
+    while (pNode)
+    {
+        auto* pNext = pNode->pNext;
+        delete pNode;
+        pNode = pNext;
+    }
+}
+
+static void AppendListItem(std::wstring& sMessage, const std::wstring& sItem)
+{
+    sMessage.append(L"\n* ");
+    sMessage.append(sItem);
+}
+
+static void AppendTriggerName(std::wstring& sMessage, uint32_t nId,
+                              ra::data::models::LeaderboardModel::LeaderboardParts nLeaderboardPart)
+{
+    const auto& pGameContext = ra::services::ServiceLocator::Get<ra::data::context::GameContext>();
+
+    if (nLeaderboardPart == ra::data::models::LeaderboardModel::LeaderboardParts::None)
+    {
+        const auto* pAchievement = pGameContext.Assets().FindAchievement(nId);
+        if (pAchievement)
+            AppendListItem(sMessage, pAchievement->GetName());
+        else
+            AppendListItem(sMessage, ra::StringPrintf(L"Achievement %u", nId));
+
+        return;
+    }
+
+    const wchar_t* sPart = L"";
+    switch (nLeaderboardPart)
+    {
+        case ra::data::models::LeaderboardModel::LeaderboardParts::Start: sPart = L"Start"; break;
+        case ra::data::models::LeaderboardModel::LeaderboardParts::Cancel: sPart = L"Cancel"; break;
+        case ra::data::models::LeaderboardModel::LeaderboardParts::Submit: sPart = L"Submit"; break;
+        case ra::data::models::LeaderboardModel::LeaderboardParts::Value: sPart = L"Value"; break;
+        default: break;
+    }
+
+    const auto* pLeaderboard = pGameContext.Assets().FindLeaderboard(nId);
+    if (pLeaderboard)
+        AppendListItem(sMessage, ra::StringPrintf(L"%s: %s", sPart, pLeaderboard->GetName()));
+    else
+        AppendListItem(sMessage, ra::StringPrintf(L"%s: Leaderboard %u", sPart, nId));
+}
+
 void FrameEventQueue::DoFrame()
 {
-    std::wstring sPauseMessage;
+    // only process events that were queued before the frame started. anything queued by a function
+    // (or by another thread) while the events are being processed will be handled next frame.
+    const auto nStopPosition = m_nEnqueuePosition.load(std::memory_order_acquire);
+    auto* pOverflow = TakeOverflow();
+
+    const auto fProcessEvent = [this](Event& pEvent) {
+        switch (pEvent.nType)
+        {
+            case EventType::Function:
+                pEvent.fAction();
+                break;
+
+            case EventType::TriggerTriggered:
+                m_vTriggered.push_back(std::move(pEvent));
+                break;
 
-    if (!m_vFunctions.empty())
+            case EventType::TriggerReset:
+                m_vReset.push_back(std::move(pEvent));
+                break;
+
+            case EventType::MemoryChanged:
+                m_vMemChanges.push_back(std::move(pEvent.sDescription));
+                break;
+
+            default:
+                break;
+        }
+    };
+
+    Event pEvent;
+    while (m_nDequeuePosition != nStopPosition && TryDequeue(pEvent))
     {
-        for (auto& fFunction : m_vFunctions)
-            fFunction();
+        fProcessEvent(pEvent);
+        pEvent = {};
+    }
 
-        m_vFunctions.clear();
+    while (pOverflow)
+    {
+        std::unique_ptr<OverflowNode> pNode(pOverflow);
+        pOverflow = pNode->pNext;
+        fProcessEvent(pNode->pEvent);
     }
 
-    if (!m_vTriggeredTriggers.empty())
+    std::wstring sPauseMessage;
+
+    const auto fAppendTriggers = [&sPauseMessage](std::vector<Event>& vEvents) {
+        for (const auto& pTrigger : vEvents)
+        {
+            if (pTrigger.nId == 0)
+                AppendListItem(sPauseMessage, pTrigger.sDescription);
+            else
+                AppendTriggerName(sPauseMessage, pTrigger.nId, pTrigger.nLeaderboardPart);
+        }
+
+        vEvents.clear();
+    };
+
+    if (!m_vTriggered.empty())
     {
         sPauseMessage.append(L"The following triggers have triggered:");
-        for (const auto& pTriggerName : m_vTriggeredTriggers)
-            sPauseMessage.append(ra::StringPrintf(L"\n* %s", pTriggerName));
-
-        m_vTriggeredTriggers.clear();
+        fAppendTriggers(m_vTriggered);
     }
 
-    if (!m_vResetTriggers.empty())
+    if (!m_vReset.empty())
     {
         if (!sPauseMessage.empty())
             sPauseMessage.append(L"\n");
 
         sPauseMessage.append(L"The following triggers have been reset:");
-        for (const auto& pTriggerName : m_vResetTriggers)
-            sPauseMessage.append(ra::StringPrintf(L"\n* %s", pTriggerName));
-
-        m_vResetTriggers.clear();
+        fAppendTriggers(m_vReset);
     }
 
     if (!m_vMemChanges.empty())
@@ -47,9 +257,13 @@ void FrameEventQueue::DoFrame()
         if (!sPauseMessage.empty())
             sPauseMessage.append(L"\n");
 
+        // each bookmark is only reported once, in sorted order
+        std::sort(m_vMemChanges.begin(), m_vMemChanges.end());
+        const auto pEnd = std::unique(m_vMemChanges.begin(), m_vMemChanges.end());
+
         sPauseMessage.append(L"The following bookmarks have changed:");
-        for (const auto& pChange : m_vMemChanges)
-            sPauseMessage.append(ra::StringPrintf(L"\n* %s", pChange));
+        for (auto pIter = m_vMemChanges.begin(); pIter != pEnd; ++pIter)
+            AppendListItem(sPauseMessage, *pIter);
 
         m_vMemChanges.clear();
     }
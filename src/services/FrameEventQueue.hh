@@ -6,47 +6,175 @@
 
 #include "data\Types.hh"
 
+#include "data\models\LeaderboardModel.hh"
+
 namespace ra {
 namespace services {
 
+/// <summary>
+/// Collects events raised while processing a frame so they can be handled together after the frame completes.
+/// </summary>
+/// <remarks>
+/// Events may be queued from any thread, but <see cref="DoFrame" /> must only be called from one thread.
+/// Queueing an event does not take a lock. Events are stored as records in a fixed-size ring buffer,
+/// and only allocate memory if the ring buffer is full, or the event has to carry a string or function.
+/// Asset names are not looked up until the events are processed. Events queued by a single thread are
+/// processed in the order they were queued, unless the ring buffer fills while another thread is in
+/// <see cref="DoFrame" />.
+/// </remarks>
 class FrameEventQueue
 {
 public:
-    GSL_SUPPRESS_F6 FrameEventQueue() = default;
-    virtual ~FrameEventQueue() = default;
+    GSL_SUPPRESS_F6 FrameEventQueue() : FrameEventQueue(DefaultCapacity) {}
+    GSL_SUPPRESS_F6 explicit FrameEventQueue(size_t nCapacity);
+    virtual ~FrameEventQueue() noexcept;
 
     FrameEventQueue(const FrameEventQueue&) noexcept = delete;
     FrameEventQueue& operator=(const FrameEventQueue&) noexcept = delete;
     FrameEventQueue(FrameEventQueue&&) noexcept = delete;
     FrameEventQueue& operator=(FrameEventQueue&&) noexcept = delete;
 
-    void QueuePauseOnChange(const std::wstring& sMemDescription)
+    void QueuePauseOnChange(std::wstring sMemDescription)
+    {
+        Event pEvent(EventType::MemoryChanged);
+        pEvent.sDescription = std::move(sMemDescription);
+        Enqueue(std::move(pEvent));
+    }
+
+    void QueuePauseOnReset(std::wstring sTriggerName)
+    {
+        Event pEvent(EventType::TriggerReset);
+        pEvent.sDescription = std::move(sTriggerName);
+        Enqueue(std::move(pEvent));
+    }
+
+    void QueuePauseOnReset(ra::AchievementID nAchievementId)
+    {
+        Event pEvent(EventType::TriggerReset);
+        pEvent.nId = nAchievementId;
+        Enqueue(std::move(pEvent));
+    }
+
+    void QueuePauseOnReset(ra::LeaderboardID nLeaderboardId, ra::data::models::LeaderboardModel::LeaderboardParts nPart)
+    {
+        Event pEvent(EventType::TriggerReset);
+        pEvent.nId = nLeaderboardId;
+        pEvent.nLeaderboardPart = nPart;
+        Enqueue(std::move(pEvent));
+    }
+
+    void QueuePauseOnTrigger(std::wstring sTriggerName)
     {
-        m_vMemChanges.insert(sMemDescription);
+        Event pEvent(EventType::TriggerTriggered);
+        pEvent.sDescription = std::move(sTriggerName);
+        Enqueue(std::move(pEvent));
     }
 
-    void QueuePauseOnReset(const std::wstring& sTriggerName)
+    void QueuePauseOnTrigger(ra::AchievementID nAchievementId)
     {
-        m_vResetTriggers.push_back(sTriggerName);
+        Event pEvent(EventType::TriggerTriggered);
+        pEvent.nId = nAchievementId;
+        Enqueue(std::move(pEvent));
     }
 
-    void QueuePauseOnTrigger(const std::wstring& sTriggerName)
+    void QueuePauseOnTrigger(ra::LeaderboardID nLeaderboardId, ra::data::models::LeaderboardModel::LeaderboardParts nPart)
     {
-        m_vTriggeredTriggers.push_back(sTriggerName);
+        Event pEvent(EventType::TriggerTriggered);
+        pEvent.nId = nLeaderboardId;
+        pEvent.nLeaderboardPart = nPart;
+        Enqueue(std::move(pEvent));
     }
 
-    void QueueFunction(std::function<void(void)> fAction)
+    void QueueFunction(std::function<void(void)>&& fAction)
     {
-        m_vFunctions.push_back(fAction);
+        Event pEvent(EventType::Function);
+        pEvent.fAction = std::move(fAction);
+        Enqueue(std::move(pEvent));
     }
 
     void DoFrame();
 
 protected:
-    std::set<std::wstring> m_vMemChanges;
-    std::vector<std::wstring> m_vResetTriggers;
-    std::vector<std::wstring> m_vTriggeredTriggers;
-    std::vector<std::function<void(void)>> m_vFunctions;
+    static constexpr size_t DefaultCapacity = 256;
+
+    enum class EventType : uint8_t
+    {
+        None = 0,
+        Function,
+        TriggerTriggered,
+        TriggerReset,
+        MemoryChanged,
+    };
+
+    struct Event
+    {
+        Event() noexcept = default;
+        explicit Event(EventType nEventType) noexcept : nType(nEventType) {}
+
+        EventType nType = EventType::None;
+
+        /// <summary>
+        /// The leaderboard part for a trigger event. If <c>None</c>, <see cref="nId" /> is an achievement ID.
+        /// </summary>
+        ra::data::models::LeaderboardModel::LeaderboardParts nLeaderboardPart =
+            ra::data::models::LeaderboardModel::LeaderboardParts::None;
+
+        /// <summary>
+        /// The asset ID for a trigger event. If <c>0</c>, <see cref="sDescription" /> is used instead.
+        /// </summary>
+        uint32_t nId = 0;
+
+        std::wstring sDescription;
+        std::function<void(void)> fAction;
+    };
+
+    /// <summary>
+    /// Calls <paramref name="fHandler" /> for each event that has been queued and not yet processed.
+    /// </summary>
+    /// <remarks>
+    /// Must only be called from the thread that calls <see cref="DoFrame" />.
+    /// </remarks>
+    void ForEachPendingEvent(const std::function<void(const Event&)>& fHandler) const;
+
+    /// <summary>
+    /// Discards any events that have been queued and not yet processed.
+    /// </summary>
+    void DiscardPendingEvents() noexcept;
+
+    /// <summary>
+    /// Gets the number of events that did not fit in the ring buffer since the queue was created.
+    /// </summary>
+    size_t GetOverflowCount() const noexcept { return m_nOverflowCount.load(std::memory_order_relaxed); }
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> nSequence{ 0 };
+        Event pEvent;
+    };
+
+    struct OverflowNode
+    {
+        Event pEvent;
+        OverflowNode* pNext = nullptr;
+    };
+
+    void Enqueue(Event&& pEvent);
+    bool TryDequeue(Event& pEvent) noexcept;
+    OverflowNode* TakeOverflow() noexcept;
+
+    std::unique_ptr<Cell[]> m_pCells;
+    size_t m_nMask = 0;
+    std::atomic<size_t> m_nEnqueuePosition{ 0 };
+    size_t m_nDequeuePosition = 0;
+
+    std::atomic<OverflowNode*> m_pOverflow{ nullptr };
+    std::atomic<size_t> m_nOverflowCount{ 0 };
+
+    // reused between frames to avoid reallocating
+    std::vector<Event> m_vTriggered;
+    std::vector<Event> m_vReset;
+    std::vector<std::wstring> m_vMemChanges;
 };
 
 } // namespace services
@@ -0,0 +1,322 @@
+#include "GameLibraryScanner.hh"
+
+#include "RA_Log.h"
+#include "RA_StringUtils.h"
+
+#include "services\IFileSystem.hh"
+#include "services\IThreadPool.hh"
+#include "services\ServiceLocator.hh"
+
+#include <rc_hash.h>
+
+namespace ra {
+namespace services {
+
+GameLibraryScanner::GameLibraryScanner()
+    : m_pContext(std::make_shared<ScanContext>())
+{
+}
+
+GameLibraryScanner::~GameLibraryScanner() noexcept
+{
+    // any outstanding workers hold their own reference to the context, just tell them to stop
+    Cancel();
+}
+
+static int64_t GetLastModifiedSeconds(const IFileSystem& pFileSystem, const std::wstring& sPath)
+{
+    const auto tLastModified = pFileSystem.GetLastModified(sPath);
+    return std::chrono::duration_cast<std::chrono::seconds>(tLastModified.time_since_epoch()).count();
+}
+
+void GameLibraryScanner::LoadCache(const std::wstring& sCacheFile)
+{
+    const auto& pFileSystem = ra::services::ServiceLocator::Get<ra::services::IFileSystem>();
+    auto pFile = pFileSystem.OpenTextFile(sCacheFile);
+    if (pFile == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_pContext->m_oMutex);
+
+    // each line is "size:modified:hash:path"
+    std::string sLine;
+    while (pFile->GetLine(sLine))
+    {
+        ra::Tokenizer pTokenizer(sLine);
+        const auto sSize = pTokenizer.ReadTo(':');
+        if (!pTokenizer.Consume(':'))
+            continue;
+        const auto sLastModified = pTokenizer.ReadTo(':');
+        if (!pTokenizer.Consume(':'))
+            continue;
+        auto sHash = pTokenizer.ReadTo(':');
+        if (!pTokenizer.Consume(':') || sHash.length() != 32)
+            continue;
+
+        CacheEntry pEntry;
+        pEntry.nSize = std::strtoll(sSize.c_str(), nullptr, 10);
+        pEntry.nLastModified = std::strtoll(sLastModified.c_str(), nullptr, 10);
+        pEntry.sHash = std::move(sHash);
+
+        const std::string sPath(pTokenizer.GetPointer(pTokenizer.CurrentPosition()));
+        m_pContext->m_mCache.insert_or_assign(ra::Widen(sPath), std::move(pEntry));
+    }
+}
+
+void GameLibraryScanner::SaveCache(const std::wstring& sCacheFile) const
+{
+    const auto& pFileSystem = ra::services::ServiceLocator::Get<ra::services::IFileSystem>();
+    auto pFile = pFileSystem.CreateTextFile(sCacheFile);
+    if (pFile == nullptr)
+    {
+        RA_LOG_WARN("Could not write %s", ra::Narrow(sCacheFile).c_str());
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_pContext->m_oMutex);
+    for (const auto& pIter : m_pContext->m_mCache)
+    {
+        if (pIter.second.sHash.empty())
+            continue;
+
+        pFile->WriteLine(ra::StringPrintf("%ll:%ll:%s:%s", pIter.second.nSize, pIter.second.nLastModified,
+                                          pIter.second.sHash, ra::Narrow(pIter.first)));
+    }
+}
+
+void GameLibraryScanner::Scan(const std::wstring& sDirectory, const std::vector<std::wstring>& vExtensions,
+                              std::function<void()>&& fCallback)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_pContext->m_oMutex);
+        if (m_pContext->m_bScanning)
+        {
+            RA_LOG_WARN("Scan already in progress");
+            return;
+        }
+
+        m_pContext->m_bScanning = true;
+        m_pContext->m_bCancel = false;
+        m_pContext->m_nHashedFiles = 0;
+        m_pContext->m_vScannedFiles.clear();
+        m_pContext->m_vPendingFiles.clear();
+        m_pContext->m_fCallback = std::move(fCallback);
+    }
+
+    std::wstring sBaseDirectory = sDirectory;
+    if (!sBaseDirectory.empty() && sBaseDirectory.back() != L'\\')
+        sBaseDirectory.push_back(L'\\');
+
+    std::vector<std::wstring> vLowerExtensions = vExtensions;
+    for (auto& sExtension : vLowerExtensions)
+        ra::StringMakeLowercase(sExtension);
+
+    auto& pThreadPool = ra::services::ServiceLocator::GetMutable<ra::services::IThreadPool>();
+    pThreadPool.RunAsync([pContext = m_pContext, sBaseDirectory, vLowerExtensions,
+                          nMinFileSize = m_nMinFileSize, nMaxFileSize = m_nMaxFileSize,
+                          nMaxConcurrency = m_nMaxConcurrency]()
+    {
+        EnumerateFiles(*pContext, sBaseDirectory, vLowerExtensions, nMinFileSize, nMaxFileSize);
+
+        size_t nWorkers = 0;
+        size_t nPendingFiles = 0;
+        {
+            std::lock_guard<std::mutex> lock(pContext->m_oMutex);
+            nPendingFiles = pContext->m_vPendingFiles.size();
+            if (!pContext->m_bCancel)
+                nWorkers = std::min(nMaxConcurrency, nPendingFiles);
+
+            pContext->m_nActiveWorkers = nWorkers;
+        }
+
+        RA_LOG_INFO("Found %zu new or modified files in %s", nPendingFiles, ra::Narrow(sBaseDirectory).c_str());
+
+        if (nWorkers == 0)
+        {
+            CompleteScan(*pContext);
+            return;
+        }
+
+        // only queue one task per worker. each worker pulls files from the pending list until it's empty,
+        // so the thread pool's queue never holds more than nMaxConcurrency scan tasks.
+        auto& pThreadPool = ra::services::ServiceLocator::GetMutable<ra::services::IThreadPool>();
+        for (size_t i = 0; i < nWorkers; ++i)
+            pThreadPool.RunAsync([pContext]() { ProcessPendingFiles(pContext); });
+    });
+}
+
+void GameLibraryScanner::EnumerateFiles(ScanContext& pContext, const std::wstring& sDirectory,
+                                        const std::vector<std::wstring>& vExtensions,
+                                        int64_t nMinFileSize, int64_t nMaxFileSize)
+{
+    const auto& pFileSystem = ra::services::ServiceLocator::Get<ra::services::IFileSystem>();
+
+    std::stack<std::wstring> vDirectories;
+    vDirectories.push(sDirectory);
+
+    std::vector<std::wstring> vEntries;
+    while (!vDirectories.empty() && !pContext.m_bCancel)
+    {
+        const std::wstring sPath = vDirectories.top();
+        vDirectories.pop();
+
+        vEntries.clear();
+        pFileSystem.GetDirectoriesInDirectory(sPath, vEntries);
+        for (const auto& sSubDirectory : vEntries)
+            vDirectories.push(sPath + sSubDirectory + L'\\');
+
+        vEntries.clear();
+        pFileSystem.GetFilesInDirectory(sPath, vEntries);
+        for (const auto& sFile : vEntries)
+        {
+            auto sExtension = pFileSystem.GetExtension(sFile);
+            ra::StringMakeLowercase(sExtension);
+            if (std::find(vExtensions.begin(), vExtensions.end(), sExtension) == vExtensions.end())
+                continue;
+
+            PendingFile pFile;
+            pFile.sPath = sPath + sFile;
+            pFile.nSize = pFileSystem.GetFileSize(pFile.sPath);
+            if (pFile.nSize < nMinFileSize || pFile.nSize > nMaxFileSize)
+                continue;
+
+            pFile.nLastModified = GetLastModifiedSeconds(pFileSystem, pFile.sPath);
+
+            std::lock_guard<std::mutex> lock(pContext.m_oMutex);
+            pContext.m_vScannedFiles.insert(pFile.sPath);
+
+            const auto pIter = pContext.m_mCache.find(pFile.sPath);
+            if (pIter != pContext.m_mCache.end() && pIter->second.nSize == pFile.nSize &&
+                pIter->second.nLastModified == pFile.nLastModified)
+            {
+                // unchanged since it was last hashed
+                continue;
+            }
+
+            pContext.m_vPendingFiles.push_back(std::move(pFile));
+        }
+    }
+}
+
+void GameLibraryScanner::ProcessPendingFiles(std::shared_ptr<ScanContext> pContext)
+{
+    const auto& pThreadPool = ra::services::ServiceLocator::Get<ra::services::IThreadPool>();
+
+    // the buffer is reused for every file processed by this worker
+    std::vector<uint8_t> vBuffer;
+
+    do
+    {
+        PendingFile pFile;
+        {
+            std::lock_guard<std::mutex> lock(pContext->m_oMutex);
+            if (pContext->m_vPendingFiles.empty() || pContext->m_bCancel || pThreadPool.IsShutdownRequested())
+            {
+                if (--pContext->m_nActiveWorkers > 0)
+                    return;
+
+                break;
+            }
+
+            pFile = std::move(pContext->m_vPendingFiles.front());
+            pContext->m_vPendingFiles.pop_front();
+        }
+
+        CacheEntry pEntry;
+        pEntry.nSize = pFile.nSize;
+        pEntry.nLastModified = pFile.nLastModified;
+        pEntry.sHash = HashFile(pFile.sPath, pFile.nSize, vBuffer);
+
+        {
+            std::lock_guard<std::mutex> lock(pContext->m_oMutex);
+            pContext->m_mCache.insert_or_assign(pFile.sPath, std::move(pEntry));
+            ++pContext->m_nHashedFiles;
+        }
+    } while (true);
+
+    // last worker out
+    CompleteScan(*pContext);
+}
+
+void GameLibraryScanner::CompleteScan(ScanContext& pContext)
+{
+    std::function<void()> fCallback;
+    {
+        std::lock_guard<std::mutex> lock(pContext.m_oMutex);
+        pContext.m_vPendingFiles.clear();
+        pContext.m_bScanning = false;
+        fCallback.swap(pContext.m_fCallback);
+    }
+
+    if (fCallback)
+        fCallback();
+}
+
+std::string GameLibraryScanner::HashFile(const std::wstring& sPath, int64_t nSize, std::vector<uint8_t>& vBuffer)
+{
+    const auto& pFileSystem = ra::services::ServiceLocator::Get<ra::services::IFileSystem>();
+    auto pFile = pFileSystem.OpenTextFile(sPath);
+    if (pFile == nullptr)
+        return "";
+
+    const auto nFileSize = gsl::narrow_cast<size_t>(nSize);
+    if (vBuffer.size() < nFileSize)
+        vBuffer.resize(nFileSize);
+
+    // read the whole file with as few calls as possible
+    const auto nRead = pFile->GetBytes(vBuffer.data(), nFileSize);
+    if (nRead != nFileSize)
+    {
+        RA_LOG_WARN("Could not read %s", ra::Narrow(sPath).c_str());
+        return "";
+    }
+
+    // let rcheevos pick the appropriate hashing algorithm(s) for the file extension
+    const auto sNarrowPath = ra::Narrow(sPath);
+    rc_hash_iterator pIterator;
+    rc_hash_initialize_iterator(&pIterator, sNarrowPath.c_str(), vBuffer.data(), nFileSize);
+
+    char sHash[33];
+    const bool bResult = rc_hash_iterate(sHash, &pIterator);
+    rc_hash_destroy_iterator(&pIterator);
+
+    if (!bResult)
+        return "";
+
+    return std::string(sHash, 32);
+}
+
+void GameLibraryScanner::Cancel() noexcept
+{
+    m_pContext->m_bCancel = true;
+}
+
+bool GameLibraryScanner::IsScanning() const
+{
+    std::lock_guard<std::mutex> lock(m_pContext->m_oMutex);
+    return m_pContext->m_bScanning;
+}
+
+std::map<std::wstring, std::string> GameLibraryScanner::GetResults() const
+{
+    std::map<std::wstring, std::string> mResults;
+
+    std::lock_guard<std::mutex> lock(m_pContext->m_oMutex);
+    for (const auto& sPath : m_pContext->m_vScannedFiles)
+    {
+        const auto pIter = m_pContext->m_mCache.find(sPath);
+        if (pIter != m_pContext->m_mCache.end() && !pIter->second.sHash.empty())
+            mResults.insert_or_assign(sPath, pIter->second.sHash);
+    }
+
+    return mResults;
+}
+
+size_t GameLibraryScanner::GetHashedFileCount() const
+{
+    std::lock_guard<std::mutex> lock(m_pContext->m_oMutex);
+    return m_pContext->m_nHashedFiles;
+}
+
+} // namespace services
+} // namespace ra
@@ -0,0 +1,119 @@
+#ifndef RA_SERVICES_GAMELIBRARYSCANNER_HH
+#define RA_SERVICES_GAMELIBRARYSCANNER_HH
+#pragma once
+
+#include "ra_fwd.h"
+
+namespace ra {
+namespace services {
+
+class GameLibraryScanner
+{
+public:
+    GameLibraryScanner();
+    virtual ~GameLibraryScanner() noexcept;
+    GameLibraryScanner(const GameLibraryScanner&) noexcept = delete;
+    GameLibraryScanner& operator=(const GameLibraryScanner&) noexcept = delete;
+    GameLibraryScanner(GameLibraryScanner&&) noexcept = delete;
+    GameLibraryScanner& operator=(GameLibraryScanner&&) noexcept = delete;
+
+    /// <summary>
+    /// Loads previously calculated hashes from the specified file.
+    /// </summary>
+    void LoadCache(const std::wstring& sCacheFile);
+
+    /// <summary>
+    /// Writes the calculated hashes to the specified file.
+    /// </summary>
+    void SaveCache(const std::wstring& sCacheFile) const;
+
+    /// <summary>
+    /// Starts scanning <paramref name="sDirectory" /> (and its subdirectories) for files having one of the
+    /// specified extensions. Only files that are not in the cache, or whose size or modification time has
+    /// changed since they were cached, are hashed.
+    /// </summary>
+    /// <param name="sDirectory">The directory to scan.</param>
+    /// <param name="vExtensions">The extensions (without the dot) of the files to hash.</param>
+    /// <param name="fCallback">Called when the scan completes. May be called on a background thread.</param>
+    void Scan(const std::wstring& sDirectory, const std::vector<std::wstring>& vExtensions, std::function<void()>&& fCallback);
+
+    /// <summary>
+    /// Requests that the current scan stop as soon as possible.
+    /// </summary>
+    void Cancel() noexcept;
+
+    /// <summary>
+    /// Determines whether a scan is in progress.
+    /// </summary>
+    bool IsScanning() const;
+
+    /// <summary>
+    /// Gets the hashes of the files found by the most recent scan, keyed by path.
+    /// </summary>
+    std::map<std::wstring, std::string> GetResults() const;
+
+    /// <summary>
+    /// Gets the number of files that had to be hashed by the most recent scan.
+    /// </summary>
+    size_t GetHashedFileCount() const;
+
+    /// <summary>
+    /// Sets the maximum number of files that will be hashed in parallel.
+    /// </summary>
+    void SetMaxConcurrency(size_t nValue) noexcept { m_nMaxConcurrency = std::max(nValue, size_t{1}); }
+
+    /// <summary>
+    /// Sets the size of the largest file that will be hashed.
+    /// </summary>
+    void SetMaxFileSize(int64_t nValue) noexcept { m_nMaxFileSize = nValue; }
+
+    /// <summary>
+    /// Sets the size of the smallest file that will be hashed.
+    /// </summary>
+    void SetMinFileSize(int64_t nValue) noexcept { m_nMinFileSize = nValue; }
+
+private:
+    struct CacheEntry
+    {
+        int64_t nSize = 0;
+        int64_t nLastModified = 0;
+        std::string sHash;
+    };
+
+    struct PendingFile
+    {
+        std::wstring sPath;
+        int64_t nSize = 0;
+        int64_t nLastModified = 0;
+    };
+
+    struct ScanContext
+    {
+        mutable std::mutex m_oMutex;
+        std::map<std::wstring, CacheEntry> m_mCache;
+        std::set<std::wstring> m_vScannedFiles;
+        std::deque<PendingFile> m_vPendingFiles;
+        size_t m_nActiveWorkers = 0;
+        size_t m_nHashedFiles = 0;
+        bool m_bScanning = false;
+        std::atomic_bool m_bCancel{false};
+        std::function<void()> m_fCallback;
+    };
+
+    static void EnumerateFiles(ScanContext& pContext, const std::wstring& sDirectory,
+                               const std::vector<std::wstring>& vExtensions,
+                               int64_t nMinFileSize, int64_t nMaxFileSize);
+    static void ProcessPendingFiles(std::shared_ptr<ScanContext> pContext);
+    static void CompleteScan(ScanContext& pContext);
+    static std::string HashFile(const std::wstring& sPath, int64_t nSize, std::vector<uint8_t>& vBuffer);
+
+    std::shared_ptr<ScanContext> m_pContext;
+    size_t m_nMaxConcurrency = 4;
+    int64_t m_nMinFileSize = 2048;
+    int64_t m_nMaxFileSize = 64 * 1024 * 1024;
+};
+
+} // namespace services
+} // namespace ra
+
+#endif // !RA_SERVICES_GAMELIBRARYSCANNER_HH
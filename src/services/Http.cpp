@@ -23,10 +23,29 @@ Http::Response Http::Request::Call() const
 
 void Http::Request::CallAsync(Callback&& fCallback) const
 {
+    IHttpRequester::AsyncCallback fResponseCallback =
+        [f = std::move(fCallback)](unsigned int nStatusCode, std::string&& sContent) {
+            const Response response(ra::itoe<Http::StatusCode>(nStatusCode), std::move(sContent));
+            f(response);
+        };
+
+    // if the requester can queue the request itself (i.e. to pipeline it on an open connection), let it
+    if (ra::services::ServiceLocator::Exists<ra::services::IHttpRequester>())
+    {
+        const auto& pHttpRequester = ra::services::ServiceLocator::Get<ra::services::IHttpRequester>();
+        if (pHttpRequester.RequestAsync(*this, std::move(fResponseCallback)))
+            return;
+    }
+
     auto& pThreadPool = ra::services::ServiceLocator::GetMutable<ra::services::IThreadPool>();
-    pThreadPool.RunAsync([request = *this, f = std::move(fCallback)]() {
-        auto response = request.Call();
-        f(response);
+    pThreadPool.RunAsync([request = *this, f = std::move(fResponseCallback)]() {
+        std::string sResponse;
+        ra::services::impl::StringTextWriter pWriter(sResponse);
+
+        const auto& pHttpRequester = ra::services::ServiceLocator::Get<ra::services::IHttpRequester>();
+        const auto nStatusCode = pHttpRequester.Request(request, pWriter);
+
+        f(nStatusCode, std::move(sResponse));
     });
 }
 
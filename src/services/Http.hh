@@ -28,6 +28,11 @@ public:
         {
         }
 
+        explicit Response(Http::StatusCode nStatusCode, std::string&& sResponse) noexcept
+            : m_nStatusCode(nStatusCode), m_sResponse(std::move(sResponse))
+        {
+        }
+
         Response() noexcept = default;
         ~Response() noexcept = default;
         Response(const Response&) noexcept = default;
@@ -46,6 +46,14 @@ public:
     /// <returns>Number of files added to <paramref name="vResults" /></returns>
     virtual size_t GetFilesInDirectory(const std::wstring& sDirectory, _Inout_ std::vector<std::wstring>& vResults) const = 0;
 
+    /// <summary>
+    /// Gets the subdirectories of a directory.
+    /// </summary>
+    /// <param name="sDirectory">The directory to enumerate.</param>
+    /// <param name="vResults">The vector to populate with the names of the subdirectories.</param>
+    /// <returns>Number of subdirectories added to <paramref name="vResults" /></returns>
+    virtual size_t GetDirectoriesInDirectory(const std::wstring& sDirectory, _Inout_ std::vector<std::wstring>& vResults) const = 0;
+
     /// <summary>
     /// Gets the size of the file (in bytes).
     /// </summary>
@@ -58,6 +66,15 @@ public:
     /// <returns>Time the file was last modified, <c>0</c> if file doesn't exist.</returns>
     virtual std::chrono::system_clock::time_point GetLastModified(const std::wstring& sPath) const = 0;
 
+    /// <summary>
+    /// Gets a counter that changes whenever a file in the directory is created, modified, renamed, or deleted.
+    /// </summary>
+    /// <remarks>
+    /// The first call for a directory starts monitoring it. Later calls only check for a pending
+    /// notification and do not touch the disk, so this can be polled frequently.
+    /// </remarks>
+    virtual uint32_t GetDirectoryChangeCount(const std::wstring& sDirectory) const = 0;
+
     /// <summary>
     /// Deletes the specified file.
     /// </summary>
@@ -67,7 +84,10 @@ public:
     /// <summary>
     /// Moves a file from one location to another.
     /// </summary>
-    /// <remarks>Can be used to rename a file if the path to the file is the same.</remarks>
+    /// <remarks>
+    /// Can be used to rename a file if the path to the file is the same. If a file already exists at
+    /// <paramref name="sNewPath" />, it is replaced.
+    /// </remarks>
     /// <returns><c>true</c> if successful, <c>false</c> if not.</returns>
     virtual bool MoveFile(const std::wstring& sOldPath, const std::wstring& sNewPath) const = 0;
 
@@ -30,6 +30,22 @@ public:
     /// <returns>The status code from the server, or an error code if the request failed before reaching the server.</returns>
     virtual unsigned int Request(const Http::Request& pRequest, TextWriter& pContentWriter) const = 0;
 
+    using AsyncCallback = std::function<void(unsigned int nStatusCode, std::string&& sContent)>;
+
+    /// <summary>
+    /// Sends the request without waiting for the response.
+    /// </summary>
+    /// <param name="pRequest">The request to send.</param>
+    /// <param name="fCallback">Called with the status code and content when the response is received. May be called on a background thread.</param>
+    /// <returns>
+    /// <c>true</c> if the request was queued. <c>false</c> if the requester does not support asynchronous requests,
+    /// in which case <paramref name="fCallback" /> is left untouched and the caller should use <see cref="Request" />.
+    /// </returns>
+    virtual bool RequestAsync([[maybe_unused]] const Http::Request& pRequest, [[maybe_unused]] AsyncCallback&& fCallback) const
+    {
+        return false;
+    }
+
     /// <summary>
     /// Determines whether or not it would be reasonable to retry the request for the provided error code.
     /// </summary>
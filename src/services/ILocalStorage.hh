@@ -37,6 +37,18 @@ public:
     /// <returns>Time the stored data was last modified, <c>0</c> if it doesn't exist.</returns>
     virtual std::chrono::system_clock::time_point GetLastModified(StorageItemType nType, const std::wstring& sKey) = 0;
 
+    /// <summary>
+    /// Gets a value that changes whenever the stored data is created, modified, or deleted.
+    /// </summary>
+    /// <returns>
+    /// A value to compare against the value returned by a previous call, <c>0</c> if the data has not existed
+    /// since monitoring started.
+    /// </returns>
+    /// <remarks>
+    /// Intended to be polled frequently. The stored data is only examined after a change notification is received.
+    /// </remarks>
+    virtual uint32_t GetChangeGeneration(StorageItemType nType, const std::wstring& sKey) = 0;
+
     /// <summary>
     ///   Begins reading stored data for the specified <paramref name="nType" /> and <paramref name="sKey" />.
     /// </summary>
@@ -67,6 +79,19 @@ public:
     /// </returns>
     virtual bool Delete(StorageItemType nType, const std::wstring& sKey) = 0;
 
+    /// <summary>
+    ///   Moves the stored data for <paramref name="sOldKey" /> to <paramref name="sNewKey" />, replacing any data
+    ///   already stored for <paramref name="sNewKey" />.
+    /// </summary>
+    /// <returns>
+    ///   <c>true</c> if the data was moved, <c>false</c> if not.
+    /// </returns>
+    /// <remarks>
+    ///   Used to replace stored data without losing it if the write is interrupted: write the new data to a
+    ///   temporary key, then move it over the original.
+    /// </remarks>
+    virtual bool Move(StorageItemType nType, const std::wstring& sOldKey, const std::wstring& sNewKey) = 0;
+
 protected:
     ILocalStorage() noexcept = default;
 };
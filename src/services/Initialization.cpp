@@ -16,6 +16,7 @@
 #include "services\impl\Clock.hh"
 #include "services\impl\FileLocalStorage.hh"
 #include "services\impl\JsonFileConfiguration.hh"
+#include "services\impl\PooledHttpRequester.hh"
 #include "services\impl\ThreadPool.hh"
 #include "services\impl\WindowsAudioSystem.hh"
 #include "services\impl\WindowsClipboard.hh"
@@ -135,8 +136,20 @@ void Initialization::RegisterServices(EmulatorID nEmulatorId, const char* sClien
     pThreadPool->Initialize(pConfiguration->GetNumBackgroundThreads());
     ra::services::ServiceLocator::Provide<ra::services::IThreadPool>(std::move(pThreadPool));
 
-    auto pHttpRequester = std::make_unique<ra::services::impl::WindowsHttpRequester>();
-    ra::services::ServiceLocator::Provide<ra::services::IHttpRequester>(std::move(pHttpRequester));
+    // the pooled requester doesn't support proxies or redirects, so it's only used if explicitly enabled.
+    // when enabled, plain http requests are sent over pooled keep-alive connections and https requests
+    // still go through WinHTTP.
+    if (pConfiguration->IsFeatureEnabled(ra::services::Feature::PooledHttpConnections))
+    {
+        auto pHttpRequester = std::make_unique<ra::services::impl::PooledHttpRequester>(
+            std::make_unique<ra::services::impl::WindowsHttpRequester>());
+        ra::services::ServiceLocator::Provide<ra::services::IHttpRequester>(std::move(pHttpRequester));
+    }
+    else
+    {
+        auto pHttpRequester = std::make_unique<ra::services::impl::WindowsHttpRequester>();
+        ra::services::ServiceLocator::Provide<ra::services::IHttpRequester>(std::move(pHttpRequester));
+    }
 
 #ifdef PERFORMANCE_COUNTERS
     auto pPerformanceCounter = std::make_unique<ra::services::PerformanceCounter>();
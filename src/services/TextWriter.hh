@@ -26,6 +26,13 @@ public:
     /// <param name="sText">The string to write.</param>
     virtual void Write(_In_ const std::wstring& sText) = 0;
 
+    /// <summary>
+    /// Writes raw bytes to the output.
+    /// </summary>
+    /// <param name="pData">The bytes to write.</param>
+    /// <param name="nBytes">The number of bytes to write.</param>
+    virtual void Write(_In_reads_(nBytes) const char* pData, _In_ size_t nBytes) = 0;
+
     /// <summary>
     /// Writes a newline to the output.
     /// </summary>
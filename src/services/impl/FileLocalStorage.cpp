@@ -78,7 +78,7 @@ std::wstring FileLocalStorage::GetPath(StorageItemType nType, const std::wstring
         case StorageItemType::CodeNotes:
             sPath.append(RA_DIR_DATA);
             sPath.append(sKey);
-            sPath.append(L"-Notes.json");
+            sPath.append(L"-Notes.bin");
             break;
 
         case StorageItemType::RichPresence:
@@ -139,6 +139,40 @@ std::chrono::system_clock::time_point FileLocalStorage::GetLastModified(StorageI
     return m_pFileSystem.GetLastModified(GetPath(nType, sKey));
 }
 
+uint32_t FileLocalStorage::GetChangeGeneration(StorageItemType nType, const std::wstring& sKey)
+{
+    const std::wstring sPath = GetPath(nType, sKey);
+    const auto nIndex = sPath.find_last_of(L'\\');
+    const auto nDirectoryChangeCount = m_pFileSystem.GetDirectoryChangeCount(sPath.substr(0, nIndex + 1));
+
+    std::lock_guard<std::mutex> lock(m_oMutex);
+    auto pIter = m_mMonitoredItems.find(sPath);
+    if (pIter == m_mMonitoredItems.end())
+    {
+        MonitoredItem pItem;
+        pItem.nDirectoryChangeCount = nDirectoryChangeCount;
+        pItem.tLastModified = m_pFileSystem.GetLastModified(sPath);
+        if (pItem.tLastModified != std::chrono::system_clock::time_point())
+            pItem.nGeneration = ++m_nGeneration;
+
+        pIter = m_mMonitoredItems.insert_or_assign(sPath, pItem).first;
+    }
+    else if (pIter->second.nDirectoryChangeCount != nDirectoryChangeCount)
+    {
+        // something in the directory changed, see if it was this file
+        pIter->second.nDirectoryChangeCount = nDirectoryChangeCount;
+
+        const auto tLastModified = m_pFileSystem.GetLastModified(sPath);
+        if (tLastModified != pIter->second.tLastModified)
+        {
+            pIter->second.tLastModified = tLastModified;
+            pIter->second.nGeneration = ++m_nGeneration;
+        }
+    }
+
+    return pIter->second.nGeneration;
+}
+
 std::unique_ptr<TextReader> FileLocalStorage::ReadText(StorageItemType nType, const std::wstring& sKey)
 {
     std::wstring sPath = GetPath(nType, sKey);
@@ -163,6 +197,11 @@ bool FileLocalStorage::Delete(StorageItemType nType, const std::wstring& sKey)
     return m_pFileSystem.DeleteFile(GetPath(nType, sKey));
 }
 
+bool FileLocalStorage::Move(StorageItemType nType, const std::wstring& sOldKey, const std::wstring& sNewKey)
+{
+    return m_pFileSystem.MoveFile(GetPath(nType, sOldKey), GetPath(nType, sNewKey));
+}
+
 } // namespace impl
 } // namespace services
 } // namespace ra
@@ -15,16 +15,29 @@ public:
     explicit FileLocalStorage(IFileSystem& pFileSystem);
 
     std::chrono::system_clock::time_point GetLastModified(StorageItemType nType, const std::wstring& sKey) override;
+    uint32_t GetChangeGeneration(StorageItemType nType, const std::wstring& sKey) override;
 
     std::unique_ptr<TextReader> ReadText(StorageItemType nType, const std::wstring& sKey) override;
     std::unique_ptr<TextWriter> WriteText(StorageItemType nType, const std::wstring& sKey) override;
     std::unique_ptr<TextWriter> AppendText(StorageItemType nType, const std::wstring& sKey) override;
     bool Delete(StorageItemType nType, const std::wstring& sKey) override;
+    bool Move(StorageItemType nType, const std::wstring& sOldKey, const std::wstring& sNewKey) override;
 
     std::wstring GetPath(StorageItemType nType, const std::wstring& sKey) const;
 
 private:
     IFileSystem& m_pFileSystem;
+
+    struct MonitoredItem
+    {
+        std::chrono::system_clock::time_point tLastModified;
+        uint32_t nDirectoryChangeCount = 0;
+        uint32_t nGeneration = 0;
+    };
+
+    std::mutex m_oMutex;
+    std::unordered_map<std::wstring, MonitoredItem> m_mMonitoredItems;
+    uint32_t m_nGeneration = 0;
 };
 
 } // namespace impl
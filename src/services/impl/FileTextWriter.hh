@@ -34,6 +34,12 @@ public:
         }
     }
 
+    void Write(_In_reads_(nBytes) const char* pData, _In_ size_t nBytes) override
+    {
+        if (m_oStream.is_open())
+            m_oStream.write(pData, ra::to_signed(nBytes));
+    }
+
     void WriteLine() override
     {
         if (m_oStream.is_open())
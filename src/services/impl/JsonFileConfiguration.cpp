@@ -129,6 +129,8 @@ bool JsonFileConfiguration::Load(const std::wstring& sFilename)
 
     if (doc.HasMember("Prefer Decimal"))
         SetFeatureEnabled(Feature::PreferDecimal, doc["Prefer Decimal"].GetBool());
+    if (doc.HasMember("Pooled HTTP Connections"))
+        SetFeatureEnabled(Feature::PooledHttpConnections, doc["Pooled HTTP Connections"].GetBool());
 
     if (doc.HasMember("Num Background Threads"))
         m_nBackgroundThreads = doc["Num Background Threads"].GetUint();
@@ -219,6 +221,7 @@ void JsonFileConfiguration::Save() const
     WritePopupLocation(doc, a, "Challenge Notification Display", GetPopupLocation(ra::ui::viewmodels::Popup::Challenge));
     WritePopupLocation(doc, a, "Informational Notification Display", GetPopupLocation(ra::ui::viewmodels::Popup::Message));
     doc.AddMember("Prefer Decimal", IsFeatureEnabled(Feature::PreferDecimal), a);
+    doc.AddMember("Pooled HTTP Connections", IsFeatureEnabled(Feature::PooledHttpConnections), a);
     doc.AddMember("Num Background Threads", m_nBackgroundThreads, a);
 
     if (!m_sRomDirectory.empty())
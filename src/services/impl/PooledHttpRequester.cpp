@@ -0,0 +1,650 @@
+#include "PooledHttpRequester.hh"
+
+#include "RA_Log.h"
+#include "RA_StringUtils.h"
+
+#include "services\IThreadPool.hh"
+#include "services\ServiceLocator.hh"
+
+namespace ra {
+namespace services {
+namespace impl {
+
+PooledHttpRequester::PooledHttpRequester(std::unique_ptr<IHttpRequester> pSecureRequester)
+    : m_pState(std::make_shared<PoolState>()), m_pSecureRequester(std::move(pSecureRequester))
+{
+}
+
+PooledHttpRequester::~PooledHttpRequester() noexcept
+{
+    // connections in use by outstanding requests are owned by those requests and will be closed when they finish
+    CloseIdleConnections();
+}
+
+void PooledHttpRequester::SetUserAgent(const std::string& sUserAgent)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_pState->m_oMutex);
+        m_pState->m_sUserAgent = sUserAgent;
+    }
+
+    if (m_pSecureRequester)
+        m_pSecureRequester->SetUserAgent(sUserAgent);
+}
+
+void PooledHttpRequester::CloseIdleConnections()
+{
+    std::lock_guard<std::mutex> lock(m_pState->m_oMutex);
+    for (auto& pIter : m_pState->m_mHosts)
+    {
+        auto& pHost = pIter.second;
+        pHost.nOpenConnections -= pHost.vIdleConnections.size();
+        pHost.vIdleConnections.clear();
+    }
+}
+
+bool PooledHttpRequester::ParseUrl(const Http::Request& pRequest, std::string& sHost, unsigned short& nPort, std::string& sPath)
+{
+    const auto& sUrl = pRequest.GetUrl();
+    if (sUrl.length() < 7 || _strnicmp(sUrl.c_str(), "http://", 7) != 0)
+        return false;
+
+    const auto nPathIndex = sUrl.find('/', 7);
+    if (nPathIndex == std::string::npos)
+    {
+        sHost.assign(sUrl, 7, std::string::npos);
+        sPath = "/";
+    }
+    else
+    {
+        sHost.assign(sUrl, 7, nPathIndex - 7);
+        sPath.assign(sUrl, nPathIndex, std::string::npos);
+    }
+
+    nPort = 80;
+    const auto nPortIndex = sHost.find(':');
+    if (nPortIndex != std::string::npos)
+    {
+        nPort = gsl::narrow_cast<unsigned short>(atoi(&sHost.at(nPortIndex + 1)));
+        sHost.resize(nPortIndex);
+    }
+
+    if (sHost.empty() || nPort == 0)
+        return false;
+
+    const auto& sQueryString = pRequest.GetQueryString();
+    if (!sQueryString.empty())
+    {
+        sPath.push_back('?');
+        sPath.append(sQueryString);
+    }
+
+    return true;
+}
+
+std::string PooledHttpRequester::BuildRequest(const PoolState& pState, const Http::Request& pRequest,
+                                              const std::string& sHost, unsigned short nPort, const std::string& sPath)
+{
+    const auto& sPostData = pRequest.GetPostData();
+
+    std::string sRequest;
+    sRequest.reserve(sPath.length() + sPostData.length() + 256);
+
+    sRequest.append(sPostData.empty() ? "GET " : "POST ");
+    sRequest.append(sPath);
+    sRequest.append(" HTTP/1.1\r\nHost: ");
+    sRequest.append(sHost);
+    if (nPort != 80)
+    {
+        sRequest.push_back(':');
+        sRequest.append(std::to_string(nPort));
+    }
+    sRequest.append("\r\n");
+
+    if (!pState.m_sUserAgent.empty())
+    {
+        sRequest.append("User-Agent: ");
+        sRequest.append(pState.m_sUserAgent);
+        sRequest.append("\r\n");
+    }
+
+    if (!pState.m_bKeepAlive)
+        sRequest.append("Connection: close\r\n");
+
+    if (!sPostData.empty())
+    {
+        sRequest.append("Content-Type: ");
+        sRequest.append(pRequest.GetContentType());
+        sRequest.append("\r\nContent-Length: ");
+        sRequest.append(std::to_string(sPostData.length()));
+        sRequest.append("\r\n");
+    }
+
+    sRequest.append("\r\n");
+    sRequest.append(sPostData);
+
+    return sRequest;
+}
+
+PooledHttpRequester::HostPool& PooledHttpRequester::GetHostPool(PoolState& pState, const std::string& sHost, unsigned short nPort)
+{
+    // caller must hold the lock. entries are never removed, so the reference remains valid after the lock is released.
+    auto pResult = pState.m_mHosts.try_emplace(ra::StringPrintf("%s:%u", sHost, nPort));
+    if (pResult.second)
+    {
+        pResult.first->second.sHost = sHost;
+        pResult.first->second.nPort = nPort;
+    }
+
+    return pResult.first->second;
+}
+
+unsigned int PooledHttpRequester::AcquireConnection(PoolState& pState, HostPool& pHost, std::unique_ptr<Connection>& pConnection)
+{
+    {
+        std::unique_lock<std::mutex> lock(pState.m_oMutex);
+        do
+        {
+            const auto tNow = std::chrono::steady_clock::now();
+            while (!pHost.vIdleConnections.empty())
+            {
+                pConnection = std::move(pHost.vIdleConnections.back());
+                pHost.vIdleConnections.pop_back();
+
+                if (tNow - pConnection->tLastUsed < pState.m_tIdleTimeout)
+                {
+                    pConnection->bReused = true;
+                    return 0;
+                }
+
+                // idle too long - the server has probably closed it
+                pConnection.reset();
+                --pHost.nOpenConnections;
+            }
+
+            if (pHost.nOpenConnections < pState.m_nMaxConnectionsPerHost)
+            {
+                // reserve a slot for the new connection
+                ++pHost.nOpenConnections;
+                break;
+            }
+
+            pState.m_cvConnectionAvailable.wait(lock);
+        } while (true);
+    }
+
+    pConnection = std::make_unique<Connection>();
+    if (!pConnection->pSocket.Connect(pHost.sHost, pHost.nPort))
+    {
+        const auto nStatusCode = GetErrorCode(*pConnection);
+        RA_LOG_WARN("Could not connect to %s:%u", pHost.sHost.c_str(), pHost.nPort);
+        ReleaseConnection(pState, pHost, std::move(pConnection), false);
+        return nStatusCode;
+    }
+
+    pConnection->pSocket.SetTimeout(pState.m_tTimeout);
+    ++pState.m_nConnectionsOpened;
+    return 0;
+}
+
+void PooledHttpRequester::ReleaseConnection(PoolState& pState, HostPool& pHost,
+                                            std::unique_ptr<Connection>&& pConnection, bool bReusable)
+{
+    if (pConnection != nullptr && bReusable && pState.m_bKeepAlive)
+    {
+        pConnection->tLastUsed = std::chrono::steady_clock::now();
+
+        std::lock_guard<std::mutex> lock(pState.m_oMutex);
+        pHost.vIdleConnections.push_back(std::move(pConnection));
+    }
+    else
+    {
+        pConnection.reset();
+
+        std::lock_guard<std::mutex> lock(pState.m_oMutex);
+        --pHost.nOpenConnections;
+    }
+
+    // the condition variable is shared by all hosts, make sure the waiter for this host is woken
+    pState.m_cvConnectionAvailable.notify_all();
+}
+
+unsigned int PooledHttpRequester::GetErrorCode(const Connection& pConnection) noexcept
+{
+    switch (pConnection.pSocket.GetLastError())
+    {
+        case TcpSocket::Error::NameNotResolved:
+            return HTTP_ERROR_NAME_NOT_RESOLVED;
+        case TcpSocket::Error::CannotConnect:
+            return HTTP_ERROR_CANNOT_CONNECT;
+        case TcpSocket::Error::Timeout:
+            return HTTP_ERROR_TIMEOUT;
+        default:
+            return HTTP_ERROR_CONNECTION_RESET;
+    }
+}
+
+static bool ReceiveMore(TcpSocket& pSocket, std::string& sBuffer)
+{
+    std::array<char, 16384> pChunk{};
+    const auto nReceived = pSocket.Receive(pChunk.data(), pChunk.size());
+    if (nReceived <= 0)
+        return false;
+
+    sBuffer.append(pChunk.data(), gsl::narrow_cast<size_t>(nReceived));
+    return true;
+}
+
+static bool HeaderNameEquals(const std::string& sHeaders, size_t nStart, size_t nLength, const char* sName) noexcept
+{
+    const auto nNameLength = strlen(sName);
+    return (nLength == nNameLength && _strnicmp(&sHeaders.at(nStart), sName, nNameLength) == 0);
+}
+
+bool PooledHttpRequester::ReadResponse(Connection& pConnection, Response& pResponse)
+{
+    auto& sBuffer = pConnection.sBuffer;
+    bool bChunked = false;
+    size_t nContentLength = std::string::npos;
+
+    do
+    {
+        size_t nHeaderEnd = sBuffer.find("\r\n\r\n");
+        while (nHeaderEnd == std::string::npos)
+        {
+            if (!ReceiveMore(pConnection.pSocket, sBuffer))
+                return false;
+
+            pResponse.bReceivedData = true;
+            nHeaderEnd = sBuffer.find("\r\n\r\n");
+        }
+
+        pResponse.bReceivedData = true;
+
+        // status line: HTTP/1.1 200 OK
+        if (nHeaderEnd < 12 || sBuffer.compare(0, 7, "HTTP/1.") != 0)
+        {
+            pResponse.nStatusCode = HTTP_ERROR_INVALID_SERVER_RESPONSE;
+            return false;
+        }
+
+        pResponse.bKeepAlive = (sBuffer.at(7) != '0');
+        pResponse.nStatusCode = gsl::narrow_cast<unsigned int>(std::strtoul(&sBuffer.at(9), nullptr, 10));
+        if (pResponse.nStatusCode < 100 || pResponse.nStatusCode > 599)
+        {
+            pResponse.nStatusCode = HTTP_ERROR_INVALID_SERVER_RESPONSE;
+            return false;
+        }
+
+        size_t nLineStart = sBuffer.find("\r\n") + 2;
+        while (nLineStart < nHeaderEnd)
+        {
+            const auto nLineEnd = sBuffer.find("\r\n", nLineStart);
+            const auto nColon = sBuffer.find(':', nLineStart);
+            if (nColon < nLineEnd)
+            {
+                auto nValueStart = nColon + 1;
+                while (nValueStart < nLineEnd && sBuffer.at(nValueStart) == ' ')
+                    ++nValueStart;
+
+                const auto nNameLength = nColon - nLineStart;
+                if (HeaderNameEquals(sBuffer, nLineStart, nNameLength, "Content-Length"))
+                {
+                    nContentLength = gsl::narrow_cast<size_t>(std::strtoull(&sBuffer.at(nValueStart), nullptr, 10));
+                }
+                else if (HeaderNameEquals(sBuffer, nLineStart, nNameLength, "Transfer-Encoding"))
+                {
+                    const auto sValue = sBuffer.substr(nValueStart, nLineEnd - nValueStart);
+                    bChunked = (sValue.find("chunked") != std::string::npos);
+                }
+                else if (HeaderNameEquals(sBuffer, nLineStart, nNameLength, "Connection"))
+                {
+                    if (HeaderNameEquals(sBuffer, nValueStart, nLineEnd - nValueStart, "close"))
+                        pResponse.bKeepAlive = false;
+                    else if (HeaderNameEquals(sBuffer, nValueStart, nLineEnd - nValueStart, "keep-alive"))
+                        pResponse.bKeepAlive = true;
+                }
+            }
+
+            nLineStart = nLineEnd + 2;
+        }
+
+        sBuffer.erase(0, nHeaderEnd + 4);
+
+        // informational responses (i.e. 100 Continue) are followed by the real response
+    } while (pResponse.nStatusCode < 200);
+
+    if (pResponse.nStatusCode == 204 || pResponse.nStatusCode == 304)
+        return true;
+
+    if (bChunked)
+    {
+        do
+        {
+            size_t nLineEnd = sBuffer.find("\r\n");
+            while (nLineEnd == std::string::npos)
+            {
+                if (!ReceiveMore(pConnection.pSocket, sBuffer))
+                    return false;
+
+                nLineEnd = sBuffer.find("\r\n");
+            }
+
+            const auto nChunkSize = gsl::narrow_cast<size_t>(std::strtoull(sBuffer.c_str(), nullptr, 16));
+            sBuffer.erase(0, nLineEnd + 2);
+
+            if (nChunkSize == 0)
+            {
+                // skip any trailers. the response ends with an empty line
+                do
+                {
+                    nLineEnd = sBuffer.find("\r\n");
+                    while (nLineEnd == std::string::npos)
+                    {
+                        if (!ReceiveMore(pConnection.pSocket, sBuffer))
+                            return false;
+
+                        nLineEnd = sBuffer.find("\r\n");
+                    }
+
+                    sBuffer.erase(0, nLineEnd + 2);
+                } while (nLineEnd != 0);
+
+                return true;
+            }
+
+            while (sBuffer.length() < nChunkSize + 2)
+            {
+                if (!ReceiveMore(pConnection.pSocket, sBuffer))
+                    return false;
+            }
+
+            pResponse.sContent.append(sBuffer, 0, nChunkSize);
+            sBuffer.erase(0, nChunkSize + 2);
+        } while (true);
+    }
+
+    if (nContentLength != std::string::npos)
+    {
+        while (sBuffer.length() < nContentLength)
+        {
+            if (!ReceiveMore(pConnection.pSocket, sBuffer))
+                return false;
+        }
+
+        pResponse.sContent.assign(sBuffer, 0, nContentLength);
+        sBuffer.erase(0, nContentLength);
+        return true;
+    }
+
+    // no length specified, content ends when the server closes the connection
+    while (ReceiveMore(pConnection.pSocket, sBuffer))
+        continue;
+
+    if (pConnection.pSocket.GetLastError() == TcpSocket::Error::Timeout)
+        return false;
+
+    pResponse.sContent.swap(sBuffer);
+    pResponse.bKeepAlive = false;
+    return true;
+}
+
+unsigned int PooledHttpRequester::Request(const Http::Request& pRequest, TextWriter& pContentWriter) const
+{
+    std::string sHost, sPath;
+    unsigned short nPort = 0;
+    if (!ParseUrl(pRequest, sHost, nPort, sPath))
+    {
+        if (m_pSecureRequester)
+            return m_pSecureRequester->Request(pRequest, pContentWriter);
+
+        return HTTP_ERROR_CANNOT_CONNECT;
+    }
+
+    HostPool* pHost = nullptr;
+    std::string sRequest;
+    {
+        std::lock_guard<std::mutex> lock(m_pState->m_oMutex);
+        pHost = &GetHostPool(*m_pState, sHost, nPort);
+        sRequest = BuildRequest(*m_pState, pRequest, sHost, nPort, sPath);
+    }
+
+    const bool bIdempotent = pRequest.GetPostData().empty();
+    Response pResponse;
+    unsigned int nStatusCode = 0;
+    do
+    {
+        std::unique_ptr<Connection> pConnection;
+        nStatusCode = AcquireConnection(*m_pState, *pHost, pConnection);
+        if (nStatusCode != 0)
+            return nStatusCode;
+
+        pResponse = Response();
+        if (pConnection->pSocket.Send(sRequest.data(), sRequest.length()) && ReadResponse(*pConnection, pResponse))
+        {
+            nStatusCode = pResponse.nStatusCode;
+            ReleaseConnection(*m_pState, *pHost, std::move(pConnection), pResponse.bKeepAlive);
+            break;
+        }
+
+        nStatusCode = (pResponse.nStatusCode == HTTP_ERROR_INVALID_SERVER_RESPONSE) ?
+            HTTP_ERROR_INVALID_SERVER_RESPONSE : GetErrorCode(*pConnection);
+
+        // the server may close an idle connection at any time. if nothing was received, a GET can safely be sent
+        // again on a new connection. a POST can't - the server may have processed it before closing the connection.
+        const bool bRetry = bIdempotent && pConnection->bReused && !pResponse.bReceivedData;
+        ReleaseConnection(*m_pState, *pHost, std::move(pConnection), false);
+
+        if (!bRetry)
+            return nStatusCode;
+    } while (true);
+
+    if (!pResponse.sContent.empty())
+        pContentWriter.Write(pResponse.sContent);
+
+    return nStatusCode;
+}
+
+bool PooledHttpRequester::RequestAsync(const Http::Request& pRequest, AsyncCallback&& fCallback) const
+{
+    std::string sHost, sPath;
+    unsigned short nPort = 0;
+    if (!ParseUrl(pRequest, sHost, nPort, sPath))
+        return m_pSecureRequester && m_pSecureRequester->RequestAsync(pRequest, std::move(fCallback));
+
+    HostPool* pHost = nullptr;
+    bool bStartDispatcher = false;
+    {
+        std::lock_guard<std::mutex> lock(m_pState->m_oMutex);
+        pHost = &GetHostPool(*m_pState, sHost, nPort);
+
+        PendingRequest pPending;
+        pPending.sRequest = BuildRequest(*m_pState, pRequest, sHost, nPort, sPath);
+        pPending.fCallback = std::move(fCallback);
+        pPending.bIdempotent = pRequest.GetPostData().empty();
+        pHost->vPendingRequests.push_back(std::move(pPending));
+
+        // each dispatcher owns one connection. once all of the connections are in use, additional GET requests are
+        // pipelined onto the existing connections by the dispatchers.
+        if (pHost->nActiveDispatchers < m_pState->m_nMaxConnectionsPerHost)
+        {
+            ++pHost->nActiveDispatchers;
+            bStartDispatcher = true;
+        }
+    }
+
+    if (bStartDispatcher)
+    {
+        auto& pThreadPool = ra::services::ServiceLocator::GetMutable<ra::services::IThreadPool>();
+        pThreadPool.RunAsync([pState = m_pState, pHost]() { ProcessPendingRequests(pState, *pHost); });
+    }
+
+    return true;
+}
+
+void PooledHttpRequester::ProcessPendingRequests(std::shared_ptr<PoolState> pState, HostPool& pHost)
+{
+    std::vector<PendingRequest> vBatch;
+    std::vector<Response> vResponses;
+    std::vector<PendingRequest> vFailed;
+
+    do
+    {
+        vBatch.clear();
+        {
+            std::lock_guard<std::mutex> lock(pState->m_oMutex);
+            if (pHost.vPendingRequests.empty())
+            {
+                --pHost.nActiveDispatchers;
+                return;
+            }
+
+            // a POST is sent by itself. if the connection fails, there's no way to tell whether the server processed
+            // it, so it must not be queued behind (or ahead of) other requests that might have to be sent again.
+            do
+            {
+                vBatch.push_back(std::move(pHost.vPendingRequests.front()));
+                pHost.vPendingRequests.pop_front();
+            } while (vBatch.size() < pState->m_nMaxPipelineDepth && !pHost.vPendingRequests.empty() &&
+                     vBatch.front().bIdempotent && pHost.vPendingRequests.front().bIdempotent);
+        }
+
+        std::unique_ptr<Connection> pConnection;
+        auto nStatusCode = AcquireConnection(*pState, pHost, pConnection);
+        if (nStatusCode != 0)
+        {
+            for (auto& pPending : vBatch)
+                pPending.fCallback(nStatusCode, std::string());
+
+            continue;
+        }
+
+        // send all of the requests at once, then read the responses in order
+        std::string sData;
+        for (const auto& pPending : vBatch)
+            sData.append(pPending.sRequest);
+
+        vResponses.clear();
+        bool bReusable = false;
+        bool bPartialResponse = false;
+        if (pConnection->pSocket.Send(sData.data(), sData.length()))
+        {
+            do
+            {
+                auto& pResponse = vResponses.emplace_back();
+                if (!ReadResponse(*pConnection, pResponse))
+                {
+                    bPartialResponse = pResponse.bReceivedData;
+                    nStatusCode = (pResponse.nStatusCode == HTTP_ERROR_INVALID_SERVER_RESPONSE) ?
+                        HTTP_ERROR_INVALID_SERVER_RESPONSE : GetErrorCode(*pConnection);
+                    vResponses.pop_back();
+                    break;
+                }
+
+                // the server will close the connection after this response. any remaining requests were not processed.
+                if (!pResponse.bKeepAlive)
+                    break;
+            } while (vResponses.size() < vBatch.size());
+
+            bReusable = (vResponses.size() == vBatch.size() && vResponses.back().bKeepAlive);
+        }
+        else
+        {
+            nStatusCode = GetErrorCode(*pConnection);
+        }
+
+        // release the connection before calling the callbacks in case they make additional requests
+        ReleaseConnection(*pState, pHost, std::move(pConnection), bReusable);
+
+        const auto nCompleted = vResponses.size();
+        for (size_t i = 0; i < nCompleted; ++i)
+        {
+            auto& pResponse = vResponses.at(i);
+            vBatch.at(i).fCallback(pResponse.nStatusCode, std::move(pResponse.sContent));
+        }
+
+        if (nCompleted < vBatch.size())
+        {
+            // GET requests that never got a response are sent again on a new connection. if part of a response was
+            // received, the server processed the request, so don't send it again. POST requests are never sent
+            // again as the server may have processed them before the connection failed.
+            vFailed.clear();
+            {
+                std::lock_guard<std::mutex> lock(pState->m_oMutex);
+                for (size_t i = vBatch.size(); i > nCompleted; --i)
+                {
+                    auto& pPending = vBatch.at(i - 1);
+                    if (pPending.bRetried || !pPending.bIdempotent || (i - 1 == nCompleted && bPartialResponse))
+                    {
+                        vFailed.push_back(std::move(pPending));
+                    }
+                    else
+                    {
+                        pPending.bRetried = true;
+                        pHost.vPendingRequests.push_front(std::move(pPending));
+                    }
+                }
+            }
+
+            for (auto pIter = vFailed.rbegin(); pIter != vFailed.rend(); ++pIter)
+                pIter->fCallback(nStatusCode, std::string());
+        }
+    } while (true);
+}
+
+bool PooledHttpRequester::IsRetryable(unsigned int nStatusCode) const noexcept
+{
+    switch (nStatusCode)
+    {
+        case 0:                             // Not attempted
+        case 200:                           // Success (empty response)
+        case HTTP_ERROR_TIMEOUT:
+        case HTTP_ERROR_NAME_NOT_RESOLVED:
+        case HTTP_ERROR_CANNOT_CONNECT:
+        case HTTP_ERROR_CONNECTION_RESET:
+        case HTTP_ERROR_INVALID_SERVER_RESPONSE:
+            return true;
+
+        default:
+            return m_pSecureRequester && m_pSecureRequester->IsRetryable(nStatusCode);
+    }
+}
+
+std::string PooledHttpRequester::GetStatusCodeText(unsigned int nStatusCode) const
+{
+    switch (nStatusCode)
+    {
+        case HTTP_ERROR_TIMEOUT: return "The operation timed out";
+        case HTTP_ERROR_NAME_NOT_RESOLVED: return "The server name or address could not be resolved";
+        case HTTP_ERROR_CANNOT_CONNECT: return "A connection with the server could not be established";
+        case HTTP_ERROR_CONNECTION_RESET: return "The connection with the server was reset";
+        case HTTP_ERROR_INVALID_SERVER_RESPONSE: return "The server returned an invalid or unrecognized response";
+    }
+
+    if (m_pSecureRequester)
+        return m_pSecureRequester->GetStatusCodeText(nStatusCode);
+
+    switch (nStatusCode)
+    {
+        case 204: return "No Content";
+        case 301: return "Moved Permanently";
+        case 302: return "Moved Temporarily";
+        case 400: return "Bad Request";
+        case 401: return "Unauthorized";
+        case 403: return "Forbidden";
+        case 404: return "Not Found";
+        case 408: return "Request Time-out";
+        case 413: return "Request Entity Too Large";
+        case 414: return "Request-URI Too Large";
+        case 429: return "Too Many Requests";
+        case 500: return "Internal Server Error";
+        case 501: return "Not Implemented";
+        case 502: return "Bad Gateway";
+        case 503: return "Service Unavailable";
+        default: return "";
+    }
+}
+
+} // namespace impl
+} // namespace services
+} // namespace ra
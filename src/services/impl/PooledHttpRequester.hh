@@ -0,0 +1,158 @@
+#ifndef RA_SERVICES_POOLEDHTTPREQUESTER_HH
+#define RA_SERVICES_POOLEDHTTPREQUESTER_HH
+#pragma once
+
+#include "services\IHttpRequester.hh"
+
+#include "services\impl\TcpSocket.hh"
+
+namespace ra {
+namespace services {
+namespace impl {
+
+/// <summary>
+/// HTTP/1.1 requester that keeps connections open and reuses them for subsequent requests to the same host.
+/// </summary>
+/// <remarks>
+/// Only plain http requests are handled directly. Anything else (i.e. https) is passed to the secure requester.
+/// Proxies and redirects are not supported, so this is only used when
+/// <see cref="ra::services::Feature::PooledHttpConnections" /> is enabled.
+/// </remarks>
+class PooledHttpRequester : public IHttpRequester
+{
+public:
+    explicit PooledHttpRequester(std::unique_ptr<IHttpRequester> pSecureRequester = nullptr);
+    ~PooledHttpRequester() noexcept;
+    PooledHttpRequester(const PooledHttpRequester&) noexcept = delete;
+    PooledHttpRequester& operator=(const PooledHttpRequester&) noexcept = delete;
+    PooledHttpRequester(PooledHttpRequester&&) noexcept = delete;
+    PooledHttpRequester& operator=(PooledHttpRequester&&) noexcept = delete;
+
+    void SetUserAgent(const std::string& sUserAgent) override;
+
+    unsigned int Request(const Http::Request& pRequest, TextWriter& pContentWriter) const override;
+
+    bool RequestAsync(const Http::Request& pRequest, AsyncCallback&& fCallback) const override;
+
+    bool IsRetryable(unsigned int nStatusCode) const noexcept override;
+
+    std::string GetStatusCodeText(unsigned int nStatusCode) const override;
+
+    /// <summary>
+    /// Sets the maximum number of simultaneous connections to a single host.
+    /// </summary>
+    void SetMaxConnectionsPerHost(size_t nValue) noexcept { m_pState->m_nMaxConnectionsPerHost = std::max(nValue, size_t{1}); }
+
+    /// <summary>
+    /// Sets the maximum number of asynchronous requests that will be sent on a connection before waiting for responses.
+    /// </summary>
+    /// <remarks>
+    /// Only GET requests are pipelined. POST requests change state on the server, so each is sent on a connection
+    /// by itself and is never sent again automatically.
+    /// </remarks>
+    void SetMaxPipelineDepth(size_t nValue) noexcept { m_pState->m_nMaxPipelineDepth = std::max(nValue, size_t{1}); }
+
+    /// <summary>
+    /// Sets whether connections are kept open after a request completes.
+    /// </summary>
+    void SetKeepAlive(bool bValue) noexcept { m_pState->m_bKeepAlive = bValue; }
+
+    /// <summary>
+    /// Sets how long a connection may sit unused before it is closed instead of reused.
+    /// </summary>
+    void SetIdleTimeout(std::chrono::milliseconds tValue) noexcept { m_pState->m_tIdleTimeout = tValue; }
+
+    /// <summary>
+    /// Sets how long to wait for the server to accept or respond to a request.
+    /// </summary>
+    void SetTimeout(std::chrono::milliseconds tValue) noexcept { m_pState->m_tTimeout = tValue; }
+
+    /// <summary>
+    /// Gets the number of connections that have been opened.
+    /// </summary>
+    size_t GetConnectionsOpened() const noexcept { return m_pState->m_nConnectionsOpened; }
+
+    /// <summary>
+    /// Closes any connections that are not currently in use.
+    /// </summary>
+    void CloseIdleConnections();
+
+    // status codes for failures that occur before a response is received.
+    // these match the equivalent wininet error codes.
+    static constexpr unsigned int HTTP_ERROR_TIMEOUT = 12002;
+    static constexpr unsigned int HTTP_ERROR_NAME_NOT_RESOLVED = 12007;
+    static constexpr unsigned int HTTP_ERROR_CANNOT_CONNECT = 12029;
+    static constexpr unsigned int HTTP_ERROR_CONNECTION_RESET = 12031;
+    static constexpr unsigned int HTTP_ERROR_INVALID_SERVER_RESPONSE = 12152;
+
+private:
+    struct Connection
+    {
+        TcpSocket pSocket;
+        std::string sBuffer; // data received but not yet processed
+        std::chrono::steady_clock::time_point tLastUsed;
+        bool bReused = false;
+    };
+
+    struct PendingRequest
+    {
+        std::string sRequest;
+        AsyncCallback fCallback;
+        bool bIdempotent = true;
+        bool bRetried = false;
+    };
+
+    struct HostPool
+    {
+        std::string sHost;
+        unsigned short nPort = 0;
+        std::vector<std::unique_ptr<Connection>> vIdleConnections;
+        size_t nOpenConnections = 0;
+        std::deque<PendingRequest> vPendingRequests;
+        size_t nActiveDispatchers = 0;
+    };
+
+    struct PoolState
+    {
+        std::mutex m_oMutex;
+        std::condition_variable m_cvConnectionAvailable;
+        std::unordered_map<std::string, HostPool> m_mHosts;
+        std::string m_sUserAgent;
+
+        size_t m_nMaxConnectionsPerHost = 6;
+        size_t m_nMaxPipelineDepth = 4;
+        bool m_bKeepAlive = true;
+        std::chrono::milliseconds m_tIdleTimeout{30000};
+        std::chrono::milliseconds m_tTimeout{30000};
+        std::atomic<size_t> m_nConnectionsOpened{0};
+    };
+
+    struct Response
+    {
+        unsigned int nStatusCode = 0;
+        std::string sContent;
+        bool bKeepAlive = true;
+        bool bReceivedData = false;
+    };
+
+    static HostPool& GetHostPool(PoolState& pState, const std::string& sHost, unsigned short nPort);
+    static bool ParseUrl(const Http::Request& pRequest, std::string& sHost, unsigned short& nPort, std::string& sPath);
+    static std::string BuildRequest(const PoolState& pState, const Http::Request& pRequest,
+                                    const std::string& sHost, unsigned short nPort, const std::string& sPath);
+
+    static unsigned int AcquireConnection(PoolState& pState, HostPool& pHost, std::unique_ptr<Connection>& pConnection);
+    static void ReleaseConnection(PoolState& pState, HostPool& pHost, std::unique_ptr<Connection>&& pConnection, bool bReusable);
+    static bool ReadResponse(Connection& pConnection, Response& pResponse);
+    static unsigned int GetErrorCode(const Connection& pConnection) noexcept;
+
+    static void ProcessPendingRequests(std::shared_ptr<PoolState> pState, HostPool& pHost);
+
+    std::shared_ptr<PoolState> m_pState;
+    std::unique_ptr<IHttpRequester> m_pSecureRequester;
+};
+
+} // namespace impl
+} // namespace services
+} // namespace ra
+
+#endif // !RA_SERVICES_POOLEDHTTPREQUESTER_HH
@@ -24,16 +24,18 @@ public:
         m_nWritePosition = sOutput.length();
     }
 
-    void Write(_In_ const std::string& sText) override
+    void Write(_In_ const std::string& sText) override { Write(sText.c_str(), sText.length()); }
+
+    void Write(_In_reads_(nBytes) const char* pData, _In_ size_t nBytes) override
     {
         if (gsl::narrow_cast<std::size_t>(m_nWritePosition) < m_sOutput.length())
         {
-            m_sOutput.replace(gsl::narrow_cast<std::size_t>(m_nWritePosition), sText.length(), sText.c_str());
-            m_nWritePosition += sText.length();
+            m_sOutput.replace(gsl::narrow_cast<std::size_t>(m_nWritePosition), nBytes, pData, nBytes);
+            m_nWritePosition += nBytes;
         }
         else
         {
-            m_sOutput.append(sText);
+            m_sOutput.append(pData, nBytes);
             m_nWritePosition = m_sOutput.length();
         }
     }
@@ -0,0 +1,248 @@
+#include "TcpSocket.hh"
+
+#ifdef _WIN32
+#include <WinSock2.h>
+#include <WS2tcpip.h>
+
+#pragma comment(lib, "ws2_32.lib")
+
+using socklen_t = int;
+#else
+#include <cerrno>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#define closesocket close
+#define SD_BOTH SHUT_RDWR
+using SOCKET = int;
+#endif
+
+namespace ra {
+namespace services {
+namespace impl {
+
+static void InitializeSockets() noexcept
+{
+#ifdef _WIN32
+    static std::once_flag oInitialized;
+    std::call_once(oInitialized, []() noexcept {
+        WSADATA pData{};
+        WSAStartup(MAKEWORD(2, 2), &pData);
+    });
+#endif
+}
+
+static SOCKET ToNative(uintptr_t nSocket) noexcept
+{
+    return static_cast<SOCKET>(nSocket);
+}
+
+static void DisableCoalescing(SOCKET nSocket) noexcept
+{
+    // messages are small and written in one call - don't wait to coalesce them with the next one
+    int nNoDelay = 1;
+    GSL_SUPPRESS_TYPE1 setsockopt(nSocket, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&nNoDelay), sizeof(nNoDelay));
+}
+
+TcpSocket::TcpSocket(TcpSocket&& pOther) noexcept
+    : m_nSocket(pOther.m_nSocket), m_nLastError(pOther.m_nLastError)
+{
+    pOther.m_nSocket = INVALID_SOCKET_HANDLE;
+}
+
+TcpSocket& TcpSocket::operator=(TcpSocket&& pOther) noexcept
+{
+    if (&pOther != this)
+    {
+        Close();
+
+        m_nSocket = pOther.m_nSocket;
+        m_nLastError = pOther.m_nLastError;
+        pOther.m_nSocket = INVALID_SOCKET_HANDLE;
+    }
+
+    return *this;
+}
+
+void TcpSocket::SetLastErrorFromSystem() noexcept
+{
+#ifdef _WIN32
+    const int nError = WSAGetLastError();
+    const bool bTimeout = (nError == WSAETIMEDOUT);
+#else
+    const int nError = errno;
+    const bool bTimeout = (nError == EAGAIN || nError == EWOULDBLOCK || nError == ETIMEDOUT);
+#endif
+
+    m_nLastError = bTimeout ? Error::Timeout : Error::ConnectionReset;
+}
+
+bool TcpSocket::Connect(const std::string& sHost, unsigned short nPort)
+{
+    Close();
+    InitializeSockets();
+
+    addrinfo pHints{};
+    pHints.ai_family = AF_UNSPEC;
+    pHints.ai_socktype = SOCK_STREAM;
+    pHints.ai_protocol = IPPROTO_TCP;
+
+    addrinfo* pAddresses = nullptr;
+    const auto sPort = std::to_string(nPort);
+    if (getaddrinfo(sHost.c_str(), sPort.c_str(), &pHints, &pAddresses) != 0 || pAddresses == nullptr)
+    {
+        m_nLastError = Error::NameNotResolved;
+        return false;
+    }
+
+    m_nLastError = Error::CannotConnect;
+    for (const auto* pAddress = pAddresses; pAddress != nullptr; pAddress = pAddress->ai_next)
+    {
+        const auto nSocket = socket(pAddress->ai_family, pAddress->ai_socktype, pAddress->ai_protocol);
+        if (nSocket == static_cast<SOCKET>(INVALID_SOCKET_HANDLE))
+            continue;
+
+        if (connect(nSocket, pAddress->ai_addr, gsl::narrow_cast<socklen_t>(pAddress->ai_addrlen)) == 0)
+        {
+            DisableCoalescing(nSocket);
+            m_nSocket = static_cast<SocketHandle>(nSocket);
+            m_nLastError = Error::None;
+            break;
+        }
+
+        closesocket(nSocket);
+    }
+
+    freeaddrinfo(pAddresses);
+    return IsOpen();
+}
+
+bool TcpSocket::Listen(unsigned short nPort)
+{
+    Close();
+    InitializeSockets();
+
+    const auto nSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (nSocket == static_cast<SOCKET>(INVALID_SOCKET_HANDLE))
+    {
+        m_nLastError = Error::CannotConnect;
+        return false;
+    }
+
+    sockaddr_in pAddress{};
+    pAddress.sin_family = AF_INET;
+    pAddress.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    pAddress.sin_port = htons(nPort);
+
+    GSL_SUPPRESS_TYPE1
+    if (bind(nSocket, reinterpret_cast<const sockaddr*>(&pAddress), sizeof(pAddress)) != 0 || listen(nSocket, SOMAXCONN) != 0)
+    {
+        closesocket(nSocket);
+        m_nLastError = Error::CannotConnect;
+        return false;
+    }
+
+    m_nSocket = static_cast<SocketHandle>(nSocket);
+    m_nLastError = Error::None;
+    return true;
+}
+
+TcpSocket TcpSocket::Accept() const
+{
+    const auto nSocket = accept(ToNative(m_nSocket), nullptr, nullptr);
+    if (nSocket == static_cast<SOCKET>(INVALID_SOCKET_HANDLE))
+        return TcpSocket();
+
+    DisableCoalescing(nSocket);
+    return TcpSocket(static_cast<SocketHandle>(nSocket));
+}
+
+unsigned short TcpSocket::GetLocalPort() const noexcept
+{
+    sockaddr_in pAddress{};
+    socklen_t nLength = sizeof(pAddress);
+
+    GSL_SUPPRESS_TYPE1
+    if (getsockname(ToNative(m_nSocket), reinterpret_cast<sockaddr*>(&pAddress), &nLength) != 0)
+        return 0;
+
+    return ntohs(pAddress.sin_port);
+}
+
+void TcpSocket::SetTimeout(std::chrono::milliseconds tTimeout) noexcept
+{
+#ifdef _WIN32
+    const DWORD nTimeout = gsl::narrow_cast<DWORD>(tTimeout.count());
+#else
+    timeval nTimeout{};
+    nTimeout.tv_sec = gsl::narrow_cast<decltype(nTimeout.tv_sec)>(tTimeout.count() / 1000);
+    nTimeout.tv_usec = gsl::narrow_cast<decltype(nTimeout.tv_usec)>((tTimeout.count() % 1000) * 1000);
+#endif
+
+    GSL_SUPPRESS_TYPE1 setsockopt(ToNative(m_nSocket), SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&nTimeout), sizeof(nTimeout));
+    GSL_SUPPRESS_TYPE1 setsockopt(ToNative(m_nSocket), SOL_SOCKET, SO_SNDTIMEO, reinterpret_cast<const char*>(&nTimeout), sizeof(nTimeout));
+}
+
+bool TcpSocket::Send(const char* pData, size_t nSize)
+{
+#ifdef MSG_NOSIGNAL
+    constexpr int nFlags = MSG_NOSIGNAL;
+#else
+    constexpr int nFlags = 0;
+#endif
+
+    while (nSize > 0)
+    {
+        const auto nChunk = gsl::narrow_cast<int>(std::min(nSize, size_t{0x10000}));
+        const auto nSent = send(ToNative(m_nSocket), pData, nChunk, nFlags);
+        if (nSent <= 0)
+        {
+            SetLastErrorFromSystem();
+            return false;
+        }
+
+        GSL_SUPPRESS_BOUNDS4 pData += nSent;
+        nSize -= gsl::narrow_cast<size_t>(nSent);
+    }
+
+    return true;
+}
+
+int TcpSocket::Receive(char* pBuffer, size_t nSize)
+{
+    const auto nChunk = gsl::narrow_cast<int>(std::min(nSize, size_t{0x10000}));
+    const auto nReceived = recv(ToNative(m_nSocket), pBuffer, nChunk, 0);
+    if (nReceived < 0)
+    {
+        SetLastErrorFromSystem();
+        return -1;
+    }
+
+    if (nReceived == 0)
+        m_nLastError = Error::ConnectionReset;
+
+    return gsl::narrow_cast<int>(nReceived);
+}
+
+void TcpSocket::Shutdown() noexcept
+{
+    if (IsOpen())
+        shutdown(ToNative(m_nSocket), SD_BOTH);
+}
+
+void TcpSocket::Close() noexcept
+{
+    if (IsOpen())
+    {
+        closesocket(ToNative(m_nSocket));
+        m_nSocket = INVALID_SOCKET_HANDLE;
+    }
+}
+
+} // namespace impl
+} // namespace services
+} // namespace ra
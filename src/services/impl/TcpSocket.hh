@@ -0,0 +1,108 @@
+#ifndef RA_SERVICES_TCPSOCKET_HH
+#define RA_SERVICES_TCPSOCKET_HH
+#pragma once
+
+#include "ra_fwd.h"
+
+namespace ra {
+namespace services {
+namespace impl {
+
+/// <summary>
+/// Minimal blocking TCP socket wrapper.
+/// </summary>
+class TcpSocket
+{
+public:
+    enum class Error
+    {
+        None = 0,
+        NameNotResolved,
+        CannotConnect,
+        Timeout,
+        ConnectionReset,
+    };
+
+    TcpSocket() noexcept = default;
+    ~TcpSocket() noexcept { Close(); }
+    TcpSocket(const TcpSocket&) noexcept = delete;
+    TcpSocket& operator=(const TcpSocket&) noexcept = delete;
+    TcpSocket(TcpSocket&& pOther) noexcept;
+    TcpSocket& operator=(TcpSocket&& pOther) noexcept;
+
+    /// <summary>
+    /// Opens a connection to the specified host.
+    /// </summary>
+    /// <returns><c>true</c> if the connection was established, <c>false</c> if not. See <see cref="GetLastError" />.</returns>
+    bool Connect(const std::string& sHost, unsigned short nPort);
+
+    /// <summary>
+    /// Starts listening for connections on the loopback interface.
+    /// </summary>
+    /// <param name="nPort">The port to listen on, or 0 to pick an unused port.</param>
+    bool Listen(unsigned short nPort = 0);
+
+    /// <summary>
+    /// Waits for a connection to a listening socket.
+    /// </summary>
+    /// <returns>The new connection, which will not be open if the socket was closed.</returns>
+    TcpSocket Accept() const;
+
+    /// <summary>
+    /// Gets the port the socket is bound to.
+    /// </summary>
+    unsigned short GetLocalPort() const noexcept;
+
+    /// <summary>
+    /// Sets how long <see cref="Send" /> and <see cref="Receive" /> will wait before failing.
+    /// </summary>
+    void SetTimeout(std::chrono::milliseconds tTimeout) noexcept;
+
+    /// <summary>
+    /// Sends all of the provided data.
+    /// </summary>
+    bool Send(const char* pData, size_t nSize);
+
+    /// <summary>
+    /// Reads up to <paramref name="nSize" /> bytes.
+    /// </summary>
+    /// <returns>The number of bytes read, 0 if the remote end closed the connection, or -1 on error.</returns>
+    int Receive(char* pBuffer, size_t nSize);
+
+    /// <summary>
+    /// Stops any further sends or receives. Unblocks a thread waiting in <see cref="Receive" />.
+    /// </summary>
+    void Shutdown() noexcept;
+
+    /// <summary>
+    /// Closes the socket.
+    /// </summary>
+    void Close() noexcept;
+
+    /// <summary>
+    /// Determines whether the socket is open.
+    /// </summary>
+    bool IsOpen() const noexcept { return m_nSocket != INVALID_SOCKET_HANDLE; }
+
+    /// <summary>
+    /// Gets the reason the last operation failed.
+    /// </summary>
+    Error GetLastError() const noexcept { return m_nLastError; }
+
+private:
+    using SocketHandle = uintptr_t;
+    static constexpr SocketHandle INVALID_SOCKET_HANDLE = ~SocketHandle{0};
+
+    explicit TcpSocket(SocketHandle nSocket) noexcept : m_nSocket(nSocket) {}
+
+    void SetLastErrorFromSystem() noexcept;
+
+    SocketHandle m_nSocket = INVALID_SOCKET_HANDLE;
+    Error m_nLastError = Error::None;
+};
+
+} // namespace impl
+} // namespace services
+} // namespace ra
+
+#endif // !RA_SERVICES_TCPSOCKET_HH
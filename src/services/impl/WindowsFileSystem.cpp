@@ -26,6 +26,15 @@ WindowsFileSystem::WindowsFileSystem() noexcept
     }
 }
 
+WindowsFileSystem::~WindowsFileSystem() noexcept
+{
+    for (auto& pIter : m_mDirectoryMonitors)
+    {
+        if (pIter.second.hNotification != INVALID_HANDLE_VALUE)
+            FindCloseChangeNotification(pIter.second.hNotification);
+    }
+}
+
 GSL_SUPPRESS_F6
 const std::wstring& WindowsFileSystem::MakeAbsolute(std::wstring& sBuffer, const std::wstring& sPath) const noexcept
 {
@@ -102,6 +111,31 @@ size_t WindowsFileSystem::GetFilesInDirectory(const std::wstring& sDirectory, _I
     return vResults.size() - nInitialSize;
 }
 
+size_t WindowsFileSystem::GetDirectoriesInDirectory(const std::wstring& sDirectory, _Inout_ std::vector<std::wstring>& vResults) const
+{
+    std::wstring sBuffer;
+    std::wstring sSearchString = MakeAbsolute(sBuffer, sDirectory);
+    sSearchString += L"\\*";
+
+    WIN32_FIND_DATAW ffdFile;
+    HANDLE hFind = FindFirstFileW(sSearchString.c_str(), &ffdFile);
+    if (hFind == INVALID_HANDLE_VALUE)
+        return 0U;
+
+    const size_t nInitialSize = vResults.size();
+    do
+    {
+        if (ffdFile.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+        {
+            if (wcscmp(ffdFile.cFileName, L".") != 0 && wcscmp(ffdFile.cFileName, L"..") != 0)
+                vResults.emplace_back(ffdFile.cFileName);
+        }
+    } while (FindNextFileW(hFind, &ffdFile) != 0);
+
+    FindClose(hFind);
+    return vResults.size() - nInitialSize;
+}
+
 bool WindowsFileSystem::DeleteFile(const std::wstring& sPath) const noexcept
 {
     std::wstring sBuffer;
@@ -114,7 +148,7 @@ bool WindowsFileSystem::MoveFile(const std::wstring& sOldPath, const std::wstrin
     std::wstring sBufferNew, sBufferOld;
     const auto& sAbsolutePathNew = MakeAbsolute(sBufferNew, sNewPath);
     const auto& sAbsolutePathOld = MakeAbsolute(sBufferOld, sOldPath);
-    return (MoveFileW(sAbsolutePathOld.c_str(), sAbsolutePathNew.c_str()) != 0);
+    return (MoveFileExW(sAbsolutePathOld.c_str(), sAbsolutePathNew.c_str(), MOVEFILE_REPLACE_EXISTING) != 0);
 }
 
 bool WindowsFileSystem::CopyFile(const std::wstring& sOldPath, const std::wstring& sNewPath) const noexcept
@@ -176,6 +210,48 @@ std::chrono::system_clock::time_point WindowsFileSystem::GetLastModified(const s
     return std::chrono::system_clock::from_time_t(tFileTime);
 }
 
+uint32_t WindowsFileSystem::GetDirectoryChangeCount(const std::wstring& sDirectory) const
+{
+    std::lock_guard<std::mutex> lock(m_oDirectoryMonitorMutex);
+
+    auto pIter = m_mDirectoryMonitors.find(sDirectory);
+    const bool bNewMonitor = (pIter == m_mDirectoryMonitors.end());
+    if (bNewMonitor)
+        pIter = m_mDirectoryMonitors.insert_or_assign(sDirectory, DirectoryMonitor()).first;
+
+    auto& pMonitor = pIter->second;
+    if (pMonitor.hNotification == INVALID_HANDLE_VALUE)
+    {
+        // if the directory doesn't exist yet, it can't be monitored. keep trying so monitoring starts as soon
+        // as it's created.
+        std::wstring sBuffer;
+        const auto& sAbsolutePath = MakeAbsolute(sBuffer, sDirectory);
+
+        pMonitor.hNotification = FindFirstChangeNotificationW(sAbsolutePath.c_str(), FALSE,
+            FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE);
+        if (pMonitor.hNotification == INVALID_HANDLE_VALUE)
+        {
+            if (bNewMonitor)
+                RA_LOG_WARN("Error %d monitoring directory: %s", GetLastError(), ra::Narrow(sDirectory).c_str());
+
+            // report a change every time so the caller checks the files directly
+            return ++pMonitor.nChangeCount;
+        }
+
+        // anything could have changed while the directory wasn't being monitored
+        if (!bNewMonitor)
+            return ++pMonitor.nChangeCount;
+    }
+
+    if (WaitForSingleObject(pMonitor.hNotification, 0) == WAIT_OBJECT_0)
+    {
+        ++pMonitor.nChangeCount;
+        FindNextChangeNotification(pMonitor.hNotification);
+    }
+
+    return pMonitor.nChangeCount;
+}
+
 std::unique_ptr<TextReader> WindowsFileSystem::OpenTextFile(const std::wstring& sPath) const
 {
     std::wstring sBuffer;
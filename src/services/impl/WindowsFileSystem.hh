@@ -19,17 +19,25 @@ class WindowsFileSystem : public IFileSystem
 {
 public:
     GSL_SUPPRESS_F6 WindowsFileSystem() noexcept;
+    ~WindowsFileSystem() noexcept;
+    WindowsFileSystem(const WindowsFileSystem&) noexcept = delete;
+    WindowsFileSystem& operator=(const WindowsFileSystem&) noexcept = delete;
+    WindowsFileSystem(WindowsFileSystem&&) noexcept = delete;
+    WindowsFileSystem& operator=(WindowsFileSystem&&) noexcept = delete;
 
     const std::wstring& BaseDirectory() const noexcept override { return m_sBaseDirectory; }
     bool DirectoryExists(const std::wstring& sDirectory) const noexcept override;
     bool CreateDirectory(const std::wstring& sDirectory) const noexcept override;
     size_t GetFilesInDirectory(const std::wstring& sDirectory,
                                _Inout_ std::vector<std::wstring>& vResults) const override;
+    size_t GetDirectoriesInDirectory(const std::wstring& sDirectory,
+                                     _Inout_ std::vector<std::wstring>& vResults) const override;
     bool DeleteFile(const std::wstring& sPath) const noexcept override;
     bool MoveFile(const std::wstring& sOldPath, const std::wstring& sNewPath) const noexcept override;
     bool CopyFile(const std::wstring& sSourcePath, const std::wstring& sNewPath) const noexcept override;
     int64_t GetFileSize(const std::wstring& sPath) const override;
     std::chrono::system_clock::time_point GetLastModified(const std::wstring& sPath) const override;
+    uint32_t GetDirectoryChangeCount(const std::wstring& sDirectory) const override;
     std::unique_ptr<TextReader> OpenTextFile(const std::wstring& sPath) const override;
     std::unique_ptr<TextWriter> CreateTextFile(const std::wstring& sPath) const override;
     std::unique_ptr<TextWriter> AppendTextFile(const std::wstring& sPath) const override;
@@ -42,6 +50,15 @@ private:
     const std::wstring& MakeAbsolute(std::wstring& sBuffer, const std::wstring& sPath) const noexcept;
 
     std::wstring m_sBaseDirectory;
+
+    struct DirectoryMonitor
+    {
+        HANDLE hNotification = INVALID_HANDLE_VALUE;
+        uint32_t nChangeCount = 0;
+    };
+
+    mutable std::mutex m_oDirectoryMonitorMutex;
+    mutable std::map<std::wstring, DirectoryMonitor> m_mDirectoryMonitors;
 };
 
 } // namespace impl
@@ -90,17 +90,45 @@ static void ReadIntoWriter(const HINTERNET hRequest, ra::services::TextWriter& p
     }
 }
 
-unsigned int WindowsHttpRequester::Request(const Http::Request& pRequest, TextWriter& pContentWriter) const
+WindowsHttpRequester::~WindowsHttpRequester() noexcept
 {
-    DWORD nStatusCode = 0;
+    if (m_hSession != nullptr)
+        WinHttpCloseHandle(m_hSession);
+}
 
-    // obtain a session handle.
+void WindowsHttpRequester::SetUserAgent(const std::string& sUserAgent)
+{
+    std::lock_guard<std::mutex> lock(m_oMutex);
+    m_sUserAgent = ra::Widen(sUserAgent);
+
+    if (m_hSession != nullptr)
+    {
+        WinHttpSetOption(m_hSession, WINHTTP_OPTION_USER_AGENT, m_sUserAgent.data(),
+                         gsl::narrow_cast<DWORD>(m_sUserAgent.length()));
+    }
+}
+
+LPVOID WindowsHttpRequester::GetSession() const
+{
+    std::lock_guard<std::mutex> lock(m_oMutex);
+    if (m_hSession == nullptr)
+    {
 #pragma warning(push)
 #pragma warning(disable: 26477)
-    GSL_SUPPRESS_ES47 HINTERNET hSession = WinHttpOpen(m_sUserAgent.c_str(), WINHTTP_ACCESS_TYPE_DEFAULT_PROXY,
-                                                       WINHTTP_NO_PROXY_NAME, WINHTTP_NO_PROXY_BYPASS, 0);
+        GSL_SUPPRESS_ES47 m_hSession = WinHttpOpen(m_sUserAgent.c_str(), WINHTTP_ACCESS_TYPE_DEFAULT_PROXY,
+                                                   WINHTTP_NO_PROXY_NAME, WINHTTP_NO_PROXY_BYPASS, 0);
 #pragma warning(pop)
+    }
+
+    return m_hSession;
+}
+
+unsigned int WindowsHttpRequester::Request(const Http::Request& pRequest, TextWriter& pContentWriter) const
+{
+    DWORD nStatusCode = 0;
 
+    // obtain a session handle.
+    HINTERNET hSession = GetSession();
     if (hSession == nullptr)
     {
         nStatusCode = GetLastError();
@@ -262,8 +290,6 @@ unsigned int WindowsHttpRequester::Request(const Http::Request& pRequest, TextWr
 
             WinHttpCloseHandle(hConnect);
         }
-
-        WinHttpCloseHandle(hSession);
     }
 
     return nStatusCode;
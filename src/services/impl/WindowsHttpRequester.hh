@@ -15,7 +15,14 @@ namespace impl {
 class WindowsHttpRequester : public IHttpRequester
 {
 public:
-    void SetUserAgent(const std::string& sUserAgent) override { m_sUserAgent = ra::Widen(sUserAgent); }
+    WindowsHttpRequester() noexcept = default;
+    ~WindowsHttpRequester() noexcept;
+    WindowsHttpRequester(const WindowsHttpRequester&) noexcept = delete;
+    WindowsHttpRequester& operator=(const WindowsHttpRequester&) noexcept = delete;
+    WindowsHttpRequester(WindowsHttpRequester&&) noexcept = delete;
+    WindowsHttpRequester& operator=(WindowsHttpRequester&&) noexcept = delete;
+
+    void SetUserAgent(const std::string& sUserAgent) override;
 
     unsigned int Request(const Http::Request& pRequest, TextWriter& pContentWriter) const override;
 
@@ -24,7 +31,14 @@ public:
     std::string GetStatusCodeText(unsigned int nStatusCode) const override;
 
 private:
+    LPVOID GetSession() const;
+
     std::wstring m_sUserAgent;
+
+    // WinHTTP keeps connections open and reuses them for requests made through the same session,
+    // so a single session is shared by all requests.
+    mutable std::mutex m_oMutex;
+    mutable LPVOID m_hSession = nullptr;
 };
 
 } // namespace impl
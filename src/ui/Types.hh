@@ -17,6 +17,14 @@ struct Size
     int Height{};
 };
 
+struct Rect
+{
+    int X{};
+    int Y{};
+    int Width{};
+    int Height{};
+};
+
 enum class FontStyles
 {
     Normal        = 0x00,
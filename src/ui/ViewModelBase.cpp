@@ -5,15 +5,9 @@ namespace ui {
 
 void ViewModelBase::OnValueChanged(const BoolModelProperty::ChangeArgs& args)
 {
-    if (!m_vNotifyTargets.empty())
+    if (!m_vNotifyTargets.IsEmpty())
     {
-        // create a copy of the list of pointers in case it's modified by one of the callbacks
-        NotifyTargetSet vNotifyTargets(m_vNotifyTargets);
-        for (NotifyTarget* target : vNotifyTargets)
-        {
-            Expects(target != nullptr);
-            target->OnViewModelBoolValueChanged(args);
-        }
+        m_vNotifyTargets.Dispatch([&](NotifyTarget& pTarget) { pTarget.OnViewModelBoolValueChanged(args); });
     }
 
     ModelBase::OnValueChanged(args);
@@ -21,15 +15,9 @@ void ViewModelBase::OnValueChanged(const BoolModelProperty::ChangeArgs& args)
 
 void ViewModelBase::OnValueChanged(const StringModelProperty::ChangeArgs& args)
 {
-    if (!m_vNotifyTargets.empty())
+    if (!m_vNotifyTargets.IsEmpty())
     {
-        // create a copy of the list of pointers in case it's modified by one of the callbacks
-        NotifyTargetSet vNotifyTargets(m_vNotifyTargets);
-        for (NotifyTarget* target : vNotifyTargets)
-        {
-            Expects(target != nullptr);
-            target->OnViewModelStringValueChanged(args);
-        }
+        m_vNotifyTargets.Dispatch([&](NotifyTarget& pTarget) { pTarget.OnViewModelStringValueChanged(args); });
     }
 
     ModelBase::OnValueChanged(args);
@@ -37,15 +25,9 @@ void ViewModelBase::OnValueChanged(const StringModelProperty::ChangeArgs& args)
 
 void ViewModelBase::OnValueChanged(const IntModelProperty::ChangeArgs& args)
 {
-    if (!m_vNotifyTargets.empty())
+    if (!m_vNotifyTargets.IsEmpty())
     {
-        // create a copy of the list of pointers in case it's modified by one of the callbacks
-        NotifyTargetSet vNotifyTargets(m_vNotifyTargets);
-        for (NotifyTarget* target : vNotifyTargets)
-        {
-            Expects(target != nullptr);
-            target->OnViewModelIntValueChanged(args);
-        }
+        m_vNotifyTargets.Dispatch([&](NotifyTarget& pTarget) { pTarget.OnViewModelIntValueChanged(args); });
     }
 
     ModelBase::OnValueChanged(args);
@@ -5,6 +5,7 @@
 #include "ra_fwd.h"
 
 #include "data\ModelBase.hh"
+#include "data\NotifyTargetSet.hh"
 
 namespace ra {
 namespace ui {
@@ -31,18 +32,18 @@ public:
         virtual void OnViewModelIntValueChanged([[maybe_unused]] const IntModelProperty::ChangeArgs& args) noexcept(false) {}
     };
 
-    void AddNotifyTarget(NotifyTarget& pTarget) noexcept { GSL_SUPPRESS_F6 m_vNotifyTargets.insert(&pTarget); }
+    void AddNotifyTarget(NotifyTarget& pTarget) noexcept { GSL_SUPPRESS_F6 m_vNotifyTargets.Add(pTarget); }
 
     void RemoveNotifyTarget(NotifyTarget& pTarget) noexcept
     {
 #ifdef RA_UTEST
         GSL_SUPPRESS_F6 Expects(!m_bDestructed);
 #endif
-        GSL_SUPPRESS_F6 m_vNotifyTargets.erase(&pTarget);
+        GSL_SUPPRESS_F6 m_vNotifyTargets.Remove(pTarget);
     }
 
 private:
-    using NotifyTargetSet = std::set<NotifyTarget*>;
+    using NotifyTargetSet = ra::data::NotifyTargetSet<NotifyTarget>;
 
 protected:
     GSL_SUPPRESS_F6 ViewModelBase() = default;
@@ -52,10 +52,10 @@ public:
     {
         if (!IsFrozen())
         {
-            if (m_vNotifyTargets.empty())
+            if (m_vNotifyTargets.IsEmpty())
                 StartWatching();
 
-            m_vNotifyTargets.insert(&pTarget);
+            m_vNotifyTargets.Add(pTarget);
         }
     }
 
@@ -65,11 +65,11 @@ public:
         Expects(!m_bDisposed);
 #endif
 
-        if (!m_vNotifyTargets.empty())
+        if (!m_vNotifyTargets.IsEmpty())
         {
-            m_vNotifyTargets.erase(&pTarget);
+            m_vNotifyTargets.Remove(pTarget);
 
-            if (m_vNotifyTargets.empty())
+            if (m_vNotifyTargets.IsEmpty())
                 StopWatching();
         }
     }
@@ -91,7 +91,7 @@ protected:
 
     bool IsWatching() const noexcept override
     {
-        return !IsFrozen() && !m_vNotifyTargets.empty();
+        return !IsFrozen() && !m_vNotifyTargets.IsEmpty();
     }
 
     void OnFrozen() noexcept override;
@@ -103,7 +103,7 @@ protected:
     void OnItemsChanged(const std::vector<gsl::index>& vChangedIndices) override;
 
 private:
-    using NotifyTargetSet = std::set<NotifyTarget*>;
+    using NotifyTargetSet = ra::data::NotifyTargetSet<NotifyTarget>;
 
     /// <summary>
     /// A collection of pointers to other objects. These are not allocated object and do not need to be free'd. It's
@@ -172,6 +172,19 @@ public:
     /// </summary>
     template<class T2>
     const T2* GetItemAt(gsl::index nIndex) const { return dynamic_cast<const T2*>(GetModelAt(nIndex)); }
+
+    /// <summary>
+    /// Removes all items matching the provided predicate.
+    /// </summary>
+    /// <param name="fPredicate">Returns <c>true</c> if the item should be removed. Must not modify the collection.</param>
+    /// <returns>The number of items that were removed.</returns>
+    size_t RemoveIf(const std::function<bool(const T&)>& fPredicate)
+    {
+        return ModelCollectionBase::RemoveIf([&fPredicate](const ra::data::ModelBase& pModel)
+        {
+            return fPredicate(dynamic_cast<const T&>(pModel));
+        });
+    }
 };
 
 } // namespace ui
@@ -0,0 +1,302 @@
+#include "ImageCache.hh"
+
+#include "services\IThreadPool.hh"
+#include "services\ServiceLocator.hh"
+
+namespace ra {
+namespace ui {
+namespace drawing {
+
+ImageCache::ImageCache(Decoder& pDecoder, size_t nBudgetBytes, size_t nShards)
+    : m_pDecoder(pDecoder),
+      m_nBudget(nBudgetBytes),
+      m_pShards(std::make_unique<Shard[]>(std::max(nShards, size_t{ 1 }))),
+      m_nShards(std::max(nShards, size_t{ 1 }))
+{
+    // images may be requested from multiple threads. create the handle now so they don't race to create it.
+    CreateAsyncHandle();
+}
+
+ImageCache::~ImageCache() noexcept
+{
+    ra::data::AsyncObject::BeginDestruction();
+
+    Clear();
+}
+
+std::string ImageCache::GetKey(ImageType nType, const std::string& sName)
+{
+    std::string sKey;
+    sKey.reserve(sName.length() + 1);
+    sKey.push_back(gsl::narrow_cast<char>(ra::etoi(nType)));
+    sKey.append(sName);
+    return sKey;
+}
+
+ImageCache::Shard& ImageCache::GetShard(const std::string& sKey) noexcept
+{
+    const auto nHash = std::hash<std::string>()(sKey);
+    return m_pShards[nHash % m_nShards];
+}
+
+const ImageCache::Shard& ImageCache::GetShard(const std::string& sKey) const noexcept
+{
+    const auto nHash = std::hash<std::string>()(sKey);
+    return m_pShards[nHash % m_nShards];
+}
+
+ImageCache::ImageHandle ImageCache::Acquire(ImageType nType, const std::string& sName)
+{
+    auto sKey = GetKey(nType, sName);
+    auto& pShard = GetShard(sKey);
+    {
+        std::lock_guard<std::mutex> lock(pShard.oMutex);
+
+        const auto pIter = pShard.mEntries.find(sKey);
+        if (pIter != pShard.mEntries.end())
+        {
+            // if the image is still being decoded, or could not be decoded, there's nothing to return
+            auto& pEntry = pIter->second;
+            if (pEntry.hImage == 0)
+                return 0;
+
+            ++pEntry.nReferences;
+            pShard.vLru.splice(pShard.vLru.begin(), pShard.vLru, pEntry.pLruPosition);
+            return pEntry.hImage;
+        }
+
+        pShard.vLru.push_front(sKey);
+
+        auto& pEntry = pShard.mEntries[std::move(sKey)];
+        pEntry.bDecoding = true;
+        pEntry.pLruPosition = pShard.vLru.begin();
+    }
+
+    auto& pThreadPool = ra::services::ServiceLocator::GetMutable<ra::services::IThreadPool>();
+    pThreadPool.RunAsync([this, pAsyncHandle = CreateAsyncHandle(), nType, sName]()
+    {
+        ra::data::AsyncKeepAlive pKeepAlive(*pAsyncHandle);
+        if (pAsyncHandle->IsDestroyed())
+            return;
+
+        DecodeImage(nType, sName);
+    });
+
+    return 0;
+}
+
+void ImageCache::DecodeImage(ImageType nType, const std::string& sName)
+{
+    const auto sKey = GetKey(nType, sName);
+    auto& pShard = GetShard(sKey);
+
+    const auto& pThreadPool = ra::services::ServiceLocator::Get<ra::services::IThreadPool>();
+    if (pThreadPool.IsShutdownRequested())
+    {
+        std::lock_guard<std::mutex> lock(pShard.oMutex);
+        const auto pIter = pShard.mEntries.find(sKey);
+        if (pIter != pShard.mEntries.end() && pIter->second.bDecoding)
+        {
+            pShard.vLru.erase(pIter->second.pLruPosition);
+            pShard.mEntries.erase(pIter);
+        }
+
+        return;
+    }
+
+    size_t nBytes = 0;
+    const auto hImage = m_pDecoder.Decode(nType, sName, nBytes);
+
+    std::vector<ImageHandle> vEvicted;
+    bool bDecodeAgain = false;
+    bool bAdded = false;
+    {
+        std::lock_guard<std::mutex> lock(pShard.oMutex);
+
+        const auto pIter = pShard.mEntries.find(sKey);
+        if (pIter == pShard.mEntries.end() || !pIter->second.bDecoding)
+        {
+            // cache was cleared while the image was being decoded
+            if (hImage != 0)
+                vEvicted.push_back(hImage);
+        }
+        else if (pIter->second.bInvalidated)
+        {
+            // file changed while the image was being decoded. the result is out of date
+            if (hImage != 0)
+                vEvicted.push_back(hImage);
+
+            pIter->second.bInvalidated = false;
+            bDecodeAgain = true;
+        }
+        else
+        {
+            auto& pEntry = pIter->second;
+            pEntry.hImage = hImage;
+            pEntry.nBytes = (hImage != 0) ? nBytes : 0;
+            pEntry.bDecoding = false;
+
+            // the image was just requested, so treat it as recently used. it's not referenced yet (the caller
+            // has to ask for it again), so keep it out of the eviction pass or it may never get referenced.
+            pShard.vLru.splice(pShard.vLru.begin(), pShard.vLru, pEntry.pLruPosition);
+            m_nBytes.fetch_add(pEntry.nBytes);
+            Evict(pShard, vEvicted, &pEntry);
+
+            bAdded = (hImage != 0);
+        }
+    }
+
+    ReleaseImages(vEvicted);
+
+    if (bDecodeAgain)
+    {
+        DecodeImage(nType, sName);
+        return;
+    }
+
+    if (bAdded)
+        m_pDecoder.OnImageDecoded(nType, sName);
+}
+
+void ImageCache::Evict(Shard& pShard, std::vector<ImageHandle>& vEvicted, const Entry* pKeep)
+{
+    auto pIter = pShard.vLru.end();
+    while (m_nBytes.load() > m_nBudget && pIter != pShard.vLru.begin())
+    {
+        --pIter;
+
+        const auto pEntry = pShard.mEntries.find(*pIter);
+        Expects(pEntry != pShard.mEntries.end());
+        if (pEntry->second.nReferences > 0 || pEntry->second.bDecoding || &pEntry->second == pKeep)
+            continue;
+
+        if (pEntry->second.hImage != 0)
+        {
+            vEvicted.push_back(pEntry->second.hImage);
+            m_nEvictions.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        m_nBytes.fetch_sub(pEntry->second.nBytes);
+        pShard.mEntries.erase(pEntry);
+        pIter = pShard.vLru.erase(pIter);
+    }
+}
+
+void ImageCache::ReleaseImages(const std::vector<ImageHandle>& vImages) noexcept
+{
+    for (const auto hImage : vImages)
+        m_pDecoder.Release(hImage);
+}
+
+void ImageCache::AddReference(ImageType nType, const std::string& sName)
+{
+    const auto sKey = GetKey(nType, sName);
+    auto& pShard = GetShard(sKey);
+    std::lock_guard<std::mutex> lock(pShard.oMutex);
+
+    const auto pIter = pShard.mEntries.find(sKey);
+    if (pIter != pShard.mEntries.end() && pIter->second.hImage != 0)
+    {
+        ++pIter->second.nReferences;
+        pShard.vLru.splice(pShard.vLru.begin(), pShard.vLru, pIter->second.pLruPosition);
+    }
+}
+
+GSL_SUPPRESS_F6
+void ImageCache::Release(ImageType nType, const std::string& sName) noexcept
+{
+    const auto sKey = GetKey(nType, sName);
+    auto& pShard = GetShard(sKey);
+
+    std::vector<ImageHandle> vEvicted;
+    {
+        std::lock_guard<std::mutex> lock(pShard.oMutex);
+
+        const auto pIter = pShard.mEntries.find(sKey);
+        if (pIter == pShard.mEntries.end() || pIter->second.nReferences == 0)
+            return;
+
+        // if the cache grew past its budget while the image was referenced, it can be discarded now
+        if (--pIter->second.nReferences == 0 && m_nBytes.load() > m_nBudget)
+            Evict(pShard, vEvicted, nullptr);
+    }
+
+    ReleaseImages(vEvicted);
+}
+
+bool ImageCache::IsDecoded(ImageType nType, const std::string& sName) const
+{
+    const auto sKey = GetKey(nType, sName);
+    const auto& pShard = GetShard(sKey);
+    std::lock_guard<std::mutex> lock(pShard.oMutex);
+
+    const auto pIter = pShard.mEntries.find(sKey);
+    return (pIter != pShard.mEntries.end() && pIter->second.hImage != 0);
+}
+
+GSL_SUPPRESS_F6
+void ImageCache::Invalidate(ImageType nType, const std::string& sName) noexcept
+{
+    const auto sKey = GetKey(nType, sName);
+    auto& pShard = GetShard(sKey);
+
+    ImageHandle hImage = 0;
+    {
+        std::lock_guard<std::mutex> lock(pShard.oMutex);
+
+        const auto pIter = pShard.mEntries.find(sKey);
+        if (pIter == pShard.mEntries.end())
+            return;
+
+        auto& pEntry = pIter->second;
+        if (pEntry.bDecoding)
+        {
+            pEntry.bInvalidated = true;
+            return;
+        }
+
+        if (pEntry.nReferences > 0)
+            return;
+
+        hImage = pEntry.hImage;
+        m_nBytes.fetch_sub(pEntry.nBytes);
+        pShard.vLru.erase(pEntry.pLruPosition);
+        pShard.mEntries.erase(pIter);
+    }
+
+    if (hImage != 0)
+        m_pDecoder.Release(hImage);
+}
+
+GSL_SUPPRESS_F6
+void ImageCache::Clear() noexcept
+{
+    std::vector<ImageHandle> vImages;
+    for (size_t i = 0; i < m_nShards; ++i)
+    {
+        auto& pShard = m_pShards[i];
+        std::lock_guard<std::mutex> lock(pShard.oMutex);
+
+        for (const auto& pEntry : pShard.mEntries)
+        {
+            if (pEntry.second.hImage != 0)
+                vImages.push_back(pEntry.second.hImage);
+
+            m_nBytes.fetch_sub(pEntry.second.nBytes);
+        }
+
+        pShard.mEntries.clear();
+        pShard.vLru.clear();
+    }
+
+    ReleaseImages(vImages);
+}
+
+size_t ImageCache::GetMemoryUsage() const noexcept
+{
+    return m_nBytes.load();
+}
+
+} // namespace drawing
+} // namespace ui
+} // namespace ra
@@ -0,0 +1,173 @@
+#ifndef RA_UI_DRAWING_IMAGECACHE_HH
+#define RA_UI_DRAWING_IMAGECACHE_HH
+#pragma once
+
+#include "data\AsyncObject.hh"
+
+#include "ui\ImageReference.hh"
+
+#include <list>
+
+namespace ra {
+namespace ui {
+namespace drawing {
+
+/// <summary>
+/// Cache of decoded images, limited to a memory budget.
+/// </summary>
+/// <remarks>
+/// Images are decoded on the <see cref="ra::services::IThreadPool" />. Until an image has been decoded, the
+/// cache reports that it is not available. When the memory used by decoded images exceeds the budget, the
+/// least recently used images are discarded. Images that are referenced, or are still being decoded, are never
+/// discarded, so the budget may be exceeded if too many images are referenced at once.
+/// The cache is split into shards, each with its own lock, so threads looking up different images rarely wait
+/// on each other. The budget is shared by all shards, so a single large image doesn't exceed the budget by
+/// itself. When the budget is exceeded, images are discarded from the shard that is being updated.
+/// </remarks>
+class ImageCache : protected ra::data::AsyncObject
+{
+public:
+    /// <summary>
+    /// Identifies a decoded image. <c>0</c> is never a valid handle.
+    /// </summary>
+    using ImageHandle = unsigned long long;
+
+    class Decoder
+    {
+    public:
+        Decoder() noexcept = default;
+        virtual ~Decoder() noexcept = default;
+        Decoder(const Decoder&) noexcept = delete;
+        Decoder& operator=(const Decoder&) noexcept = delete;
+        Decoder(Decoder&&) noexcept = delete;
+        Decoder& operator=(Decoder&&) noexcept = delete;
+
+        /// <summary>
+        /// Decodes an image. Called from a background thread.
+        /// </summary>
+        /// <param name="nType">Type of the image.</param>
+        /// <param name="sName">Name of the image.</param>
+        /// <param name="nBytes">[out] The amount of memory used by the decoded image.</param>
+        /// <returns>Handle to the decoded image, <c>0</c> if the image could not be decoded.</returns>
+        virtual ImageHandle Decode(ImageType nType, const std::string& sName, size_t& nBytes) = 0;
+
+        /// <summary>
+        /// Frees a decoded image.
+        /// </summary>
+        virtual void Release(ImageHandle hImage) noexcept = 0;
+
+        /// <summary>
+        /// Called from a background thread after an image has been decoded and added to the cache.
+        /// </summary>
+        virtual void OnImageDecoded([[maybe_unused]] ImageType nType, [[maybe_unused]] const std::string& sName) {}
+    };
+
+    static constexpr size_t DefaultShardCount = 16;
+
+    /// <summary>
+    /// Creates a cache.
+    /// </summary>
+    /// <param name="pDecoder">Object that decodes and frees images.</param>
+    /// <param name="nBudgetBytes">The amount of memory decoded images may use.</param>
+    /// <param name="nShards">The number of shards.</param>
+    explicit ImageCache(Decoder& pDecoder, size_t nBudgetBytes, size_t nShards = DefaultShardCount);
+    ~ImageCache() noexcept;
+    ImageCache(const ImageCache&) = delete;
+    ImageCache& operator=(const ImageCache&) = delete;
+    ImageCache(ImageCache&&) = delete;
+    ImageCache& operator=(ImageCache&&) = delete;
+
+    /// <summary>
+    /// Gets a decoded image and adds a reference to it.
+    /// </summary>
+    /// <returns>
+    /// Handle to the decoded image, or <c>0</c> if the image has not been decoded. If the image has not been
+    /// decoded, a request to decode it is queued, and no reference is added.
+    /// </returns>
+    ImageHandle Acquire(ImageType nType, const std::string& sName);
+
+    /// <summary>
+    /// Adds a reference to an image that has been decoded. Does nothing if the image has not been decoded.
+    /// </summary>
+    void AddReference(ImageType nType, const std::string& sName);
+
+    /// <summary>
+    /// Releases a reference obtained from <see cref="Acquire" /> or <see cref="AddReference" />.
+    /// </summary>
+    /// <remarks>
+    /// The image stays in the cache until it has to be discarded to stay within the budget.
+    /// </remarks>
+    void Release(ImageType nType, const std::string& sName) noexcept;
+
+    /// <summary>
+    /// Determines whether an image has been decoded and is in the cache.
+    /// </summary>
+    bool IsDecoded(ImageType nType, const std::string& sName) const;
+
+    /// <summary>
+    /// Discards the cached result for an image so it will be decoded again the next time it is requested.
+    /// </summary>
+    /// <remarks>
+    /// Used when the underlying file changes. Images that are referenced are left alone.
+    /// </remarks>
+    void Invalidate(ImageType nType, const std::string& sName) noexcept;
+
+    /// <summary>
+    /// Frees all decoded images, including images that are still referenced.
+    /// </summary>
+    void Clear() noexcept;
+
+    /// <summary>
+    /// Gets the amount of memory used by decoded images.
+    /// </summary>
+    size_t GetMemoryUsage() const noexcept;
+
+    /// <summary>
+    /// Gets the amount of memory the cache tries to stay within.
+    /// </summary>
+    size_t GetBudget() const noexcept { return m_nBudget; }
+
+    /// <summary>
+    /// Gets the number of decoded images that have been discarded to stay within the budget.
+    /// </summary>
+    size_t GetEvictionCount() const noexcept { return m_nEvictions.load(std::memory_order_relaxed); }
+
+private:
+    struct Entry
+    {
+        ImageHandle hImage = 0;
+        size_t nBytes = 0;
+        unsigned int nReferences = 0;
+        bool bDecoding = false;
+        bool bInvalidated = false;
+        std::list<std::string>::iterator pLruPosition;
+    };
+
+    struct Shard
+    {
+        mutable std::mutex oMutex;
+        std::unordered_map<std::string, Entry> mEntries;
+        std::list<std::string> vLru; // most recently used first
+    };
+
+    static std::string GetKey(ImageType nType, const std::string& sName);
+    Shard& GetShard(const std::string& sKey) noexcept;
+    const Shard& GetShard(const std::string& sKey) const noexcept;
+
+    void DecodeImage(ImageType nType, const std::string& sName);
+    void Evict(Shard& pShard, std::vector<ImageHandle>& vEvicted, const Entry* pKeep);
+    void ReleaseImages(const std::vector<ImageHandle>& vImages) noexcept;
+
+    Decoder& m_pDecoder;
+    size_t m_nBudget;
+    std::unique_ptr<Shard[]> m_pShards;
+    size_t m_nShards;
+    std::atomic<size_t> m_nBytes{ 0 };
+    std::atomic<size_t> m_nEvictions{ 0 };
+};
+
+} // namespace drawing
+} // namespace ui
+} // namespace ra
+
+#endif // !RA_UI_DRAWING_IMAGECACHE_HH
@@ -13,6 +13,8 @@
 #include "services\IThreadPool.hh"
 #include "services\ServiceLocator.hh"
 
+#include "ui\IDesktop.hh"
+
 namespace ra {
 namespace ui {
 namespace drawing {
@@ -65,14 +67,10 @@ bool ImageRepository::Initialize()
 
 ImageRepository::~ImageRepository() noexcept
 {
-    // clean up anything that's still referenced
-    for (auto& badge : m_mBadges)
-        DeleteBitmap(badge.second.m_hBitmap);
-    m_mBadges.clear();
+    ra::data::AsyncObject::BeginDestruction();
 
-    for (auto& userPic : m_mUserPics)
-        DeleteBitmap(userPic.second.m_hBitmap);
-    m_mUserPics.clear();
+    // clean up anything that's still referenced
+    m_pCache.Clear();
 
     if (g_pIWICFactory != nullptr)
         g_pIWICFactory->Release();
@@ -134,15 +132,8 @@ bool ImageRepository::IsImageAvailable(ImageType nType, const std::string& sName
     if (sName.empty())
         return false;
 
-    HBitmapMap* mMap;
-    GSL_SUPPRESS_TYPE3{ mMap = const_cast<ImageRepository*>(this)->GetBitmapMap(nType); }
-    if (mMap != nullptr)
-    {
-        std::lock_guard<std::mutex> lock(m_oMutex);
-        const HBitmapMap::iterator iter = mMap->find(sName);
-        if (iter != mMap->end())
-            return true;
-    }
+    if (m_pCache.IsDecoded(nType, sName))
+        return true;
 
     std::wstring sFilename = GetFilename(nType, sName);
     {
@@ -226,6 +217,9 @@ void ImageRepository::FetchImage(ImageType nType, const std::string& sName, cons
             ra::services::ServiceLocator::Get<ra::services::IFileSystem>().DeleteFile(sFilename);
         }
 
+        // the file didn't exist when the image was last decoded. discard the result so it gets decoded again.
+        m_pCache.Invalidate(nType, sName);
+
         OnImageChanged(nType, sName);
     });
 }
@@ -264,10 +258,10 @@ HBITMAP ImageRepository::GetDefaultImage(ImageType nType)
     {
         case ImageType::Badge:
         case ImageType::Icon:
-            return GetImage(ImageType::Badge, DefaultBadge);
+            return GetPinnedImage(m_hDefaultBadge, ImageType::Badge, DefaultBadge);
 
         case ImageType::UserPic:
-            return GetImage(ImageType::UserPic, DefaultUserPic);
+            return GetPinnedImage(m_hDefaultUserPic, ImageType::UserPic, DefaultUserPic);
 
         default:
             Expects(!"Unsupported image type");
@@ -275,6 +269,27 @@ HBITMAP ImageRepository::GetDefaultImage(ImageType nType)
     }
 }
 
+HBITMAP ImageRepository::GetPinnedImage(std::atomic<ImageCache::ImageHandle>& hPinned, ImageType nType, const std::string& sName)
+{
+    // the default images are shown whenever another image isn't ready. keep a reference to them so they're
+    // never discarded from the cache.
+    auto hImage = hPinned.load(std::memory_order_acquire);
+    if (hImage == 0)
+    {
+        hImage = m_pCache.Acquire(nType, sName);
+        if (hImage != 0)
+        {
+            ImageCache::ImageHandle hExpected = 0;
+            if (!hPinned.compare_exchange_strong(hExpected, hImage, std::memory_order_acq_rel))
+                m_pCache.Release(nType, sName); // another thread pinned it first
+        }
+    }
+
+    HBITMAP hBitmap{};
+    GSL_SUPPRESS_TYPE1 hBitmap = reinterpret_cast<HBITMAP>(hImage);
+    return hBitmap;
+}
+
 GSL_SUPPRESS_F23
 static HRESULT ConvertBitmapSource(_In_ RECT rcDest, _In_ IWICBitmapSource* pOriginalBitmapSource, _Inout_ IWICBitmapSource*& pToRenderBitmapSource)
 {
@@ -355,12 +370,8 @@ static HRESULT CreateDIBFromBitmapSource(_In_ IWICBitmapSource* pToRenderBitmapS
     const BITMAPINFO bminfo{info_header};
     void *pvImageBits = nullptr;
 
-    auto hWindow = GetActiveWindow();
-    while (GetParent(hWindow) != nullptr)
-        hWindow = GetParent(hWindow);
-
-    // Get a DC for the full screen
-    auto hdcScreen = GetDC(hWindow);
+    // Get a DC for the full screen. this is called from the thread pool, which doesn't own any windows.
+    auto hdcScreen = GetDC(nullptr);
     if (hdcScreen)
     {
         // Release the previously allocated bitmap 
@@ -464,66 +475,69 @@ HBITMAP ImageRepository::LoadLocalPNG(const std::wstring& sFilename, unsigned in
     return hBitmap;
 }
 
-ImageRepository::HBitmapMap* ImageRepository::GetBitmapMap(ImageType nType) noexcept
+ImageCache::ImageHandle ImageRepository::Decode(ImageType nType, const std::string& sName, size_t& nBytes)
 {
-    switch (nType)
+    std::wstring sFilename = GetFilename(nType, sName);
+
+    const auto& pFileSystem = ra::services::ServiceLocator::Get<ra::services::IFileSystem>();
+    if (pFileSystem.GetFileSize(sFilename) <= 0)
     {
-        case ImageType::Badge:
-            return &m_mBadges;
+        // FetchImage will invalidate the cached result when the download completes
+        FetchImage(nType, sName, "");
+        return 0;
+    }
 
-        case ImageType::UserPic:
-            return &m_mUserPics;
+    // images are decoded on the thread pool, which doesn't initialize COM. WIC needs it.
+    // RPC_E_CHANGED_MODE means the thread is already initialized differently, which WIC can also use.
+    const auto hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED | COINIT_DISABLE_OLE1DDE);
 
-        case ImageType::Local:
-            return &m_mLocal;
+    const unsigned int nSize = (nType == ImageType::Local) ? 0 : 64;
+    HBITMAP hBitmap = LoadLocalPNG(sFilename, nSize, nSize);
 
-        case ImageType::Icon:
-            return &m_mIcons;
+    if (SUCCEEDED(hr))
+        CoUninitialize();
 
-        default:
-            Expects(!"Unsupported image type");
-            return nullptr;
-    }
-}
+    if (hBitmap == nullptr)
+        return 0;
 
-HBITMAP ImageRepository::GetImage(ImageType nType, const std::string& sName)
-{
-    if (sName.empty())
-        return nullptr;
+    BITMAP pBitmap{};
+    if (GetObject(hBitmap, sizeof(pBitmap), &pBitmap))
+        nBytes = gsl::narrow_cast<size_t>(pBitmap.bmWidthBytes) * gsl::narrow_cast<size_t>(pBitmap.bmHeight);
 
-    HBitmapMap* mMap = GetBitmapMap(nType);
-    if (mMap == nullptr)
-        return nullptr;
+    ImageCache::ImageHandle hImage{};
+    GSL_SUPPRESS_TYPE1 hImage = reinterpret_cast<ImageCache::ImageHandle>(hBitmap);
+    return hImage;
+}
 
-    {
-        std::lock_guard<std::mutex> lock(m_oMutex);
+void ImageRepository::Release(ImageCache::ImageHandle hImage) noexcept
+{
+    HBITMAP hBitmap{};
+    GSL_SUPPRESS_TYPE1 hBitmap = reinterpret_cast<HBITMAP>(hImage);
+    DeleteBitmap(hBitmap);
+}
 
-        const HBitmapMap::iterator iter = mMap->find(sName);
-        if (iter != mMap->end())
-            return iter->second.m_hBitmap;
-    }
+void ImageRepository::OnImageDecoded(ImageType nType, const std::string& sName)
+{
+    // decoding happens on the thread pool. the targets update windows, so notify them from the UI thread.
+    ra::services::ServiceLocator::Get<ra::ui::IDesktop>().InvokeOnUIThread(
+        [this, pAsyncHandle = CreateAsyncHandle(), nType, sName]() {
+        ra::data::AsyncKeepAlive pKeepAlive(*pAsyncHandle);
+        if (pAsyncHandle->IsDestroyed())
+            return;
 
-    std::wstring sFilename = GetFilename(nType, sName);
+        OnImageChanged(nType, sName);
+    });
+}
 
-    const auto& pFileSystem = ra::services::ServiceLocator::Get<ra::services::IFileSystem>();
-    if (pFileSystem.GetFileSize(sFilename) <= 0)
-    {
-        FetchImage(nType, sName, "");
+HBITMAP ImageRepository::AcquireImage(ImageType nType, const std::string& sName)
+{
+    if (sName.empty())
         return nullptr;
-    }
-
-    const unsigned int nSize = (nType == ImageType::Local) ? 0 : 64;
-    HBITMAP hBitmap = LoadLocalPNG(sFilename, nSize, nSize);
-    if (hBitmap != nullptr)
-    {
-        std::lock_guard<std::mutex> lock(m_oMutex);
-
-        // bracket operator appears to be the only way to add an item to the map since
-        // std::atomic deleted its move and copy constructors.
-        auto& item = (*mMap)[sName];
-        item.m_hBitmap = hBitmap;
-    }
 
+    // if the image hasn't been decoded yet, this queues it to be decoded on a background thread.
+    // OnImageChanged will be raised when it's ready.
+    HBITMAP hBitmap{};
+    GSL_SUPPRESS_TYPE1 hBitmap = reinterpret_cast<HBITMAP>(m_pCache.Acquire(nType, sName));
     return hBitmap;
 }
 
@@ -537,14 +551,12 @@ HBITMAP ImageRepository::GetHBitmap(const ImageReference& pImage)
         auto pImageRepository = dynamic_cast<ImageRepository*>(&ra::services::ServiceLocator::GetMutable<IImageRepository>());
         if (pImageRepository != nullptr)
         {
-            hBitmap = pImageRepository->GetImage(pImage.Type(), pImage.Name());
+            // ImageReference will release the reference
+            hBitmap = pImageRepository->AcquireImage(pImage.Type(), pImage.Name());
             if (hBitmap == nullptr)
                 return pImageRepository->GetDefaultImage(pImage.Type());
 
             GSL_SUPPRESS_TYPE1 pImage.m_nData = reinterpret_cast<unsigned long long>(hBitmap);
-
-            // ImageReference will release the reference
-            pImageRepository->AddReference(pImage);
         }
     }
 
@@ -556,18 +568,7 @@ void ImageRepository::AddReference(const ImageReference& pImage)
     if (pImage.Name().empty())
         return;
 
-    HBitmapMap* mMap = GetBitmapMap(pImage.Type());
-    if (mMap == nullptr)
-        return;
-
-    {
-        std::lock_guard<std::mutex> lock(m_oMutex);
-
-        const HBitmapMap::iterator iter = mMap->find(pImage.Name());
-        Expects(iter != mMap->end()); // AddReference should only be called if an HBITMAP exists, which will be in the map
-        if (iter != mMap->end())
-            ++iter->second.m_nReferences;
-    }
+    m_pCache.AddReference(pImage.Type(), pImage.Name());
 }
 
 void ImageRepository::ReleaseReference(ImageReference& pImage) noexcept
@@ -576,24 +577,7 @@ void ImageRepository::ReleaseReference(ImageReference& pImage) noexcept
     if (pImage.m_nData == 0)
         return;
 
-    HBitmapMap* mMap = GetBitmapMap(pImage.Type());
-    if (mMap != nullptr)
-    {
-        std::lock_guard<std::mutex> lock(m_oMutex);
-
-        const HBitmapMap::iterator iter = mMap->find(pImage.Name());
-
-        if(iter != mMap->end())
-        {
-            HBITMAP hBitmap = iter->second.m_hBitmap;
-
-            if(--iter->second.m_nReferences == 0)
-            {
-                mMap->erase(iter);
-                DeleteObject(hBitmap);
-            }
-        }
-    }
+    m_pCache.Release(pImage.Type(), pImage.Name());
 
     pImage.m_nData = {};
 }
@@ -2,25 +2,25 @@
 #define RA_UI_DRAWING_GDI_IMAGEREPOSITORY_HH
 #pragma once
 
+#include "data\AsyncObject.hh"
+
 #include "ui\ImageReference.hh"
 
+#include "ui\drawing\ImageCache.hh"
+
 namespace ra {
 namespace ui {
 namespace drawing {
 namespace gdi {
 
-class ImageRepository : public IImageRepository
+class ImageRepository : public IImageRepository, private ImageCache::Decoder, protected ra::data::AsyncObject
 {
-    struct HBitmapReference
-    {
-        HBITMAP m_hBitmap{};
-        std::atomic<unsigned int> m_nReferences;
-    };
-
-    using HBitmapMap = std::unordered_map<std::string, HBitmapReference>;
 public:
-    ImageRepository() noexcept(std::is_nothrow_default_constructible_v<HBitmapMap> &&
-                               std::is_nothrow_default_constructible_v<std::set<std::wstring>>) = default;
+    GSL_SUPPRESS_F6 ImageRepository() : m_pCache(*this, MemoryBudget)
+    {
+        // images are decoded on multiple threads. create the handle now so they don't race to create it.
+        CreateAsyncHandle();
+    }
     GSL_SUPPRESS_F6 ~ImageRepository() noexcept;
     ImageRepository(const ImageRepository&) = delete;
     ImageRepository& operator=(const ImageRepository&) = delete;
@@ -50,17 +50,25 @@ public:
     std::wstring GetFilename(ImageType nType, const std::string& sName) const override;
 
 private:
+    /// <summary>
+    /// The amount of memory decoded images may use before the least recently used are discarded.
+    /// </summary>
+    static constexpr size_t MemoryBudget = 64 * 1024 * 1024;
+
     static HBITMAP LoadLocalPNG(const std::wstring& sFilename, unsigned int nWidth, unsigned int nHeight);
 
-    HBITMAP GetImage(ImageType nType, const std::string& sName);
-    HBITMAP GetDefaultImage(ImageType nType);
+    // ImageCache::Decoder
+    ImageCache::ImageHandle Decode(ImageType nType, const std::string& sName, size_t& nBytes) override;
+    void Release(ImageCache::ImageHandle hImage) noexcept override;
+    void OnImageDecoded(ImageType nType, const std::string& sName) override;
 
-    HBitmapMap m_mBadges;
-    HBitmapMap m_mUserPics;
-    HBitmapMap m_mLocal;
-    HBitmapMap m_mIcons;
+    HBITMAP AcquireImage(ImageType nType, const std::string& sName);
+    HBITMAP GetDefaultImage(ImageType nType);
+    HBITMAP GetPinnedImage(std::atomic<ImageCache::ImageHandle>& hPinned, ImageType nType, const std::string& sName);
 
-    GSL_SUPPRESS_F6 HBitmapMap* GetBitmapMap(ImageType nType) noexcept;
+    ImageCache m_pCache;
+    std::atomic<ImageCache::ImageHandle> m_hDefaultBadge{ 0 };
+    std::atomic<ImageCache::ImageHandle> m_hDefaultUserPic{ 0 };
 
     mutable std::mutex m_oMutex;
     std::set<std::wstring> m_vRequestedImages;
@@ -58,17 +58,18 @@ void AssetUploadViewModel::QueueAchievement(ra::data::models::AchievementModel&
     {
         pItem.nState = UploadState::WaitingForImage;
 
-        for (const auto& pQueuedItem : m_vUploadQueue)
+        // local badges are named by the hash of their contents. only upload each image once, even if it
+        // was stored for several games.
+        if (!m_vQueuedBadges.insert(GetBadgeHash(sBadge)).second)
         {
-            const auto* pQueuedAchievement = dynamic_cast<const ra::data::models::AchievementModel*>(pQueuedItem.pAsset);
-            if (pQueuedAchievement && pQueuedAchievement != &pAchievement && pQueuedAchievement->GetBadge() == sBadge)
-            {
-                // badge request already queued, do nothing
-                return;
-            }
+            // badge request already queued, do nothing
+            return;
         }
 
-        QueueTask([this, sBadge]()
+        // only allow one badge upload at a time to prevent a race condition on server that could
+        // result in non-unique image IDs being returned. other assets can still be uploaded while
+        // waiting for the badge.
+        QueueSerializedTask([this, sBadge]()
         {
             UploadBadge(sBadge);
         });
@@ -175,6 +176,39 @@ void AssetUploadViewModel::OnBegin()
     SetMessage(ra::StringPrintf(L"Uploading %d items...", TaskCount()));
 }
 
+std::wstring AssetUploadViewModel::GetBadgeHash(const std::wstring& sBadge)
+{
+    // local badges are stored as "local\\<gameid>-<md5>.<ext>"
+    const auto nIndex = sBadge.find(L'-');
+    if (nIndex == std::wstring::npos)
+        return sBadge;
+
+    return sBadge.substr(nIndex + 1);
+}
+
+template<class TApi>
+typename TApi::Response AssetUploadViewModel::CallWithRetry(const typename TApi::Request& pRequest) const
+{
+    int nAttempt = 1;
+    do
+    {
+        auto response = pRequest.Call();
+        if (response.Result != ra::api::ApiResult::Incomplete)
+            return response;
+
+        if (nAttempt == MaxUploadAttempts)
+        {
+            RA_LOG_WARN("Giving up after %d attempts", nAttempt);
+            if (response.ErrorMessage.empty())
+                response.ErrorMessage = "Server is busy. Please try again later.";
+
+            return response;
+        }
+
+        Rest(nAttempt++);
+    } while (true);
+}
+
 void AssetUploadViewModel::UploadBadge(const std::wstring& sBadge)
 {
     const auto& pImageRepository = ra::services::ServiceLocator::Get<ra::ui::IImageRepository>();
@@ -183,35 +217,26 @@ void AssetUploadViewModel::UploadBadge(const std::wstring& sBadge)
     ra::api::UploadBadge::Request request;
     request.ImageFilePath = sFilename;
 
-    ra::api::UploadBadge::Response response;
-    {
-        // only allow one badge upload at a time to prevent a race condition on server that could
-        // result in non-unique image IDs being returned.
-        std::lock_guard<std::mutex> pLock(m_pMutex);
-        response = request.Call();
-    }
+    const auto& response = CallWithRetry<ra::api::UploadBadge>(request);
+    const auto sBadgeHash = GetBadgeHash(sBadge);
 
-    if (response.Result == ra::api::ApiResult::Incomplete)
-    {
-        Rest();
-        UploadBadge(sBadge);
-        return;
-    }
     std::vector<ra::data::models::AchievementModel*> vAffectedAchievements;
     {
         // if the upload succeeded, update the badge property for each associated achievement and queue the
         // achievement update. if the upload failed, set the error message and don't queue the achievement update.
+        std::lock_guard<std::mutex> pLock(m_pMutex);
         for (auto& pItem : m_vUploadQueue)
         {
             if (pItem.nState == UploadState::WaitingForImage)
             {
                 auto* pQueuedAchievement = dynamic_cast<ra::data::models::AchievementModel*>(pItem.pAsset);
-                if (pQueuedAchievement && pQueuedAchievement->GetBadge() == sBadge)
+                if (pQueuedAchievement && GetBadgeHash(pQueuedAchievement->GetBadge()) == sBadgeHash)
                 {
                     if (response.Succeeded())
                     {
                         RA_LOG_INFO("Changed badge on achievement %u to %s", pQueuedAchievement->GetID(), response.BadgeId);
                         pQueuedAchievement->SetBadge(ra::Widen(response.BadgeId));
+                        pItem.nState = UploadState::Uploading;
                         vAffectedAchievements.push_back(pQueuedAchievement);
                     }
                     else
@@ -275,7 +300,7 @@ void AssetUploadViewModel::UploadAchievement(ra::data::models::AchievementModel&
         request.AchievementId = pAchievement.GetID();
     }
 
-    const auto& response = request.Call();
+    const auto& response = CallWithRetry<ra::api::UpdateAchievement>(request);
 
     // update the achievement
     if (response.Succeeded())
@@ -289,12 +314,6 @@ void AssetUploadViewModel::UploadAchievement(ra::data::models::AchievementModel&
         pAchievement.UpdateLocalCheckpoint();
         pAchievement.UpdateServerCheckpoint();
     }
-    else if (response.Result == ra::api::ApiResult::Incomplete)
-    {
-        Rest();
-        UploadAchievement(pAchievement);
-        return;
-    }
 
     // update the queue
     std::lock_guard<std::mutex> pLock(m_pMutex);
@@ -339,7 +358,7 @@ void AssetUploadViewModel::UploadLeaderboard(ra::data::models::LeaderboardModel&
     if (pLeaderboard.GetCategory() != ra::data::models::AssetCategory::Local)
         request.LeaderboardId = pLeaderboard.GetID();
 
-    const auto& response = request.Call();
+    const auto& response = CallWithRetry<ra::api::UpdateLeaderboard>(request);
 
     // update the achievement
     if (response.Succeeded())
@@ -353,12 +372,6 @@ void AssetUploadViewModel::UploadLeaderboard(ra::data::models::LeaderboardModel&
         pLeaderboard.UpdateLocalCheckpoint();
         pLeaderboard.UpdateServerCheckpoint();
     }
-    else if (response.Result == ra::api::ApiResult::Incomplete)
-    {
-        Rest();
-        UploadLeaderboard(pLeaderboard);
-        return;
-    }
 
     // update the queue
     std::lock_guard<std::mutex> pLock(m_pMutex);
@@ -403,19 +416,13 @@ void AssetUploadViewModel::UploadCodeNote(ra::data::models::CodeNotesModel& pNot
         request.GameId = ra::services::ServiceLocator::Get<ra::data::context::GameContext>().GameId();
         request.Address = nAddress;
 
-        const auto& response = request.Call();
+        const auto& response = CallWithRetry<ra::api::DeleteCodeNote>(request);
 
         if (response.Succeeded())
         {
             pNotes.SetServerCodeNote(nAddress, L"");
             nState = UploadState::Success;
         }
-        else if (response.Result == ra::api::ApiResult::Incomplete)
-        {
-            Rest();
-            UploadCodeNote(pNotes, nAddress);
-            return;
-        }
 
         sErrorMessage = response.ErrorMessage;
     }
@@ -426,19 +433,13 @@ void AssetUploadViewModel::UploadCodeNote(ra::data::models::CodeNotesModel& pNot
         request.Address = nAddress;
         request.Note = *pNote;
 
-        const auto& response = request.Call();
+        const auto& response = CallWithRetry<ra::api::UpdateCodeNote>(request);
 
         if (response.Succeeded())
         {
             pNotes.SetServerCodeNote(nAddress, *pNote);
             nState = UploadState::Success;
         }
-        else if (response.Result == ra::api::ApiResult::Incomplete)
-        {
-            Rest();
-            UploadCodeNote(pNotes, nAddress);
-            return;
-        }
 
         sErrorMessage = response.ErrorMessage;
     }
@@ -30,11 +30,17 @@ public:
 protected:
     void OnBegin() override;
 
-    virtual void Rest() const noexcept
+    /// <summary>
+    /// The number of times to attempt a request that the server reported as temporarily unavailable.
+    /// </summary>
+    static constexpr int MaxUploadAttempts = 5;
+
+    virtual void Rest(int nAttempt) const noexcept
     {
-        // sleep 500-1500ms to allow server to stop throttling us.
-        // stagger value so we don't slam it in batches.
-        Sleep(rand() % 1000 + 500);
+        // back off exponentially (500ms, 1s, 2s, 4s, ...) to allow server to stop throttling us.
+        // add up to a second of jitter so the worker threads don't slam it in batches.
+        const auto nDelay = 500 << std::min(nAttempt - 1, 4);
+        Sleep(nDelay + rand() % 1000);
     }
 
 private:
@@ -55,12 +61,18 @@ private:
         UploadState nState = UploadState::None;
     };
 
+    static std::wstring GetBadgeHash(const std::wstring& sBadge);
+
+    template<class TApi>
+    typename TApi::Response CallWithRetry(const typename TApi::Request& pRequest) const;
+
     void UploadBadge(const std::wstring& sBadge);
     void UploadAchievement(ra::data::models::AchievementModel& pAchievement);
     void UploadLeaderboard(ra::data::models::LeaderboardModel& pLeaderboard);
     void UploadCodeNote(ra::data::models::CodeNotesModel& pNotes, ra::ByteAddress nAddress);
 
     std::vector<UploadItem> m_vUploadQueue;
+    std::set<std::wstring> m_vQueuedBadges;
     std::mutex m_pMutex;
 };
 
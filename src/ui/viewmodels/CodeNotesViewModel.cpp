@@ -71,6 +71,7 @@ void CodeNotesViewModel::OnActiveGameChanged()
 {
     const auto& pGameContext = ra::services::ServiceLocator::Get<ra::data::context::GameContext>();
     m_nGameId = pGameContext.GameId();
+    m_bSearchIndexValid = false;
 
     SetFilterValue(L"");
 
@@ -80,22 +81,40 @@ void CodeNotesViewModel::OnActiveGameChanged()
 
 void CodeNotesViewModel::OnEndGameLoad()
 {
+    m_bSearchIndexValid = false;
     ResetFilter();
 }
 
+void CodeNotesViewModel::OnCodeNotesReloaded()
+{
+    m_bSearchIndexValid = false;
+
+    // if a game is loading, the list will be rebuilt by OnEndGameLoad
+    const auto& pGameContext = ra::services::ServiceLocator::Get<ra::data::context::GameContext>();
+    if (!pGameContext.IsGameLoading())
+        ResetFilter();
+}
+
 void CodeNotesViewModel::ResetFilter()
 {
     m_vNotes.BeginUpdate();
 
     gsl::index nIndex = 0;
 
+    // the index only has to be rebuilt if the notes were replaced. otherwise, it's kept up to date by OnCodeNoteChanged
+    const bool bRebuildSearchIndex = !m_bSearchIndexValid;
+    if (bRebuildSearchIndex)
+        m_pSearchIndex.Clear();
+
     const auto& pGameContext = ra::services::ServiceLocator::Get<ra::data::context::GameContext>();
     auto* pCodeNotes = pGameContext.Assets().FindCodeNotes();
     if (pCodeNotes != nullptr)
     {
-        pCodeNotes->EnumerateCodeNotes([this, &nIndex, pCodeNotes](ra::ByteAddress nAddress, unsigned int nBytes, const std::wstring& sNote)
+        pCodeNotes->EnumerateCodeNotes([this, &nIndex, pCodeNotes, bRebuildSearchIndex](ra::ByteAddress nAddress, unsigned int nBytes, const std::wstring& sNote)
         {
             const auto bNoteModified = pCodeNotes->IsNoteModified(nAddress);
+            if (bRebuildSearchIndex)
+                UpdateSearchIndex(nAddress, sNote, bNoteModified);
 
             std::wstring sAddress;
             if (nBytes <= 4)
@@ -131,10 +150,50 @@ void CodeNotesViewModel::ResetFilter()
 
     m_vNotes.EndUpdate();
 
+    m_bSearchIndexValid = true;
     m_nUnfilteredNotesCount = m_vNotes.Count();
     SetValue(ResultCountProperty, ra::StringPrintf(L"%u/%u", m_nUnfilteredNotesCount, m_nUnfilteredNotesCount));
 }
 
+void CodeNotesViewModel::RebuildSearchIndex()
+{
+    m_pSearchIndex.Clear();
+
+    const auto& pGameContext = ra::services::ServiceLocator::Get<ra::data::context::GameContext>();
+    const auto* pCodeNotes = pGameContext.Assets().FindCodeNotes();
+    if (pCodeNotes != nullptr)
+    {
+        pCodeNotes->EnumerateCodeNotes([this, pCodeNotes](ra::ByteAddress nAddress, unsigned int, const std::wstring& sNote)
+        {
+            UpdateSearchIndex(nAddress, sNote, pCodeNotes->IsNoteModified(nAddress));
+            return true;
+        });
+    }
+
+    m_bSearchIndexValid = true;
+}
+
+void CodeNotesViewModel::UpdateSearchIndex(ra::ByteAddress nAddress, const std::wstring& sNote, bool bNoteModified)
+{
+    // index the text that's displayed in the list
+    if (!sNote.empty())
+        m_pSearchIndex.Set(nAddress, sNote);
+    else if (bNoteModified)
+        m_pSearchIndex.Set(nAddress, L"[Deleted]");
+    else
+        m_pSearchIndex.Remove(nAddress);
+}
+
+static void CopyNote(CodeNotesViewModel::CodeNoteViewModel& pTarget, const CodeNotesViewModel::CodeNoteViewModel& pSource)
+{
+    pTarget.SetLabel(pSource.GetLabel());
+    pTarget.SetNote(pSource.GetNote());
+    pTarget.SetSelected(pSource.IsSelected());
+    pTarget.SetModified(pSource.IsModified());
+    pTarget.nAddress = pSource.nAddress;
+    pTarget.nBytes = pSource.nBytes;
+}
+
 void CodeNotesViewModel::ApplyFilter()
 {
     const bool bOnlyUnpublished = OnlyUnpublishedFilter();
@@ -146,20 +205,63 @@ void CodeNotesViewModel::ApplyFilter()
     std::wstring sFilterLower = sFilter;
     ra::StringMakeLowercase(sFilterLower);
 
-    m_vNotes.BeginUpdate();
+    // use the index to eliminate most of the notes without having to scan their text
+    std::vector<ra::ByteAddress> vCandidates;
+    bool bHasCandidates = false;
+    if (!sFilterLower.empty())
+    {
+        if (!m_bSearchIndexValid)
+            RebuildSearchIndex();
 
-    for (gsl::index i = ra::to_signed(m_vNotes.Count()) - 1; i >= 0; --i)
+        bHasCandidates = m_pSearchIndex.FindCandidates(sFilterLower, vCandidates);
+    }
+
+    std::vector<gsl::index> vMatches;
+    const auto nCount = ra::to_signed(m_vNotes.Count());
+    vMatches.reserve(bHasCandidates ? std::min(vCandidates.size(), m_vNotes.Count()) : m_vNotes.Count());
+    for (gsl::index i = 0; i < nCount; ++i)
     {
         const auto* pNote = m_vNotes.GetItemAt(i);
         Expects(pNote != nullptr);
 
         if (bOnlyUnpublished && !pNote->IsModified())
-            m_vNotes.RemoveAt(i);
-        else if (!sFilterLower.empty() && !ra::StringContainsCaseInsensitive(pNote->GetNote(), sFilterLower, true))
-            m_vNotes.RemoveAt(i);
+            continue;
+
+        if (bHasCandidates && !std::binary_search(vCandidates.begin(), vCandidates.end(), pNote->nAddress))
+            continue;
+
+        if (!sFilterLower.empty() && !ra::StringContainsCaseInsensitive(pNote->GetNote(), sFilterLower, true))
+            continue;
+
+        vMatches.push_back(i);
     }
 
-    m_vNotes.EndUpdate();
+    if (ra::to_signed(vMatches.size()) != nCount)
+    {
+        m_vNotes.BeginUpdate();
+
+        // RemoveAt has to shift every item after the removed item. instead, copy the matching items over
+        // the non-matching ones (items before the first non-matching item don't change), and then remove
+        // the excess items from the end of the list.
+        gsl::index nIndex = 0;
+        for (const auto nMatch : vMatches)
+        {
+            if (nMatch != nIndex)
+            {
+                auto* pTarget = m_vNotes.GetItemAt(nIndex);
+                const auto* pSource = m_vNotes.GetItemAt(nMatch);
+                Expects(pTarget != nullptr && pSource != nullptr);
+                CopyNote(*pTarget, *pSource);
+            }
+
+            ++nIndex;
+        }
+
+        for (gsl::index i = nCount - 1; i >= nIndex; --i)
+            m_vNotes.RemoveAt(i);
+
+        m_vNotes.EndUpdate();
+    }
 
     SetValue(ResultCountProperty, ra::StringPrintf(L"%u/%u", m_vNotes.Count(), m_nUnfilteredNotesCount));
 }
@@ -177,6 +279,9 @@ void CodeNotesViewModel::OnCodeNoteChanged(ra::ByteAddress nAddress, const std::
     m_nUnfilteredNotesCount = pCodeNotes->CodeNoteCount();
     const bool bNoteModified = pCodeNotes->IsNoteModified(nAddress);
 
+    if (m_bSearchIndexValid)
+        UpdateSearchIndex(nAddress, sNewNote, bNoteModified);
+
     bool bMatchesFilter = false;
     if (bNoteModified || !OnlyUnpublishedFilter())
     {
@@ -2,6 +2,8 @@
 #define RA_UI_CODENOTESVIEWMODEL_H
 #pragma once
 
+#include "data\TrigramIndex.hh"
+
 #include "data\context\GameContext.hh"
 
 #include "ui\WindowViewModelBase.hh"
@@ -204,6 +206,7 @@ protected:
     void OnActiveGameChanged() override;
     void OnEndGameLoad() override;
     void OnCodeNoteChanged(ra::ByteAddress nAddress, const std::wstring& sNewNote) override;
+    void OnCodeNotesReloaded() override;
 
     // ra::ui::ViewModelCollectionBase::NotifyTarget
     void OnViewModelBoolValueChanged(gsl::index nIndex, const BoolModelProperty::ChangeArgs& args) override;
@@ -212,10 +215,15 @@ protected:
 private:
     void OnSelectedItemsChanged();
     void GetSelectedModifiedNoteAddresses(std::vector<ra::ByteAddress>& vAddresses);
+    void RebuildSearchIndex();
+    void UpdateSearchIndex(ra::ByteAddress nAddress, const std::wstring& sNote, bool bNoteModified);
 
     ViewModelCollection<CodeNoteViewModel> m_vNotes;
     size_t m_nUnfilteredNotesCount = 0U;
 
+    ra::data::TrigramIndex m_pSearchIndex;
+    bool m_bSearchIndexValid = false;
+
     gsl::index m_nSelectionStart = -1, m_nSelectionEnd = -1;
     unsigned int m_nGameId = 0U;
 };
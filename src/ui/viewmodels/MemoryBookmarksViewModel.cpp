@@ -592,6 +592,22 @@ void MemoryBookmarksViewModel::OnCodeNoteChanged(ra::ByteAddress nAddress, const
     }
 }
 
+void MemoryBookmarksViewModel::OnCodeNotesReloaded()
+{
+    const auto& pGameContext = ra::services::ServiceLocator::Get<ra::data::context::GameContext>();
+    const auto* pCodeNotes = pGameContext.Assets().FindCodeNotes();
+
+    for (gsl::index nIndex = 0; ra::to_unsigned(nIndex) < m_vBookmarks.Count(); ++nIndex)
+    {
+        auto* pBookmark = m_vBookmarks.GetItemAt(nIndex);
+        if (pBookmark)
+        {
+            const auto* pNote = (pCodeNotes != nullptr) ? pCodeNotes->FindCodeNote(pBookmark->GetAddress()) : nullptr;
+            pBookmark->SetRealNote(pNote ? *pNote : std::wstring(L""));
+        }
+    }
+}
+
 void MemoryBookmarksViewModel::LoadBookmarks(ra::services::TextReader& sBookmarksFile)
 {
     const auto& pGameContext = ra::services::ServiceLocator::Get<ra::data::context::GameContext>();
@@ -750,19 +766,30 @@ void MemoryBookmarksViewModel::SaveBookmarks(ra::services::TextWriter& sBookmark
     SaveDocument(document, sBookmarksFile);
 }
 
-void MemoryBookmarksViewModel::OnByteWritten(ra::ByteAddress nAddress, uint8_t)
+void MemoryBookmarksViewModel::OnByteWritten(ra::ByteAddress nAddress, uint8_t nValue)
+{
+    OnBytesWritten(nAddress, &nValue, 1);
+}
+
+void MemoryBookmarksViewModel::OnBytesWritten(ra::ByteAddress nAddress, const uint8_t[], size_t nCount)
 {
     for (gsl::index nIndex = 0; ra::to_unsigned(nIndex) < m_vBookmarks.Count(); ++nIndex)
     {
         auto& pBookmark = *m_vBookmarks.GetItemAt(nIndex);
         const auto nBookmarkAddress = pBookmark.GetAddress();
         if (nAddress < nBookmarkAddress)
-            continue;
-
-        const auto nSize = pBookmark.GetSize();
-        const auto nBytes = (nSize == MemSize::Text) ? MaxTextBookmarkLength : ra::data::MemSizeBytes(nSize);
-        if (nAddress >= nBookmarkAddress + nBytes)
-            continue;
+        {
+            // range starts before the bookmark. ignore it if it also ends before the bookmark
+            if (nBookmarkAddress - nAddress >= nCount)
+                continue;
+        }
+        else
+        {
+            const auto nSize = pBookmark.GetSize();
+            const auto nBytes = (nSize == MemSize::Text) ? MaxTextBookmarkLength : ra::data::MemSizeBytes(nSize);
+            if (nAddress - nBookmarkAddress >= nBytes)
+                continue;
+        }
 
         if (m_nWritingMemoryCount)
             pBookmark.SetDirty(true);
@@ -456,9 +456,11 @@ protected:
     // ra::data::context::GameContext::NotifyTarget
     void OnActiveGameChanged() override;
     void OnCodeNoteChanged(ra::ByteAddress nAddress, const std::wstring& sNewNote) override;
+    void OnCodeNotesReloaded() override;
 
     // ra::data::context::EmulatorContext::NotifyTarget
-    void OnByteWritten(ra::ByteAddress, uint8_t) override;
+    void OnByteWritten(ra::ByteAddress nAddress, uint8_t nValue) override;
+    void OnBytesWritten(ra::ByteAddress nAddress, const uint8_t pBytes[], size_t nCount) override;
 
     // ra::ui::ViewModelCollectionBase::NotifyTarget
     void OnViewModelBoolValueChanged(gsl::index nIndex, const BoolModelProperty::ChangeArgs& args) override;
@@ -230,6 +230,18 @@ void MemoryInspectorViewModel::OnCodeNoteChanged(ra::ByteAddress nAddress, const
     }
 }
 
+void MemoryInspectorViewModel::OnCodeNotesReloaded()
+{
+    const auto& pGameContext = ra::services::ServiceLocator::Get<ra::data::context::GameContext>();
+    const auto* pCodeNotes = pGameContext.Assets().FindCodeNotes();
+    if (pCodeNotes != nullptr)
+    {
+        const auto nAddress = GetCurrentAddress();
+        const auto* pNote = pCodeNotes->FindCodeNote(nAddress);
+        OnCodeNoteChanged(nAddress, pNote ? *pNote : std::wstring(L""));
+    }
+}
+
 void MemoryInspectorViewModel::SetCurrentAddressNote(const std::wstring& sValue)
 {
     m_bSyncingCodeNote = true;
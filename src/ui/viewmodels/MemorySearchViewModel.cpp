@@ -983,6 +983,12 @@ void MemorySearchViewModel::OnCodeNoteChanged(ra::ByteAddress nAddress, const st
     }
 }
 
+void MemorySearchViewModel::OnCodeNotesReloaded()
+{
+    if (m_vResults.Count() > 0)
+        DispatchMemoryRead([this]() { UpdateResults(); });
+}
+
 static constexpr bool CanEditFilterValue(ra::services::SearchFilterType nFilterType)
 {
     switch (nFilterType)
@@ -468,6 +468,7 @@ protected:
 
     // GameContext::NotifyTarget
     void OnCodeNoteChanged(ra::ByteAddress nAddress, const std::wstring& sNote) override;
+    void OnCodeNotesReloaded() override;
 
     void SaveResults(ra::services::TextWriter& sFile, std::function<bool(int)> pProgressCallback) const;
 
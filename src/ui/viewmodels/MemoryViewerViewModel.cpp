@@ -859,6 +859,36 @@ void MemoryViewerViewModel::OnByteWritten(ra::ByteAddress nAddress, uint8_t nVal
     }
 }
 
+void MemoryViewerViewModel::OnBytesWritten(ra::ByteAddress nAddress, const uint8_t pBytes[], size_t nCount)
+{
+    const auto nFirstAddress = GetFirstAddress();
+    const auto nVisibleLines = GetNumVisibleLines();
+    const auto nMaxAddress = nFirstAddress + nVisibleLines * 16;
+
+    // only copy the part of the range that's visible
+    if (nAddress < nFirstAddress)
+    {
+        if (nFirstAddress - nAddress >= nCount)
+            return;
+
+        pBytes += nFirstAddress - nAddress;
+        nCount -= nFirstAddress - nAddress;
+        nAddress = nFirstAddress;
+    }
+
+    if (nAddress >= nMaxAddress)
+        return;
+
+    nCount = std::min(nCount, gsl::narrow_cast<size_t>(nMaxAddress - nAddress));
+
+    const auto nOffset = nAddress - nFirstAddress;
+    memcpy(&m_pMemory[nOffset], pBytes, nCount);
+    for (size_t i = 0; i < nCount; ++i)
+        m_pColor[nOffset + i] |= STALE_COLOR;
+
+    m_nNeedsRedraw |= REDRAW_MEMORY;
+}
+
 #pragma warning(push)
 #pragma warning(disable : 5045)
 
@@ -187,10 +187,12 @@ protected:
     // GameContext::NotifyTarget
     void OnActiveGameChanged() override;
     void OnCodeNoteChanged(ra::ByteAddress, const std::wstring&) override;
+    void OnCodeNotesReloaded() override { UpdateColors(); }
 
     // EmulatorContext::NotifyTarget
     void OnTotalMemorySizeChanged() override;
     void OnByteWritten(ra::ByteAddress nAddress, uint8_t nValue) override;
+    void OnBytesWritten(ra::ByteAddress nAddress, const uint8_t pBytes[], size_t nCount) override;
 
     uint8_t* m_pMemory;
     uint8_t* m_pColor;
@@ -26,7 +26,7 @@ static void RenderPopup(ra::ui::drawing::ISurface& pSurface, const PopupViewMode
     pSurface.DrawSurface(nX, nY, vmPopup.GetRenderImage());
 }
 
-static void RenderPopupClippedX(ra::ui::drawing::ISurface& pSurface, const PopupViewModelBase& vmPopup, int nClipX)
+static void RenderPopupClipped(ra::ui::drawing::ISurface& pSurface, const PopupViewModelBase& vmPopup, const ra::ui::Rect& pClip)
 {
     if (!vmPopup.IsAnimationStarted())
         return;
@@ -35,9 +35,18 @@ static void RenderPopupClippedX(ra::ui::drawing::ISurface& pSurface, const Popup
     const auto nY = vmPopup.GetRenderLocationY();
 
     const auto& pImage = vmPopup.GetRenderImage();
-    const int nVisibleWidth = nX + ra::to_signed(pImage.GetWidth()) - nClipX;
-    if (nVisibleWidth > 0)
-        pSurface.DrawSurface(nClipX, nY, pImage, pImage.GetWidth() - nVisibleWidth, 0, nVisibleWidth, pImage.GetHeight());
+    const int nLeft = std::max(nX, pClip.X);
+    const int nTop = std::max(nY, pClip.Y);
+    const int nRight = std::min(nX + ra::to_signed(pImage.GetWidth()), pClip.X + pClip.Width);
+    const int nBottom = std::min(nY + ra::to_signed(pImage.GetHeight()), pClip.Y + pClip.Height);
+    if (nRight > nLeft && nBottom > nTop)
+        pSurface.DrawSurface(nLeft, nTop, pImage, nLeft - nX, nTop - nY, nRight - nLeft, nBottom - nTop);
+}
+
+static bool Intersects(const ra::ui::Rect& pFirst, const ra::ui::Rect& pSecond) noexcept
+{
+    return pFirst.X < pSecond.X + pSecond.Width && pSecond.X < pFirst.X + pFirst.Width &&
+           pFirst.Y < pSecond.Y + pSecond.Height && pSecond.Y < pFirst.Y + pFirst.Height;
 }
 
 void OverlayManager::InitializeNotifyTargets()
@@ -131,6 +140,7 @@ void OverlayManager::Render(ra::ui::drawing::ISurface& pSurface, bool bRedrawAll
 {
     m_bRenderRequestPending = false;
     m_bRedrawAll = bRedrawAll;
+    m_vDirtyRects.clear();
 
     bool bRequestRender = false;
     {
@@ -157,7 +167,7 @@ void OverlayManager::Render(ra::ui::drawing::ISurface& pSurface, bool bRedrawAll
             {
                 UpdateActiveMessage(pSurface, pPopupLocations, fElapsed);
 
-                // a visible popup may not set m_bRedrawAll if it's in the pause portion of its animation loop
+                // a visible popup may not add a dirty rect if it's in the pause portion of its animation loop
                 // make sure we keep the render cycle going so it'll eventually handle when the pause ends
                 bRequestRender = true;
             }
@@ -166,7 +176,7 @@ void OverlayManager::Render(ra::ui::drawing::ISurface& pSurface, bool bRedrawAll
             {
                 UpdateActiveScoreboard(pSurface, pPopupLocations, fElapsed);
 
-                // a visible scoreboard may not set m_bRedrawAll if it's in the pause portion of its animation loop
+                // a visible scoreboard may not add a dirty rect if it's in the pause portion of its animation loop
                 // make sure we keep the render cycle going so it'll eventually handle when the pause ends
                 bRequestRender = true;
             }
@@ -181,8 +191,8 @@ void OverlayManager::Render(ra::ui::drawing::ISurface& pSurface, bool bRedrawAll
             {
                 UpdateProgressTracker(pSurface, pPopupLocations, fElapsed);
 
-                // a visible progress tracker may not set m_bRedrawAll if it's in the pause portion of its animation
-                // loop make sure we keep the render cycle going so it'll eventually handle when the pause ends
+                // a visible progress tracker may not add a dirty rect if it's in the pause portion of its animation
+                // loop. make sure we keep the render cycle going so it'll eventually handle when the pause ends
                 bRequestRender = true;
             }
         }
@@ -204,6 +214,14 @@ void OverlayManager::Render(ra::ui::drawing::ISurface& pSurface, bool bRedrawAll
                 if (!m_vPopupMessages.empty())
                     RenderPopup(pSurface, *m_vPopupMessages.front());
 
+                m_vDirtyRects.clear();
+                AddDirtyRect(0, 0, pSurface.GetWidth(), pSurface.GetHeight());
+                bRequestRender = true;
+            }
+            else if (!m_vDirtyRects.empty())
+            {
+                // only repaint the areas that changed
+                RenderDirtyRects(pSurface);
                 bRequestRender = true;
             }
         }
@@ -485,7 +503,6 @@ ra::ui::Position OverlayManager::GetRenderLocation(const ra::ui::viewmodels::Pop
 
 void OverlayManager::UpdatePopup(ra::ui::drawing::ISurface& pSurface, const PopupLocations& pPopupLocations, double fElapsed, ra::ui::viewmodels::PopupViewModelBase& vmPopup)
 {
-    constexpr int nFudge = 4;
     unsigned nOldWidth = 0, nOldHeight = 0;
 
     if (!vmPopup.IsAnimationStarted())
@@ -509,55 +526,113 @@ void OverlayManager::UpdatePopup(ra::ui::drawing::ISurface& pSurface, const Popu
 
     if (vmPopup.IsDestroyPending())
     {
-        pSurface.FillRectangle(nOldX, nOldY, nOldWidth, nOldHeight, ra::ui::Color::Transparent);
-        m_bRedrawAll = true;
+        AddDirtyRect(nOldX, nOldY, nOldWidth, nOldHeight);
         return;
     }
 
-    m_bRedrawAll |= vmPopup.UpdateRenderImage(fElapsed);
+    const bool bImageChanged = vmPopup.UpdateRenderImage(fElapsed);
 
     const auto& pNewImage = vmPopup.GetRenderImage();
 
     const auto nNewPos = GetRenderLocation(vmPopup, vmPopup.GetHorizontalOffset(),
         vmPopup.GetVerticalOffset(), pSurface, pPopupLocations);
 
-    // eliminate any excess to the left or right of the popup
-    if (nOldX != nNewPos.X || nOldWidth != pNewImage.GetWidth())
+    if (nOldX != nNewPos.X || nOldY != nNewPos.Y ||
+        nOldWidth != pNewImage.GetWidth() || nOldHeight != pNewImage.GetHeight())
     {
         vmPopup.SetRenderLocationX(nNewPos.X);
+        vmPopup.SetRenderLocationY(nNewPos.Y);
 
-        if (nOldWidth != 0)
-        {
-            const int nHeight = pNewImage.GetHeight() + std::abs(nNewPos.Y - nOldY);
-            if (nNewPos.X > nOldX && nOldX + ra::to_signed(nOldWidth) >= 0)
-                pSurface.FillRectangle(nOldX - nFudge, nOldY, nNewPos.X - nOldX + nFudge, nHeight, ra::ui::Color::Transparent);
-
-            const int nOldRightBound = nOldX + nOldWidth;
-            const int nNewRightBound = nNewPos.X + pNewImage.GetWidth();
-            if (nNewRightBound < nOldRightBound)
-                pSurface.FillRectangle(nNewRightBound, nOldY, nOldRightBound - nNewRightBound + nFudge, nHeight, ra::ui::Color::Transparent);
-        }
-
-        m_bRedrawAll = true;
+        // the area previously covered by the popup has to be erased
+        AddDirtyRect(nOldX, nOldY, nOldWidth, nOldHeight);
+    }
+    else if (!bImageChanged)
+    {
+        return;
     }
 
-    // eliminate any excess above or below the popup
-    if (nOldY != nNewPos.Y || nOldHeight != pNewImage.GetHeight())
+    AddDirtyRect(nNewPos.X, nNewPos.Y, pNewImage.GetWidth(), pNewImage.GetHeight());
+}
+
+void OverlayManager::AddDirtyRect(int nX, int nY, int nWidth, int nHeight)
+{
+    if (nWidth > 0 && nHeight > 0)
+        m_vDirtyRects.push_back({ nX, nY, nWidth, nHeight });
+}
+
+void OverlayManager::MergeDirtyRects(int nSurfaceWidth, int nSurfaceHeight)
+{
+    // clip to the surface, discarding anything that's entirely offscreen
+    for (auto& pRect : m_vDirtyRects)
     {
-        vmPopup.SetRenderLocationY(nNewPos.Y);
+        const int nRight = std::min(pRect.X + pRect.Width, nSurfaceWidth);
+        const int nBottom = std::min(pRect.Y + pRect.Height, nSurfaceHeight);
+        pRect.X = std::max(pRect.X, 0);
+        pRect.Y = std::max(pRect.Y, 0);
+        pRect.Width = nRight - pRect.X;
+        pRect.Height = nBottom - pRect.Y;
+    }
 
-        if (nOldHeight != 0)
+    m_vDirtyRects.erase(std::remove_if(m_vDirtyRects.begin(), m_vDirtyRects.end(),
+        [](const ra::ui::Rect& pRect) noexcept { return pRect.Width <= 0 || pRect.Height <= 0; }),
+        m_vDirtyRects.end());
+
+    // replace overlapping rectangles with their bounding box. a merged rectangle may now overlap
+    // one that was previously checked, so keep going until nothing changes.
+    bool bMerged = true;
+    while (bMerged)
+    {
+        bMerged = false;
+        for (size_t i = 0; i < m_vDirtyRects.size(); ++i)
         {
-            if (nNewPos.Y > nOldY && nOldY + ra::to_signed(nOldHeight) >= 0)
-                pSurface.FillRectangle(nNewPos.X, nOldY - nFudge, pNewImage.GetWidth(), nNewPos.Y - nOldY + nFudge, ra::ui::Color::Transparent);
+            size_t j = i + 1;
+            while (j < m_vDirtyRects.size())
+            {
+                auto& pRect = m_vDirtyRects.at(i);
+                const auto& pOther = m_vDirtyRects.at(j);
+                if (!Intersects(pRect, pOther))
+                {
+                    ++j;
+                    continue;
+                }
+
+                const int nRight = std::max(pRect.X + pRect.Width, pOther.X + pOther.Width);
+                const int nBottom = std::max(pRect.Y + pRect.Height, pOther.Y + pOther.Height);
+                pRect.X = std::min(pRect.X, pOther.X);
+                pRect.Y = std::min(pRect.Y, pOther.Y);
+                pRect.Width = nRight - pRect.X;
+                pRect.Height = nBottom - pRect.Y;
 
-            const int nOldLowerBound = nOldY + nOldHeight;
-            const int nNewLowerBound = nNewPos.Y + pNewImage.GetHeight();
-            if (nNewLowerBound < nOldLowerBound)
-                pSurface.FillRectangle(nNewPos.X, nNewLowerBound, pNewImage.GetWidth(), nOldLowerBound - nNewLowerBound + nFudge, ra::ui::Color::Transparent);
+                m_vDirtyRects.erase(m_vDirtyRects.begin() + j);
+                bMerged = true;
+            }
         }
+    }
+}
+
+void OverlayManager::RenderPopupsClipped(ra::ui::drawing::ISurface& pSurface, const ra::ui::Rect& pClip) const
+{
+    // items that should appear over other items should be drawn last
+    if (!m_vScoreboards.empty())
+        RenderPopupClipped(pSurface, m_vScoreboards.front(), pClip);
+    for (const auto& pScoreTracker : m_vScoreTrackers)
+        RenderPopupClipped(pSurface, *pScoreTracker, pClip);
+    for (const auto& pChallengeIndicator : m_vChallengeIndicators)
+        RenderPopupClipped(pSurface, *pChallengeIndicator, pClip);
+    if (m_vmProgressTracker != nullptr)
+        RenderPopupClipped(pSurface, *m_vmProgressTracker, pClip);
+    if (!m_vPopupMessages.empty())
+        RenderPopupClipped(pSurface, *m_vPopupMessages.front(), pClip);
+}
 
-        m_bRedrawAll = true;
+void OverlayManager::RenderDirtyRects(ra::ui::drawing::ISurface& pSurface)
+{
+    MergeDirtyRects(pSurface.GetWidth(), pSurface.GetHeight());
+
+    for (const auto& pRect : m_vDirtyRects)
+    {
+        pSurface.FillRectangle(pRect.X, pRect.Y, pRect.Width, pRect.Height, ra::ui::Color::Transparent);
+        RenderPopupsClipped(pSurface, pRect);
     }
 }
 
@@ -670,6 +745,12 @@ void OverlayManager::UpdateScoreTrackers(ra::ui::drawing::ISurface& pSurface, Po
                         if (vDisplayedValues.find(nDisplayedValue) != vDisplayedValues.end())
                         {
                             // position offscreen
+                            if (vmTracker.IsAnimationStarted() && vmTracker.HasRenderImage())
+                            {
+                                const auto& pImage = vmTracker.GetRenderImage();
+                                AddDirtyRect(vmTracker.GetRenderLocationX(), vmTracker.GetRenderLocationY(),
+                                             pImage.GetWidth(), pImage.GetHeight());
+                            }
                             vmTracker.SetRenderLocationY(-100);
                             ++pIter;
                             continue;
@@ -768,47 +849,44 @@ void OverlayManager::UpdateOverlay(ra::ui::drawing::ISurface& pSurface, double f
         m_vmOverlay.Resize(pSurface.GetWidth(), pSurface.GetHeight());
     }
 
-    if (m_vmOverlay.CurrentState() == OverlayViewModel::State::FadeOut)
-    {
-        // when fading out, have to redraw the popups that were obscured by the overlay
-        const int nOverlayRight = m_vmOverlay.GetHorizontalOffset() +
-            m_vmOverlay.GetRenderImage().GetWidth();
+    const int nSurfaceWidth = ra::to_signed(pSurface.GetWidth());
+    const int nSurfaceHeight = ra::to_signed(pSurface.GetHeight());
+    const int nOldOverlayRight = m_vmOverlay.GetHorizontalOffset() +
+        ra::to_signed(m_vmOverlay.GetRenderImage().GetWidth());
 
-        for (const auto& pChallengeIndicator : m_vChallengeIndicators)
-            RenderPopupClippedX(pSurface, *pChallengeIndicator, nOverlayRight);
-        if (m_vmProgressTracker != nullptr)
-            RenderPopupClippedX(pSurface, *m_vmProgressTracker, nOverlayRight);
+    const auto nPopupDirtyRects = m_vDirtyRects.size();
+    UpdatePopup(pSurface, pPopupLocations, fElapsed, m_vmOverlay);
+    const bool bOverlayChanged = m_bRedrawAll || m_vDirtyRects.size() > nPopupDirtyRects;
+    m_vDirtyRects.resize(nPopupDirtyRects);
 
-        for (const auto& pTracker : m_vScoreTrackers)
-            RenderPopupClippedX(pSurface, *pTracker, nOverlayRight);
+    const int nOverlayRight = std::clamp(m_vmOverlay.GetHorizontalOffset() +
+        ra::to_signed(m_vmOverlay.GetRenderImage().GetWidth()), 0, nSurfaceWidth);
 
-        if (!m_vScoreboards.empty())
-            RenderPopupClippedX(pSurface, m_vScoreboards.front(), nOverlayRight);
+    // popups are obscured by the overlay. only the portions to the right of it need to be painted
+    for (auto& pRect : m_vDirtyRects)
+    {
+        if (pRect.X < nOverlayRight)
+        {
+            pRect.Width -= nOverlayRight - pRect.X;
+            pRect.X = nOverlayRight;
+        }
+    }
 
-        if (!m_vPopupMessages.empty())
-            RenderPopupClippedX(pSurface, *m_vPopupMessages.front(), nOverlayRight);
+    // when fading out, have to redraw the popups that were obscured by the overlay
+    const int nRevealedRight = m_bRedrawAll ? nSurfaceWidth : std::min(nOldOverlayRight, nSurfaceWidth);
+    AddDirtyRect(nOverlayRight, 0, nRevealedRight - nOverlayRight, nSurfaceHeight);
 
-        m_bRedrawAll = true;
-    }
+    RenderDirtyRects(pSurface);
 
-    UpdatePopup(pSurface, pPopupLocations, fElapsed, m_vmOverlay);
-    if (m_bRedrawAll)
+    if (bOverlayChanged)
+    {
         RenderPopup(pSurface, m_vmOverlay);
+        AddDirtyRect(0, 0, nOverlayRight, nSurfaceHeight);
+    }
 
+    // once the fade out completes, everything that was obscured by the overlay has been redrawn
     if (m_vmOverlay.CurrentState() == OverlayViewModel::State::Hidden)
-    {
         m_vmOverlay.DestroyRenderImage();
-
-        // fade out completed, render everything that was obscured by the overlay
-        for (auto& pTracker : m_vScoreTrackers)
-            RenderPopup(pSurface, *pTracker);
-
-        if (!m_vScoreboards.empty())
-            RenderPopup(pSurface, m_vScoreboards.front());
-
-        if (!m_vPopupMessages.empty())
-            RenderPopup(pSurface, *m_vPopupMessages.front());
-    }
 }
 
 void OverlayManager::CaptureScreenshot(int nMessageId, const std::wstring& sPath)
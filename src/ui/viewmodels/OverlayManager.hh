@@ -322,6 +322,15 @@ public:
     /// </summary>
     bool NeedsRender() const noexcept;
 
+    /// <summary>
+    /// Gets the areas of the surface that were modified by the most recent call to <see cref="Render" />.
+    /// </summary>
+    /// <remarks>
+    /// The rectangles are clipped to the surface and do not overlap. A host that only needs to repaint
+    /// the changed parts of the surface can limit its update to these areas.
+    /// </remarks>
+    const std::vector<ra::ui::Rect>& GetDirtyRects() const noexcept { return m_vDirtyRects; }
+
 protected:
     ra::ui::viewmodels::OverlayViewModel m_vmOverlay;
     std::deque<std::unique_ptr<PopupMessageViewModel>> m_vPopupMessages;
@@ -367,10 +376,16 @@ private:
 
     void UpdateOverlay(ra::ui::drawing::ISurface& pSurface, double fElapsed);
 
+    void AddDirtyRect(int nX, int nY, int nWidth, int nHeight);
+    void MergeDirtyRects(int nSurfaceWidth, int nSurfaceHeight);
+    void RenderDirtyRects(ra::ui::drawing::ISurface& pSurface);
+    void RenderPopupsClipped(ra::ui::drawing::ISurface& pSurface, const ra::ui::Rect& pClip) const;
+
     void ProcessScreenshots();
     std::unique_ptr<ra::ui::drawing::ISurface> RenderScreenshot(const ra::ui::drawing::ISurface& pClientSurface, const PopupMessageViewModel& vmPopup);
 
     bool m_bRedrawAll = false;
+    std::vector<ra::ui::Rect> m_vDirtyRects;
     std::chrono::steady_clock::time_point m_tLastRender{};
     std::chrono::steady_clock::time_point m_tLastRequestRender{};
     std::function<void()> m_fHandleRenderRequest;
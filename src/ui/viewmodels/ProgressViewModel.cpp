@@ -11,12 +11,28 @@ const StringModelProperty ProgressViewModel::MessageProperty("ProgressViewModel"
 const IntModelProperty ProgressViewModel::ProgressProperty("ProgressViewModel", "Progress", 0);
 
 void ProgressViewModel::QueueTask(std::function<void()>&& fTaskHandler)
+{
+    QueueTask(std::move(fTaskHandler), false);
+}
+
+void ProgressViewModel::QueueSerializedTask(std::function<void()>&& fTaskHandler)
+{
+    QueueTask(std::move(fTaskHandler), true);
+}
+
+void ProgressViewModel::QueueTask(std::function<void()>&& fTaskHandler, bool bSerialized)
 {
     auto pItem = std::make_unique<TaskItem>();
     pItem->fTaskHandler = std::move(fTaskHandler);
+    pItem->bSerialized = bSerialized;
 
-    std::lock_guard<std::mutex> pGuard(m_pMutex);
-    m_vTasks.emplace_back(std::move(pItem));
+    {
+        std::lock_guard<std::mutex> pGuard(m_pMutex);
+        m_vTasks.emplace_back(std::move(pItem));
+    }
+
+    // wake any threads waiting for work
+    m_cvTasksChanged.notify_all();
 }
 
 void ProgressViewModel::OnValueChanged(const BoolModelProperty::ChangeArgs& args)
@@ -35,10 +51,9 @@ void ProgressViewModel::BeginTasks()
 
     OnBegin();
 
-    // use up to four threads to process the queue
-    constexpr int MAX_THREADS = 4;
+    // use up to MaxConcurrentTasks threads to process the queue
     auto& pThreadPool = ra::services::ServiceLocator::GetMutable<ra::services::IThreadPool>();
-    for (int i = 0; i < std::min(gsl::narrow_cast<int>(m_vTasks.size()), MAX_THREADS); ++i)
+    for (int i = 0; i < std::min(gsl::narrow_cast<int>(m_vTasks.size()), MaxConcurrentTasks); ++i)
     {
         pThreadPool.RunAsync([this, pAsyncHandle = CreateAsyncHandle()]()
         {
@@ -59,40 +74,96 @@ void ProgressViewModel::BeginTasks()
 
 void ProgressViewModel::ProcessQueue()
 {
+    TaskItem* pCompletedTask = nullptr;
     do
     {
         TaskItem* pTask = nullptr;
         int nComplete = 0;
         {
-            std::lock_guard<std::mutex> pGuard(m_pMutex);
-            if (m_bQueueComplete || GetDialogResult() != DialogResult::None)
-                return;
+            std::unique_lock<std::mutex> pGuard(m_pMutex);
 
-            for (auto& pItem : m_vTasks)
+            if (pCompletedTask != nullptr)
             {
-                if (pItem->nState == TaskState::None && !pTask)
+                pCompletedTask->nState = TaskState::Done;
+                --m_nRunningTasks;
+                if (pCompletedTask->bSerialized)
+                    m_bSerializedTaskRunning = false;
+
+                pCompletedTask = nullptr;
+
+                // a running task may have queued more tasks, or unblocked a serialized task
+                m_cvTasksChanged.notify_all();
+            }
+
+            do
+            {
+                if (m_bQueueComplete || GetDialogResult() != DialogResult::None)
+                    return;
+
+                // tasks are claimed in order, so everything before m_nFirstPendingTask has been started
+                while (m_nFirstPendingTask < m_vTasks.size() &&
+                       m_vTasks.at(m_nFirstPendingTask)->nState != TaskState::None)
                 {
-                    pItem->nState = TaskState::Running;
-                    pTask = pItem.get();
+                    ++m_nFirstPendingTask;
                 }
-                else if (pItem->nState == TaskState::Done)
+
+                for (auto nIndex = m_nFirstPendingTask; nIndex < m_vTasks.size(); ++nIndex)
                 {
-                    ++nComplete;
+                    auto& pItem = *m_vTasks.at(nIndex);
+                    if (pItem.nState != TaskState::None)
+                        continue;
+
+                    if (pItem.bSerialized)
+                    {
+                        if (m_bSerializedTaskRunning)
+                            continue;
+
+                        m_bSerializedTaskRunning = true;
+                    }
+
+                    pItem.nState = TaskState::Running;
+                    pTask = &pItem;
+                    ++m_nRunningTasks;
+                    break;
+                }
+
+                if (pTask != nullptr)
+                    break;
+
+                if (m_nRunningTasks == 0)
+                {
+                    // nothing left to do, and nothing running that could queue more work
+                    m_bQueueComplete = true;
+                    m_cvTasksChanged.notify_all();
+                    break;
                 }
-            }
 
-            if (pTask == nullptr)
-                m_bQueueComplete = true;
+                // a running task may queue more work (or finish and unblock a serialized task). wait for it.
+                // poll periodically so the wait is abandoned if the dialog is closed.
+                m_cvTasksChanged.wait_for(pGuard, std::chrono::milliseconds(100));
+            } while (true);
 
-            nComplete = nComplete * 100 / gsl::narrow_cast<int>(m_vTasks.size());
+            const auto nTotal = gsl::narrow_cast<int>(m_vTasks.size());
+            const auto nNotDone = gsl::narrow_cast<int>(std::count_if(m_vTasks.begin(), m_vTasks.end(),
+                [](const std::unique_ptr<TaskItem>& pItem) noexcept { return pItem->nState != TaskState::Done; }));
+            nComplete = nTotal - nNotDone;
+            nComplete = nComplete * 100 / nTotal;
         }
 
-        SetValue(ProgressProperty, nComplete);
+        {
+            // several threads may be reporting progress at the same time
+            std::lock_guard<std::mutex> pGuard(m_pProgressMutex);
+            if (nComplete != m_nLastProgress)
+            {
+                m_nLastProgress = nComplete;
+                SetValue(ProgressProperty, nComplete);
+            }
+        }
 
         if (pTask != nullptr)
         {
             pTask->fTaskHandler();
-            pTask->nState = TaskState::Done;
+            pCompletedTask = pTask;
         }
     } while (true);
 }
@@ -59,10 +59,21 @@ public:
 
     void QueueTask(std::function<void()>&& fTaskHandler);
 
+    /// <summary>
+    /// Queues a task that will not be run at the same time as any other serialized task. Other tasks may
+    /// still be processed by the remaining threads while the serialized task is running.
+    /// </summary>
+    void QueueSerializedTask(std::function<void()>&& fTaskHandler);
+
     const size_t TaskCount() const noexcept { return m_vTasks.size(); }
 
     bool IsProcessingTasks() const noexcept { return m_vActiveThreads != 0; }
 
+    /// <summary>
+    /// The maximum number of tasks to process at the same time.
+    /// </summary>
+    static constexpr int MaxConcurrentTasks = 4;
+
 protected:
     void OnValueChanged(const BoolModelProperty::ChangeArgs& args) override;
 
@@ -84,12 +95,21 @@ private:
     {
         std::function<void()> fTaskHandler;
         TaskState nState = TaskState::None;
+        bool bSerialized = false;
     };
 
+    void QueueTask(std::function<void()>&& fTaskHandler, bool bSerialized);
+
     std::vector<std::unique_ptr<TaskItem>> m_vTasks;
     std::mutex m_pMutex;
+    std::condition_variable m_cvTasksChanged;
+    size_t m_nFirstPendingTask = 0;
+    int m_nRunningTasks = 0;
+    bool m_bSerializedTaskRunning = false;
     bool m_bQueueComplete = false;
-    int m_vActiveThreads = 0;
+    std::atomic<int> m_vActiveThreads = 0;
+    int m_nLastProgress = -1;
+    std::mutex m_pProgressMutex;
 };
 
 } // namespace viewmodels
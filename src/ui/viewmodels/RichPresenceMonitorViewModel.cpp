@@ -38,12 +38,18 @@ void RichPresenceMonitorViewModel::UpdateDisplayString()
 
     auto* pRichPresence = pGameContext.Assets().FindRichPresence();
 
-    // check to see if the script was updated
+    // check to see if the script was updated. this is called frequently, so rely on the change
+    // notification rather than examining the file each time.
+    if (nGameId != m_nRichPresenceGameId)
+    {
+        m_nRichPresenceGameId = nGameId;
+        m_nRichPresenceGeneration = 0;
+    }
+
     auto& pLocalStorage = ra::services::ServiceLocator::GetMutable<ra::services::ILocalStorage>();
-    const auto tLastModified = pLocalStorage.GetLastModified(ra::services::StorageItemType::RichPresence,
-                                                             std::to_wstring(nGameId));
-    const auto tRichPresenceFileTime = std::chrono::system_clock::to_time_t(tLastModified);
-    if (tRichPresenceFileTime == m_tRichPresenceFileTime)
+    const auto nRichPresenceGeneration = pLocalStorage.GetChangeGeneration(ra::services::StorageItemType::RichPresence,
+                                                                           std::to_wstring(nGameId));
+    if (nRichPresenceGeneration == m_nRichPresenceGeneration)
     {
         // not updated. if no model, set default string and bail
         if (!pRichPresence)
@@ -54,7 +60,7 @@ void RichPresenceMonitorViewModel::UpdateDisplayString()
     }
     else
     {
-        m_tRichPresenceFileTime = tRichPresenceFileTime;
+        m_nRichPresenceGeneration = nRichPresenceGeneration;
 
         if (!pRichPresence)
         {
@@ -88,9 +94,8 @@ void RichPresenceMonitorViewModel::UpdateDisplayString()
         case ra::data::models::AssetState::Active:
         case ra::data::models::AssetState::Disabled: // parse error, still display it
         {
-            auto& pRuntime = ra::services::ServiceLocator::Get<ra::services::AchievementRuntime>();
-            const std::wstring sDisplayString = ra::Widen(pRuntime.GetRichPresenceDisplayString());
-            SetDisplayString(sDisplayString);
+            const auto& pRuntime = ra::services::ServiceLocator::Get<ra::services::AchievementRuntime>();
+            SetDisplayString(pRuntime.GetRichPresenceDisplayString());
             return;
         }
 
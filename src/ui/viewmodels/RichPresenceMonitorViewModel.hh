@@ -47,7 +47,8 @@ protected:
 private:
     void UpdateWindowTitle();
 
-    time_t m_tRichPresenceFileTime{ 0 };
+    unsigned int m_nRichPresenceGameId = 0;
+    uint32_t m_nRichPresenceGeneration = 0;
 };
 
 } // namespace viewmodels
@@ -715,6 +715,9 @@ void TriggerViewModel::ConditionsMonitor::OnEndViewModelCollectionUpdate()
 
 void TriggerViewModel::ConditionsMonitor::UpdateCurrentGroup()
 {
+    // the conditions may no longer match the ones the hits were last copied from. resynchronize on the next frame.
+    m_vmTrigger->m_pLastHitsConditionSet = nullptr;
+
     if (m_nUpdateCount > 0)
     {
         m_bUpdatePending = true;
@@ -862,6 +865,8 @@ void TriggerViewModel::UpdateConditions(const GroupViewModel* pGroup)
 
     int nIndex = 0;
     m_bHasHitChain = false;
+    m_vLastHits.clear();
+    m_pLastHitsConditionSet = nullptr;
 
     if (pGroup != nullptr)
     {
@@ -897,17 +902,27 @@ void TriggerViewModel::UpdateConditions(const GroupViewModel* pGroup)
                 vmCondition->InitializeFrom(*pCondition);
                 vmCondition->SetCurrentHits(pCondition->current_hits);
                 vmCondition->SetTotalHits(0);
+                m_vLastHits.push_back(pCondition->current_hits);
 
                 vmCondition->SetIndirect(bIsIndirect);
                 bIsIndirect = (pCondition->type == RC_CONDITION_ADD_ADDRESS);
 
                 m_bHasHitChain |= (pCondition->type == RC_CONDITION_ADD_HITS || pCondition->type == RC_CONDITION_SUB_HITS);
             }
+
+            // hits in a temporary copy of the conditions can't be monitored
+            if (pConditions == pGroup->m_pConditionSet)
+                m_pLastHitsConditionSet = pConditions;
         }
 
+        IdentifyHitChains(gsl::narrow_cast<size_t>(nIndex));
         if (m_bHasHitChain)
             UpdateTotalHits();
     }
+    else
+    {
+        IdentifyHitChains(0);
+    }
 
     for (gsl::index nScan = m_vConditions.Count() - 1; nScan >= nIndex; --nScan)
         m_vConditions.RemoveAt(nScan);
@@ -947,25 +962,27 @@ void TriggerViewModel::ToggleDecimal()
     m_vConditions.AddNotifyTarget(m_pConditionsMonitor);
 }
 
-void TriggerViewModel::UpdateTotalHits()
+void TriggerViewModel::IdentifyHitChains(size_t nConditions)
 {
-    int nHits = 0;
-    bool bIsHitsChain = false;
+    m_vHitChains.clear();
+    m_vConditionHitChain.clear();
+
+    if (!m_bHasHitChain)
+        return;
 
-    for (size_t nIndex = 0; nIndex < m_vConditions.Count(); ++nIndex)
+    m_vConditionHitChain.resize(nConditions, -1);
+
+    gsl::index nFirst = -1;
+    for (gsl::index nIndex = 0; nIndex < gsl::narrow_cast<gsl::index>(nConditions); ++nIndex)
     {
-        auto* vmCondition = m_vConditions.GetItemAt(nIndex);
+        const auto* vmCondition = m_vConditions.GetItemAt(nIndex);
         Expects(vmCondition != nullptr);
         switch (vmCondition->GetType())
         {
             case ra::ui::viewmodels::TriggerConditionType::AddHits:
-                bIsHitsChain = true;
-                nHits += vmCondition->GetCurrentHits();
-                break;
-
             case ra::ui::viewmodels::TriggerConditionType::SubHits:
-                bIsHitsChain = true;
-                nHits -= vmCondition->GetCurrentHits();
+                if (nFirst == -1)
+                    nFirst = nIndex;
                 break;
 
             case ra::ui::viewmodels::TriggerConditionType::AddAddress:
@@ -978,13 +995,50 @@ void TriggerViewModel::UpdateTotalHits()
                 break;
 
             default:
-                if (bIsHitsChain)
+                if (nFirst != -1)
+                {
+                    const auto nHitChain = gsl::narrow_cast<int>(m_vHitChains.size());
+                    m_vHitChains.emplace_back(nFirst, nIndex);
+                    for (gsl::index nScan = nFirst; nScan <= nIndex; ++nScan)
+                        gsl::at(m_vConditionHitChain, nScan) = nHitChain;
+
+                    nFirst = -1;
+                }
+                break;
+        }
+    }
+}
+
+void TriggerViewModel::UpdateTotalHits()
+{
+    for (const auto& pHitChain : m_vHitChains)
+        UpdateTotalHits(pHitChain.first, pHitChain.second);
+}
+
+void TriggerViewModel::UpdateTotalHits(gsl::index nFirst, gsl::index nLast)
+{
+    int nHits = 0;
+
+    for (gsl::index nIndex = nFirst; nIndex <= nLast; ++nIndex)
+    {
+        auto* vmCondition = m_vConditions.GetItemAt(nIndex);
+        Expects(vmCondition != nullptr);
+        switch (vmCondition->GetType())
+        {
+            case ra::ui::viewmodels::TriggerConditionType::AddHits:
+                nHits += vmCondition->GetCurrentHits();
+                break;
+
+            case ra::ui::viewmodels::TriggerConditionType::SubHits:
+                nHits -= vmCondition->GetCurrentHits();
+                break;
+
+            default:
+                if (nIndex == nLast)
                 {
                     nHits += vmCondition->GetCurrentHits();
                     vmCondition->SetTotalHits(nHits);
-                    bIsHitsChain = false;
                 }
-                nHits = 0;
                 break;
         }
     }
@@ -1062,33 +1116,108 @@ void TriggerViewModel::RemoveGroup()
 
 void TriggerViewModel::DoFrame()
 {
-    auto* pGroup = m_vGroups.GetItemAt(GetSelectedGroupIndex());
-    if (pGroup != nullptr && pGroup->m_pConditionSet)
+    const auto* pGroup = m_vGroups.GetItemAt(GetSelectedGroupIndex());
+    if (pGroup == nullptr || !pGroup->m_pConditionSet)
+        return;
+
+    const auto& pConditionSet = *pGroup->m_pConditionSet;
+    if (&pConditionSet != m_pLastHitsConditionSet || m_vLastHits.size() != m_vConditions.Count())
     {
-        m_vConditions.RemoveNotifyTarget(m_pConditionsMonitor);
-        m_vConditions.BeginUpdate();
+        SynchronizeHits(pConditionSet);
+        return;
+    }
 
-        gsl::index nConditionIndex = 0;
-        rc_condition_t* pCondition = pGroup->m_pConditionSet->conditions;
-        for (; pCondition != nullptr; pCondition = pCondition->next)
+    // most frames, very few (if any) hit counts change. find them before touching the view models.
+    m_vChangedHits.clear();
+    const size_t nConditions = m_vLastHits.size();
+    size_t nIndex = 0;
+    const rc_condition_t* pCondition = pConditionSet.conditions;
+    for (; pCondition != nullptr && nIndex < nConditions; pCondition = pCondition->next, ++nIndex)
+    {
+        if (pCondition->current_hits != m_vLastHits.at(nIndex))
+        {
+            m_vLastHits.at(nIndex) = pCondition->current_hits;
+            m_vChangedHits.push_back(nIndex);
+        }
+    }
+
+    if (pCondition != nullptr || nIndex != nConditions)
+    {
+        // number of conditions changed
+        SynchronizeHits(pConditionSet);
+        return;
+    }
+
+    if (m_vChangedHits.empty())
+        return;
+
+    m_vConditions.RemoveNotifyTarget(m_pConditionsMonitor);
+    m_vConditions.BeginUpdate();
+
+    for (const auto nChangedIndex : m_vChangedHits)
+    {
+        auto* vmCondition = m_vConditions.GetItemAt(gsl::narrow_cast<gsl::index>(nChangedIndex));
+        if (vmCondition != nullptr)
+            vmCondition->SetCurrentHits(m_vLastHits.at(nChangedIndex));
+    }
+
+    if (m_bHasHitChain)
+    {
+        // only recalculate the totals for the hit chains that contain a changed condition
+        m_vChangedHitChains.clear();
+        for (const auto nChangedIndex : m_vChangedHits)
         {
-            auto* vmCondition = m_vConditions.GetItemAt(nConditionIndex++);
-            if (vmCondition == nullptr)
+            if (nChangedIndex < m_vConditionHitChain.size())
             {
-                // assume the trigger is being updated on another thread and we'll
-                // resynchronize the hit counts on the next frame
-                break;
+                const auto nHitChain = m_vConditionHitChain.at(nChangedIndex);
+                if (nHitChain != -1 && (m_vChangedHitChains.empty() || m_vChangedHitChains.back() != nHitChain))
+                    m_vChangedHitChains.push_back(nHitChain);
             }
+        }
 
-            vmCondition->SetCurrentHits(pCondition->current_hits);
+        // m_vChangedHits is sorted, so m_vChangedHitChains is too
+        for (const auto nHitChain : m_vChangedHitChains)
+        {
+            const auto& pHitChain = m_vHitChains.at(nHitChain);
+            UpdateTotalHits(pHitChain.first, pHitChain.second);
         }
+    }
 
-        if (m_bHasHitChain)
-            UpdateTotalHits();
+    m_vConditions.EndUpdate();
+    m_vConditions.AddNotifyTarget(m_pConditionsMonitor);
+}
+
+void TriggerViewModel::SynchronizeHits(const rc_condset_t& pConditionSet)
+{
+    m_vConditions.RemoveNotifyTarget(m_pConditionsMonitor);
+    m_vConditions.BeginUpdate();
+
+    m_vLastHits.clear();
+    m_pLastHitsConditionSet = &pConditionSet;
+
+    gsl::index nConditionIndex = 0;
+    const rc_condition_t* pCondition = pConditionSet.conditions;
+    for (; pCondition != nullptr; pCondition = pCondition->next)
+    {
+        auto* vmCondition = m_vConditions.GetItemAt(nConditionIndex++);
+        if (vmCondition == nullptr)
+        {
+            // assume the trigger is being updated on another thread and we'll
+            // resynchronize the hit counts on the next frame
+            m_pLastHitsConditionSet = nullptr;
+            break;
+        }
 
-        m_vConditions.EndUpdate();
-        m_vConditions.AddNotifyTarget(m_pConditionsMonitor);
+        vmCondition->SetCurrentHits(pCondition->current_hits);
+        m_vLastHits.push_back(pCondition->current_hits);
     }
+
+    IdentifyHitChains(m_vLastHits.size());
+    if (m_bHasHitChain)
+        UpdateTotalHits();
+
+    m_vConditions.EndUpdate();
+    m_vConditions.AddNotifyTarget(m_pConditionsMonitor);
 }
 
 bool TriggerViewModel::BuildHitChainTooltip(std::wstring& sTooltip,
@@ -164,7 +164,10 @@ private:
     void InitializeGroups(const rc_trigger_t& pTrigger);
     void UpdateGroups(const rc_trigger_t& pTrigger);
     void UpdateConditions(const GroupViewModel* pGroup);
+    void SynchronizeHits(const rc_condset_t& pConditionSet);
+    void IdentifyHitChains(size_t nConditions);
     void UpdateTotalHits();
+    void UpdateTotalHits(gsl::index nFirst, gsl::index nLast);
 
     int AppendMemRefChain(const std::string& sTrigger);
 
@@ -179,6 +182,18 @@ private:
     ViewModelCollection<TriggerConditionViewModel> m_vConditions;
     bool m_bHasHitChain = false;
 
+    // the current_hits of each condition in the selected group when it was last copied into m_vConditions.
+    // DoFrame only updates the conditions whose hits differ from this. if m_pLastHitsConditionSet doesn't
+    // match the selected group, all of the conditions are updated.
+    std::vector<unsigned> m_vLastHits;
+    const rc_condset_t* m_pLastHitsConditionSet = nullptr;
+    std::vector<size_t> m_vChangedHits;
+
+    // the first and last condition of each hit chain, and the hit chain each condition belongs to (-1 for none)
+    std::vector<std::pair<gsl::index, gsl::index>> m_vHitChains;
+    std::vector<int> m_vConditionHitChain;
+    std::vector<int> m_vChangedHitChains;
+
     class ConditionsMonitor : public ViewModelCollectionBase::NotifyTarget
     {
     public:
@@ -17,6 +17,17 @@ class ImageBinding : public ControlBinding, protected IImageRepository::NotifyTa
 public:
     explicit ImageBinding(ViewModelBase& vmViewModel) noexcept : ControlBinding(vmViewModel) {}
 
+    GSL_SUPPRESS_F6 ~ImageBinding() noexcept
+    {
+        if (ra::services::ServiceLocator::Exists<ra::ui::IImageRepository>())
+            ra::services::ServiceLocator::GetMutable<ra::ui::IImageRepository>().RemoveNotifyTarget(*this);
+    }
+
+    ImageBinding(const ImageBinding&) noexcept = delete;
+    ImageBinding& operator=(const ImageBinding&) noexcept = delete;
+    ImageBinding(ImageBinding&&) noexcept = delete;
+    ImageBinding& operator=(ImageBinding&&) noexcept = delete;
+
     void SetHWND(DialogBase& pDialog, HWND hControl) override
     {
         ControlBinding::SetHWND(pDialog, hControl);
@@ -66,16 +77,17 @@ private:
     {
         if (m_hWnd)
         {
+            // images are decoded in the background, so even if the file is available, the placeholder
+            // may be shown until it's ready. listen for the notification before asking for the image.
+            auto& pImageRepository = ra::services::ServiceLocator::GetMutable<ra::ui::IImageRepository>();
+            pImageRepository.AddNotifyTarget(*this);
+
             // load the image or placeholder
             UpdateImage();
 
-            // if it's the placeholder, request the actual image
-            auto& pImageRepository = ra::services::ServiceLocator::GetMutable<ra::ui::IImageRepository>();
+            // if the file isn't available, request it
             if (!pImageRepository.IsImageAvailable(m_pImageReference.Type(), m_pImageReference.Name()))
-            {
-                pImageRepository.AddNotifyTarget(*this);
                 pImageRepository.FetchImage(m_pImageReference.Type(), m_pImageReference.Name(), "");
-            }
         }
     }
 
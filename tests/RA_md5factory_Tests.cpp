@@ -0,0 +1,103 @@
+#include "RA_md5factory.h"
+
+#include "RA_UnitTestHelpers.h"
+
+#include "tests\mocks\MockFileSystem.hh"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using ra::services::mocks::MockFileSystem;
+
+namespace ra {
+namespace tests {
+
+TEST_CLASS(RA_md5factory_Tests)
+{
+public:
+    TEST_METHOD(TestGenerateMD5String)
+    {
+        Assert::AreEqual(std::string("d41d8cd98f00b204e9800998ecf8427e"), RAGenerateMD5(std::string()));
+        Assert::AreEqual(std::string("900150983cd24fb0d6963f7d28e17f72"), RAGenerateMD5(std::string("abc")));
+        Assert::AreEqual(std::string("9e107d9d372bb6826bd81d3542a419d6"),
+                         RAGenerateMD5(std::string("The quick brown fox jumps over the lazy dog")));
+    }
+
+    TEST_METHOD(TestGenerateMD5Buffer)
+    {
+        const std::array<BYTE, 3> pBuffer = { 'a', 'b', 'c' };
+        Assert::AreEqual(std::string("900150983cd24fb0d6963f7d28e17f72"), RAGenerateMD5(pBuffer.data(), pBuffer.size()));
+
+        const std::vector<BYTE> vBuffer = { 'a', 'b', 'c' };
+        Assert::AreEqual(std::string("900150983cd24fb0d6963f7d28e17f72"), RAGenerateMD5(vBuffer));
+    }
+
+    TEST_METHOD(TestHasherIncremental)
+    {
+        MD5Hasher pHasher;
+        pHasher.Append(std::string("The quick brown "));
+        pHasher.Append(std::string("fox jumps over "));
+        pHasher.Append(std::string("the lazy dog"));
+        Assert::AreEqual(std::string("9e107d9d372bb6826bd81d3542a419d6"), FormatMD5(pHasher.Finish()));
+    }
+
+    TEST_METHOD(TestHasherReuse)
+    {
+        MD5Hasher pHasher;
+        pHasher.Append(std::string("abc"));
+        const auto pDigest1 = pHasher.Finish();
+
+        // Finish should reset the hasher
+        pHasher.Append(std::string("abc"));
+        const auto pDigest2 = pHasher.Finish();
+        Assert::IsTrue(pDigest1 == pDigest2);
+        Assert::AreEqual(std::string("900150983cd24fb0d6963f7d28e17f72"), FormatMD5(pDigest2));
+
+        pHasher.Append(std::string("xyz"));
+        pHasher.Reset();
+        Assert::AreEqual(std::string("d41d8cd98f00b204e9800998ecf8427e"), FormatMD5(pHasher.Finish()));
+    }
+
+    TEST_METHOD(TestDigestBytes)
+    {
+        MD5Hasher pHasher;
+        pHasher.Append(std::string("abc"));
+        const auto pDigest = pHasher.Finish();
+        Assert::AreEqual({ 0x90 }, static_cast<int>(pDigest.at(0)));
+        Assert::AreEqual({ 0x01 }, static_cast<int>(pDigest.at(1)));
+        Assert::AreEqual({ 0x72 }, static_cast<int>(pDigest.at(15)));
+    }
+
+    TEST_METHOD(TestGenerateFileMD5)
+    {
+        MockFileSystem mockFileSystem;
+        mockFileSystem.MockFile(L"test.txt", "The quick brown fox jumps over the lazy dog");
+
+        Assert::AreEqual(std::string("9e107d9d372bb6826bd81d3542a419d6"), RAGenerateFileMD5(L"test.txt"));
+        Assert::AreEqual(std::string(), RAGenerateFileMD5(L"missing.txt"));
+    }
+
+    TEST_METHOD(TestGenerateFileMD5SpansMultipleChunks)
+    {
+        std::string sContents;
+        sContents.resize(MD5Hasher::FILE_CHUNK_SIZE * 2 + 17);
+        for (size_t i = 0; i < sContents.size(); ++i)
+            sContents.at(i) = gsl::narrow_cast<char>(i * 31);
+
+        MockFileSystem mockFileSystem;
+        mockFileSystem.MockFile(L"big.bin", sContents);
+
+        Assert::AreEqual(RAGenerateMD5(sContents), RAGenerateFileMD5(L"big.bin"));
+
+        // reusing a hasher (and its read buffer) should produce the same result
+        MD5Hasher pHasher;
+        Assert::IsTrue(pHasher.AppendFile(L"big.bin"));
+        const auto pDigest1 = pHasher.Finish();
+        Assert::IsTrue(pHasher.AppendFile(L"big.bin"));
+        const auto pDigest2 = pHasher.Finish();
+        Assert::IsTrue(pDigest1 == pDigest2);
+        Assert::AreEqual(RAGenerateMD5(sContents), FormatMD5(pDigest1));
+    }
+};
+
+} // namespace tests
+} // namespace ra
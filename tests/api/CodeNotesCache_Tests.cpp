@@ -0,0 +1,174 @@
+#include "CppUnitTest.h"
+
+#include "api\impl\CodeNotesCache.hh"
+
+#include "services\impl\StringTextReader.hh"
+#include "services\impl\StringTextWriter.hh"
+
+#include "tests\RA_UnitTestHelpers.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using ra::api::impl::CodeNotesCache;
+
+namespace ra {
+namespace api {
+namespace tests {
+
+TEST_CLASS(CodeNotesCache_Tests)
+{
+private:
+    struct Note
+    {
+        ra::ByteAddress nAddress;
+        std::string sAuthor;
+        std::string sNote;
+    };
+
+    static std::string WriteCache(const std::vector<Note>& vNotes)
+    {
+        uint32_t nHash = CodeNotesCache::EmptyHash;
+        for (const auto& pNote : vNotes)
+        {
+            nHash = CodeNotesCache::HashNote(nHash, pNote.nAddress, pNote.sAuthor.c_str(), pNote.sAuthor.length(),
+                                             pNote.sNote.c_str(), pNote.sNote.length());
+        }
+
+        std::string sOutput;
+        ra::services::impl::StringTextWriter pWriter(sOutput);
+        CodeNotesCache::WriteHeader(pWriter, vNotes.size(), nHash);
+        for (const auto& pNote : vNotes)
+        {
+            CodeNotesCache::WriteNote(pWriter, pNote.nAddress, pNote.sAuthor.c_str(), pNote.sAuthor.length(),
+                                      pNote.sNote.c_str(), pNote.sNote.length());
+        }
+
+        return sOutput;
+    }
+
+    static bool ReadCache(const std::string& sInput, FetchCodeNotes::Response& pResponse)
+    {
+        ra::services::impl::StringTextReader pReader(sInput);
+        return CodeNotesCache::Read(pReader, pResponse);
+    }
+
+public:
+    TEST_METHOD(TestRoundTrip)
+    {
+        const auto sCache = WriteCache({
+            { 0x1234, "Author1", "Note1" },
+            { 0x2345, "Author2", "Line1\nLine2" },
+            { 0x3456, "", "" },
+        });
+
+        FetchCodeNotes::Response response;
+        Assert::IsTrue(ReadCache(sCache, response));
+        Assert::AreEqual({ 3U }, response.Notes.size());
+
+        Assert::AreEqual({ 0x1234U }, response.Notes.at(0).Address);
+        Assert::AreEqual(std::string("Author1"), response.Notes.at(0).Author);
+        Assert::AreEqual(std::wstring(L"Note1"), response.Notes.at(0).Note);
+
+        Assert::AreEqual({ 0x2345U }, response.Notes.at(1).Address);
+        Assert::AreEqual(std::string("Author2"), response.Notes.at(1).Author);
+        Assert::AreEqual(std::wstring(L"Line1\r\nLine2"), response.Notes.at(1).Note);
+
+        Assert::AreEqual({ 0x3456U }, response.Notes.at(2).Address);
+        Assert::AreEqual(std::string(), response.Notes.at(2).Author);
+        Assert::AreEqual(std::wstring(), response.Notes.at(2).Note);
+    }
+
+    TEST_METHOD(TestRoundTripEmpty)
+    {
+        const auto sCache = WriteCache({});
+
+        FetchCodeNotes::Response response;
+        Assert::IsTrue(ReadCache(sCache, response));
+        Assert::AreEqual({ 0U }, response.Notes.size());
+        Assert::AreEqual(CodeNotesCache::EmptyHash, response.Hash);
+    }
+
+    TEST_METHOD(TestRoundTripUnicode)
+    {
+        const auto sCache = WriteCache({ { 0x1234, "Author", "\xE2\x86\x92 [8-bit]" } });
+
+        FetchCodeNotes::Response response;
+        Assert::IsTrue(ReadCache(sCache, response));
+        Assert::AreEqual({ 1U }, response.Notes.size());
+        Assert::AreEqual(std::wstring(L"\x2192 [8-bit]"), response.Notes.at(0).Note);
+    }
+
+    TEST_METHOD(TestHash)
+    {
+        const auto nHash1 = CodeNotesCache::HashNote(CodeNotesCache::EmptyHash, 0x1234, "Author", 6, "Note", 4);
+        const auto nHash2 = CodeNotesCache::HashNote(CodeNotesCache::EmptyHash, 0x1234, "Author", 6, "Note", 4);
+        Assert::AreEqual(nHash1, nHash2);
+
+        // address, author, and note all contribute
+        Assert::AreNotEqual(nHash1, CodeNotesCache::HashNote(CodeNotesCache::EmptyHash, 0x1235, "Author", 6, "Note", 4));
+        Assert::AreNotEqual(nHash1, CodeNotesCache::HashNote(CodeNotesCache::EmptyHash, 0x1234, "Author2", 7, "Note", 4));
+        Assert::AreNotEqual(nHash1, CodeNotesCache::HashNote(CodeNotesCache::EmptyHash, 0x1234, "Author", 6, "Note2", 5));
+
+        // moving text from the author to the note changes the hash
+        Assert::AreNotEqual(nHash1, CodeNotesCache::HashNote(CodeNotesCache::EmptyHash, 0x1234, "Autho", 5, "rNote", 5));
+
+        const auto sCache = WriteCache({ { 0x1234, "Author", "Note" } });
+        FetchCodeNotes::Response response;
+        Assert::IsTrue(ReadCache(sCache, response));
+        Assert::AreEqual(nHash1, response.Hash);
+    }
+
+    TEST_METHOD(TestReadNotCache)
+    {
+        // legacy JSON cache
+        FetchCodeNotes::Response response;
+        Assert::IsFalse(ReadCache("[{\"User\":\"Author\",\"Address\":\"0x001234\",\"Note\":\"Note\"}]", response));
+        Assert::AreEqual({ 0U }, response.Notes.size());
+
+        Assert::IsFalse(ReadCache("", response));
+    }
+
+    TEST_METHOD(TestReadWrongVersion)
+    {
+        auto sCache = WriteCache({ { 0x1234, "Author", "Note" } });
+        sCache.at(4) = gsl::narrow_cast<char>(CodeNotesCache::FormatVersion + 1);
+
+        FetchCodeNotes::Response response;
+        Assert::IsFalse(ReadCache(sCache, response));
+        Assert::AreEqual({ 0U }, response.Notes.size());
+    }
+
+    TEST_METHOD(TestReadTruncated)
+    {
+        const auto sCache = WriteCache({ { 0x1234, "Author", "Note1" }, { 0x2345, "Author", "Note2" } });
+
+        FetchCodeNotes::Response response;
+        for (size_t nLength = 0; nLength < sCache.length(); ++nLength)
+            Assert::IsFalse(ReadCache(sCache.substr(0, nLength), response));
+
+        Assert::AreEqual({ 0U }, response.Notes.size());
+    }
+
+    TEST_METHOD(TestReadCorrupted)
+    {
+        auto sCache = WriteCache({ { 0x1234, "Author", "Note1" }, { 0x2345, "Author", "Note2" } });
+        sCache.back() = '3';
+
+        FetchCodeNotes::Response response;
+        Assert::IsFalse(ReadCache(sCache, response));
+        Assert::AreEqual({ 0U }, response.Notes.size());
+    }
+
+    TEST_METHOD(TestReadExtraData)
+    {
+        auto sCache = WriteCache({ { 0x1234, "Author", "Note1" } });
+        sCache.push_back('\0');
+
+        FetchCodeNotes::Response response;
+        Assert::IsFalse(ReadCache(sCache, response));
+    }
+};
+
+} // namespace tests
+} // namespace api
+} // namespace ra
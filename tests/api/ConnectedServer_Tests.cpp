@@ -2,8 +2,11 @@
 
 #include "api\impl\ConnectedServer.hh"
 
+#include "api\impl\CodeNotesCache.hh"
 #include "api\impl\DisconnectedServer.hh"
 
+#include "services\impl\StringTextReader.hh"
+
 #include "tests\RA_UnitTestHelpers.h"
 #include "tests\api\ApiAsserts.hh"
 #include "tests\mocks\MockHttpRequester.hh"
@@ -14,6 +17,7 @@
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
+using ra::api::impl::CodeNotesCache;
 using ra::api::impl::ConnectedServer;
 using ra::api::mocks::MockServer;
 using ra::data::context::mocks::MockUserContext;
@@ -253,9 +257,48 @@ public:
         Assert::AreEqual({0x00f304}, response.Notes.at(0).Address);
         Assert::AreEqual(std::wstring(L"Line1\r\nLine2\r\nLine3\r\n"), response.Notes.at(0).Note);
 
-        // cached file is not normalized (or unescaped)
-        std::string sPatchData = "[{\"User\":\"Username\",\"Address\":\"0x00f304\",\"Note\":\"Line1\\nLine2\\r\\nLine3\\n\"}]";
-        Assert::AreEqual(sPatchData, mockLocalStorage.GetStoredData(ra::services::StorageItemType::CodeNotes, L"99"));
+        // cached file is not normalized, but is normalized when read back
+        const auto& sCache = mockLocalStorage.GetStoredData(ra::services::StorageItemType::CodeNotes, L"99");
+        Assert::IsTrue(sCache.find("Line1\nLine2\r\nLine3\n") != std::string::npos);
+
+        ra::services::impl::StringTextReader pReader(sCache);
+        FetchCodeNotes::Response cached;
+        Assert::IsTrue(CodeNotesCache::Read(pReader, cached));
+        Assert::AreEqual(response.Hash, cached.Hash);
+        Assert::AreEqual({1U}, cached.Notes.size());
+        Assert::AreEqual(std::string("Username"), cached.Notes.at(0).Author);
+        Assert::AreEqual({0x00f304}, cached.Notes.at(0).Address);
+        Assert::AreEqual(std::wstring(L"Line1\r\nLine2\r\nLine3\r\n"), cached.Notes.at(0).Note);
+    }
+
+    TEST_METHOD(TestFetchCodeNotesHashChangesWithContent)
+    {
+        MockUserContext mockUserContext;
+        mockUserContext.Initialize("Username", "ApiToken");
+
+        std::string sNote = "Note";
+        MockHttpRequester mockHttp([&sNote](const Http::Request&)
+        {
+            return Http::Response(Http::StatusCode::OK,
+                "{\"Success\":true,\"CodeNotes\":["
+                    "{\"User\":\"Username\",\"Address\":\"0x00f304\",\"Note\":\"" + sNote + "\"}"
+                "]}");
+        });
+
+        MockLocalStorage mockLocalStorage;
+
+        ra::services::ServiceLocator::ServiceOverride<ra::api::IServer> serviceOverride(new ConnectedServer("host.com"), true);
+        auto& server = ra::services::ServiceLocator::GetMutable<ra::api::IServer>();
+
+        FetchCodeNotes::Request request;
+        request.GameId = 99;
+        const auto response1 = server.FetchCodeNotes(request);
+        const auto response2 = server.FetchCodeNotes(request);
+        Assert::AreEqual(response1.Hash, response2.Hash);
+
+        sNote = "Note2";
+        const auto response3 = server.FetchCodeNotes(request);
+        Assert::AreNotEqual(response1.Hash, response3.Hash);
     }
 };
 
@@ -2,6 +2,8 @@
 
 #include "ra_fwd.h"
 
+#include "RA_StringUtils.h"
+
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
 namespace ra {
@@ -1189,6 +1191,177 @@ public:
         Assert::AreEqual(std::wstring(L"Test3a"), pModel.GetString());
         Assert::AreEqual(std::wstring(L"Test3b"), pModel.GetTransactionalString());
     }
+
+    class OrderedNotifyTargetHarness : public DataModelBase::NotifyTarget
+    {
+    public:
+        void OnDataModelBoolValueChanged(const BoolModelProperty::ChangeArgs& args) override
+        {
+            m_vChanges.push_back(args.Property.GetPropertyName());
+            if (m_fHandler)
+                m_fHandler(args.Property);
+        }
+
+        void OnDataModelStringValueChanged(const StringModelProperty::ChangeArgs& args) override
+        {
+            m_vChanges.push_back(args.Property.GetPropertyName());
+            if (m_fHandler)
+                m_fHandler(args.Property);
+        }
+
+        void OnDataModelIntValueChanged(const IntModelProperty::ChangeArgs& args) override
+        {
+            m_vChanges.push_back(args.Property.GetPropertyName());
+            if (m_fHandler)
+                m_fHandler(args.Property);
+        }
+
+        std::string GetChanges() const
+        {
+            std::string sChanges;
+            for (const auto& sChange : m_vChanges)
+            {
+                if (!sChanges.empty())
+                    sChanges.push_back(',');
+                sChanges.append(sChange);
+            }
+            return sChanges;
+        }
+
+        void Reset() noexcept { m_vChanges.clear(); }
+
+        std::function<void(const ModelPropertyBase&)> m_fHandler;
+
+    private:
+        std::vector<std::string> m_vChanges;
+    };
+
+    TEST_METHOD(TestBeginUpdateEventOrder)
+    {
+        DataModelHarness pModel;
+        OrderedNotifyTargetHarness oNotify;
+        pModel.AddNotifyTarget(oNotify);
+
+        pModel.BeginUpdate();
+        pModel.SetTransactionalString(L"A");
+        pModel.SetTransactionalInt(1);
+        pModel.SetBool(true);
+        pModel.SetString(L"B");
+        pModel.SetInt(2);
+        pModel.SetTransactionalBool(true);
+        pModel.SetTransactionalInt(3);
+        pModel.SetString(L"C");
+        Assert::AreEqual(std::string(), oNotify.GetChanges());
+        pModel.EndUpdate();
+
+        // ints, then bools, then strings - each in the order they were first changed
+        Assert::AreEqual(std::string("TransactionalInt,Int,Bool,TransactionalBool,TransactionalString,String"), oNotify.GetChanges());
+        oNotify.Reset();
+
+        // second update reuses the UpdateTransaction, and should not remember anything from the first
+        pModel.BeginUpdate();
+        pModel.SetInt(4);
+        pModel.SetTransactionalInt(3);
+        pModel.SetString(L"D");
+        pModel.SetString(L"C");
+        pModel.EndUpdate();
+
+        Assert::AreEqual(std::string("Int"), oNotify.GetChanges());
+        Assert::AreEqual(4, pModel.GetInt());
+        Assert::AreEqual(3, pModel.GetTransactionalInt());
+        Assert::AreEqual(std::wstring(L"C"), pModel.GetString());
+    }
+
+    TEST_METHOD(TestBeginUpdateFromEndUpdateHandler)
+    {
+        DataModelHarness pModel;
+        OrderedNotifyTargetHarness oNotify;
+        pModel.AddNotifyTarget(oNotify);
+
+        oNotify.m_fHandler = [&pModel](const ModelPropertyBase& pProperty)
+        {
+            if (pProperty == DataModelHarness::IntProperty)
+            {
+                Assert::IsFalse(pModel.IsUpdating());
+
+                pModel.BeginUpdate();
+                pModel.SetBool(true);
+                pModel.SetString(L"Nested");
+                pModel.EndUpdate();
+            }
+        };
+
+        pModel.BeginUpdate();
+        pModel.SetInt(1);
+        pModel.SetTransactionalInt(2);
+        pModel.EndUpdate();
+
+        Assert::AreEqual(std::string("Int,Bool,String,TransactionalInt"), oNotify.GetChanges());
+        Assert::IsFalse(pModel.IsUpdating());
+        oNotify.Reset();
+        oNotify.m_fHandler = nullptr;
+
+        pModel.BeginUpdate();
+        Assert::IsTrue(pModel.IsUpdating());
+        pModel.SetBool(false);
+        pModel.EndUpdate();
+        Assert::IsFalse(pModel.IsUpdating());
+
+        Assert::AreEqual(std::string("Bool"), oNotify.GetChanges());
+
+        // extra EndUpdate should be ignored
+        pModel.EndUpdate();
+        Assert::IsFalse(pModel.IsUpdating());
+        pModel.SetInt(5);
+        Assert::AreEqual(std::string("Bool,Int"), oNotify.GetChanges());
+    }
+
+    class ManyPropertiesHarness : public DataModelBase
+    {
+    public:
+        using DataModelBase::GetValue;
+        using DataModelBase::SetValue;
+        using DataModelBase::BeginUpdate;
+        using DataModelBase::EndUpdate;
+    };
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(TestBeginUpdatePerformance)
+        TEST_IGNORE()
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(TestBeginUpdatePerformance)
+    {
+        std::vector<std::unique_ptr<IntModelProperty>> vProperties;
+        for (int i = 0; i < 64; ++i)
+            vProperties.push_back(std::make_unique<IntModelProperty>("ManyPropertiesHarness", "Int", 0));
+
+        for (const int nProperties : { 1, 8, 64 })
+        {
+            ManyPropertiesHarness pModel;
+            NotifyTargetHarness oNotify;
+            pModel.AddNotifyTarget(oNotify);
+
+            // keep the total number of changes constant so the test runs in a reasonable time
+            const int nCycles = 1000000 / nProperties;
+
+            const auto tStart = std::chrono::steady_clock::now();
+            for (int nCycle = 1; nCycle <= nCycles; ++nCycle)
+            {
+                pModel.BeginUpdate();
+                for (int i = 0; i < nProperties; ++i)
+                    pModel.SetValue(*vProperties.at(i), nCycle);
+                pModel.EndUpdate();
+
+                oNotify.Reset();
+            }
+            const auto tElapsed = std::chrono::steady_clock::now() - tStart;
+
+            for (int i = 0; i < nProperties; ++i)
+                Assert::AreEqual(nCycles, pModel.GetValue(*vProperties.at(i)));
+
+            const auto nMilliseconds = gsl::narrow_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(tElapsed).count());
+            Logger::WriteMessage(ra::StringPrintf("%d update cycles of %d properties in %dms\n", nCycles, nProperties, nMilliseconds).c_str());
+        }
+    }
 };
 
 const StringModelProperty DataModelBase_Tests::DataModelHarness::StringProperty("DataModelHarness", "String", L"");
@@ -0,0 +1,537 @@
+#include "CppUnitTest.h"
+
+#include "data\NotifyTargetSet.hh"
+
+#include "tests\RA_UnitTestHelpers.h"
+
+#include <future>
+#include <thread>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace ra {
+namespace data {
+namespace tests {
+
+TEST_CLASS(NotifyTargetSet_Tests)
+{
+private:
+    class Target
+    {
+    public:
+        explicit Target(int nId) noexcept : m_nId(nId) {}
+
+        int GetId() const noexcept { return m_nId; }
+
+        int nNotifications = 0;
+        std::function<void(Target&)> fOnNotify;
+
+        void Notify()
+        {
+            ++nNotifications;
+            if (fOnNotify)
+                fOnNotify(*this);
+        }
+
+    private:
+        int m_nId;
+    };
+
+    static size_t s_nAllocations;
+
+    template<class T>
+    class CountingAllocator
+    {
+    public:
+        using value_type = T;
+
+        CountingAllocator() noexcept = default;
+        template<class U>
+        CountingAllocator(const CountingAllocator<U>&) noexcept {}
+
+        T* allocate(size_t n)
+        {
+            ++s_nAllocations;
+            return std::allocator<T>().allocate(n);
+        }
+
+        void deallocate(T* p, size_t n) noexcept { std::allocator<T>().deallocate(p, n); }
+
+        template<class U>
+        bool operator==(const CountingAllocator<U>&) const noexcept { return true; }
+        template<class U>
+        bool operator!=(const CountingAllocator<U>&) const noexcept { return false; }
+    };
+
+    using TargetSet = NotifyTargetSet<Target, 4, CountingAllocator<Target*>>;
+
+    static std::vector<int> Dispatch(TargetSet& vTargets)
+    {
+        std::vector<int> vNotified;
+        vTargets.Dispatch([&vNotified](Target& pTarget) {
+            vNotified.push_back(pTarget.GetId());
+            pTarget.Notify();
+        });
+        return vNotified;
+    }
+
+    static void AssertNotified(const std::vector<int>& vExpected, const std::vector<int>& vNotified)
+    {
+        Assert::AreEqual(vExpected.size(), vNotified.size());
+        for (size_t i = 0; i < vExpected.size(); ++i)
+            Assert::AreEqual(vExpected.at(i), vNotified.at(i));
+    }
+
+public:
+    TEST_METHOD(TestEmpty)
+    {
+        TargetSet vTargets;
+        Assert::IsTrue(vTargets.IsEmpty());
+        Assert::AreEqual({ 0U }, vTargets.Count());
+        AssertNotified({}, Dispatch(vTargets));
+    }
+
+    TEST_METHOD(TestAddRemove)
+    {
+        Target pTarget1(1), pTarget2(2), pTarget3(3);
+        TargetSet vTargets;
+        vTargets.Add(pTarget1);
+        vTargets.Add(pTarget2);
+        vTargets.Add(pTarget3);
+        Assert::IsFalse(vTargets.IsEmpty());
+        Assert::AreEqual({ 3U }, vTargets.Count());
+        AssertNotified({ 1, 2, 3 }, Dispatch(vTargets));
+
+        vTargets.Remove(pTarget2);
+        Assert::AreEqual({ 2U }, vTargets.Count());
+        AssertNotified({ 1, 3 }, Dispatch(vTargets));
+
+        // not in collection
+        vTargets.Remove(pTarget2);
+        Assert::AreEqual({ 2U }, vTargets.Count());
+
+        vTargets.Remove(pTarget1);
+        vTargets.Remove(pTarget3);
+        Assert::IsTrue(vTargets.IsEmpty());
+        AssertNotified({}, Dispatch(vTargets));
+    }
+
+    TEST_METHOD(TestAddDuplicate)
+    {
+        Target pTarget1(1);
+        TargetSet vTargets;
+        vTargets.Add(pTarget1);
+        vTargets.Add(pTarget1);
+        Assert::AreEqual({ 1U }, vTargets.Count());
+        AssertNotified({ 1 }, Dispatch(vTargets));
+    }
+
+    TEST_METHOD(TestClear)
+    {
+        Target pTarget1(1), pTarget2(2);
+        TargetSet vTargets;
+        vTargets.Add(pTarget1);
+        vTargets.Add(pTarget2);
+
+        vTargets.Clear();
+        Assert::IsTrue(vTargets.IsEmpty());
+        AssertNotified({}, Dispatch(vTargets));
+
+        vTargets.Add(pTarget2);
+        AssertNotified({ 2 }, Dispatch(vTargets));
+    }
+
+    TEST_METHOD(TestInlineStorage)
+    {
+        std::vector<std::unique_ptr<Target>> vTargetObjects;
+        for (int i = 1; i <= 6; ++i)
+            vTargetObjects.push_back(std::make_unique<Target>(i));
+
+        s_nAllocations = 0;
+        TargetSet vTargets;
+        for (int i = 0; i < 4; ++i)
+            vTargets.Add(*vTargetObjects.at(i));
+        Assert::AreEqual({ 0U }, s_nAllocations);
+
+        // fifth target moves the collection to the heap
+        vTargets.Add(*vTargetObjects.at(4));
+        Assert::AreEqual({ 1U }, s_nAllocations);
+        vTargets.Add(*vTargetObjects.at(5));
+        AssertNotified({ 1, 2, 3, 4, 5, 6 }, Dispatch(vTargets));
+
+        vTargets.Remove(*vTargetObjects.at(0));
+        AssertNotified({ 2, 3, 4, 5, 6 }, Dispatch(vTargets));
+        Assert::AreEqual({ 1U }, s_nAllocations);
+    }
+
+    TEST_METHOD(TestRemoveSelfDuringDispatch)
+    {
+        Target pTarget1(1), pTarget2(2), pTarget3(3);
+        TargetSet vTargets;
+        vTargets.Add(pTarget1);
+        vTargets.Add(pTarget2);
+        vTargets.Add(pTarget3);
+
+        pTarget2.fOnNotify = [&vTargets](Target& pTarget) { vTargets.Remove(pTarget); };
+        AssertNotified({ 1, 2, 3 }, Dispatch(vTargets));
+        Assert::AreEqual({ 2U }, vTargets.Count());
+        AssertNotified({ 1, 3 }, Dispatch(vTargets));
+    }
+
+    TEST_METHOD(TestRemoveOtherDuringDispatch)
+    {
+        Target pTarget1(1), pTarget2(2), pTarget3(3);
+        TargetSet vTargets;
+        vTargets.Add(pTarget1);
+        vTargets.Add(pTarget2);
+        vTargets.Add(pTarget3);
+
+        // removed target should not be notified
+        pTarget1.fOnNotify = [&vTargets, &pTarget2](Target&) { vTargets.Remove(pTarget2); };
+        AssertNotified({ 1, 3 }, Dispatch(vTargets));
+        Assert::AreEqual({ 2U }, vTargets.Count());
+        Assert::AreEqual(0, pTarget2.nNotifications);
+    }
+
+    TEST_METHOD(TestAddDuringDispatch)
+    {
+        Target pTarget1(1), pTarget2(2), pTarget3(3);
+        TargetSet vTargets;
+        vTargets.Add(pTarget1);
+        vTargets.Add(pTarget2);
+
+        // added target should not be notified until the next dispatch
+        pTarget1.fOnNotify = [&vTargets, &pTarget3](Target&) { vTargets.Add(pTarget3); };
+        AssertNotified({ 1, 2 }, Dispatch(vTargets));
+        Assert::AreEqual({ 3U }, vTargets.Count());
+        AssertNotified({ 1, 2, 3 }, Dispatch(vTargets));
+    }
+
+    TEST_METHOD(TestAddDuringDispatchMovesToHeap)
+    {
+        std::vector<std::unique_ptr<Target>> vTargetObjects;
+        for (int i = 1; i <= 8; ++i)
+            vTargetObjects.push_back(std::make_unique<Target>(i));
+
+        TargetSet vTargets;
+        for (int i = 0; i < 4; ++i)
+            vTargets.Add(*vTargetObjects.at(i));
+
+        vTargetObjects.at(1)->fOnNotify = [&vTargets, &vTargetObjects](Target&) {
+            for (int i = 4; i < 8; ++i)
+                vTargets.Add(*vTargetObjects.at(i));
+        };
+        AssertNotified({ 1, 2, 3, 4 }, Dispatch(vTargets));
+        AssertNotified({ 1, 2, 3, 4, 5, 6, 7, 8 }, Dispatch(vTargets));
+    }
+
+    TEST_METHOD(TestRemoveAndAddDuringDispatch)
+    {
+        Target pTarget1(1), pTarget2(2);
+        TargetSet vTargets;
+        vTargets.Add(pTarget1);
+        vTargets.Add(pTarget2);
+
+        // target is moved to the end of the list, and not notified a second time
+        pTarget1.fOnNotify = [&vTargets](Target& pTarget) {
+            vTargets.Remove(pTarget);
+            vTargets.Add(pTarget);
+        };
+        AssertNotified({ 1, 2 }, Dispatch(vTargets));
+        Assert::AreEqual({ 2U }, vTargets.Count());
+        pTarget1.fOnNotify = nullptr;
+        AssertNotified({ 2, 1 }, Dispatch(vTargets));
+    }
+
+    TEST_METHOD(TestClearDuringDispatch)
+    {
+        Target pTarget1(1), pTarget2(2), pTarget3(3);
+        TargetSet vTargets;
+        vTargets.Add(pTarget1);
+        vTargets.Add(pTarget2);
+        vTargets.Add(pTarget3);
+
+        pTarget1.fOnNotify = [&vTargets](Target&) { vTargets.Clear(); };
+        AssertNotified({ 1 }, Dispatch(vTargets));
+        Assert::IsTrue(vTargets.IsEmpty());
+        AssertNotified({}, Dispatch(vTargets));
+    }
+
+    TEST_METHOD(TestNestedDispatch)
+    {
+        Target pTarget1(1), pTarget2(2), pTarget3(3);
+        TargetSet vTargets;
+        vTargets.Add(pTarget1);
+        vTargets.Add(pTarget2);
+        vTargets.Add(pTarget3);
+
+        std::vector<int> vInnerNotified;
+        pTarget2.fOnNotify = [&vTargets, &vInnerNotified](Target& pTarget) {
+            pTarget.fOnNotify = nullptr;
+            vTargets.Remove(pTarget);
+            vInnerNotified = Dispatch(vTargets);
+        };
+
+        AssertNotified({ 1, 2, 3 }, Dispatch(vTargets));
+        AssertNotified({ 1, 3 }, vInnerNotified);
+        Assert::AreEqual(2, pTarget1.nNotifications);
+        Assert::AreEqual(1, pTarget2.nNotifications);
+        Assert::AreEqual(2, pTarget3.nNotifications);
+        AssertNotified({ 1, 3 }, Dispatch(vTargets));
+    }
+
+    TEST_METHOD(TestDestroyDuringDispatch)
+    {
+        Target pTarget1(1), pTarget2(2), pTarget3(3);
+        auto pTargets = std::make_unique<TargetSet>();
+        pTargets->Add(pTarget1);
+        pTargets->Add(pTarget2);
+        pTargets->Add(pTarget3);
+
+        pTarget2.fOnNotify = [&pTargets](Target&) { pTargets.reset(); };
+
+        // can't use the Dispatch helper, it would access the destroyed collection
+        std::vector<int> vNotified;
+        auto* pTargetsRaw = pTargets.get();
+        pTargetsRaw->Dispatch([&vNotified](Target& pTarget) {
+            vNotified.push_back(pTarget.GetId());
+            pTarget.Notify();
+        });
+
+        AssertNotified({ 1, 2 }, vNotified);
+        Assert::IsTrue(pTargets == nullptr);
+    }
+
+    TEST_METHOD(TestDispatchException)
+    {
+        Target pTarget1(1), pTarget2(2), pTarget3(3);
+        TargetSet vTargets;
+        vTargets.Add(pTarget1);
+        vTargets.Add(pTarget2);
+        vTargets.Add(pTarget3);
+
+        pTarget1.fOnNotify = [&vTargets](Target& pTarget) {
+            vTargets.Remove(pTarget);
+            throw std::runtime_error("oops");
+        };
+
+        Assert::ExpectException<std::runtime_error>([&vTargets]() { Dispatch(vTargets); });
+
+        // collection should be usable after the exception
+        Assert::AreEqual({ 2U }, vTargets.Count());
+        AssertNotified({ 2, 3 }, Dispatch(vTargets));
+    }
+
+    TEST_METHOD(TestMove)
+    {
+        Target pTarget1(1), pTarget2(2);
+        TargetSet vTargets;
+        vTargets.Add(pTarget1);
+        vTargets.Add(pTarget2);
+
+        TargetSet vTargets2(std::move(vTargets));
+        Assert::AreEqual({ 2U }, vTargets2.Count());
+        AssertNotified({ 1, 2 }, Dispatch(vTargets2));
+
+        vTargets.Add(pTarget2);
+        vTargets = std::move(vTargets2);
+        AssertNotified({ 1, 2 }, Dispatch(vTargets));
+    }
+
+    TEST_METHOD(TestDispatchOnMultipleThreads)
+    {
+        Target pTarget1(1), pTarget2(2), pTarget3(3);
+        TargetSet vTargets;
+        vTargets.Add(pTarget1);
+        vTargets.Add(pTarget2);
+        vTargets.Add(pTarget3);
+
+        // the first dispatch starts before the second and finishes while the second is still running
+        std::promise<void> pFirstStarted, pSecondStarted, pFirstFinished;
+        std::thread pFirst([&]() {
+            bool bWaited = false;
+            vTargets.Dispatch([&](Target&) {
+                if (!bWaited)
+                {
+                    bWaited = true;
+                    pFirstStarted.set_value();
+                    pSecondStarted.get_future().wait();
+                }
+            });
+            pFirstFinished.set_value();
+        });
+
+        std::thread pSecond([&]() {
+            pFirstStarted.get_future().wait();
+            bool bWaited = false;
+            vTargets.Dispatch([&](Target&) {
+                if (!bWaited)
+                {
+                    bWaited = true;
+                    pSecondStarted.set_value();
+                    pFirstFinished.get_future().wait();
+                }
+            });
+        });
+
+        pFirst.join();
+        pSecond.join();
+
+        // no dispatch is active, so the collection is compacted immediately
+        vTargets.Remove(pTarget2);
+        Assert::AreEqual({ 2U }, vTargets.Count());
+        AssertNotified({ 1, 3 }, Dispatch(vTargets));
+
+        vTargets.Add(pTarget2);
+        AssertNotified({ 1, 3, 2 }, Dispatch(vTargets));
+    }
+
+    TEST_METHOD(TestReentrancyStress)
+    {
+        constexpr int nTargets = 32;
+        std::vector<std::unique_ptr<Target>> vTargetObjects;
+        for (int i = 0; i < nTargets; ++i)
+            vTargetObjects.push_back(std::make_unique<Target>(i));
+
+        TargetSet vTargets;
+        std::set<int> vExpected;
+        for (int i = 0; i < nTargets; i += 2)
+        {
+            vTargets.Add(*vTargetObjects.at(i));
+            vExpected.insert(i);
+        }
+
+        // deterministic pseudo-random sequence of adds, removes, and nested dispatches from inside handlers
+        uint32_t nSeed = 12345;
+        const auto fRandom = [&nSeed](int nMax) {
+            nSeed = nSeed * 1103515245 + 12345;
+            return gsl::narrow_cast<int>((nSeed >> 16) % gsl::narrow_cast<uint32_t>(nMax));
+        };
+
+        int nDepth = 0;
+        std::function<void(Target&)> fOnNotify = [&](Target&) {
+            const auto nOther = fRandom(nTargets);
+            switch (fRandom(4))
+            {
+                case 0:
+                    vTargets.Add(*vTargetObjects.at(nOther));
+                    vExpected.insert(nOther);
+                    break;
+
+                case 1:
+                    vTargets.Remove(*vTargetObjects.at(nOther));
+                    vExpected.erase(nOther);
+                    break;
+
+                case 2:
+                    if (nDepth < 3)
+                    {
+                        ++nDepth;
+                        const auto vNotified = Dispatch(vTargets);
+                        --nDepth;
+
+                        // a target may only be notified once per dispatch
+                        std::set<int> vUnique(vNotified.begin(), vNotified.end());
+                        Assert::AreEqual(vNotified.size(), vUnique.size());
+                    }
+                    break;
+
+                default:
+                    break;
+            }
+        };
+        for (auto& pTarget : vTargetObjects)
+            pTarget->fOnNotify = fOnNotify;
+
+        for (int i = 0; i < 200; ++i)
+        {
+            const std::set<int> vBefore = vExpected;
+            const auto vNotified = Dispatch(vTargets);
+
+            // only targets registered before the dispatch can be notified
+            std::set<int> vUnique;
+            for (const auto nId : vNotified)
+            {
+                Assert::IsTrue(vBefore.find(nId) != vBefore.end());
+                Assert::IsTrue(vUnique.insert(nId).second);
+            }
+
+            Assert::AreEqual(vExpected.size(), vTargets.Count());
+        }
+
+        // the collection should exactly match the expected set
+        for (auto& pTarget : vTargetObjects)
+            pTarget->fOnNotify = nullptr;
+        const auto vNotified = Dispatch(vTargets);
+        Assert::AreEqual(vExpected.size(), vNotified.size());
+        for (const auto nId : vNotified)
+            Assert::IsTrue(vExpected.find(nId) != vExpected.end());
+    }
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(TestDispatchPerformance)
+        TEST_IGNORE()
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(TestDispatchPerformance)
+    {
+        constexpr int nIterations = 100000;
+        using CopiedTargetSet = std::set<Target*, std::less<Target*>, CountingAllocator<Target*>>;
+
+        std::vector<std::unique_ptr<Target>> vTargetObjects;
+        for (int i = 0; i < 32; ++i)
+            vTargetObjects.push_back(std::make_unique<Target>(i));
+
+        for (const int nTargets : { 0, 1, 4, 32 })
+        {
+            TargetSet vTargets;
+            CopiedTargetSet vCopiedTargets;
+            for (int i = 0; i < nTargets; ++i)
+            {
+                vTargets.Add(*vTargetObjects.at(i));
+                vCopiedTargets.insert(vTargetObjects.at(i).get());
+            }
+
+            for (auto& pTarget : vTargetObjects)
+                pTarget->nNotifications = 0;
+
+            s_nAllocations = 0;
+            auto tStart = std::chrono::steady_clock::now();
+            for (int i = 0; i < nIterations; ++i)
+                vTargets.Dispatch([](Target& pTarget) { ++pTarget.nNotifications; });
+            const auto tDispatch = std::chrono::steady_clock::now() - tStart;
+            const auto nDispatchAllocations = s_nAllocations;
+
+            // previous implementation: copy the set before notifying so it can be modified by the callbacks
+            s_nAllocations = 0;
+            tStart = std::chrono::steady_clock::now();
+            for (int i = 0; i < nIterations; ++i)
+            {
+                CopiedTargetSet vCopy(vCopiedTargets);
+                for (auto* pTarget : vCopy)
+                    ++pTarget->nNotifications;
+            }
+            const auto tCopy = std::chrono::steady_clock::now() - tStart;
+            const auto nCopyAllocations = s_nAllocations;
+
+            for (int i = 0; i < nTargets; ++i)
+                Assert::AreEqual(nIterations * 2, vTargetObjects.at(i)->nNotifications);
+
+            // dispatching should never allocate
+            Assert::AreEqual({ 0U }, nDispatchAllocations);
+            Assert::AreEqual(gsl::narrow_cast<size_t>(nIterations) * nTargets, nCopyAllocations);
+
+            // with no targets, report the cost of the dispatch itself
+            const auto nNotifications = gsl::narrow_cast<long long>(nIterations) * std::max(nTargets, 1);
+            const auto nDispatchNs = std::chrono::duration_cast<std::chrono::nanoseconds>(tDispatch).count();
+            const auto nCopyNs = std::chrono::duration_cast<std::chrono::nanoseconds>(tCopy).count();
+            Logger::WriteMessage(ra::StringPrintf("%d targets: dispatch %dns/notification (%zu allocations), copy %dns/notification (%zu allocations)\n",
+                nTargets, gsl::narrow_cast<int>(nDispatchNs / nNotifications), nDispatchAllocations,
+                gsl::narrow_cast<int>(nCopyNs / nNotifications), nCopyAllocations).c_str());
+        }
+    }
+};
+
+size_t NotifyTargetSet_Tests::s_nAllocations = 0;
+
+} // namespace tests
+} // namespace data
+} // namespace ra
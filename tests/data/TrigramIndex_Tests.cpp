@@ -0,0 +1,145 @@
+#include "CppUnitTest.h"
+
+#include "data\TrigramIndex.hh"
+
+#include "tests\RA_UnitTestHelpers.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace ra {
+namespace data {
+namespace tests {
+
+TEST_CLASS(TrigramIndex_Tests)
+{
+private:
+    static void AssertCandidates(const TrigramIndex& pIndex, const std::wstring& sQuery,
+                                 const std::vector<ra::ByteAddress>& vExpected)
+    {
+        std::vector<ra::ByteAddress> vCandidates;
+        Assert::IsTrue(pIndex.FindCandidates(sQuery, vCandidates));
+
+        Assert::AreEqual(vExpected.size(), vCandidates.size(), sQuery.c_str());
+        for (size_t i = 0; i < vExpected.size(); ++i)
+            Assert::AreEqual(vExpected.at(i), vCandidates.at(i), sQuery.c_str());
+    }
+
+public:
+    TEST_METHOD(TestEmpty)
+    {
+        TrigramIndex pIndex;
+        Assert::AreEqual({ 0U }, pIndex.Count());
+        AssertCandidates(pIndex, L"abc", {});
+    }
+
+    TEST_METHOD(TestShortQuery)
+    {
+        TrigramIndex pIndex;
+        pIndex.Set(1U, L"Health");
+
+        std::vector<ra::ByteAddress> vCandidates{ 7U };
+        Assert::IsFalse(pIndex.FindCandidates(L"", vCandidates));
+        Assert::IsTrue(vCandidates.empty());
+        Assert::IsFalse(pIndex.FindCandidates(L"h", vCandidates));
+        Assert::IsFalse(pIndex.FindCandidates(L"he", vCandidates));
+    }
+
+    TEST_METHOD(TestFindCandidates)
+    {
+        TrigramIndex pIndex;
+        pIndex.Set(0x10U, L"Player Health");
+        pIndex.Set(0x20U, L"Enemy Health");
+        pIndex.Set(0x30U, L"Player Lives");
+        pIndex.Set(0x40U, L"[8-bit] Timer");
+        Assert::AreEqual({ 4U }, pIndex.Count());
+
+        AssertCandidates(pIndex, L"health", { 0x10U, 0x20U });
+        AssertCandidates(pIndex, L"player", { 0x10U, 0x30U });
+        AssertCandidates(pIndex, L"player h", { 0x10U });
+        AssertCandidates(pIndex, L"bit]", { 0x40U });
+        AssertCandidates(pIndex, L"mana", {});
+    }
+
+    TEST_METHOD(TestFindCandidatesCaseInsensitive)
+    {
+        TrigramIndex pIndex;
+        pIndex.Set(0x10U, L"PLAYER HEALTH");
+        pIndex.Set(0x20U, L"player health");
+
+        // query is expected to already be lowercased
+        AssertCandidates(pIndex, L"health", { 0x10U, 0x20U });
+        AssertCandidates(pIndex, L"HEALTH", {});
+    }
+
+    TEST_METHOD(TestFindCandidatesNotAdjacent)
+    {
+        TrigramIndex pIndex;
+        pIndex.Set(0x10U, L"abcd bcde");
+
+        // every sequence in the query exists, but the query does not. caller is responsible for verifying
+        AssertCandidates(pIndex, L"abcde", { 0x10U });
+    }
+
+    TEST_METHOD(TestSetOutOfOrder)
+    {
+        TrigramIndex pIndex;
+        pIndex.Set(0x30U, L"Health");
+        pIndex.Set(0x10U, L"Health");
+        pIndex.Set(0x20U, L"Health");
+
+        AssertCandidates(pIndex, L"health", { 0x10U, 0x20U, 0x30U });
+    }
+
+    TEST_METHOD(TestUpdate)
+    {
+        TrigramIndex pIndex;
+        pIndex.Set(0x10U, L"Health");
+        pIndex.Set(0x20U, L"Health");
+
+        pIndex.Set(0x10U, L"Lives");
+        Assert::AreEqual({ 2U }, pIndex.Count());
+        AssertCandidates(pIndex, L"health", { 0x20U });
+        AssertCandidates(pIndex, L"lives", { 0x10U });
+
+        // unchanged
+        pIndex.Set(0x10U, L"LIVES");
+        AssertCandidates(pIndex, L"lives", { 0x10U });
+    }
+
+    TEST_METHOD(TestRemove)
+    {
+        TrigramIndex pIndex;
+        pIndex.Set(0x10U, L"Health");
+        pIndex.Set(0x20U, L"Health");
+
+        pIndex.Remove(0x10U);
+        Assert::AreEqual({ 1U }, pIndex.Count());
+        AssertCandidates(pIndex, L"health", { 0x20U });
+
+        pIndex.Remove(0x20U);
+        Assert::AreEqual({ 0U }, pIndex.Count());
+        AssertCandidates(pIndex, L"health", {});
+
+        // not in index
+        pIndex.Remove(0x30U);
+        Assert::AreEqual({ 0U }, pIndex.Count());
+    }
+
+    TEST_METHOD(TestClear)
+    {
+        TrigramIndex pIndex;
+        pIndex.Set(0x10U, L"Health");
+        pIndex.Set(0x20U, L"Lives");
+
+        pIndex.Clear();
+        Assert::AreEqual({ 0U }, pIndex.Count());
+        AssertCandidates(pIndex, L"health", {});
+
+        pIndex.Set(0x20U, L"Health");
+        AssertCandidates(pIndex, L"health", { 0x20U });
+    }
+};
+
+} // namespace tests
+} // namespace data
+} // namespace ra
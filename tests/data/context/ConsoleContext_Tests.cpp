@@ -3,6 +3,7 @@
 #include "data\context\ConsoleContext.hh"
 
 #include "tests\data\DataAsserts.hh"
+#include "tests\mocks\MockConsoleContext.hh"
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
@@ -29,6 +30,147 @@ private:
         }
     }
 
+    // the linear scans that were used before the lookup tables were added
+    static ra::ByteAddress ScanRealAddressFromByteAddress(const ConsoleContext& context, ra::ByteAddress nByteAddress) noexcept
+    {
+        for (const auto& pRegion : context.MemoryRegions())
+        {
+            if (pRegion.EndAddress >= nByteAddress && pRegion.StartAddress <= nByteAddress)
+                return nByteAddress + pRegion.RealAddress;
+        }
+
+        return 0xFFFFFFFF;
+    }
+
+    static ra::ByteAddress ScanByteAddressFromRealAddress(const ConsoleContext& context, ra::ByteAddress nRealAddress) noexcept
+    {
+        for (const auto& pRegion : context.MemoryRegions())
+        {
+            if (pRegion.RealAddress < nRealAddress)
+            {
+                const auto nRegionSize = pRegion.EndAddress - pRegion.StartAddress;
+                if (nRealAddress < pRegion.RealAddress + nRegionSize)
+                    return (nRealAddress - pRegion.RealAddress) + pRegion.StartAddress;
+            }
+        }
+
+        switch (context.Id())
+        {
+            case ConsoleID::Dreamcast:
+                if (nRealAddress >= 0x8C000000 && nRealAddress <= 0x8CFFFFFF)
+                    return ScanByteAddressFromRealAddress(context, nRealAddress & 0x0FFFFFFF);
+                if (nRealAddress >= 0xAC000000 && nRealAddress <= 0xACFFFFFF)
+                    return ScanByteAddressFromRealAddress(context, nRealAddress & 0x0FFFFFFF);
+                break;
+
+            case ConsoleID::GameCube:
+                if (nRealAddress >= 0xC0000000 && nRealAddress <= 0xC17FFFFF)
+                    return ScanByteAddressFromRealAddress(context, nRealAddress - (0xC0000000 - 0x80000000));
+                break;
+
+            case ConsoleID::DSi:
+                if (nRealAddress >= 0x0C000000 && nRealAddress <= 0x0CFFFFFF)
+                    return ScanByteAddressFromRealAddress(context, nRealAddress - (0x0C000000 - 0x02000000));
+                break;
+
+            case ConsoleID::PlayStation:
+                if (nRealAddress >= 0x80000000 && nRealAddress <= 0x801FFFFF)
+                    return ScanByteAddressFromRealAddress(context, nRealAddress & 0x001FFFFF);
+                if (nRealAddress >= 0xA0000000 && nRealAddress <= 0xA01FFFFF)
+                    return ScanByteAddressFromRealAddress(context, nRealAddress & 0x001FFFFF);
+                break;
+
+            case ConsoleID::PlayStation2:
+                if (nRealAddress >= 0x20000000 && nRealAddress <= 0x21FFFFFF)
+                    return ScanByteAddressFromRealAddress(context, nRealAddress & 0x01FFFFFF);
+                if (nRealAddress >= 0x30100000 && nRealAddress <= 0x31FFFFFF)
+                    return ScanByteAddressFromRealAddress(context, nRealAddress & 0x01FFFFFF);
+                break;
+
+            case ConsoleID::WII:
+                if (nRealAddress >= 0xC0000000 && nRealAddress <= 0xC17FFFFF)
+                    return ScanByteAddressFromRealAddress(context, nRealAddress - (0xC0000000 - 0x80000000));
+                if (nRealAddress >= 0xD0000000 && nRealAddress <= 0xD3FFFFFF)
+                    return ScanByteAddressFromRealAddress(context, nRealAddress - (0xD0000000 - 0x90000000));
+                break;
+
+            default:
+                break;
+        }
+
+        return 0xFFFFFFFF;
+    }
+
+    static void AssertTranslation(const ConsoleContext& context, ra::ByteAddress nAddress)
+    {
+        const auto nExpectedReal = ScanRealAddressFromByteAddress(context, nAddress);
+        const auto nReal = context.RealAddressFromByteAddress(nAddress);
+        if (nReal != nExpectedReal)
+        {
+            Assert::Fail(ra::StringPrintf(L"%s: RealAddressFromByteAddress(%08x) returned %08x, expected %08x",
+                context.Name(), nAddress, nReal, nExpectedReal).c_str());
+        }
+
+        const auto nExpectedByte = ScanByteAddressFromRealAddress(context, nAddress);
+        const auto nByte = context.ByteAddressFromRealAddress(nAddress);
+        if (nByte != nExpectedByte)
+        {
+            Assert::Fail(ra::StringPrintf(L"%s: ByteAddressFromRealAddress(%08x) returned %08x, expected %08x",
+                context.Name(), nAddress, nByte, nExpectedByte).c_str());
+        }
+    }
+
+    static void AssertTranslationsAround(const ConsoleContext& context, ra::ByteAddress nAddress)
+    {
+        for (ra::ByteAddress nDelta = 0; nDelta <= 2; ++nDelta)
+        {
+            AssertTranslation(context, nAddress - nDelta);
+            AssertTranslation(context, nAddress + nDelta);
+        }
+    }
+
+    static void AssertTranslationsMatchScan(const ConsoleContext& context)
+    {
+        // every byte address, if the address space is small enough. otherwise, a sampling of addresses.
+        const auto nMaxAddress = context.MaxAddress();
+        const ra::ByteAddress nStep = (nMaxAddress < 0x00400000) ? 1 : 0x101;
+        for (uint64_t nAddress = 0; nAddress <= uint64_t{ nMaxAddress } + 0x100; nAddress += nStep)
+            AssertTranslation(context, gsl::narrow_cast<ra::ByteAddress>(nAddress));
+
+        // boundaries of each region in both address spaces
+        for (const auto& pRegion : context.MemoryRegions())
+        {
+            AssertTranslationsAround(context, pRegion.StartAddress);
+            AssertTranslationsAround(context, pRegion.EndAddress);
+            AssertTranslationsAround(context, pRegion.RealAddress);
+            AssertTranslationsAround(context, pRegion.RealAddress + (pRegion.EndAddress - pRegion.StartAddress));
+
+            // sampling of the real address space of the region
+            const auto nSize = pRegion.EndAddress - pRegion.StartAddress;
+            for (ra::ByteAddress nOffset = 0; nOffset < nSize; nOffset += 0x1001)
+                AssertTranslation(context, pRegion.RealAddress + nOffset);
+        }
+
+        // boundaries of the mirrors
+        for (const ra::ByteAddress nAddress : { 0x0C000000U, 0x0CFFFFFFU, 0x20000000U, 0x21FFFFFFU, 0x30100000U,
+                                                0x31FFFFFFU, 0x80000000U, 0x801FFFFFU, 0x8C000000U, 0x8CFFFFFFU,
+                                                0xA0000000U, 0xA01FFFFFU, 0xAC000000U, 0xACFFFFFFU, 0xC0000000U,
+                                                0xC17FFFFFU, 0xD0000000U, 0xD3FFFFFFU, 0xFFFFFFFFU })
+        {
+            AssertTranslationsAround(context, nAddress);
+        }
+
+        // random addresses
+        uint32_t nSeed = 0x12345678;
+        for (int i = 0; i < 100000; ++i)
+        {
+            nSeed ^= nSeed << 13;
+            nSeed ^= nSeed >> 17;
+            nSeed ^= nSeed << 5;
+            AssertTranslation(context, nSeed);
+        }
+    }
+
 public:
     TEST_METHOD(TestInitializeAtari2600)
     {
@@ -185,6 +327,138 @@ public:
         Assert::AreEqual({ 0xFFFFFFFF }, context.ByteAddressFromRealAddress(0xB0001234U));
         Assert::AreEqual({ 0xFFFFFFFF }, context.ByteAddressFromRealAddress(0x00001234U));
     }
+
+    TEST_METHOD(TestAddressTranslationMatchesScanAllConsoles)
+    {
+        int nConsoles = 0;
+        for (int nId = 1; nId < 256; ++nId)
+        {
+            ConsoleContext context(ra::itoe<ConsoleID>(nId));
+            if (context.MemoryRegions().empty())
+                continue;
+
+            AssertTranslationsMatchScan(context);
+            ++nConsoles;
+        }
+
+        Assert::IsTrue(nConsoles > 50);
+    }
+
+    TEST_METHOD(TestAddressTranslationOverlappingRegions)
+    {
+        ra::data::context::mocks::MockConsoleContext context;
+        context.AddMemoryRegion(0x0000U, 0x0FFFU, ConsoleContext::AddressType::SystemRAM, 0x8000U);
+        context.AddMemoryRegion(0x1000U, 0x1FFFU, ConsoleContext::AddressType::VirtualRAM, 0x8800U);
+        context.AddMemoryRegion(0x0800U, 0x17FFU, ConsoleContext::AddressType::SaveRAM, 0x20000U);
+
+        // the first region containing an address is used
+        Assert::AreEqual({ 0x8800U }, context.RealAddressFromByteAddress(0x0800U));
+        Assert::AreEqual({ 0x9800U }, context.RealAddressFromByteAddress(0x1000U));
+        Assert::AreEqual({ 0x8800U + 0x1FFFU }, context.RealAddressFromByteAddress(0x1FFFU));
+        Assert::AreEqual({ 0xFFFFFFFFU }, context.RealAddressFromByteAddress(0x2000U));
+
+        // 0x8800-0x8FFF is in the first and second regions. 0x9000-0x97FF is only in the second region.
+        Assert::AreEqual({ 0x0801U }, context.ByteAddressFromRealAddress(0x8801U));
+        Assert::AreEqual({ 0x1800U }, context.ByteAddressFromRealAddress(0x9000U));
+        Assert::AreEqual({ 0x0801U }, context.ByteAddressFromRealAddress(0x20001U));
+
+        AssertTranslationsMatchScan(context);
+
+        context.ResetMemoryRegions();
+        Assert::AreEqual({ 0xFFFFFFFFU }, context.RealAddressFromByteAddress(0x0800U));
+        Assert::AreEqual({ 0xFFFFFFFFU }, context.ByteAddressFromRealAddress(0x8801U));
+    }
+
+    TEST_METHOD(TestAddressTranslationUnalignedRegions)
+    {
+        // regions that don't start or end on a page boundary
+        ra::data::context::mocks::MockConsoleContext context;
+        context.AddMemoryRegion(0x0000U, 0x0012U, ConsoleContext::AddressType::SystemRAM, 0x1000U);
+        context.AddMemoryRegion(0x0013U, 0x0133U, ConsoleContext::AddressType::SystemRAM, 0x3000U);
+        context.AddMemoryRegion(0x0200U, 0x02FFU, ConsoleContext::AddressType::SystemRAM, 0x0F00U);
+        context.AddMemoryRegion(0x0301U, 0x2000U, ConsoleContext::AddressType::VideoRAM, 0x4000U);
+        context.AddMemoryRegion(0x3000U, 0x3000U, ConsoleContext::AddressType::VideoRAM, 0x7000U);
+
+        AssertTranslationsMatchScan(context);
+        for (ra::ByteAddress nAddress = 0; nAddress < 0x10000; ++nAddress)
+            AssertTranslation(context, nAddress);
+    }
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(TestAddressTranslationPerformance)
+        TEST_IGNORE()
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(TestAddressTranslationPerformance)
+    {
+        constexpr int nTranslations = 100000000;
+
+        std::vector<std::unique_ptr<ConsoleContext>> vConsoles;
+        for (int nId = 1; nId < 256; ++nId)
+        {
+            auto pContext = std::make_unique<ConsoleContext>(ra::itoe<ConsoleID>(nId));
+            if (!pContext->MemoryRegions().empty())
+                vConsoles.push_back(std::move(pContext));
+        }
+
+        // byte addresses are random within the address space of the console. real addresses are random within
+        // the real address space of a random region. the pointer inspector and pointer finder mostly translate
+        // addresses that are mapped.
+        constexpr size_t nBufferSize = 65536;
+        const int nPerConsole = nTranslations / gsl::narrow_cast<int>(vConsoles.size()) / 2;
+        uint32_t nSeed = 0x12345678;
+        const auto fNext = [&nSeed]() noexcept {
+            nSeed ^= nSeed << 13;
+            nSeed ^= nSeed >> 17;
+            nSeed ^= nSeed << 5;
+            return nSeed;
+        };
+
+        std::vector<ra::ByteAddress> vByteAddresses(nBufferSize);
+        std::vector<ra::ByteAddress> vRealAddresses(nBufferSize);
+        std::chrono::steady_clock::duration tTable{}, tScan{};
+        uint32_t nChecksum = 0, nScanChecksum = 0;
+        for (const auto& pContext : vConsoles)
+        {
+            const auto& vRegions = pContext->MemoryRegions();
+            const uint64_t nRange = uint64_t{ pContext->MaxAddress() } + 1;
+            for (size_t i = 0; i < nBufferSize; ++i)
+            {
+                vByteAddresses.at(i) = gsl::narrow_cast<ra::ByteAddress>(fNext() % nRange);
+
+                const auto& pRegion = vRegions.at(fNext() % vRegions.size());
+                const auto nSize = uint64_t{ pRegion.EndAddress - pRegion.StartAddress } + 1;
+                vRealAddresses.at(i) = pRegion.RealAddress + gsl::narrow_cast<ra::ByteAddress>(fNext() % nSize);
+            }
+
+            const auto tStart = std::chrono::steady_clock::now();
+            for (int i = 0; i < nPerConsole; ++i)
+            {
+                const auto nIndex = gsl::narrow_cast<size_t>(i) % nBufferSize;
+                nChecksum += pContext->RealAddressFromByteAddress(vByteAddresses.at(nIndex));
+                nChecksum += pContext->ByteAddressFromRealAddress(vRealAddresses.at(nIndex));
+            }
+            const auto tTableDone = std::chrono::steady_clock::now();
+            tTable += tTableDone - tStart;
+
+            // the scan is slower, so only do a tenth as many
+            for (int i = 0; i < nPerConsole / 10; ++i)
+            {
+                const auto nIndex = gsl::narrow_cast<size_t>(i) % nBufferSize;
+                nScanChecksum += ScanRealAddressFromByteAddress(*pContext, vByteAddresses.at(nIndex));
+                nScanChecksum += ScanByteAddressFromRealAddress(*pContext, vRealAddresses.at(nIndex));
+            }
+            tScan += std::chrono::steady_clock::now() - tTableDone;
+        }
+
+        Assert::AreNotEqual(0U, nChecksum + nScanChecksum);
+
+        const auto nTableCount = gsl::narrow_cast<int>(vConsoles.size()) * nPerConsole * 2;
+        const auto nScanCount = gsl::narrow_cast<int>(vConsoles.size()) * (nPerConsole / 10) * 2;
+        Logger::WriteMessage(ra::StringPrintf("%d translations across %zu consoles: table %d ms (%d ns each), scan %d ns each\n",
+            nTableCount, vConsoles.size(),
+            gsl::narrow_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(tTable).count()),
+            gsl::narrow_cast<int>(std::chrono::duration_cast<std::chrono::nanoseconds>(tTable).count() / nTableCount),
+            gsl::narrow_cast<int>(std::chrono::duration_cast<std::chrono::nanoseconds>(tScan).count() / nScanCount)).c_str());
+    }
 };
 
 } // namespace tests
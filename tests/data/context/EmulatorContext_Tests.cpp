@@ -100,6 +100,22 @@ private:
         uint8_t nLastByteWritten = 0xFF;
     };
 
+    class EmulatorContextRangeNotifyHarness : public EmulatorContext::NotifyTarget
+    {
+    public:
+        void OnByteWritten(ra::ByteAddress nAddress, uint8_t nValue) noexcept override
+        {
+            vRanges.emplace_back(nAddress, std::vector<uint8_t>{ nValue });
+        }
+
+        void OnBytesWritten(ra::ByteAddress nAddress, const uint8_t pBytes[], size_t nCount) override
+        {
+            vRanges.emplace_back(nAddress, std::vector<uint8_t>(pBytes, pBytes + nCount));
+        }
+
+        std::vector<std::pair<ra::ByteAddress, std::vector<uint8_t>>> vRanges;
+    };
+
 public:
     TEST_METHOD(TestClientName)
     {
@@ -1147,6 +1163,15 @@ public:
     static void WriteMemory2(uint32_t nAddress, uint8_t nValue) noexcept { memory.at(gsl::narrow_cast<size_t>(nAddress) + 20) = nValue; }
     static void WriteMemory3(uint32_t nAddress, uint8_t nValue) noexcept { memory.at(gsl::narrow_cast<size_t>(nAddress) + 30) = nValue; }
 
+    static size_t s_nWriteMemoryBlockCalls;
+
+    static uint32_t WriteMemoryBlock1(uint32_t nAddress, const uint8_t* pBuffer, uint32_t nBytes) noexcept
+    {
+        ++s_nWriteMemoryBlockCalls;
+        memcpy(&memory.at(gsl::narrow_cast<size_t>(nAddress) + 10), pBuffer, nBytes);
+        return nBytes;
+    }
+
     static void InitializeMemory()
     {
         for (size_t i = 0; i < memory.size(); ++i)
@@ -1619,6 +1644,173 @@ public:
         Assert::AreEqual((uint8_t)0xFF, memory.at(4));
     }
 
+    TEST_METHOD(TestWriteMemoryBuffer)
+    {
+        InitializeMemory();
+
+        EmulatorContextHarness emulator;
+        emulator.AddMemoryBlock(0, 20, &ReadMemory0, &WriteMemory0);
+        emulator.AddMemoryBlock(1, 10, &ReadMemory2, &WriteMemory2);
+        Assert::AreEqual({ 30U }, emulator.TotalMemorySize());
+
+        // spans both blocks and extends past the end of memory
+        std::array<uint8_t, 24> buffer{};
+        for (size_t i = 0; i < buffer.size(); ++i)
+            buffer.at(i) = gsl::narrow_cast<uint8_t>(0x80 + i);
+
+        emulator.WriteMemory(10U, buffer.data(), buffer.size());
+
+        for (uint8_t i = 0; i < 10; ++i)
+            Assert::AreEqual(i, memory.at(i));
+        for (uint8_t i = 10; i < 30; ++i)
+            Assert::AreEqual(static_cast<uint8_t>(0x80 + i - 10), memory.at(i));
+        for (uint8_t i = 30; i < memory.size(); ++i)
+            Assert::AreEqual(i, memory.at(i));
+
+        Assert::IsTrue(emulator.WasMemoryModified());
+    }
+
+    TEST_METHOD(TestWriteMemoryBufferBlockWriter)
+    {
+        InitializeMemory();
+        s_nWriteMemoryBlockCalls = 0;
+
+        EmulatorContextHarness emulator;
+        emulator.AddMemoryBlock(0, 10, &ReadMemory0, &WriteMemory0);
+        emulator.AddMemoryBlock(1, 10, &ReadMemory1, &WriteMemory1);
+        emulator.AddMemoryBlockWriter(1, &WriteMemoryBlock1);
+
+        std::array<uint8_t, 8> buffer{ 0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7 };
+        emulator.WriteMemory(6U, buffer.data(), buffer.size());
+
+        // first four bytes written through WriteMemory0, last four through a single call to WriteMemoryBlock1
+        Assert::AreEqual({ 1U }, s_nWriteMemoryBlockCalls);
+        Assert::AreEqual((uint8_t)0x05, memory.at(5));
+        for (uint8_t i = 0; i < buffer.size(); ++i)
+            Assert::AreEqual(buffer.at(i), memory.at(gsl::narrow_cast<size_t>(i) + 6));
+        Assert::AreEqual((uint8_t)0x0E, memory.at(14));
+
+        // single byte writes use the block writer if there's no byte writer
+        emulator.ClearMemoryBlocks();
+        emulator.AddMemoryBlock(0, 10, &ReadMemory0, &WriteMemory0);
+        emulator.AddMemoryBlock(1, 10, &ReadMemory1, nullptr);
+        emulator.AddMemoryBlockWriter(1, &WriteMemoryBlock1);
+
+        emulator.WriteMemoryByte(15U, 0x55);
+        Assert::AreEqual({ 2U }, s_nWriteMemoryBlockCalls);
+        Assert::AreEqual((uint8_t)0x55, memory.at(15));
+    }
+
+    TEST_METHOD(TestWriteMemoryBufferEvents)
+    {
+        InitializeMemory();
+
+        EmulatorContextHarness emulator;
+        emulator.AddMemoryBlock(0, 10, &ReadMemory0, &WriteMemory0);
+        emulator.AddMemoryBlock(1, 10, &ReadMemory1, &WriteMemory1);
+        emulator.AddMemoryBlock(2, 10, &ReadMemory2, nullptr);
+        emulator.AddMemoryBlock(3, 10, &ReadMemory3, &WriteMemory3);
+
+        EmulatorContextRangeNotifyHarness notify;
+        emulator.AddNotifyTarget(notify);
+
+        // contiguous writable blocks are reported as a single range
+        std::array<uint8_t, 8> buffer{ 0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7 };
+        emulator.WriteMemory(6U, buffer.data(), buffer.size());
+        Assert::AreEqual({ 1U }, notify.vRanges.size());
+        Assert::AreEqual(6U, notify.vRanges.at(0).first);
+        Assert::AreEqual({ 8U }, notify.vRanges.at(0).second.size());
+        Assert::AreEqual((uint8_t)0xA7, notify.vRanges.at(0).second.at(7));
+
+        // unwritable block splits the range
+        notify.vRanges.clear();
+        std::array<uint8_t, 24> buffer2{};
+        buffer2.fill(0xCC);
+        emulator.WriteMemory(14U, buffer2.data(), buffer2.size());
+        Assert::AreEqual({ 2U }, notify.vRanges.size());
+        Assert::AreEqual(14U, notify.vRanges.at(0).first);
+        Assert::AreEqual({ 6U }, notify.vRanges.at(0).second.size());
+        Assert::AreEqual(30U, notify.vRanges.at(1).first);
+        Assert::AreEqual({ 8U }, notify.vRanges.at(1).second.size());
+        Assert::AreEqual((uint8_t)22, memory.at(22));
+
+        // completely unwritable, no event
+        notify.vRanges.clear();
+        emulator.WriteMemory(22U, buffer2.data(), 4);
+        Assert::AreEqual({ 0U }, notify.vRanges.size());
+
+        // multi-byte value is reported as a single range
+        emulator.WriteMemory(2U, MemSize::ThirtyTwoBitBigEndian, 0x12345678);
+        Assert::AreEqual({ 1U }, notify.vRanges.size());
+        Assert::AreEqual(2U, notify.vRanges.at(0).first);
+        const std::vector<uint8_t> vExpected{ 0x12, 0x34, 0x56, 0x78 };
+        Assert::IsTrue(vExpected == notify.vRanges.at(0).second);
+
+        // targets that only handle single bytes are told about each byte
+        EmulatorContextNotifyHarness notifyBytes;
+        emulator.AddNotifyTarget(notifyBytes);
+        emulator.WriteMemory(2U, MemSize::SixteenBit, 0xABCD);
+        Assert::AreEqual(3U, notifyBytes.nLastByteWrittenAddress);
+        Assert::AreEqual((uint8_t)0xAB, notifyBytes.nLastByteWritten);
+    }
+
+    TEST_METHOD(TestWriteMemoryBufferEventCount)
+    {
+        // bulk writes should raise one event per listener rather than one per byte
+        std::vector<uint8_t> vMemory(0x10000);
+        static uint8_t* s_pMemory = nullptr;
+        s_pMemory = vMemory.data();
+
+        EmulatorContextHarness emulator;
+        emulator.AddMemoryBlock(0, vMemory.size(),
+            [](uint32_t nAddress) noexcept { return s_pMemory[nAddress]; },
+            [](uint32_t nAddress, uint8_t nValue) noexcept { s_pMemory[nAddress] = nValue; });
+
+        class CountingNotifyTarget : public EmulatorContext::NotifyTarget
+        {
+        public:
+            void OnByteWritten(ra::ByteAddress, uint8_t) noexcept override { ++nBytes; ++nEvents; }
+            void OnBytesWritten(ra::ByteAddress, const uint8_t[], size_t nCount) noexcept override
+            {
+                nBytes += nCount;
+                ++nEvents;
+            }
+
+            size_t nBytes = 0;
+            size_t nEvents = 0;
+        };
+
+        std::array<CountingNotifyTarget, 5> vTargets;
+        for (auto& pTarget : vTargets)
+            emulator.AddNotifyTarget(pTarget);
+
+        std::vector<uint8_t> vPaste(0x10000);
+        for (size_t i = 0; i < vPaste.size(); ++i)
+            vPaste.at(i) = gsl::narrow_cast<uint8_t>(i * 7);
+
+        // 64KB paste: byte at a time vs. one range
+        for (size_t i = 0; i < vPaste.size(); ++i)
+            emulator.WriteMemoryByte(gsl::narrow_cast<ra::ByteAddress>(i), vPaste.at(i));
+
+        Assert::AreEqual(vPaste.size(), vTargets.at(0).nEvents);
+        vTargets.at(0).nEvents = 0;
+
+        emulator.WriteMemory(0U, vPaste.data(), vPaste.size());
+
+        Assert::IsTrue(vPaste == vMemory);
+        for (const auto& pTarget : vTargets)
+            Assert::AreEqual(vPaste.size() * 2, pTarget.nBytes);
+        Assert::AreEqual({ 1U }, vTargets.at(0).nEvents);
+
+        // 10000 frozen 32-bit values
+        vTargets.at(0).nEvents = 0;
+        for (ra::ByteAddress nAddress = 0; nAddress < 40000; nAddress += 4)
+            emulator.WriteMemory(nAddress, MemSize::ThirtyTwoBit, nAddress);
+
+        Assert::AreEqual({ 10000U }, vTargets.at(0).nEvents);
+        Assert::AreEqual(0x9C3CU, emulator.ReadMemory(0x9C3CU, MemSize::ThirtyTwoBit));
+    }
+
     TEST_METHOD(TestIsMemoryInsecureCached)
     {
         EmulatorContextHarness emulator;
@@ -1810,6 +2002,7 @@ public:
 };
 
 std::array<uint8_t, 64> EmulatorContext_Tests::memory;
+size_t EmulatorContext_Tests::s_nWriteMemoryBlockCalls = 0;
 
 } // namespace tests
 } // namespace context
@@ -2,6 +2,8 @@
 
 #include "data\context\SessionTracker.hh"
 
+#include "RA_md5factory.h"
+
 #include "tests\RA_UnitTestHelpers.h"
 #include "tests\data\DataAsserts.hh"
 
@@ -88,7 +90,7 @@ public:
         tracker.mockThreadPool.ExecuteNextTask(); // execute async server call
         Assert::AreEqual({ 1U }, tracker.mockThreadPool.PendingTasks());
         Assert::IsTrue(tracker.HasStoredData());
-        Assert::AreEqual(std::string("1234:1534889323:150:5d\n"), tracker.GetStoredData());
+        Assert::AreEqual(std::string("1234:1534889323:150:b5defa9e\n"), tracker.GetStoredData());
 
         // after two more minutes, the callback will be called again, and the file updated
         tracker.mockClock.AdvanceTime(std::chrono::seconds(120));
@@ -96,12 +98,12 @@ public:
         tracker.mockThreadPool.ExecuteNextTask(); // execute async server call
         Assert::AreEqual({ 1U }, tracker.mockThreadPool.PendingTasks());
         Assert::IsTrue(tracker.HasStoredData());
-        Assert::AreEqual(std::string("1234:1534889323:270:f9\n"), tracker.GetStoredData());
+        Assert::AreEqual(std::string("1234:1534889323:270:a4ef811e\n"), tracker.GetStoredData());
     }
 
     TEST_METHOD(TestNonEmptyFile)
     {
-        std::string sInitialValue("1234:1534000000:1732:f5\n");
+        std::string sInitialValue("1234:1534000000:1732:69003708\n");
         SessionTrackerHarness tracker;
         tracker.MockStoredData(sInitialValue);
 
@@ -123,12 +125,12 @@ public:
         // after two minutes, the callback will be called again, and a new entry added to the file
         tracker.mockClock.AdvanceTime(std::chrono::seconds(120));
         tracker.mockThreadPool.AdvanceTime(std::chrono::seconds(120));
-        Assert::AreEqual(std::string("1234:1534000000:1732:f5\n1234:1534889323:150:5d\n"), tracker.GetStoredData());
+        Assert::AreEqual(std::string("1234:1534000000:1732:69003708\n1234:1534889323:150:b5defa9e\n"), tracker.GetStoredData());
 
         // after two more minutes, the callback will be called again, and the new entry updated
         tracker.mockClock.AdvanceTime(std::chrono::seconds(120));
         tracker.mockThreadPool.AdvanceTime(std::chrono::seconds(120));
-        Assert::AreEqual(std::string("1234:1534000000:1732:f5\n1234:1534889323:270:f9\n"), tracker.GetStoredData());
+        Assert::AreEqual(std::string("1234:1534000000:1732:69003708\n1234:1534889323:270:a4ef811e\n"), tracker.GetStoredData());
 
         // total playtime should include current session and previous session
         Assert::AreEqual(1732U + 270U, static_cast<unsigned int>(tracker.GetTotalPlaytime(1234U).count()));
@@ -136,7 +138,7 @@ public:
         // ending session should count any time in the since the last callback
         tracker.mockClock.AdvanceTime(std::chrono::seconds(23));
         tracker.EndSession();
-        Assert::AreEqual(std::string("1234:1534000000:1732:f5\n1234:1534889323:293:c9\n"), tracker.GetStoredData());
+        Assert::AreEqual(std::string("1234:1534000000:1732:69003708\n1234:1534889323:293:855cffd7\n"), tracker.GetStoredData());
         Assert::AreEqual(1732U + 293U, static_cast<unsigned int>(tracker.GetTotalPlaytime(1234U).count()));
     }
 
@@ -169,9 +171,176 @@ public:
         Assert::AreEqual(963U, static_cast<unsigned int>(tracker.GetTotalPlaytime(9999U).count()));
     }
 
+    TEST_METHOD(TestMigrateLegacyFile)
+    {
+        std::string sInitialValue("1234:1534000000:1732:f5\n"
+            "9999:1534100000:963:4e\n"
+            "1234:1534200000:591:0b\n");
+        SessionTrackerHarness tracker;
+        tracker.MockStoredData(sInitialValue);
+
+        // legacy entries should be converted to one entry per game
+        tracker.Initialize("User");
+        Assert::AreEqual(std::string("1234:1534200000:2323:55201f66\n9999:1534100000:963:35abb8a6\n"), tracker.GetStoredData());
+        Assert::AreEqual(2323U, static_cast<unsigned int>(tracker.GetTotalPlaytime(1234U).count()));
+        Assert::AreEqual(963U, static_cast<unsigned int>(tracker.GetTotalPlaytime(9999U).count()));
+
+        // most recently played first
+        Assert::AreEqual({ 2U }, tracker.SessionData().size());
+        Assert::AreEqual(1234U, tracker.SessionData().at(0).GameId);
+        Assert::AreEqual(9999U, tracker.SessionData().at(1).GameId);
+
+        // converted file should load without being rewritten
+        SessionTrackerHarness tracker2;
+        tracker2.MockStoredData(tracker.GetStoredData());
+        tracker2.Initialize("User");
+        Assert::AreEqual(tracker.GetStoredData(), tracker2.GetStoredData());
+        Assert::AreEqual(2323U, static_cast<unsigned int>(tracker2.GetTotalPlaytime(1234U).count()));
+        Assert::AreEqual(963U, static_cast<unsigned int>(tracker2.GetTotalPlaytime(9999U).count()));
+    }
+
+    TEST_METHOD(TestTruncatedTail)
+    {
+        std::string sInitialValue("1234:1534000000:1732:69003708\n"
+            "9999:1534100000:963:35abb8a6\n"
+            "1234:15348");
+        SessionTrackerHarness tracker;
+        tracker.MockStoredData(sInitialValue);
+
+        // partial entry should be discarded
+        tracker.Initialize("User");
+        Assert::AreEqual(std::string("1234:1534000000:1732:69003708\n9999:1534100000:963:35abb8a6\n"), tracker.GetStoredData());
+        Assert::AreEqual(1732U, static_cast<unsigned int>(tracker.GetTotalPlaytime(1234U).count()));
+        Assert::AreEqual(963U, static_cast<unsigned int>(tracker.GetTotalPlaytime(9999U).count()));
+
+        // new session should be written after the valid entries
+        tracker.mockGameContext.SetGameId(1234U);
+        tracker.BeginSession(1234U);
+        tracker.mockClock.AdvanceTime(std::chrono::seconds(30));
+        tracker.mockThreadPool.AdvanceTime(std::chrono::seconds(30));
+        tracker.mockClock.AdvanceTime(std::chrono::seconds(120));
+        tracker.mockThreadPool.AdvanceTime(std::chrono::seconds(120));
+        tracker.EndSession();
+        Assert::AreEqual(std::string("1234:1534000000:1732:69003708\n9999:1534100000:963:35abb8a6\n"
+                                     "1234:1534889323:150:b5defa9e\n"), tracker.GetStoredData());
+
+        SessionTrackerHarness tracker2;
+        tracker2.MockStoredData(tracker.GetStoredData());
+        tracker2.Initialize("User");
+        Assert::AreEqual(1732U + 150U, static_cast<unsigned int>(tracker2.GetTotalPlaytime(1234U).count()));
+        Assert::AreEqual(963U, static_cast<unsigned int>(tracker2.GetTotalPlaytime(9999U).count()));
+    }
+
+    TEST_METHOD(TestCompaction)
+    {
+        SessionTrackerHarness tracker;
+        tracker.Initialize("User");
+
+        for (int i = 0; i < 70; ++i)
+        {
+            tracker.BeginSession((i % 2) ? 1234U : 9999U);
+            tracker.mockClock.AdvanceTime(std::chrono::seconds(60));
+            tracker.EndSession();
+        }
+
+        // one line per session
+        const std::string sStoredData = tracker.GetStoredData();
+        Assert::AreEqual({ 70 }, std::count(sStoredData.begin(), sStoredData.end(), '\n'));
+
+        // reloading the file should compact it to one line per game
+        SessionTrackerHarness tracker2;
+        tracker2.MockStoredData(sStoredData);
+        tracker2.Initialize("User");
+        const std::string sCompactedData = tracker2.GetStoredData();
+        Assert::AreEqual({ 2 }, std::count(sCompactedData.begin(), sCompactedData.end(), '\n'));
+        Assert::AreEqual(35U * 60U, static_cast<unsigned int>(tracker2.GetTotalPlaytime(1234U).count()));
+        Assert::AreEqual(35U * 60U, static_cast<unsigned int>(tracker2.GetTotalPlaytime(9999U).count()));
+
+        // most recently played first
+        Assert::AreEqual(1234U, tracker2.SessionData().at(0).GameId);
+        Assert::AreEqual(9999U, tracker2.SessionData().at(1).GameId);
+
+        // compacted data is written to a temporary item, then moved over the original
+        Assert::IsFalse(tracker2.mockStorage.HasStoredData(StorageItemType::SessionStats, L"User.tmp"));
+    }
+
+    TEST_METHOD(TestCompactionKeepsGamesWithoutPlaytime)
+    {
+        // corrupt line forces compaction
+        SessionTrackerHarness tracker;
+        tracker.MockStoredData("1234:1534000000:1732:69003708\n"
+                               "5555:1534000500:0:80b9012b\n"
+                               "1234:garbage\n");
+        tracker.Initialize("User");
+
+        const std::string& sCompactedData = tracker.GetStoredData();
+        Assert::AreEqual({ 2 }, std::count(sCompactedData.begin(), sCompactedData.end(), '\n'));
+        Assert::IsFalse(tracker.mockStorage.HasStoredData(StorageItemType::SessionStats, L"User.tmp"));
+
+        SessionTrackerHarness tracker2;
+        tracker2.MockStoredData(sCompactedData);
+        tracker2.Initialize("User");
+
+        Assert::AreEqual({ 2U }, tracker2.SessionData().size());
+        Assert::AreEqual(5555U, tracker2.SessionData().at(0).GameId);
+        Assert::AreEqual(0U, static_cast<unsigned int>(tracker2.GetTotalPlaytime(5555U).count()));
+        Assert::AreEqual(1234U, tracker2.SessionData().at(1).GameId);
+        Assert::AreEqual(1732U, static_cast<unsigned int>(tracker2.GetTotalPlaytime(1234U).count()));
+    }
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(TestLoadLargeLegacyFile)
+        TEST_IGNORE()
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(TestLoadLargeLegacyFile)
+    {
+        constexpr unsigned int nGames = 1000;
+        constexpr unsigned int nSessionsPerGame = 100;
+
+        std::string sInitialValue;
+        sInitialValue.reserve(nGames * nSessionsPerGame * 32);
+        for (unsigned int nSession = 0; nSession < nSessionsPerGame; ++nSession)
+        {
+            for (unsigned int nGameId = 1; nGameId <= nGames; ++nGameId)
+            {
+                auto sLine = ra::StringPrintf("%u:%u:60:", nGameId, 1534000000U + nSession * 3600U + nGameId);
+                const auto sMD5 = RAGenerateMD5(sLine);
+                sLine.push_back(sMD5.front());
+                sLine.push_back(sMD5.back());
+                sLine.push_back('\n');
+                sInitialValue.append(sLine);
+            }
+        }
+
+        SessionTrackerHarness tracker;
+        tracker.MockStoredData(sInitialValue);
+
+        const auto tStart = std::chrono::steady_clock::now();
+        tracker.Initialize("User");
+        const auto tElapsed = std::chrono::steady_clock::now() - tStart;
+
+        Assert::AreEqual({ nGames }, tracker.SessionData().size());
+        Assert::AreEqual(nGames, tracker.SessionData().front().GameId);
+        for (unsigned int nGameId = 1; nGameId <= nGames; ++nGameId)
+            Assert::AreEqual(nSessionsPerGame * 60U, static_cast<unsigned int>(tracker.GetTotalPlaytime(nGameId).count()));
+
+        const std::string& sCompactedData = tracker.GetStoredData();
+        Assert::AreEqual({ nGames }, gsl::narrow_cast<size_t>(std::count(sCompactedData.begin(), sCompactedData.end(), '\n')));
+
+        const auto tReloadStart = std::chrono::steady_clock::now();
+        SessionTrackerHarness tracker2;
+        tracker2.MockStoredData(sCompactedData);
+        tracker2.Initialize("User");
+        const auto tReloadElapsed = std::chrono::steady_clock::now() - tReloadStart;
+        Assert::AreEqual({ nGames }, tracker2.SessionData().size());
+
+        Logger::WriteMessage(ra::StringPrintf("%u legacy entries: migrate %llms, reload %llms\n", nGames * nSessionsPerGame,
+            std::chrono::duration_cast<std::chrono::milliseconds>(tElapsed).count(),
+            std::chrono::duration_cast<std::chrono::milliseconds>(tReloadElapsed).count()).c_str());
+    }
+
     TEST_METHOD(TestMultipleSessions)
     {
-        std::string sInitialValue("1234:1534000000:1732:f5\n");
+        std::string sInitialValue("1234:1534000000:1732:69003708\n");
         SessionTrackerHarness tracker;
         tracker.MockStoredData(sInitialValue);
 
@@ -189,12 +358,12 @@ public:
         // after two minutes, the callback will be called again, and a new entry added to the file
         tracker.mockClock.AdvanceTime(std::chrono::seconds(120));
         tracker.mockThreadPool.AdvanceTime(std::chrono::seconds(120));
-        Assert::AreEqual(std::string("1234:1534000000:1732:f5\n1234:1534889323:150:5d\n"), tracker.GetStoredData());
+        Assert::AreEqual(std::string("1234:1534000000:1732:69003708\n1234:1534889323:150:b5defa9e\n"), tracker.GetStoredData());
 
         // end session should include time since last callback
         tracker.mockClock.AdvanceTime(std::chrono::seconds(23));
         tracker.EndSession();
-        Assert::AreEqual(std::string("1234:1534000000:1732:f5\n1234:1534889323:173:bb\n"), tracker.GetStoredData());
+        Assert::AreEqual(std::string("1234:1534000000:1732:69003708\n1234:1534889323:173:9d777d33\n"), tracker.GetStoredData());
 
         // start new session
         tracker.BeginSession(9999U);
@@ -206,12 +375,12 @@ public:
         // after two minutes, the callback will be called again, and a new entry added to the file
         tracker.mockClock.AdvanceTime(std::chrono::seconds(120));
         tracker.mockThreadPool.AdvanceTime(std::chrono::seconds(120));
-        Assert::AreEqual(std::string("1234:1534000000:1732:f5\n1234:1534889323:173:bb\n9999:1534889496:150:d0\n"), tracker.GetStoredData());
+        Assert::AreEqual(std::string("1234:1534000000:1732:69003708\n1234:1534889323:173:9d777d33\n9999:1534889496:150:dac61dcd\n"), tracker.GetStoredData());
 
         // end session should include time since last callback
         tracker.mockClock.AdvanceTime(std::chrono::seconds(19));
         tracker.EndSession();
-        Assert::AreEqual(std::string("1234:1534000000:1732:f5\n1234:1534889323:173:bb\n9999:1534889496:169:14\n"), tracker.GetStoredData());
+        Assert::AreEqual(std::string("1234:1534000000:1732:69003708\n1234:1534889323:173:9d777d33\n9999:1534889496:169:094218dd\n"), tracker.GetStoredData());
     }
 };
 
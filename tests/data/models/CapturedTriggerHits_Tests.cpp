@@ -2,6 +2,9 @@
 
 #include "data\models\CapturedTriggerHits.hh"
 
+#include "RA_md5factory.h"
+#include "RA_StringUtils.h"
+
 #include "tests\mocks\MockConsoleContext.hh"
 #include "tests\mocks\MockEmulatorContext.hh"
 
@@ -216,6 +219,163 @@ public:
         Assert::AreEqual(0U, value->conditions->conditions->current_hits);
     }
 
+    TEST_METHOD(TestGetFingerprint)
+    {
+        // matches xxHash64 for short strings
+        Assert::AreEqual({ 0xEF46DB3751D8E999ULL }, CapturedTriggerHits::GetFingerprint(""));
+        Assert::AreEqual({ 0xD24EC4F1A98C6E5BULL }, CapturedTriggerHits::GetFingerprint("a"));
+        Assert::AreEqual({ 0x44BC2CF5AD770999ULL }, CapturedTriggerHits::GetFingerprint("abc"));
+
+        // every character should affect the result
+        const std::string sDefinition = "0xH1234=1_0xH2345=2_0xH3456=3_0xH4567=4";
+        const auto nFingerprint = CapturedTriggerHits::GetFingerprint(sDefinition);
+        for (size_t i = 0; i < sDefinition.length(); ++i)
+        {
+            std::string sModified = sDefinition;
+            sModified.at(i) ^= 1;
+            Assert::AreNotEqual(nFingerprint, CapturedTriggerHits::GetFingerprint(sModified));
+        }
+
+        Assert::AreNotEqual(nFingerprint, CapturedTriggerHits::GetFingerprint(sDefinition + "_"));
+        Assert::AreNotEqual(nFingerprint, CapturedTriggerHits::GetFingerprint(sDefinition.substr(1)));
+    }
+
+    TEST_METHOD(TestRestoreTriggerFingerprint)
+    {
+        const std::string trigger_definition = "0xH1234=1_0xH2345=2";
+        char buffer[512];
+        rc_trigger_t* trigger = rc_parse_trigger(buffer, trigger_definition.c_str(), NULL, 0);
+        CapturedTriggerHits hits;
+
+        trigger->requirement->conditions->current_hits = 6U;
+        trigger->requirement->conditions->next->current_hits = 7U;
+        trigger->has_hits = 1;
+
+        hits.Capture(trigger, CapturedTriggerHits::GetFingerprint(trigger_definition));
+
+        trigger->requirement->conditions->current_hits = 8U;
+        trigger->requirement->conditions->next->current_hits = 15U;
+
+        Assert::IsFalse(hits.Restore(trigger, CapturedTriggerHits::GetFingerprint("0xH1234=1_0xH2345=3")));
+        Assert::AreEqual(8U, trigger->requirement->conditions->current_hits);
+
+        Assert::IsTrue(hits.Restore(trigger, trigger_definition));
+        Assert::AreEqual(6U, trigger->requirement->conditions->current_hits);
+        Assert::AreEqual(7U, trigger->requirement->conditions->next->current_hits);
+
+        // capturing again should reuse the existing array
+        trigger->requirement->conditions->current_hits = 9U;
+        hits.Capture(trigger, trigger_definition);
+        trigger->requirement->conditions->current_hits = 1U;
+        Assert::IsTrue(hits.Restore(trigger, trigger_definition));
+        Assert::AreEqual(9U, trigger->requirement->conditions->current_hits);
+        Assert::AreEqual(7U, trigger->requirement->conditions->next->current_hits);
+
+        hits.Reset();
+        Assert::IsFalse(hits.Restore(trigger, trigger_definition));
+    }
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(TestCapturePerformance)
+        TEST_IGNORE()
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(TestCapturePerformance)
+    {
+        // simulate deactivating and reactivating 5000 achievements and 1000 leaderboards
+        constexpr int nAchievements = 5000;
+        constexpr int nLeaderboards = 1000;
+        constexpr int nCycles = 10;
+
+        struct ParsedTrigger
+        {
+            std::string sDefinition;
+            uint64_t nFingerprint = 0;
+            std::vector<unsigned char> vBuffer;
+            rc_trigger_t* pTrigger = nullptr;
+            CapturedTriggerHits pHits;
+        };
+
+        struct ParsedValue
+        {
+            std::string sDefinition;
+            uint64_t nFingerprint = 0;
+            std::vector<unsigned char> vBuffer;
+            rc_value_t* pValue = nullptr;
+            CapturedTriggerHits pHits;
+        };
+
+        std::vector<ParsedTrigger> vTriggers(nAchievements + nLeaderboards * 3);
+        int nId = 0;
+        for (auto& pTrigger : vTriggers)
+        {
+            pTrigger.sDefinition = ra::StringPrintf("0xH%04x=%d_0xH%04x>%d_d0xX%04x!=0xX%04x.%d._R:0xH%04x=1",
+                                                    nId & 0xFFFF, nId % 100, (nId + 1) & 0xFFFF, nId % 7,
+                                                    (nId + 2) & 0xFFFF, (nId + 2) & 0xFFFF, nId % 20 + 1, (nId + 3) & 0xFFFF);
+            pTrigger.nFingerprint = CapturedTriggerHits::GetFingerprint(pTrigger.sDefinition);
+            pTrigger.vBuffer.resize(rc_trigger_size(pTrigger.sDefinition.c_str()));
+            pTrigger.pTrigger = rc_parse_trigger(pTrigger.vBuffer.data(), pTrigger.sDefinition.c_str(), nullptr, 0);
+            Expects(pTrigger.pTrigger != nullptr);
+            ++nId;
+        }
+
+        std::vector<ParsedValue> vValues(nLeaderboards);
+        for (auto& pValue : vValues)
+        {
+            pValue.sDefinition = ra::StringPrintf("M:0xH%04x*2_0xH%04x$M:0xX%04x", nId & 0xFFFF, (nId + 1) & 0xFFFF, (nId + 2) & 0xFFFF);
+            pValue.nFingerprint = CapturedTriggerHits::GetFingerprint(pValue.sDefinition);
+            pValue.vBuffer.resize(rc_value_size(pValue.sDefinition.c_str()));
+            pValue.pValue = rc_parse_value(pValue.vBuffer.data(), pValue.sDefinition.c_str(), nullptr, 0);
+            Expects(pValue.pValue != nullptr);
+            ++nId;
+        }
+
+        const auto tStart = std::chrono::steady_clock::now();
+        for (int nCycle = 1; nCycle <= nCycles; ++nCycle)
+        {
+            for (auto& pTrigger : vTriggers)
+            {
+                pTrigger.pTrigger->requirement->conditions->current_hits = nCycle;
+                pTrigger.pTrigger->has_hits = 1;
+                pTrigger.pHits.Capture(pTrigger.pTrigger, pTrigger.nFingerprint);
+            }
+            for (auto& pValue : vValues)
+            {
+                pValue.pValue->conditions->conditions->current_hits = nCycle;
+                pValue.pHits.Capture(pValue.pValue, pValue.nFingerprint);
+            }
+
+            for (auto& pTrigger : vTriggers)
+            {
+                pTrigger.pTrigger->requirement->conditions->current_hits = 0;
+                Assert::IsTrue(pTrigger.pHits.Restore(pTrigger.pTrigger, pTrigger.sDefinition));
+                Assert::AreEqual(gsl::narrow_cast<unsigned>(nCycle), pTrigger.pTrigger->requirement->conditions->current_hits);
+            }
+            for (auto& pValue : vValues)
+            {
+                pValue.pValue->conditions->conditions->current_hits = 0;
+                Assert::IsTrue(pValue.pHits.Restore(pValue.pValue, pValue.sDefinition));
+                Assert::AreEqual(gsl::narrow_cast<unsigned>(nCycle), pValue.pValue->conditions->conditions->current_hits);
+            }
+        }
+        const auto tElapsed = std::chrono::steady_clock::now() - tStart;
+
+        // for comparison, the cost of the MD5s that used to be calculated for each capture and restore
+        const auto tMD5Start = std::chrono::steady_clock::now();
+        size_t nMD5Length = 0;
+        for (int nCycle = 1; nCycle <= nCycles; ++nCycle)
+        {
+            for (const auto& pTrigger : vTriggers)
+                nMD5Length += RAGenerateMD5(pTrigger.sDefinition).length() + RAGenerateMD5(pTrigger.sDefinition).length();
+            for (const auto& pValue : vValues)
+                nMD5Length += RAGenerateMD5(pValue.sDefinition).length() + RAGenerateMD5(pValue.sDefinition).length();
+        }
+        const auto tMD5Elapsed = std::chrono::steady_clock::now() - tMD5Start;
+        Assert::AreEqual(nCycles * (vTriggers.size() + vValues.size()) * 64, nMD5Length);
+
+        const auto nMilliseconds = gsl::narrow_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(tElapsed).count());
+        const auto nMD5Milliseconds = gsl::narrow_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(tMD5Elapsed).count());
+        Logger::WriteMessage(ra::StringPrintf("%d capture/restore cycles of %d achievements and %d leaderboards: %dms (MD5 alone: %dms)\n",
+                                              nCycles, nAchievements, nLeaderboards, nMilliseconds, nMD5Milliseconds).c_str());
+    }
 };
 
 } // namespace tests
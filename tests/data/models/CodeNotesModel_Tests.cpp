@@ -2,14 +2,19 @@
 
 #include "data\models\CodeNotesModel.hh"
 
+#include "api\impl\CodeNotesCache.hh"
+
 #include "services\impl\StringTextWriter.hh"
 
+#include "ui\viewmodels\MessageBoxViewModel.hh"
+
 #include "tests\RA_UnitTestHelpers.h"
 #include "tests\data\DataAsserts.hh"
 
 #include "tests\mocks\MockConsoleContext.hh"
 #include "tests\mocks\MockDesktop.hh"
 #include "tests\mocks\MockEmulatorContext.hh"
+#include "tests\mocks\MockLocalStorage.hh"
 #include "tests\mocks\MockServer.hh"
 #include "tests\mocks\MockThreadPool.hh"
 #include "tests\mocks\MockUserContext.hh"
@@ -31,22 +36,78 @@ private:
         ra::data::context::mocks::MockConsoleContext mockConsoleContext;
         ra::data::context::mocks::MockEmulatorContext mockEmulatorContext;
         ra::data::context::mocks::MockUserContext mockUserContext;
+        ra::services::mocks::MockLocalStorage mockLocalStorage;
         ra::services::mocks::MockThreadPool mockThreadPool;
         ra::ui::mocks::MockDesktop mockDesktop;
 
         std::map<unsigned, std::wstring> mNewNotes;
+        unsigned nReloadCount = 0;
+        unsigned nLoadedCount = 0;
 
         void InitializeCodeNotes(unsigned nGameId)
+        {
+            BeginRefresh(nGameId);
+
+            mockThreadPool.ExecuteNextTask(); // FetchCodeNotes is async
+        }
+
+        void BeginRefresh(unsigned nGameId)
         {
             mNewNotes.clear();
+            nReloadCount = 0;
+            nLoadedCount = 0;
 
             CodeNotesModel::Refresh(nGameId,
                 [this](ra::ByteAddress nAddress, const std::wstring& sNewNote) {
                     mNewNotes[nAddress] = sNewNote;
                 },
-                []() {});
+                [this]() { ++nReloadCount; },
+                [this]() { ++nLoadedCount; });
+        }
 
-            mockThreadPool.ExecuteNextTask(); // FetchCodeNotes is async
+        void ExecutePendingTasks()
+        {
+            // parsing a large batch of notes may queue helper tasks ahead of the server request
+            while (mockThreadPool.NextTaskDelay() == std::chrono::milliseconds(0))
+                mockThreadPool.ExecuteNextTask();
+        }
+
+        void MockCachedNotes(unsigned nGameId, const std::vector<ra::api::FetchCodeNotes::Response::CodeNote>& vNotes)
+        {
+            std::string sCache;
+            ra::services::impl::StringTextWriter pWriter(sCache);
+            ra::api::impl::CodeNotesCache::WriteHeader(pWriter, vNotes.size(), HashNotes(vNotes));
+            for (const auto& pNote : vNotes)
+            {
+                const auto sNote = ra::Narrow(pNote.Note);
+                ra::api::impl::CodeNotesCache::WriteNote(pWriter, pNote.Address, pNote.Author.c_str(),
+                                                         pNote.Author.length(), sNote.c_str(), sNote.length());
+            }
+
+            mockLocalStorage.MockStoredData(ra::services::StorageItemType::CodeNotes, std::to_wstring(nGameId), sCache);
+        }
+
+        void MockServerNotes(const std::vector<ra::api::FetchCodeNotes::Response::CodeNote>& vNotes)
+        {
+            mockServer.HandleRequest<ra::api::FetchCodeNotes>([vNotes](const ra::api::FetchCodeNotes::Request&, ra::api::FetchCodeNotes::Response& response)
+            {
+                response.Notes = vNotes;
+                response.Hash = HashNotes(vNotes);
+                response.Result = ra::api::ApiResult::Success;
+                return true;
+            });
+        }
+
+        static uint32_t HashNotes(const std::vector<ra::api::FetchCodeNotes::Response::CodeNote>& vNotes)
+        {
+            uint32_t nHash = ra::api::impl::CodeNotesCache::EmptyHash;
+            for (const auto& pNote : vNotes)
+            {
+                const auto sNote = ra::Narrow(pNote.Note);
+                nHash = ra::api::impl::CodeNotesCache::HashNote(nHash, pNote.Address, pNote.Author.c_str(),
+                                                                pNote.Author.length(), sNote.c_str(), sNote.length());
+            }
+            return nHash;
         }
 
         void MonitorCodeNoteChanges()
@@ -142,16 +203,15 @@ public:
         });
 
         notes.InitializeCodeNotes(1U);
-        Assert::AreEqual({3U}, notes.mNewNotes.size());
 
-        notes.AssertNote(1234U, L"Note1");
-        Assert::AreEqual(std::wstring(L"Note1"), notes.mNewNotes[1234U]);
+        // a single reloaded event is raised instead of a changed event for each note
+        Assert::AreEqual({0U}, notes.mNewNotes.size());
+        Assert::AreEqual(1U, notes.nReloadCount);
+        Assert::AreEqual({3U}, notes.CodeNoteCount());
 
+        notes.AssertNote(1234U, L"Note1");
         notes.AssertNote(2345U, L"Note2");
-        Assert::AreEqual(std::wstring(L"Note2"), notes.mNewNotes[2345U]);
-
         notes.AssertNote(3456U, L"Note3");
-        Assert::AreEqual(std::wstring(L"Note3"), notes.mNewNotes[3456U]);
 
         const auto* pNote4 = notes.FindCodeNote(4567U);
         Assert::IsNull(pNote4);
@@ -162,6 +222,485 @@ public:
         Assert::AreEqual({0U}, notes.mNewNotes.size());
     }
 
+    TEST_METHOD(TestLoadCodeNotesUnsorted)
+    {
+        CodeNotesModelHarness notes;
+        notes.mockServer.HandleRequest<ra::api::FetchCodeNotes>([](const ra::api::FetchCodeNotes::Request&, ra::api::FetchCodeNotes::Response& response)
+        {
+            response.Notes.emplace_back(ra::api::FetchCodeNotes::Response::CodeNote{ 3456, L"Note3", "Author" });
+            response.Notes.emplace_back(ra::api::FetchCodeNotes::Response::CodeNote{ 1234, L"Note1", "Author" });
+            response.Notes.emplace_back(ra::api::FetchCodeNotes::Response::CodeNote{ 2345, L"Note2", "Author" });
+            response.Notes.emplace_back(ra::api::FetchCodeNotes::Response::CodeNote{ 1234, L"Note1b", "Author2" });
+            return true;
+        });
+
+        notes.InitializeCodeNotes(1U);
+        Assert::AreEqual(1U, notes.nReloadCount);
+        Assert::AreEqual({3U}, notes.CodeNoteCount());
+
+        // duplicate address keeps the last note
+        std::string sAuthor;
+        const auto* pNote = notes.FindCodeNote(1234U, sAuthor);
+        Assert::IsNotNull(pNote);
+        Ensures(pNote != nullptr);
+        Assert::AreEqual(std::wstring(L"Note1b"), *pNote);
+        Assert::AreEqual(std::string("Author2"), sAuthor);
+
+        Assert::AreEqual(1234U, notes.FirstCodeNoteAddress());
+        Assert::AreEqual(2345U, notes.GetNextNoteAddress(1234U));
+        Assert::AreEqual(3456U, notes.GetNextNoteAddress(2345U));
+        Assert::AreEqual(0xFFFFFFFFU, notes.GetNextNoteAddress(3456U));
+    }
+
+    TEST_METHOD(TestLoadCodeNotesPointer)
+    {
+        CodeNotesModelHarness notes;
+        notes.mockServer.HandleRequest<ra::api::FetchCodeNotes>([](const ra::api::FetchCodeNotes::Request&, ra::api::FetchCodeNotes::Response& response)
+        {
+            response.Notes.emplace_back(ra::api::FetchCodeNotes::Response::CodeNote{ 1234, L"Note1", "Author" });
+            response.Notes.emplace_back(ra::api::FetchCodeNotes::Response::CodeNote{ 2345,
+                L"Pointer (16-bit)\n+0x10 = Health\n+0x14 = Lives", "Author" });
+            return true;
+        });
+
+        notes.InitializeCodeNotes(1U);
+        notes.DoFrame();
+
+        notes.AssertNote(1234U, L"Note1");
+        notes.AssertIndirectNote(2345U, 0x10, L"Health");
+        notes.AssertIndirectNote(2345U, 0x14, L"Lives");
+
+        // pointer base is $0000, so derived notes should be found
+        notes.AssertNote(0x10U, L"Health");
+        Assert::AreEqual(2345U, notes.GetIndirectSource(0x14U));
+    }
+
+    TEST_METHOD(TestLoadCodeNotesPendingChanges)
+    {
+        CodeNotesModelHarness notes;
+        notes.mockServer.HandleRequest<ra::api::FetchCodeNotes>([](const ra::api::FetchCodeNotes::Request&, ra::api::FetchCodeNotes::Response& response)
+        {
+            response.Notes.emplace_back(ra::api::FetchCodeNotes::Response::CodeNote{ 1234, L"Note1", "Author" });
+            response.Notes.emplace_back(ra::api::FetchCodeNotes::Response::CodeNote{ 2345, L"Note2", "Author" });
+            return true;
+        });
+        notes.mockUserContext.Initialize("User", "ApiToken");
+
+        notes.Refresh(1U,
+            [&notes](ra::ByteAddress nAddress, const std::wstring& sNewNote) {
+                notes.mNewNotes[nAddress] = sNewNote;
+            },
+            [&notes]() { ++notes.nReloadCount; },
+            []() {});
+
+        // changes made while the server request is outstanding are applied after the server notes are loaded
+        notes.SetCodeNote(2345U, L"Local2");
+        notes.SetCodeNote(3456U, L"Local3");
+        Assert::AreEqual({0U}, notes.CodeNoteCount());
+
+        notes.mockThreadPool.ExecuteNextTask();
+        Assert::AreEqual(1U, notes.nReloadCount);
+        Assert::AreEqual({3U}, notes.CodeNoteCount());
+        Assert::AreEqual(AssetChanges::Unpublished, notes.GetChanges());
+
+        notes.AssertNote(1234U, L"Note1");
+        Assert::IsFalse(notes.IsNoteModified(1234U));
+
+        notes.AssertNote(2345U, L"Local2");
+        Assert::IsTrue(notes.IsNoteModified(2345U));
+        const auto* pServerNote = notes.GetServerCodeNote(2345U);
+        Assert::IsNotNull(pServerNote);
+        Ensures(pServerNote != nullptr);
+        Assert::AreEqual(std::wstring(L"Note2"), *pServerNote);
+
+        notes.AssertNote(3456U, L"Local3");
+        Assert::IsTrue(notes.IsNoteModified(3456U));
+
+        // only the pending changes raise changed events
+        Assert::AreEqual({2U}, notes.mNewNotes.size());
+        Assert::AreEqual(std::wstring(L"Local2"), notes.mNewNotes[2345U]);
+        Assert::AreEqual(std::wstring(L"Local3"), notes.mNewNotes[3456U]);
+    }
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(TestLoadCodeNotesLarge)
+        TEST_IGNORE()
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(TestLoadCodeNotesLarge)
+    {
+        // 50000 notes, every tenth of which is a pointer
+        constexpr unsigned nNoteCount = 50000;
+        std::vector<ra::api::FetchCodeNotes::Response::CodeNote> vServerNotes;
+        vServerNotes.reserve(nNoteCount);
+        for (unsigned i = 0; i < nNoteCount; ++i)
+        {
+            const auto nAddress = 0x10000 + i * 4;
+            if (i % 10 == 0)
+            {
+                vServerNotes.emplace_back(ra::api::FetchCodeNotes::Response::CodeNote{ nAddress,
+                    ra::StringPrintf(L"Pointer %u (32-bit)\n+0x10 = Health [16-bit]\n+0x14 = Lives", i), "Author" });
+            }
+            else
+            {
+                vServerNotes.emplace_back(ra::api::FetchCodeNotes::Response::CodeNote{ nAddress,
+                    ra::StringPrintf(L"[16-bit] Note %u", i), "Author" });
+            }
+        }
+
+        // reverse the order so the notes have to be sorted and every per-note insert is at the front
+        std::reverse(vServerNotes.begin(), vServerNotes.end());
+
+        CodeNotesModelHarness notes;
+        notes.mockServer.HandleRequest<ra::api::FetchCodeNotes>([&vServerNotes](const ra::api::FetchCodeNotes::Request&, ra::api::FetchCodeNotes::Response& response)
+        {
+            response.Notes = vServerNotes;
+            return true;
+        });
+
+        const auto tStart = std::chrono::steady_clock::now();
+        notes.InitializeCodeNotes(1U);
+        const auto tElapsed = std::chrono::steady_clock::now() - tStart;
+
+        Assert::AreEqual({nNoteCount}, notes.CodeNoteCount());
+        Assert::AreEqual(1U, notes.nReloadCount);
+        Assert::AreEqual({0U}, notes.mNewNotes.size());
+        notes.AssertNote(0x10004U, L"[16-bit] Note 1", MemSize::SixteenBit);
+        notes.AssertIndirectNote(0x10000U + 9990 * 4, 0x10, L"Health [16-bit]");
+        Assert::AreEqual(0x10004U, notes.GetNextNoteAddress(0x10000U));
+
+        // compare to adding the notes one at a time
+        CodeNotesModelHarness notes2;
+        notes2.SetGameId(1U);
+        notes2.MonitorCodeNoteChanges();
+
+        const auto tStart2 = std::chrono::steady_clock::now();
+        for (const auto& pNote : vServerNotes)
+            notes2.AddCodeNote(pNote.Address, pNote.Author, pNote.Note);
+        const auto tElapsed2 = std::chrono::steady_clock::now() - tStart2;
+
+        Assert::AreEqual({nNoteCount}, notes2.CodeNoteCount());
+
+        Logger::WriteMessage(ra::StringPrintf("%u notes: bulk load %llms, individual %llms\n", nNoteCount,
+            std::chrono::duration_cast<std::chrono::milliseconds>(tElapsed).count(),
+            std::chrono::duration_cast<std::chrono::milliseconds>(tElapsed2).count()).c_str());
+    }
+
+    TEST_METHOD(TestLoadCodeNotesFromCache)
+    {
+        const std::vector<ra::api::FetchCodeNotes::Response::CodeNote> vNotes{
+            { 1234, L"Note1", "Author" },
+            { 2345, L"Note2", "Author" },
+            { 3456, L"Note3", "Author" },
+        };
+
+        CodeNotesModelHarness notes;
+        notes.MockCachedNotes(1U, vNotes);
+        notes.MockServerNotes(vNotes);
+
+        // cached notes are available immediately
+        notes.BeginRefresh(1U);
+        Assert::AreEqual(1U, notes.nLoadedCount);
+        Assert::AreEqual(1U, notes.nReloadCount);
+        Assert::AreEqual({3U}, notes.CodeNoteCount());
+        Assert::AreEqual({0U}, notes.mNewNotes.size());
+        notes.AssertNote(1234U, L"Note1");
+        notes.AssertNote(2345U, L"Note2");
+        notes.AssertNote(3456U, L"Note3");
+
+        // server notes match cached notes, nothing changes
+        notes.ExecutePendingTasks();
+        Assert::AreEqual(1U, notes.nLoadedCount);
+        Assert::AreEqual(1U, notes.nReloadCount);
+        Assert::AreEqual({3U}, notes.CodeNoteCount());
+        Assert::AreEqual({0U}, notes.mNewNotes.size());
+        Assert::AreEqual(AssetChanges::None, notes.GetChanges());
+    }
+
+    TEST_METHOD(TestLoadCodeNotesFromCacheServerChanged)
+    {
+        CodeNotesModelHarness notes;
+        notes.MockCachedNotes(1U, {
+            { 1234, L"Note1", "Author" },
+            { 2345, L"Note2", "Author" },
+            { 3456, L"Note3", "Author" },
+            { 4567, L"Note4", "Author" },
+        });
+        notes.MockServerNotes({
+            { 1234, L"Note1", "Author" },
+            { 2345, L"Note2b", "Author2" }, // changed
+            { 3000, L"Note5", "Author" },   // added
+            { 4567, L"Note4", "Author3" },  // author changed
+            // 3456 removed
+        });
+
+        notes.BeginRefresh(1U);
+        Assert::AreEqual({4U}, notes.CodeNoteCount());
+
+        // only the differences are reported
+        notes.ExecutePendingTasks();
+        Assert::AreEqual(1U, notes.nLoadedCount);
+        Assert::AreEqual(1U, notes.nReloadCount);
+        Assert::AreEqual({4U}, notes.CodeNoteCount());
+        Assert::AreEqual({3U}, notes.mNewNotes.size());
+        Assert::AreEqual(std::wstring(L"Note2b"), notes.mNewNotes[2345U]);
+        Assert::AreEqual(std::wstring(L"Note5"), notes.mNewNotes[3000U]);
+        Assert::AreEqual(std::wstring(), notes.mNewNotes[3456U]);
+        Assert::AreEqual(AssetChanges::None, notes.GetChanges());
+
+        notes.AssertNote(1234U, L"Note1");
+        notes.AssertNote(2345U, L"Note2b");
+        notes.AssertNote(3000U, L"Note5");
+        notes.AssertNoNote(3456U);
+        notes.AssertNote(4567U, L"Note4");
+
+        std::string sAuthor;
+        notes.FindCodeNote(2345U, sAuthor);
+        Assert::AreEqual(std::string("Author2"), sAuthor);
+        notes.FindCodeNote(4567U, sAuthor);
+        Assert::AreEqual(std::string("Author3"), sAuthor);
+        Assert::AreEqual(3000U, notes.GetNextNoteAddress(2345U));
+    }
+
+    TEST_METHOD(TestLoadCodeNotesFromCachePointerChanged)
+    {
+        CodeNotesModelHarness notes;
+        notes.MockCachedNotes(1U, {
+            { 4, L"Pointer (8-bit)\n+0x2 = Health (8-bit)", "Author" },
+        });
+        notes.MockServerNotes({
+            { 4, L"Pointer (8-bit)\n+0x2 = Lives (8-bit)", "Author" },
+        });
+
+        std::array<unsigned char, 32> memory{};
+        memory.at(4) = 16;
+        notes.mockEmulatorContext.MockMemory(memory);
+
+        notes.BeginRefresh(1U);
+        notes.DoFrame();
+        notes.AssertIndirectNote(4U, 2, L"Health (8-bit)");
+        Assert::AreEqual(std::wstring(L"Health (8-bit) [indirect]"), notes.FindCodeNote(18, MemSize::EightBit));
+
+        notes.ExecutePendingTasks();
+        notes.AssertIndirectNote(4U, 2, L"Lives (8-bit)");
+
+        // pointer is still tracked after the merge
+        memory.at(4) = 20;
+        notes.DoFrame();
+        Assert::AreEqual(std::wstring(), notes.FindCodeNote(18, MemSize::EightBit));
+        Assert::AreEqual(std::wstring(L"Lives (8-bit) [indirect]"), notes.FindCodeNote(22, MemSize::EightBit));
+    }
+
+    TEST_METHOD(TestLoadCodeNotesFromCacheServerFailed)
+    {
+        CodeNotesModelHarness notes;
+        notes.MockCachedNotes(1U, {
+            { 1234, L"Note1", "Author" },
+            { 2345, L"Note2", "Author" },
+        });
+        notes.mockServer.HandleRequest<ra::api::FetchCodeNotes>([](const ra::api::FetchCodeNotes::Request&, ra::api::FetchCodeNotes::Response& response)
+        {
+            response.Result = ra::api::ApiResult::Error;
+            response.ErrorMessage = "Timeout";
+            return true;
+        });
+
+        bool bDialogShown = false;
+        notes.mockDesktop.ExpectWindow<ra::ui::viewmodels::MessageBoxViewModel>([&bDialogShown](ra::ui::viewmodels::MessageBoxViewModel&)
+        {
+            bDialogShown = true;
+            return ra::ui::DialogResult::OK;
+        });
+
+        notes.BeginRefresh(1U);
+        notes.ExecutePendingTasks();
+
+        // cached notes are kept and the user is not interrupted
+        Assert::IsFalse(bDialogShown);
+        Assert::AreEqual(1U, notes.nLoadedCount);
+        Assert::AreEqual({2U}, notes.CodeNoteCount());
+        Assert::AreEqual({0U}, notes.mNewNotes.size());
+    }
+
+    TEST_METHOD(TestLoadCodeNotesFromCacheInvalid)
+    {
+        CodeNotesModelHarness notes;
+        notes.mockLocalStorage.MockStoredData(ra::services::StorageItemType::CodeNotes, L"1",
+            "[{\"User\":\"Author\",\"Address\":\"0x0004d2\",\"Note\":\"Note1\"}]");
+        notes.MockServerNotes({
+            { 1234, L"Note1", "Author" },
+            { 2345, L"Note2", "Author" },
+        });
+
+        // unreadable cache is ignored
+        notes.BeginRefresh(1U);
+        Assert::AreEqual(0U, notes.nLoadedCount);
+        Assert::AreEqual({0U}, notes.CodeNoteCount());
+
+        notes.ExecutePendingTasks();
+        Assert::AreEqual(1U, notes.nLoadedCount);
+        Assert::AreEqual(1U, notes.nReloadCount);
+        Assert::AreEqual({2U}, notes.CodeNoteCount());
+        Assert::AreEqual({0U}, notes.mNewNotes.size());
+    }
+
+    TEST_METHOD(TestLoadCodeNotesFromCachePendingChanges)
+    {
+        CodeNotesModelHarness notes;
+        notes.mockUserContext.Initialize("User", "ApiToken");
+        notes.MockCachedNotes(1U, {
+            { 1234, L"Note1", "Author" },
+            { 2345, L"Note2", "Author" },
+        });
+        notes.MockServerNotes({
+            { 1234, L"Note1", "Author" },
+            { 2345, L"Note2b", "Author" },
+        });
+
+        notes.BeginRefresh(1U);
+
+        // changes made while the server request is outstanding are applied immediately
+        notes.SetCodeNote(2345U, L"Local2");
+        notes.AssertNote(2345U, L"Local2");
+        Assert::IsTrue(notes.IsNoteModified(2345U));
+
+        notes.ExecutePendingTasks();
+        Assert::AreEqual({2U}, notes.CodeNoteCount());
+        Assert::AreEqual(AssetChanges::Unpublished, notes.GetChanges());
+
+        notes.AssertNote(2345U, L"Local2");
+        Assert::IsTrue(notes.IsNoteModified(2345U));
+        const auto* pServerNote = notes.GetServerCodeNote(2345U);
+        Assert::IsNotNull(pServerNote);
+        Ensures(pServerNote != nullptr);
+        Assert::AreEqual(std::wstring(L"Note2b"), *pServerNote);
+    }
+
+    TEST_METHOD(TestLoadCodeNotesFromCacheGameChanged)
+    {
+        CodeNotesModelHarness notes;
+        notes.MockCachedNotes(1U, {
+            { 1234, L"Note1", "Author" },
+        });
+        notes.mockServer.HandleRequest<ra::api::FetchCodeNotes>([](const ra::api::FetchCodeNotes::Request& request, ra::api::FetchCodeNotes::Response& response)
+        {
+            if (request.GameId == 1U)
+                response.Notes.emplace_back(ra::api::FetchCodeNotes::Response::CodeNote{ 1234, L"Note1b", "Author" });
+            else
+                response.Notes.emplace_back(ra::api::FetchCodeNotes::Response::CodeNote{ 2345, L"Note2", "Author" });
+
+            response.Hash = CodeNotesModelHarness::HashNotes(response.Notes);
+            response.Result = ra::api::ApiResult::Success;
+            return true;
+        });
+
+        notes.BeginRefresh(1U);
+        notes.AssertNote(1234U, L"Note1");
+
+        // game changes before the server responds for the first game
+        notes.BeginRefresh(2U);
+        notes.ExecutePendingTasks();
+
+        // response for the first game is discarded
+        Assert::AreEqual(1U, notes.nLoadedCount);
+        Assert::AreEqual({1U}, notes.CodeNoteCount());
+        Assert::AreEqual({0U}, notes.mNewNotes.size());
+        notes.AssertNoNote(1234U);
+        notes.AssertNote(2345U, L"Note2");
+    }
+
+    TEST_METHOD(TestLoadCodeNotesGameChanged)
+    {
+        CodeNotesModelHarness notes;
+        notes.mockServer.HandleRequest<ra::api::FetchCodeNotes>([](const ra::api::FetchCodeNotes::Request& request, ra::api::FetchCodeNotes::Response& response)
+        {
+            if (request.GameId == 1U)
+                response.Notes.emplace_back(ra::api::FetchCodeNotes::Response::CodeNote{ 1234, L"Note1", "Author" });
+            else
+                response.Notes.emplace_back(ra::api::FetchCodeNotes::Response::CodeNote{ 2345, L"Note2", "Author" });
+
+            response.Hash = CodeNotesModelHarness::HashNotes(response.Notes);
+            response.Result = ra::api::ApiResult::Success;
+            return true;
+        });
+
+        notes.BeginRefresh(1U);
+        notes.BeginRefresh(2U);
+        notes.ExecutePendingTasks();
+
+        // response for the first game is discarded, but the caller is still told the load completed
+        Assert::AreEqual(2U, notes.nLoadedCount);
+        Assert::AreEqual(1U, notes.nReloadCount);
+        Assert::AreEqual({1U}, notes.CodeNoteCount());
+        notes.AssertNoNote(1234U);
+        notes.AssertNote(2345U, L"Note2");
+    }
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(TestLoadCodeNotesFromCacheLarge)
+        TEST_IGNORE()
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(TestLoadCodeNotesFromCacheLarge)
+    {
+        // 30000 notes, every tenth of which is a pointer
+        constexpr unsigned nNoteCount = 30000;
+        std::vector<ra::api::FetchCodeNotes::Response::CodeNote> vNotes;
+        vNotes.reserve(nNoteCount);
+        for (unsigned i = 0; i < nNoteCount; ++i)
+        {
+            const auto nAddress = 0x10000 + i * 4;
+            if (i % 10 == 0)
+            {
+                vNotes.emplace_back(ra::api::FetchCodeNotes::Response::CodeNote{ nAddress,
+                    ra::StringPrintf(L"Pointer %u (32-bit)\r\n+0x10 = Health [16-bit]\r\n+0x14 = Lives", i), "Author" });
+            }
+            else
+            {
+                vNotes.emplace_back(ra::api::FetchCodeNotes::Response::CodeNote{ nAddress,
+                    ra::StringPrintf(L"[16-bit] Note %u", i), "Author" });
+            }
+        }
+
+        // one note changed on the server since the cache was written
+        auto vServerNotes = vNotes;
+        vServerNotes.at(1234).Note = L"Changed";
+
+        // game load completes as soon as the cache is read. the server response is only merged later
+        CodeNotesModelHarness notes;
+        notes.MockCachedNotes(1U, vNotes);
+        notes.MockServerNotes(vServerNotes);
+
+        const auto tStart = std::chrono::steady_clock::now();
+        notes.BeginRefresh(1U);
+        const auto tElapsed = std::chrono::steady_clock::now() - tStart;
+
+        Assert::AreEqual(1U, notes.nLoadedCount);
+        Assert::AreEqual({nNoteCount}, notes.CodeNoteCount());
+        notes.AssertIndirectNote(0x10000U + 9990 * 4, 0x10, L"Health [16-bit]");
+
+        const auto tStartMerge = std::chrono::steady_clock::now();
+        notes.ExecutePendingTasks();
+        const auto tElapsedMerge = std::chrono::steady_clock::now() - tStartMerge;
+
+        Assert::AreEqual({nNoteCount}, notes.CodeNoteCount());
+        Assert::AreEqual({1U}, notes.mNewNotes.size());
+        notes.AssertNote(0x10000U + 1234 * 4, L"Changed");
+
+        // compare to waiting for the server response without a cache
+        CodeNotesModelHarness notes2;
+        notes2.MockServerNotes(vServerNotes);
+
+        const auto tStart2 = std::chrono::steady_clock::now();
+        notes2.BeginRefresh(1U);
+        notes2.ExecutePendingTasks();
+        const auto tElapsed2 = std::chrono::steady_clock::now() - tStart2;
+
+        Assert::AreEqual(1U, notes2.nLoadedCount);
+        Assert::AreEqual({nNoteCount}, notes2.CodeNoteCount());
+
+        Logger::WriteMessage(ra::StringPrintf("%u notes: cached load %llms (merge %llms), server load %llms (excluding network)\n",
+            nNoteCount, std::chrono::duration_cast<std::chrono::milliseconds>(tElapsed).count(),
+            std::chrono::duration_cast<std::chrono::milliseconds>(tElapsedMerge).count(),
+            std::chrono::duration_cast<std::chrono::milliseconds>(tElapsed2).count()).c_str());
+    }
+
     TEST_METHOD(TestFindCodeNoteSized)
     {
         CodeNotesModelHarness notes;
@@ -864,6 +1403,163 @@ public:
         Assert::AreEqual({0U}, notes.mNewNotes.size());
     }
 
+    TEST_METHOD(TestDoFrameNestedPointer)
+    {
+        CodeNotesModelHarness notes;
+        notes.MonitorCodeNoteChanges();
+
+        std::array<unsigned char, 32> memory{};
+        for (uint8_t i = 0; i < memory.size(); i++)
+            memory.at(i) = i;
+        notes.mockEmulatorContext.MockMemory(memory);
+        memory.at(0) = 16; // start with initial value for pointer
+
+        const std::wstring sNote =
+            L"Pointer (8-bit)\n"
+            L"+0x2 = Nested pointer (8-bit)\n"
+            L"++0x1 = Value";
+        notes.AddCodeNote(0x0000, "Author", sNote);
+        notes.mNewNotes.clear();
+        notes.DoFrame();
+
+        // root pointer -> $10. nested pointer at $12 -> $12. value at $13
+        Assert::AreEqual({1U}, notes.mNewNotes.size());
+        Assert::AreEqual(std::wstring(L"Value"), notes.mNewNotes[0x13]);
+        notes.AssertNote(0x13U, L"Value");
+
+        // nested pointer changes without the root pointer changing
+        notes.mNewNotes.clear();
+        memory.at(18) = 4;
+        notes.DoFrame();
+
+        Assert::AreEqual({2U}, notes.mNewNotes.size());
+        Assert::AreEqual(std::wstring(L""), notes.mNewNotes[0x13]);
+        Assert::AreEqual(std::wstring(L"Value"), notes.mNewNotes[0x05]);
+        notes.AssertNoNote(0x13U);
+        notes.AssertNote(0x05U, L"Value");
+
+        // root pointer changes. nested pointer is now read from $0A -> $0A. value at $0B
+        notes.mNewNotes.clear();
+        memory.at(0) = 8;
+        notes.DoFrame();
+
+        Assert::AreEqual({2U}, notes.mNewNotes.size());
+        Assert::AreEqual(std::wstring(L""), notes.mNewNotes[0x05]);
+        Assert::AreEqual(std::wstring(L"Value"), notes.mNewNotes[0x0B]);
+        notes.AssertNote(0x0BU, L"Value");
+
+        // no change to pointers should not raise any events
+        notes.mNewNotes.clear();
+        notes.DoFrame();
+        Assert::AreEqual({0U}, notes.mNewNotes.size());
+    }
+
+    TEST_METHOD(TestDoFramePointerNoteReplaced)
+    {
+        CodeNotesModelHarness notes;
+        notes.MonitorCodeNoteChanges();
+
+        std::array<unsigned char, 32> memory{};
+        for (uint8_t i = 0; i < memory.size(); i++)
+            memory.at(i) = i;
+        notes.mockEmulatorContext.MockMemory(memory);
+        memory.at(0) = 16;
+        memory.at(4) = 8;
+
+        notes.AddCodeNote(0x0000, "Author", L"Pointer (8-bit)\n+1 = Small (8-bit)");
+        notes.DoFrame();
+        notes.AssertNote(0x11U, L"Small (8-bit)");
+
+        // replacing the pointer with a non-pointer note stops tracking it
+        notes.AddCodeNote(0x0000, "Author", L"Not a pointer");
+        notes.mNewNotes.clear();
+        memory.at(0) = 12;
+        notes.DoFrame();
+        Assert::AreEqual({0U}, notes.mNewNotes.size());
+        notes.AssertNoNote(0x11U);
+        notes.AssertNoNote(0x0DU);
+
+        // adding a new pointer starts tracking it
+        notes.AddCodeNote(0x0004, "Author", L"Pointer (8-bit)\n+2 = Other (8-bit)");
+        notes.mNewNotes.clear();
+        notes.DoFrame();
+        Assert::AreEqual({1U}, notes.mNewNotes.size());
+        Assert::AreEqual(std::wstring(L"Other (8-bit)"), notes.mNewNotes[0x0A]);
+        notes.AssertNote(0x0AU, L"Other (8-bit)");
+    }
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(TestDoFrameManyPointers)
+        TEST_IGNORE()
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(TestDoFrameManyPointers)
+    {
+        // 20000 notes, 500 of which are multi-level pointers
+        constexpr unsigned nNoteCount = 20000;
+        constexpr unsigned nPointerInterval = 40;
+        constexpr unsigned nFrames = 1000;
+
+        CodeNotesModelHarness notes;
+        notes.MonitorCodeNoteChanges();
+
+        std::vector<unsigned char> memory(0x10000);
+        notes.mockEmulatorContext.MockMemory(memory);
+
+        for (unsigned i = 0; i < nNoteCount; ++i)
+        {
+            const auto nAddress = 0x100 + i * 2;
+            if (i % nPointerInterval == 0)
+            {
+                notes.AddCodeNote(nAddress, "Author",
+                    L"Pointer (16-bit)\n"
+                    L"+0x10 = Nested pointer (16-bit)\n"
+                    L"++0x04 = Value\n"
+                    L"+0x20 = Other");
+
+                // point each root pointer at a different block of memory
+                memory.at(nAddress + 1) = gsl::narrow_cast<unsigned char>(0xA0 + (i / nPointerInterval) % 0x50);
+            }
+            else
+            {
+                notes.AddCodeNote(nAddress, "Author", ra::StringPrintf(L"Note %u", i));
+            }
+        }
+
+        notes.DoFrame();
+        notes.mNewNotes.clear();
+
+        // move one pointer per frame
+        const auto tStart = std::chrono::steady_clock::now();
+        for (unsigned nFrame = 0; nFrame < nFrames; ++nFrame)
+        {
+            ++memory.at(0x100);
+            notes.DoFrame();
+        }
+        const auto tElapsed = std::chrono::steady_clock::now() - tStart;
+
+        // each frame, the first pointer moves (only the low byte is incremented, so it wraps)
+        Assert::IsFalse(notes.mNewNotes.empty());
+        Assert::AreEqual(std::wstring(L"Other"), notes.mNewNotes[0xA000 + (nFrames % 0x100) + 0x20]);
+
+        // compare to checking every note and recursively updating each pointer
+        const auto& pEmulatorContext = notes.mockEmulatorContext;
+        const auto tStart2 = std::chrono::steady_clock::now();
+        for (unsigned nFrame = 0; nFrame < nFrames; ++nFrame)
+        {
+            ++memory.at(0x100);
+            notes.EnumerateCodeNotes([&pEmulatorContext](ra::ByteAddress nAddress, const CodeNoteModel& pNote) {
+                if (pNote.IsPointer())
+                    const_cast<CodeNoteModel&>(pNote).UpdateRawPointerValue(nAddress, pEmulatorContext, nullptr);
+                return true;
+            }, false);
+        }
+        const auto tElapsed2 = std::chrono::steady_clock::now() - tStart2;
+
+        Logger::WriteMessage(ra::StringPrintf("%u notes, %u pointers, %u frames: pointer slots %llms, full scan %llms\n",
+            nNoteCount, nNoteCount / nPointerInterval, nFrames,
+            std::chrono::duration_cast<std::chrono::milliseconds>(tElapsed).count(),
+            std::chrono::duration_cast<std::chrono::milliseconds>(tElapsed2).count()).c_str());
+    }
+
     TEST_METHOD(TestDoFrameRealAddressConversion)
     {
         CodeNotesModelHarness notes;
@@ -29,7 +29,11 @@ public:
 
     void SetName(std::wstring&& sName) noexcept { m_sName = std::move(sName); }
 
-    void ResetMemoryRegions() noexcept { m_vRegions.clear(); }
+    GSL_SUPPRESS_F6 void ResetMemoryRegions() noexcept
+    {
+        m_vRegions.clear();
+        UpdateAddressTranslation();
+    }
 
     void AddMemoryRegion(ra::ByteAddress nStartAddress, ra::ByteAddress nEndAddress, 
         AddressType nAddressType, const std::string& sDescription = "")
@@ -46,6 +50,8 @@ public:
         pRegion.RealAddress = nRealAddress;
         pRegion.Type = nAddressType;
         pRegion.Description = sDescription;
+
+        UpdateAddressTranslation();
     }
 
 private:
@@ -53,6 +53,30 @@ public:
         return vResults.size() - nInitialSize;
     }
 
+    size_t GetDirectoriesInDirectory(const std::wstring& sDirectory, _Inout_ std::vector<std::wstring>& vResults) const override
+    {
+        const size_t nInitialSize = vResults.size();
+
+        std::wstring sPrefix = sDirectory;
+        if (sPrefix.empty() || sPrefix.back() != '\\')
+            sPrefix.push_back('\\');
+
+        for (const auto& sSubDirectory : m_vDirectories)
+        {
+            if (sSubDirectory.length() <= sPrefix.length() || sSubDirectory.compare(0, sPrefix.length(), sPrefix) != 0)
+                continue;
+
+            std::wstring sName(sSubDirectory, sPrefix.length());
+            if (sName.back() == '\\')
+                sName.pop_back();
+
+            if (!sName.empty() && sName.find('\\') == std::wstring::npos)
+                vResults.push_back(sName);
+        }
+
+        return vResults.size() - nInitialSize;
+    }
+
     /// <summary>
     /// Mocks the contents of a file.
     /// </summary>
@@ -62,6 +86,7 @@ public:
     {
         m_mFileSizes.erase(sPath);
         m_mFileContents.insert_or_assign(sPath, sContents);
+        OnFileChanged(sPath);
     }
 
     const std::string& GetFileContents(const std::wstring& sPath)
@@ -114,13 +139,24 @@ public:
     void MockLastModified(const std::wstring& sPath, std::chrono::system_clock::time_point tLastModified)
     {
         m_mFileModifiedTimes.insert_or_assign(sPath, tLastModified);
+        OnFileChanged(sPath);
     }
 
-    bool DeleteFile(const std::wstring& sPath) const noexcept override
+    uint32_t GetDirectoryChangeCount(const std::wstring& sDirectory) const override
+    {
+        const auto pIter = m_mDirectoryChangeCounts.find(sDirectory);
+        return (pIter != m_mDirectoryChangeCounts.end()) ? pIter->second : 0;
+    }
+
+    bool DeleteFile(const std::wstring& sPath) const override
     {
         m_mFileSizes.erase(sPath);
         m_mFileModifiedTimes.erase(sPath);
-        return m_mFileContents.erase(sPath) != 0;
+        if (m_mFileContents.erase(sPath) == 0)
+            return false;
+
+        OnFileChanged(sPath);
+        return true;
     }
 
     bool MoveFile(const std::wstring& sOldPath, const std::wstring& sNewPath) const override
@@ -129,6 +165,10 @@ public:
         if (hNode.empty())
             return false;
 
+        // replace any existing file at the destination
+        m_mFileContents.erase(sNewPath);
+        m_mFileSizes.erase(sNewPath);
+
         hNode.key() = sNewPath;
         (void)m_mFileContents.insert(std::move(hNode));
 
@@ -139,6 +179,8 @@ public:
             (void)m_mFileSizes.insert(std::move(hNode2));
         }
 
+        OnFileChanged(sOldPath);
+        OnFileChanged(sNewPath);
         return true;
     }
 
@@ -154,6 +196,7 @@ public:
         if (hNode2 != m_mFileSizes.end())
             m_mFileSizes.insert_or_assign(sNewPath, hNode2->second);
 
+        OnFileChanged(sNewPath);
         return true;
     }
 
@@ -171,6 +214,8 @@ public:
     {
         m_mFileSizes.erase(sPath);
 
+        OnFileChanged(sPath);
+
         // insert_or_assign will replace any existing value
         const auto iter = m_mFileContents.insert_or_assign(sPath, "");
         auto pWriter = std::make_unique<ra::services::impl::StringTextWriter>(iter.first->second);
@@ -181,6 +226,8 @@ public:
     {
         m_mFileSizes.erase(sPath);
 
+        OnFileChanged(sPath);
+
         // insert will return a pointer to the new (or previously existing) value
         const auto iter = m_mFileContents.insert({ sPath, "" });
         auto pWriter = std::make_unique<ra::services::impl::StringTextWriter>(iter.first->second);
@@ -215,12 +262,20 @@ public:
     }
 
 private:
+    void OnFileChanged(const std::wstring& sPath) const
+    {
+        const auto nIndex = sPath.find_last_of('\\');
+        if (nIndex != std::string::npos)
+            ++m_mDirectoryChangeCounts[sPath.substr(0, nIndex + 1)];
+    }
+
     ra::services::ServiceLocator::ServiceOverride<ra::services::IFileSystem> m_Override;
     std::wstring m_sBaseDirectory = L".\\";
     mutable std::set<std::wstring> m_vDirectories;
     mutable std::unordered_map<std::wstring, std::string> m_mFileContents;
     mutable std::unordered_map<std::wstring, int64_t> m_mFileSizes;
     mutable std::unordered_map<std::wstring, std::chrono::system_clock::time_point> m_mFileModifiedTimes;
+    mutable std::unordered_map<std::wstring, uint32_t> m_mDirectoryChangeCounts;
 };
 
 } // namespace mocks
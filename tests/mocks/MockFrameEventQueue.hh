@@ -12,27 +12,53 @@ namespace mocks {
 class MockFrameEventQueue : public FrameEventQueue
 {
 public:
-    MockFrameEventQueue() noexcept : m_Override(this)
+    MockFrameEventQueue() : m_Override(this)
     {
     }
 
-    size_t NumTriggeredTriggers() const noexcept { return m_vTriggeredTriggers.size(); }
-    size_t NumResetTriggers() const noexcept { return m_vResetTriggers.size(); }
-    size_t NumMemoryChanges() const noexcept { return m_vMemChanges.size(); }
+    size_t NumTriggeredTriggers() const { return CountPendingEvents(EventType::TriggerTriggered); }
+    size_t NumResetTriggers() const { return CountPendingEvents(EventType::TriggerReset); }
+
+    size_t NumMemoryChanges() const
+    {
+        // duplicate changes are only reported once
+        std::set<std::wstring> vMemChanges;
+        ForEachPendingEvent([&vMemChanges](const Event& pEvent) {
+            if (pEvent.nType == EventType::MemoryChanged)
+                vMemChanges.insert(pEvent.sDescription);
+        });
+
+        return vMemChanges.size();
+    }
 
     bool ContainsMemoryChange(const std::wstring& sChange) const
     {
-        return (m_vMemChanges.find(sChange) != m_vMemChanges.end());
+        bool bFound = false;
+        ForEachPendingEvent([&bFound, &sChange](const Event& pEvent) {
+            if (pEvent.nType == EventType::MemoryChanged && pEvent.sDescription == sChange)
+                bFound = true;
+        });
+
+        return bFound;
     }
 
     void Reset() noexcept
     {
-        m_vTriggeredTriggers.clear();
-        m_vResetTriggers.clear();
-        m_vMemChanges.clear();
+        DiscardPendingEvents();
     }
 
 private:
+    size_t CountPendingEvents(EventType nType) const
+    {
+        size_t nCount = 0;
+        ForEachPendingEvent([&nCount, nType](const Event& pEvent) {
+            if (pEvent.nType == nType)
+                ++nCount;
+        });
+
+        return nCount;
+    }
+
     ra::services::ServiceLocator::ServiceOverride<ra::services::FrameEventQueue> m_Override;
 };
 
@@ -20,6 +20,7 @@ public:
     {
         const gsl::not_null<std::string*> pText{gsl::make_not_null(GetText(nType, sKey, true))};
         *pText = sContents;
+        OnChanged(nType, sKey);
     }
 
     bool HasStoredData(ra::services::StorageItemType nType, const std::wstring& sKey) const
@@ -43,21 +44,62 @@ public:
         if (pMap != m_mStoredData.end())
         {
             pMap->second.erase(sKey);
+            OnChanged(nType, sKey);
             return true;
         }
 
         return false;
     }
 
+    bool Move(ra::services::StorageItemType nType, const std::wstring& sOldKey, const std::wstring& sNewKey) override
+    {
+        const auto pMap = m_mStoredData.find(nType);
+        if (pMap == m_mStoredData.end())
+            return false;
+
+        const auto pIter = pMap->second.find(sOldKey);
+        if (pIter == pMap->second.end())
+            return false;
+
+        std::string sText = std::move(pIter->second);
+        pMap->second.erase(pIter);
+        pMap->second.insert_or_assign(sNewKey, std::move(sText));
+
+        OnChanged(nType, sOldKey);
+        OnChanged(nType, sNewKey);
+        return true;
+    }
+
     void MockLastModified(StorageItemType nType, const std::wstring& sKey,
         std::chrono::system_clock::time_point tLastModified)
     {
         m_mLastModified[nType][sKey] = tLastModified;
+        OnChanged(nType, sKey);
+    }
+
+    /// <summary>
+    /// Gets the number of calls that would have accessed the file system (GetLastModified and ReadText).
+    /// </summary>
+    size_t GetFileAccessCount() const noexcept { return m_nFileAccessCount; }
+
+    uint32_t GetChangeGeneration(StorageItemType nType, const std::wstring& sKey) override
+    {
+        const auto pMap = m_mGenerations.find(nType);
+        if (pMap != m_mGenerations.end())
+        {
+            const auto pIter = pMap->second.find(sKey);
+            if (pIter != pMap->second.end())
+                return pIter->second;
+        }
+
+        return 0;
     }
 
     std::chrono::system_clock::time_point GetLastModified(StorageItemType nType,
                                                           const std::wstring& sKey) override
     {
+        ++m_nFileAccessCount;
+
         const auto pMap = m_mLastModified.find(nType);
         if (pMap != m_mLastModified.end())
         {
@@ -71,6 +113,8 @@ public:
 
     std::unique_ptr<TextReader> ReadText(StorageItemType nType, const std::wstring& sKey) override
     {
+        ++m_nFileAccessCount;
+
         const auto pText = GetText(nType, sKey, false);
         if (pText == nullptr)
             return std::unique_ptr<TextReader>();
@@ -83,6 +127,7 @@ public:
     {
         const gsl::not_null<std::string*> pText{gsl::make_not_null(GetText(nType, sKey, true))};
         pText->clear();
+        OnChanged(nType, sKey);
 
         auto pWriter = std::make_unique<ra::services::impl::StringTextWriter>(*pText);
         return std::unique_ptr<TextWriter>(pWriter.release());
@@ -91,11 +136,18 @@ public:
     std::unique_ptr<TextWriter> AppendText(StorageItemType nType, const std::wstring& sKey) override
     {
         const gsl::not_null<std::string*> pText{gsl::make_not_null(GetText(nType, sKey, true))};
+        OnChanged(nType, sKey);
         auto pWriter = std::make_unique<ra::services::impl::StringTextWriter>(*pText);
         return std::unique_ptr<TextWriter>(pWriter.release());
     }
 
 private:
+    void OnChanged(StorageItemType nType, const std::wstring& sKey)
+    {
+        // generations are unique across all items so switching keys is always detected as a change
+        m_mGenerations[nType][sKey] = ++m_nGeneration;
+    }
+
     std::string* GetText(StorageItemType nType, const std::wstring& sKey, bool bCreateIfMissing) const
     {
         auto pMap = m_mStoredData.find(nType);
@@ -124,6 +176,9 @@ private:
     ra::services::ServiceLocator::ServiceOverride<ra::services::ILocalStorage> m_Override;
     mutable std::unordered_map<StorageItemType, std::unordered_map<std::wstring, std::string>> m_mStoredData;
     mutable std::unordered_map<StorageItemType, std::unordered_map<std::wstring, std::chrono::system_clock::time_point>> m_mLastModified;
+    std::unordered_map<StorageItemType, std::unordered_map<std::wstring, uint32_t>> m_mGenerations;
+    uint32_t m_nGeneration = 0;
+    size_t m_nFileAccessCount = 0;
 };
 
 } // namespace mocks
@@ -0,0 +1,524 @@
+#include "SoftwareSurface.hh"
+
+#include "services\IFileSystem.hh"
+#include "services\ServiceLocator.hh"
+
+namespace ra {
+namespace ui {
+namespace drawing {
+namespace mocks {
+
+static constexpr int GLYPH_WIDTH = 5;
+static constexpr int GLYPH_HEIGHT = 7;
+static constexpr int CELL_WIDTH = GLYPH_WIDTH + 1;
+static constexpr int CELL_HEIGHT = GLYPH_HEIGHT + 1;
+
+static constexpr wchar_t FIRST_GLYPH = L' ';
+static constexpr wchar_t LAST_GLYPH = L'~';
+
+// one byte per column. the low bit is the top row.
+static constexpr uint8_t FONT_5X7[LAST_GLYPH - FIRST_GLYPH + 1][GLYPH_WIDTH] = {
+    { 0x00, 0x00, 0x00, 0x00, 0x00 }, // ' '
+    { 0x00, 0x00, 0x5F, 0x00, 0x00 }, // !
+    { 0x00, 0x07, 0x00, 0x07, 0x00 }, // "
+    { 0x14, 0x7F, 0x14, 0x7F, 0x14 }, // #
+    { 0x24, 0x2A, 0x7F, 0x2A, 0x12 }, // $
+    { 0x23, 0x13, 0x08, 0x64, 0x62 }, // %
+    { 0x36, 0x49, 0x55, 0x22, 0x50 }, // &
+    { 0x00, 0x05, 0x03, 0x00, 0x00 }, // '
+    { 0x00, 0x1C, 0x22, 0x41, 0x00 }, // (
+    { 0x00, 0x41, 0x22, 0x1C, 0x00 }, // )
+    { 0x08, 0x2A, 0x1C, 0x2A, 0x08 }, // *
+    { 0x08, 0x08, 0x3E, 0x08, 0x08 }, // +
+    { 0x00, 0x50, 0x30, 0x00, 0x00 }, // ,
+    { 0x08, 0x08, 0x08, 0x08, 0x08 }, // -
+    { 0x00, 0x60, 0x60, 0x00, 0x00 }, // .
+    { 0x20, 0x10, 0x08, 0x04, 0x02 }, // /
+    { 0x3E, 0x51, 0x49, 0x45, 0x3E }, // 0
+    { 0x00, 0x42, 0x7F, 0x40, 0x00 }, // 1
+    { 0x42, 0x61, 0x51, 0x49, 0x46 }, // 2
+    { 0x21, 0x41, 0x45, 0x4B, 0x31 }, // 3
+    { 0x18, 0x14, 0x12, 0x7F, 0x10 }, // 4
+    { 0x27, 0x45, 0x45, 0x45, 0x39 }, // 5
+    { 0x3C, 0x4A, 0x49, 0x49, 0x30 }, // 6
+    { 0x01, 0x71, 0x09, 0x05, 0x03 }, // 7
+    { 0x36, 0x49, 0x49, 0x49, 0x36 }, // 8
+    { 0x06, 0x49, 0x49, 0x29, 0x1E }, // 9
+    { 0x00, 0x36, 0x36, 0x00, 0x00 }, // :
+    { 0x00, 0x56, 0x36, 0x00, 0x00 }, // ;
+    { 0x08, 0x14, 0x22, 0x41, 0x00 }, // <
+    { 0x14, 0x14, 0x14, 0x14, 0x14 }, // =
+    { 0x00, 0x41, 0x22, 0x14, 0x08 }, // >
+    { 0x02, 0x01, 0x51, 0x09, 0x06 }, // ?
+    { 0x32, 0x49, 0x79, 0x41, 0x3E }, // @
+    { 0x7E, 0x11, 0x11, 0x11, 0x7E }, // A
+    { 0x7F, 0x49, 0x49, 0x49, 0x36 }, // B
+    { 0x3E, 0x41, 0x41, 0x41, 0x22 }, // C
+    { 0x7F, 0x41, 0x41, 0x22, 0x1C }, // D
+    { 0x7F, 0x49, 0x49, 0x49, 0x41 }, // E
+    { 0x7F, 0x09, 0x09, 0x09, 0x01 }, // F
+    { 0x3E, 0x41, 0x49, 0x49, 0x7A }, // G
+    { 0x7F, 0x08, 0x08, 0x08, 0x7F }, // H
+    { 0x00, 0x41, 0x7F, 0x41, 0x00 }, // I
+    { 0x20, 0x40, 0x41, 0x3F, 0x01 }, // J
+    { 0x7F, 0x08, 0x14, 0x22, 0x41 }, // K
+    { 0x7F, 0x40, 0x40, 0x40, 0x40 }, // L
+    { 0x7F, 0x02, 0x0C, 0x02, 0x7F }, // M
+    { 0x7F, 0x04, 0x08, 0x10, 0x7F }, // N
+    { 0x3E, 0x41, 0x41, 0x41, 0x3E }, // O
+    { 0x7F, 0x09, 0x09, 0x09, 0x06 }, // P
+    { 0x3E, 0x41, 0x51, 0x21, 0x5E }, // Q
+    { 0x7F, 0x09, 0x19, 0x29, 0x46 }, // R
+    { 0x46, 0x49, 0x49, 0x49, 0x31 }, // S
+    { 0x01, 0x01, 0x7F, 0x01, 0x01 }, // T
+    { 0x3F, 0x40, 0x40, 0x40, 0x3F }, // U
+    { 0x1F, 0x20, 0x40, 0x20, 0x1F }, // V
+    { 0x3F, 0x40, 0x38, 0x40, 0x3F }, // W
+    { 0x63, 0x14, 0x08, 0x14, 0x63 }, // X
+    { 0x07, 0x08, 0x70, 0x08, 0x07 }, // Y
+    { 0x61, 0x51, 0x49, 0x45, 0x43 }, // Z
+    { 0x00, 0x7F, 0x41, 0x41, 0x00 }, // [
+    { 0x02, 0x04, 0x08, 0x10, 0x20 }, // backslash
+    { 0x00, 0x41, 0x41, 0x7F, 0x00 }, // ]
+    { 0x04, 0x02, 0x01, 0x02, 0x04 }, // ^
+    { 0x40, 0x40, 0x40, 0x40, 0x40 }, // _
+    { 0x00, 0x01, 0x02, 0x04, 0x00 }, // `
+    { 0x20, 0x54, 0x54, 0x54, 0x78 }, // a
+    { 0x7F, 0x48, 0x44, 0x44, 0x38 }, // b
+    { 0x38, 0x44, 0x44, 0x44, 0x20 }, // c
+    { 0x38, 0x44, 0x44, 0x48, 0x7F }, // d
+    { 0x38, 0x54, 0x54, 0x54, 0x18 }, // e
+    { 0x08, 0x7E, 0x09, 0x01, 0x02 }, // f
+    { 0x0C, 0x52, 0x52, 0x52, 0x3E }, // g
+    { 0x7F, 0x08, 0x04, 0x04, 0x78 }, // h
+    { 0x00, 0x44, 0x7D, 0x40, 0x00 }, // i
+    { 0x20, 0x40, 0x44, 0x3D, 0x00 }, // j
+    { 0x7F, 0x10, 0x28, 0x44, 0x00 }, // k
+    { 0x00, 0x41, 0x7F, 0x40, 0x00 }, // l
+    { 0x7C, 0x04, 0x18, 0x04, 0x78 }, // m
+    { 0x7C, 0x08, 0x04, 0x04, 0x78 }, // n
+    { 0x38, 0x44, 0x44, 0x44, 0x38 }, // o
+    { 0x7C, 0x14, 0x14, 0x14, 0x08 }, // p
+    { 0x08, 0x14, 0x14, 0x18, 0x7C }, // q
+    { 0x7C, 0x08, 0x04, 0x04, 0x08 }, // r
+    { 0x48, 0x54, 0x54, 0x54, 0x20 }, // s
+    { 0x04, 0x3F, 0x44, 0x40, 0x20 }, // t
+    { 0x3C, 0x40, 0x40, 0x20, 0x7C }, // u
+    { 0x1C, 0x20, 0x40, 0x20, 0x1C }, // v
+    { 0x3C, 0x40, 0x30, 0x40, 0x3C }, // w
+    { 0x44, 0x28, 0x10, 0x28, 0x44 }, // x
+    { 0x0C, 0x50, 0x50, 0x50, 0x3C }, // y
+    { 0x44, 0x64, 0x54, 0x4C, 0x44 }, // z
+    { 0x00, 0x08, 0x36, 0x41, 0x00 }, // {
+    { 0x00, 0x00, 0x7F, 0x00, 0x00 }, // |
+    { 0x00, 0x41, 0x36, 0x08, 0x00 }, // }
+    { 0x08, 0x04, 0x08, 0x10, 0x08 }, // ~
+};
+
+// drawn for any character not in the font
+static constexpr uint8_t MISSING_GLYPH[GLYPH_WIDTH] = { 0x7F, 0x41, 0x41, 0x41, 0x7F };
+
+static constexpr uint32_t FNV_OFFSET_BASIS_32 = 0x811C9DC5;
+static constexpr uint32_t FNV_PRIME_32 = 0x01000193;
+static constexpr uint64_t FNV_OFFSET_BASIS_64 = 0xCBF29CE484222325ULL;
+static constexpr uint64_t FNV_PRIME_64 = 0x00000100000001B3ULL;
+
+static constexpr uint8_t BlendPixel(uint8_t nTarget, uint8_t nBlend, uint8_t nAlpha) noexcept
+{
+    return gsl::narrow_cast<uint8_t>(((nBlend * nAlpha) + (nTarget * (256 - nAlpha))) / 256);
+}
+
+int SoftwareResources::LoadFont(int nFontSize, FontStyles nStyle)
+{
+    using namespace ra::bitwise_ops;
+
+    Font pFont{};
+    pFont.nScale = std::max((nFontSize + CELL_HEIGHT / 2) / CELL_HEIGHT, 1);
+    pFont.bBold = ((nStyle & FontStyles::Bold) == FontStyles::Bold);
+
+    for (size_t i = 0; i < m_vFonts.size(); ++i)
+    {
+        const auto& pExisting = m_vFonts.at(i);
+        if (pExisting.nScale == pFont.nScale && pExisting.bBold == pFont.bBold)
+            return gsl::narrow_cast<int>(i + 1);
+    }
+
+    m_vFonts.push_back(pFont);
+    return gsl::narrow_cast<int>(m_vFonts.size());
+}
+
+const SoftwareResources::Font* SoftwareResources::GetFont(int nFont) const noexcept
+{
+    if (nFont < 1 || ra::to_unsigned(nFont) > m_vFonts.size())
+        return nullptr;
+
+    return &m_vFonts.at(gsl::narrow_cast<size_t>(nFont) - 1);
+}
+
+void SoftwareResources::SetImage(ImageType nType, const std::string& sName, int nWidth, int nHeight, const uint32_t* pARGB)
+{
+    auto& pImage = m_mImages[{nType, sName}];
+    pImage.nWidth = nWidth;
+    pImage.nHeight = nHeight;
+    pImage.vPixels.assign(pARGB, pARGB + gsl::narrow_cast<size_t>(nWidth) * nHeight);
+}
+
+const SoftwareResources::Image* SoftwareResources::GetImage(ImageType nType, const std::string& sName) const
+{
+    const auto pIter = m_mImages.find({nType, sName});
+    if (pIter == m_mImages.end())
+        return nullptr;
+
+    return &pIter->second;
+}
+
+SoftwareSurface::SoftwareSurface(int nWidth, int nHeight, bool bTransparent, std::shared_ptr<SoftwareResources> pResources)
+    : m_nWidth(std::max(nWidth, 0)), m_nHeight(std::max(nHeight, 0)), m_bTransparent(bTransparent),
+      m_pResources(std::move(pResources))
+{
+    m_vPixels.resize(gsl::narrow_cast<size_t>(m_nWidth) * m_nHeight);
+}
+
+void SoftwareSurface::FillRectangle(int nX, int nY, int nWidth, int nHeight, Color nColor) noexcept
+{
+    // clip to surface
+    if (nX < 0)
+    {
+        nWidth += nX;
+        nX = 0;
+    }
+    if (nY < 0)
+    {
+        nHeight += nY;
+        nY = 0;
+    }
+    nWidth = std::min(nWidth, m_nWidth - nX);
+    nHeight = std::min(nHeight, m_nHeight - nY);
+    if (nWidth <= 0 || nHeight <= 0)
+        return;
+
+    auto pRow = m_vPixels.begin() + gsl::narrow_cast<ptrdiff_t>(nY) * m_nWidth + nX;
+    if (nWidth == m_nWidth)
+    {
+        // doing full scanlines, just bulk fill
+        std::fill_n(pRow, gsl::narrow_cast<size_t>(nWidth) * nHeight, nColor.ARGB);
+        return;
+    }
+
+    while (nHeight--)
+    {
+        std::fill_n(pRow, nWidth, nColor.ARGB);
+        pRow += m_nWidth;
+    }
+}
+
+int SoftwareSurface::LoadFont(const std::string&, int nFontSize, FontStyles nStyle)
+{
+    // all fonts are rendered with the built-in font
+    return m_pResources->LoadFont(nFontSize, nStyle);
+}
+
+ra::ui::Size SoftwareSurface::MeasureText(int nFont, const std::wstring& sText) const noexcept
+{
+    const auto* pFont = m_pResources->GetFont(nFont);
+    if (pFont == nullptr)
+        return {};
+
+    const int nAdvance = (CELL_WIDTH + (pFont->bBold ? 1 : 0)) * pFont->nScale;
+    return { nAdvance * gsl::narrow_cast<int>(sText.length()), CELL_HEIGHT * pFont->nScale };
+}
+
+void SoftwareSurface::WriteText(int nX, int nY, int nFont, Color nColor, const std::wstring& sText) noexcept
+{
+    const auto* pFont = m_pResources->GetFont(nFont);
+    if (pFont == nullptr)
+        return;
+
+    const int nScale = pFont->nScale;
+    const int nAdvance = (CELL_WIDTH + (pFont->bBold ? 1 : 0)) * nScale;
+
+    for (const auto c : sText)
+    {
+        if (nX >= m_nWidth)
+            break;
+
+        if (nX + nAdvance > 0)
+        {
+            const uint8_t* pGlyph = (c >= FIRST_GLYPH && c <= LAST_GLYPH) ? &FONT_5X7[c - FIRST_GLYPH][0] : &MISSING_GLYPH[0];
+            for (int nColumn = 0; nColumn < GLYPH_WIDTH; ++nColumn)
+            {
+                const uint8_t nBits = pGlyph[nColumn];
+                for (int nRow = 0; nRow < GLYPH_HEIGHT; ++nRow)
+                {
+                    if (nBits & (1 << nRow))
+                    {
+                        // bold pixels are one pixel wider, so adjacent columns run together
+                        FillRectangle(nX + nColumn * nScale, nY + nRow * nScale,
+                                      pFont->bBold ? nScale + 1 : nScale, nScale, nColor);
+                    }
+                }
+            }
+        }
+
+        nX += nAdvance;
+    }
+}
+
+void SoftwareSurface::DrawPixels(int nX, int nY, const uint32_t* pPixels, int nStride,
+                                 int nWidth, int nHeight, bool bBlend) noexcept
+{
+    // clip to surface
+    if (nX < 0)
+    {
+        pPixels -= nX;
+        nWidth += nX;
+        nX = 0;
+    }
+    if (nY < 0)
+    {
+        pPixels -= gsl::narrow_cast<ptrdiff_t>(nY) * nStride;
+        nHeight += nY;
+        nY = 0;
+    }
+    nWidth = std::min(nWidth, m_nWidth - nX);
+    nHeight = std::min(nHeight, m_nHeight - nY);
+    if (nWidth <= 0 || nHeight <= 0)
+        return;
+
+    uint32_t* pRow = &m_vPixels.at(gsl::narrow_cast<size_t>(nY) * m_nWidth + nX);
+    while (nHeight--)
+    {
+        if (!bBlend)
+        {
+            memcpy(pRow, pPixels, gsl::narrow_cast<size_t>(nWidth) * sizeof(uint32_t));
+        }
+        else
+        {
+            for (int i = 0; i < nWidth; ++i)
+            {
+                const Color nSource(pPixels[i]);
+                const auto nAlpha = nSource.Channel.A;
+                if (nAlpha == 0)
+                {
+                    // ignore fully transparent pixels
+                }
+                else if (nAlpha == 0xFF)
+                {
+                    // copy fully opaque pixels
+                    pRow[i] = nSource.ARGB;
+                }
+                else
+                {
+                    // merge partially transparent pixels
+                    Color nTarget(pRow[i]);
+                    nTarget.Channel.R = BlendPixel(nTarget.Channel.R, nSource.Channel.R, nAlpha);
+                    nTarget.Channel.G = BlendPixel(nTarget.Channel.G, nSource.Channel.G, nAlpha);
+                    nTarget.Channel.B = BlendPixel(nTarget.Channel.B, nSource.Channel.B, nAlpha);
+                    pRow[i] = nTarget.ARGB;
+                }
+            }
+        }
+
+        pRow += m_nWidth;
+        pPixels += nStride;
+    }
+}
+
+void SoftwareSurface::DrawPlaceholder(int nX, int nY, int nWidth, int nHeight, const ImageReference& pImage) noexcept
+{
+    if (pImage.Type() == ImageType::None)
+        return;
+
+    uint32_t nHash = FNV_OFFSET_BASIS_32;
+    for (const auto c : pImage.Name())
+    {
+        nHash ^= gsl::narrow_cast<uint8_t>(c);
+        nHash *= FNV_PRIME_32;
+    }
+
+    FillRectangle(nX, nY, nWidth, nHeight, Color(0xFF000000 | (nHash & 0x00FFFFFF)));
+}
+
+void SoftwareSurface::DrawImage(int nX, int nY, int nWidth, int nHeight, const ImageReference& pImage)
+{
+    const auto* pSource = m_pResources->GetImage(pImage.Type(), pImage.Name());
+    if (pSource == nullptr)
+    {
+        DrawPlaceholder(nX, nY, nWidth, nHeight, pImage);
+        return;
+    }
+
+    DrawPixels(nX, nY, pSource->vPixels.data(), pSource->nWidth,
+               std::min(nWidth, pSource->nWidth), std::min(nHeight, pSource->nHeight), false);
+}
+
+void SoftwareSurface::DrawImageStretched(int nX, int nY, int nWidth, int nHeight, const ImageReference& pImage)
+{
+    const auto* pSource = m_pResources->GetImage(pImage.Type(), pImage.Name());
+    if (pSource == nullptr)
+    {
+        DrawPlaceholder(nX, nY, nWidth, nHeight, pImage);
+        return;
+    }
+
+    if (nWidth <= 0 || nHeight <= 0 || pSource->nWidth <= 0 || pSource->nHeight <= 0)
+        return;
+
+    // nearest neighbor
+    std::vector<uint32_t> vRow(gsl::narrow_cast<size_t>(nWidth));
+    for (int nRow = 0; nRow < nHeight; ++nRow)
+    {
+        const auto nTargetY = nY + nRow;
+        if (nTargetY < 0)
+            continue;
+        if (nTargetY >= m_nHeight)
+            break;
+
+        const auto nSourceY = nRow * pSource->nHeight / nHeight;
+        const uint32_t* pSourceRow = &pSource->vPixels.at(gsl::narrow_cast<size_t>(nSourceY) * pSource->nWidth);
+        for (int nColumn = 0; nColumn < nWidth; ++nColumn)
+            vRow.at(nColumn) = pSourceRow[nColumn * pSource->nWidth / nWidth];
+
+        DrawPixels(nX, nTargetY, vRow.data(), nWidth, nWidth, 1, false);
+    }
+}
+
+void SoftwareSurface::DrawSurface(int nX, int nY, const ISurface& pSurface) noexcept
+{
+    const auto* pSoftwareSurface = dynamic_cast<const SoftwareSurface*>(&pSurface);
+    Expects(pSoftwareSurface != nullptr);
+
+    DrawPixels(nX, nY, pSoftwareSurface->m_vPixels.data(), pSoftwareSurface->m_nWidth,
+               pSoftwareSurface->m_nWidth, pSoftwareSurface->m_nHeight, pSoftwareSurface->m_bTransparent);
+}
+
+void SoftwareSurface::DrawSurface(int nX, int nY, const ISurface& pSurface, int nSurfaceX, int nSurfaceY,
+                                  int nWidth, int nHeight) noexcept
+{
+    const auto* pSoftwareSurface = dynamic_cast<const SoftwareSurface*>(&pSurface);
+    Expects(pSoftwareSurface != nullptr);
+
+    // clip to source surface
+    if (nSurfaceX < 0)
+    {
+        nX -= nSurfaceX;
+        nWidth += nSurfaceX;
+        nSurfaceX = 0;
+    }
+    if (nSurfaceY < 0)
+    {
+        nY -= nSurfaceY;
+        nHeight += nSurfaceY;
+        nSurfaceY = 0;
+    }
+    nWidth = std::min(nWidth, pSoftwareSurface->m_nWidth - nSurfaceX);
+    nHeight = std::min(nHeight, pSoftwareSurface->m_nHeight - nSurfaceY);
+    if (nWidth <= 0 || nHeight <= 0)
+        return;
+
+    const uint32_t* pPixels = &pSoftwareSurface->m_vPixels.at(
+        gsl::narrow_cast<size_t>(nSurfaceY) * pSoftwareSurface->m_nWidth + nSurfaceX);
+    DrawPixels(nX, nY, pPixels, pSoftwareSurface->m_nWidth, nWidth, nHeight, pSoftwareSurface->m_bTransparent);
+}
+
+void SoftwareSurface::SetOpacity(double fAlpha) noexcept
+{
+    Expects(fAlpha >= 0.0 && fAlpha <= 1.0);
+    const auto nAlpha = static_cast<uint32_t>(255 * fAlpha);
+
+    for (auto& nPixel : m_vPixels)
+    {
+        // only update the alpha for non-transparent pixels
+        if (nPixel & 0xFF000000)
+            nPixel = (nPixel & 0x00FFFFFF) | (nAlpha << 24);
+    }
+}
+
+void SoftwareSurface::SetPixels(int nX, int nY, int nWidth, int nHeight, uint32_t* pARGB) noexcept
+{
+    DrawPixels(nX, nY, pARGB, nWidth, nWidth, nHeight, false);
+}
+
+uint64_t SoftwareSurface::GetPixelHash() const noexcept
+{
+    uint64_t nHash = FNV_OFFSET_BASIS_64;
+    const auto HashValue = [&nHash](uint32_t nValue) noexcept {
+        for (int i = 0; i < 4; ++i)
+        {
+            nHash ^= (nValue & 0xFF);
+            nHash *= FNV_PRIME_64;
+            nValue >>= 8;
+        }
+    };
+
+    HashValue(gsl::narrow_cast<uint32_t>(m_nWidth));
+    HashValue(gsl::narrow_cast<uint32_t>(m_nHeight));
+    for (const auto nPixel : m_vPixels)
+        HashValue(nPixel);
+
+    return nHash;
+}
+
+static void PutUInt16(std::string& sBuffer, size_t nOffset, uint16_t nValue)
+{
+    sBuffer.at(nOffset) = gsl::narrow_cast<char>(nValue & 0xFF);
+    sBuffer.at(nOffset + 1) = gsl::narrow_cast<char>((nValue >> 8) & 0xFF);
+}
+
+static void PutUInt32(std::string& sBuffer, size_t nOffset, uint32_t nValue)
+{
+    PutUInt16(sBuffer, nOffset, gsl::narrow_cast<uint16_t>(nValue & 0xFFFF));
+    PutUInt16(sBuffer, nOffset + 2, gsl::narrow_cast<uint16_t>(nValue >> 16));
+}
+
+bool SoftwareSurfaceFactory::SaveImage(const ISurface& pSurface, const std::wstring& sPath) const
+{
+    const auto* pSoftwareSurface = dynamic_cast<const SoftwareSurface*>(&pSurface);
+    if (pSoftwareSurface == nullptr)
+        return false;
+
+    constexpr size_t nFileHeaderSize = 14;
+    constexpr size_t nInfoHeaderSize = 40;
+    const auto nWidth = pSoftwareSurface->GetWidth();
+    const auto nHeight = pSoftwareSurface->GetHeight();
+    const auto nImageSize = gsl::narrow_cast<uint32_t>(nWidth * nHeight * 4);
+
+    std::string sHeader;
+    sHeader.resize(nFileHeaderSize + nInfoHeaderSize);
+    sHeader.at(0) = 'B';
+    sHeader.at(1) = 'M';
+    PutUInt32(sHeader, 2, gsl::narrow_cast<uint32_t>(sHeader.size()) + nImageSize);
+    PutUInt32(sHeader, 10, gsl::narrow_cast<uint32_t>(sHeader.size()));
+    PutUInt32(sHeader, 14, nInfoHeaderSize);
+    PutUInt32(sHeader, 18, nWidth);
+    PutUInt32(sHeader, 22, gsl::narrow_cast<uint32_t>(-ra::to_signed(nHeight))); // negative height = top-down
+    PutUInt16(sHeader, 26, 1);  // planes
+    PutUInt16(sHeader, 28, 32); // bits per pixel
+    PutUInt32(sHeader, 34, nImageSize);
+
+    const auto& pFileSystem = ra::services::ServiceLocator::Get<ra::services::IFileSystem>();
+    auto pFile = pFileSystem.CreateTextFile(sPath);
+    if (pFile == nullptr)
+        return false;
+
+    pFile->Write(sHeader.data(), sHeader.size());
+
+    // pixels are stored as little-endian BGRA, which is the in-memory layout of ARGB on little-endian platforms
+    std::string sRow;
+    sRow.resize(gsl::narrow_cast<size_t>(nWidth) * 4);
+    const auto& vPixels = pSoftwareSurface->GetPixels();
+    for (unsigned int nRow = 0; nRow < nHeight; ++nRow)
+    {
+        for (unsigned int nColumn = 0; nColumn < nWidth; ++nColumn)
+            PutUInt32(sRow, gsl::narrow_cast<size_t>(nColumn) * 4, vPixels.at(gsl::narrow_cast<size_t>(nRow) * nWidth + nColumn));
+
+        pFile->Write(sRow.data(), sRow.size());
+    }
+
+    return true;
+}
+
+} // namespace mocks
+} // namespace drawing
+} // namespace ui
+} // namespace ra
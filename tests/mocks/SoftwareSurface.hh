@@ -0,0 +1,144 @@
+#ifndef RA_SERVICES_MOCK_SOFTWARE_SURFACE_HH
+#define RA_SERVICES_MOCK_SOFTWARE_SURFACE_HH
+#pragma once
+
+#include "ra_fwd.h"
+
+#include "ui\drawing\ISurface.hh"
+
+namespace ra {
+namespace ui {
+namespace drawing {
+namespace mocks {
+
+/// <summary>
+/// Fonts and images shared by all surfaces created by a <see cref="SoftwareSurfaceFactory" />.
+/// </summary>
+class SoftwareResources
+{
+public:
+    struct Font
+    {
+        int nScale;
+        bool bBold;
+    };
+
+    struct Image
+    {
+        int nWidth;
+        int nHeight;
+        std::vector<uint32_t> vPixels;
+    };
+
+    int LoadFont(int nFontSize, FontStyles nStyle);
+    const Font* GetFont(int nFont) const noexcept;
+
+    void SetImage(ImageType nType, const std::string& sName, int nWidth, int nHeight, const uint32_t* pARGB);
+    const Image* GetImage(ImageType nType, const std::string& sName) const;
+
+private:
+    std::vector<Font> m_vFonts;
+    std::map<std::pair<ImageType, std::string>, Image> m_mImages;
+};
+
+/// <summary>
+/// Portable <see cref="ISurface" /> that renders into a 32-bit ARGB pixel buffer.
+/// </summary>
+/// <remarks>
+/// Text is rendered with a built-in 5x7 bitmap font scaled to the requested font size. Images that
+/// have not been provided to the factory are drawn as a solid block whose color is derived from the
+/// image name, so the output is always deterministic.
+/// </remarks>
+class SoftwareSurface : public ISurface
+{
+public:
+    explicit SoftwareSurface(int nWidth, int nHeight, bool bTransparent,
+                             std::shared_ptr<SoftwareResources> pResources);
+    ~SoftwareSurface() noexcept = default;
+
+    SoftwareSurface(const SoftwareSurface&) noexcept = delete;
+    SoftwareSurface& operator=(const SoftwareSurface&) noexcept = delete;
+    SoftwareSurface(SoftwareSurface&&) noexcept = delete;
+    SoftwareSurface& operator=(SoftwareSurface&&) noexcept = delete;
+
+    unsigned int GetWidth() const noexcept override { return gsl::narrow_cast<unsigned int>(m_nWidth); }
+    unsigned int GetHeight() const noexcept override { return gsl::narrow_cast<unsigned int>(m_nHeight); }
+
+    void FillRectangle(int nX, int nY, int nWidth, int nHeight, Color nColor) noexcept override;
+    int LoadFont(const std::string& sFont, int nFontSize, FontStyles nStyle) override;
+    ra::ui::Size MeasureText(int nFont, const std::wstring& sText) const noexcept override;
+    void WriteText(int nX, int nY, int nFont, Color nColor, const std::wstring& sText) noexcept override;
+    void DrawImage(int nX, int nY, int nWidth, int nHeight, const ImageReference& pImage) override;
+    void DrawImageStretched(int nX, int nY, int nWidth, int nHeight, const ImageReference& pImage) override;
+    void DrawSurface(int nX, int nY, const ISurface& pSurface) noexcept override;
+    void DrawSurface(int nX, int nY, const ISurface& pSurface, int nSurfaceX, int nSurfaceY, int nWidth, int nHeight) noexcept override;
+    void SetOpacity(double fAlpha) noexcept override;
+    void SetPixels(int nX, int nY, int nWidth, int nHeight, uint32_t* pARGB) noexcept override;
+
+    /// <summary>
+    /// Determines whether the surface has an alpha channel that should be blended when drawn onto another surface.
+    /// </summary>
+    bool IsTransparent() const noexcept { return m_bTransparent; }
+
+    /// <summary>
+    /// Gets the ARGB value of a pixel.
+    /// </summary>
+    uint32_t GetPixel(int nX, int nY) const { return m_vPixels.at(gsl::narrow_cast<size_t>(nY) * m_nWidth + nX); }
+
+    /// <summary>
+    /// Gets the ARGB values of all pixels, top row first.
+    /// </summary>
+    const std::vector<uint32_t>& GetPixels() const noexcept { return m_vPixels; }
+
+    /// <summary>
+    /// Gets a 64-bit FNV-1a hash of the surface size and contents.
+    /// </summary>
+    uint64_t GetPixelHash() const noexcept;
+
+private:
+    void DrawPixels(int nX, int nY, const uint32_t* pPixels, int nStride, int nWidth, int nHeight, bool bBlend) noexcept;
+    void DrawPlaceholder(int nX, int nY, int nWidth, int nHeight, const ImageReference& pImage) noexcept;
+
+    int m_nWidth;
+    int m_nHeight;
+    bool m_bTransparent;
+    std::vector<uint32_t> m_vPixels;
+    std::shared_ptr<SoftwareResources> m_pResources;
+};
+
+class SoftwareSurfaceFactory : public ISurfaceFactory
+{
+public:
+    std::unique_ptr<ISurface> CreateSurface(int nWidth, int nHeight) const override
+    {
+        return std::make_unique<SoftwareSurface>(nWidth, nHeight, false, m_pResources);
+    }
+
+    std::unique_ptr<ISurface> CreateTransparentSurface(int nWidth, int nHeight) const override
+    {
+        return std::make_unique<SoftwareSurface>(nWidth, nHeight, true, m_pResources);
+    }
+
+    /// <summary>
+    /// Saves the provided surface as an uncompressed 32-bit bitmap.
+    /// </summary>
+    bool SaveImage(const ISurface& pSurface, const std::wstring& sPath) const override;
+
+    /// <summary>
+    /// Provides the pixels to draw for an image.
+    /// </summary>
+    void SetImage(ImageType nType, const std::string& sName, int nWidth, int nHeight, const uint32_t* pARGB)
+    {
+        m_pResources->SetImage(nType, sName, nWidth, nHeight, pARGB);
+    }
+
+private:
+    std::shared_ptr<SoftwareResources> m_pResources = std::make_shared<SoftwareResources>();
+};
+
+} // namespace mocks
+} // namespace drawing
+} // namespace ui
+} // namespace ra
+
+#endif // !RA_SERVICES_MOCK_SOFTWARE_SURFACE_HH
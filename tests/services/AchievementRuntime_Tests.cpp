@@ -28,6 +28,8 @@
 #include <rcheevos\src\rc_client_internal.h>
 #include <rcheevos\src\rcheevos\rc_internal.h>
 
+#include <random>
+
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
 namespace ra {
@@ -355,15 +357,22 @@ public:
         mockWindowManager.MemoryBookmarks.SetIsVisible(bInspectingMemory);
     }
 
+    // also pass captured events to the real handler as they're raised
+    void SetForwardEvents(bool bForwardEvents) noexcept { m_bForwardEvents = bForwardEvents; }
+
 private:
     static void CaptureEventHandler(const rc_client_event_t* pEvent, rc_client_t* pClient)
     {
         auto* harness = static_cast<AchievementRuntimeHarness*>(rc_client_get_userdata(pClient));
         Expects(harness != nullptr);
         harness->m_vEvents.push_back(*pEvent);
+
+        if (harness->m_bForwardEvents)
+            harness->m_fRealEventHandler(pEvent, pClient);
     }
 
     std::vector<rc_client_event_t> m_vEvents;
+    bool m_bForwardEvents = false;
 
     static rc_client_subset_info_t* GetSubset(rc_client_game_info_t* game, uint32_t subset_id, const char* name)
     {
@@ -1056,6 +1065,299 @@ public:
         Assert::AreEqual(0x040000U, pMemRef->value.prior);
     }
 
+    TEST_METHOD(TestSaveProgressToFileWritesInBackground)
+    {
+        AchievementRuntimeHarness runtime;
+        runtime.MockAchievement(3U, "1=1.10.");
+        runtime.SyncToRuntime();
+
+        SetConditionHitCount(runtime, 3U, 0, 0, 2);
+        runtime.SaveProgressToFile("test.sav");
+
+        // file isn't written until the background task runs
+        Assert::AreEqual({ -1 }, runtime.mockFileSystem.GetFileSize(L"test.sav.rap"));
+        Assert::AreEqual({ 1U }, runtime.mockThreadPool.PendingTasks());
+
+        runtime.mockThreadPool.ExecuteNextTask();
+        Assert::AreEqual(std::string("RAP"), runtime.mockFileSystem.GetFileContents(L"test.sav.rap").substr(0, 3));
+        Assert::AreEqual({ -1 }, runtime.mockFileSystem.GetFileSize(L"test.sav.rap.tmp"));
+
+        // data should now come from the file
+        SetConditionHitCount(runtime, 3U, 0, 0, 5);
+        runtime.LoadProgressFromFile("test.sav");
+        AssertConditionHitCount(runtime, 3U, 0, 0, 2);
+    }
+
+    TEST_METHOD(TestSaveProgressToFileReplacesExistingFile)
+    {
+        AchievementRuntimeHarness runtime;
+        runtime.MockAchievement(3U, "1=1.10.");
+        runtime.SyncToRuntime();
+
+        runtime.mockFileSystem.MockFile(L"test.sav.rap", "3:1:1:0:0:0:0:6e2301982f40d1a3f311cdb063f57e2f:4f52856e145d7cb05822e8a9675b086b:");
+
+        SetConditionHitCount(runtime, 3U, 0, 0, 4);
+        runtime.SaveProgressToFile("test.sav");
+        runtime.mockThreadPool.ExecuteNextTask();
+
+        Assert::AreEqual(std::string("RAP"), runtime.mockFileSystem.GetFileContents(L"test.sav.rap").substr(0, 3));
+
+        SetConditionHitCount(runtime, 3U, 0, 0, 0);
+        runtime.LoadProgressFromFile("test.sav");
+        AssertConditionHitCount(runtime, 3U, 0, 0, 4);
+    }
+
+    TEST_METHOD(TestSaveProgressToFileMultipleSavesBeforeWrite)
+    {
+        AchievementRuntimeHarness runtime;
+        runtime.MockAchievement(3U, "1=1.10.");
+        runtime.SyncToRuntime();
+
+        SetConditionHitCount(runtime, 3U, 0, 0, 2);
+        runtime.SaveProgressToFile("test.sav");
+        SetConditionHitCount(runtime, 3U, 0, 0, 3);
+        runtime.SaveProgressToFile("test.sav");
+        Assert::AreEqual({ 2U }, runtime.mockThreadPool.PendingTasks());
+
+        // first task should see that it's been superseded and do nothing
+        runtime.mockThreadPool.ExecuteNextTask();
+        Assert::AreEqual({ -1 }, runtime.mockFileSystem.GetFileSize(L"test.sav.rap"));
+
+        // second task writes the most recent data
+        runtime.mockThreadPool.ExecuteNextTask();
+        SetConditionHitCount(runtime, 3U, 0, 0, 6);
+        runtime.LoadProgressFromFile("test.sav");
+        AssertConditionHitCount(runtime, 3U, 0, 0, 3);
+    }
+
+    TEST_METHOD(TestFlushProgressWrites)
+    {
+        AchievementRuntimeHarness runtime;
+        runtime.MockAchievement(3U, "1=1.10.");
+        runtime.SyncToRuntime();
+
+        SetConditionHitCount(runtime, 3U, 0, 0, 2);
+        runtime.SaveProgressToFile("test.sav");
+        runtime.SaveProgressToFile("test2.sav");
+
+        runtime.FlushProgressWrites();
+        const std::string sContents = runtime.mockFileSystem.GetFileContents(L"test.sav.rap");
+        Assert::AreEqual(std::string("RAP"), sContents.substr(0, 3));
+        Assert::AreEqual(sContents, runtime.mockFileSystem.GetFileContents(L"test2.sav.rap"));
+
+        // queued tasks have nothing left to do
+        runtime.mockThreadPool.ExecuteNextTask();
+        runtime.mockThreadPool.ExecuteNextTask();
+        Assert::AreEqual(sContents, runtime.mockFileSystem.GetFileContents(L"test.sav.rap"));
+        Assert::AreEqual({ -1 }, runtime.mockFileSystem.GetFileSize(L"test.sav.rap.tmp"));
+    }
+
+    TEST_METHOD(TestPersistProgressFileRandomized)
+    {
+        AchievementRuntimeHarness runtime;
+        constexpr uint32_t nAchievements = 64;
+        for (uint32_t i = 1; i <= nAchievements; ++i)
+            runtime.MockAchievement(i, "1=1.100._2=2.100.S3=3.100.");
+        runtime.SyncToRuntime();
+
+        // fixed seed so failures are reproducible
+        std::mt19937 pRandom(0x5EED);
+        std::uniform_int_distribution<int> pHits(0, 99);
+        std::array<std::array<int, 3>, nAchievements> vExpected{};
+
+        for (int nIteration = 0; nIteration < 20; ++nIteration)
+        {
+            for (uint32_t i = 1; i <= nAchievements; ++i)
+            {
+                auto& pExpected = vExpected.at(i - 1);
+                pExpected.at(0) = pHits(pRandom);
+                pExpected.at(1) = pHits(pRandom);
+                pExpected.at(2) = pHits(pRandom);
+                SetConditionHitCount(runtime, i, 0, 0, pExpected.at(0));
+                SetConditionHitCount(runtime, i, 0, 1, pExpected.at(1));
+                SetConditionHitCount(runtime, i, 2, 0, pExpected.at(2));
+            }
+
+            runtime.SaveProgressToFile("test.sav");
+            runtime.mockThreadPool.ExecuteNextTask();
+
+            for (uint32_t i = 1; i <= nAchievements; ++i)
+            {
+                SetConditionHitCount(runtime, i, 0, 0, pHits(pRandom));
+                SetConditionHitCount(runtime, i, 0, 1, pHits(pRandom));
+                SetConditionHitCount(runtime, i, 2, 0, pHits(pRandom));
+            }
+
+            runtime.LoadProgressFromFile("test.sav");
+
+            for (uint32_t i = 1; i <= nAchievements; ++i)
+            {
+                const auto& pExpected = vExpected.at(i - 1);
+                AssertConditionHitCount(runtime, i, 0, 0, pExpected.at(0));
+                AssertConditionHitCount(runtime, i, 0, 1, pExpected.at(1));
+                AssertConditionHitCount(runtime, i, 2, 0, pExpected.at(2));
+            }
+        }
+    }
+
+    TEST_METHOD(TestSaveProgressToBufferUsesSizeQuerySnapshot)
+    {
+        AchievementRuntimeHarness runtime;
+        runtime.MockAchievement(3U, "1=1.10.");
+        runtime.SyncToRuntime();
+
+        SetConditionHitCount(runtime, 3U, 0, 0, 2);
+        const int nSize = runtime.SaveProgressToBuffer(nullptr, 0);
+
+        // state is captured when the size is requested
+        SetConditionHitCount(runtime, 3U, 0, 0, 4);
+        std::string sBuffer;
+        sBuffer.resize(nSize);
+        Assert::AreEqual(nSize, runtime.SaveProgressToBuffer(reinterpret_cast<uint8_t*>(sBuffer.data()), nSize));
+
+        // captured state is only used once
+        std::string sBuffer2;
+        sBuffer2.resize(nSize);
+        Assert::AreEqual(nSize, runtime.SaveProgressToBuffer(reinterpret_cast<uint8_t*>(sBuffer2.data()), nSize));
+
+        runtime.LoadProgressFromString(sBuffer);
+        AssertConditionHitCount(runtime, 3U, 0, 0, 2);
+
+        runtime.LoadProgressFromString(sBuffer2);
+        AssertConditionHitCount(runtime, 3U, 0, 0, 4);
+    }
+
+    TEST_METHOD(TestSaveProgressToBufferSizeQueryInvalidatedByFrame)
+    {
+        std::array<unsigned char, 5> memory{ 0x00, 0x12, 0x34, 0xAB, 0x56 };
+
+        AchievementRuntimeHarness runtime;
+        runtime.mockEmulatorContext.MockMemory(memory);
+        runtime.MockAchievement(9U, "0xH0001=1");
+        runtime.SyncToRuntime();
+        auto* pMemRef = &runtime.GetClient()->game->runtime.memrefs->memrefs.items[0];
+
+        runtime.DoFrame();
+        Assert::AreEqual(0x12U, pMemRef->value.value);
+
+        const int nSize = runtime.SaveProgressToBuffer(nullptr, 0);
+
+        // processing a frame discards the state captured by the size query
+        memory.at(1) = 0x22;
+        runtime.DoFrame();
+        Assert::AreEqual(0x22U, pMemRef->value.value);
+
+        std::string sBuffer;
+        sBuffer.resize(nSize);
+        Assert::AreEqual(nSize, runtime.SaveProgressToBuffer(reinterpret_cast<uint8_t*>(sBuffer.data()), nSize));
+
+        pMemRef->value.value = 0;
+        runtime.LoadProgressFromString(sBuffer);
+        Assert::AreEqual(0x22U, pMemRef->value.value);
+    }
+
+    TEST_METHOD(TestSaveProgressToBufferSizeQueryInvalidatedByLoad)
+    {
+        AchievementRuntimeHarness runtime;
+        runtime.MockAchievement(3U, "1=1.10.");
+        runtime.SyncToRuntime();
+
+        SetConditionHitCount(runtime, 3U, 0, 0, 2);
+        std::string sBuffer;
+        runtime.SaveProgressToString(sBuffer);
+
+        SetConditionHitCount(runtime, 3U, 0, 0, 5);
+        const int nSize = runtime.SaveProgressToBuffer(nullptr, 0);
+
+        // restoring state discards the state captured by the size query
+        runtime.LoadProgressFromString(sBuffer);
+        AssertConditionHitCount(runtime, 3U, 0, 0, 2);
+
+        std::string sBuffer2;
+        sBuffer2.resize(nSize);
+        Assert::AreEqual(nSize, runtime.SaveProgressToBuffer(reinterpret_cast<uint8_t*>(sBuffer2.data()), nSize));
+
+        SetConditionHitCount(runtime, 3U, 0, 0, 0);
+        runtime.LoadProgressFromString(sBuffer2);
+        AssertConditionHitCount(runtime, 3U, 0, 0, 2);
+    }
+
+    TEST_METHOD(TestSaveProgressToFileUsesSizeQuerySnapshot)
+    {
+        AchievementRuntimeHarness runtime;
+        runtime.MockAchievement(3U, "1=1.10.");
+        runtime.SyncToRuntime();
+
+        SetConditionHitCount(runtime, 3U, 0, 0, 2);
+        runtime.SaveProgressToBuffer(nullptr, 0);
+
+        SetConditionHitCount(runtime, 3U, 0, 0, 4);
+        runtime.SaveProgressToFile("test.sav");
+        runtime.mockThreadPool.ExecuteNextTask();
+
+        SetConditionHitCount(runtime, 3U, 0, 0, 6);
+        runtime.LoadProgressFromFile("test.sav");
+        AssertConditionHitCount(runtime, 3U, 0, 0, 2);
+    }
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(TestSaveProgressRewindPerformance)
+        TEST_IGNORE()
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(TestSaveProgressRewindPerformance)
+    {
+        std::array<unsigned char, 5> memory{ 0x00, 0x12, 0x34, 0xAB, 0x56 };
+
+        AchievementRuntimeHarness runtime;
+        runtime.mockEmulatorContext.MockMemory(memory);
+
+        constexpr uint32_t nAchievements = 3000;
+        for (uint32_t i = 1; i <= nAchievements; ++i)
+            runtime.MockAchievement(i, ra::StringPrintf("0xH0001=%u_0xH0002=%u.100.", i % 256, (i * 7) % 256));
+        runtime.SyncToRuntime();
+
+        // simulate an emulator that captures a rewind point every four frames by asking for the size
+        // of the state and then serializing it
+        constexpr int nFrames = 10000;
+        std::string sBuffer;
+        std::chrono::microseconds tSaving{ 0 };
+        int nSaves = 0;
+
+        const auto tStart = std::chrono::steady_clock::now();
+        for (int nFrame = 1; nFrame <= nFrames; ++nFrame)
+        {
+            memory.at(1) = gsl::narrow_cast<unsigned char>(nFrame & 0xFF);
+            memory.at(2) = gsl::narrow_cast<unsigned char>((nFrame >> 3) & 0xFF);
+            runtime.DoFrame();
+
+            if (nFrame % 4 != 0)
+                continue;
+
+            const auto tSaveStart = std::chrono::steady_clock::now();
+            const int nSize = runtime.SaveProgressToBuffer(nullptr, 0);
+            sBuffer.resize(nSize);
+            Assert::AreEqual(nSize, runtime.SaveProgressToBuffer(reinterpret_cast<uint8_t*>(sBuffer.data()), nSize));
+            tSaving += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - tSaveStart);
+            ++nSaves;
+
+            // periodically make sure the captured state matches the current state
+            if (nSaves % 100 == 0)
+            {
+                std::string sExpected;
+                sExpected.resize(rc_client_progress_size(runtime.GetClient()));
+                rc_client_serialize_progress(runtime.GetClient(), reinterpret_cast<uint8_t*>(sExpected.data()));
+                Assert::IsTrue(sExpected == sBuffer);
+            }
+        }
+        const auto tElapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - tStart);
+
+        Assert::AreEqual(nFrames / 4, nSaves);
+        Logger::WriteMessage(ra::StringPrintf("%d saves over %d frames (%u achievements, %zu bytes): %dms saving (%dus/save), %dms total\n",
+                                              nSaves, nFrames, nAchievements, sBuffer.size(),
+                                              gsl::narrow_cast<int>(tSaving.count() / 1000),
+                                              gsl::narrow_cast<int>(tSaving.count() / nSaves),
+                                              gsl::narrow_cast<int>(tElapsed.count())).c_str());
+    }
+
     TEST_METHOD(TestLoadProgressV1)
     {
         AchievementRuntimeHarness runtime;
@@ -1161,6 +1463,131 @@ public:
         Assert::AreEqual({0U}, runtime.GetEventCount());
     }
 
+    class DisplayTextChangeCounter : public ra::ui::ViewModelBase::NotifyTarget
+    {
+    public:
+        void OnViewModelStringValueChanged(const ra::ui::StringModelProperty::ChangeArgs& args) noexcept override
+        {
+            if (args.Property == ra::ui::viewmodels::ScoreTrackerViewModel::DisplayTextProperty)
+                ++nChanges;
+        }
+
+        int nChanges = 0;
+    };
+
+    TEST_METHOD(TestDoFrameLeaderboardTrackerUpdates)
+    {
+        std::array<unsigned char, 5> memory{ 0x00, 0x12, 0x34, 0xAB, 0x56 };
+        DisplayTextChangeCounter pCounter;
+
+        AchievementRuntimeHarness runtime;
+        runtime.mockEmulatorContext.MockMemory(memory);
+        runtime.mockConfiguration.SetFeatureEnabled(ra::services::Feature::Leaderboards, true);
+        runtime.mockConfiguration.SetPopupLocation(ra::ui::viewmodels::Popup::LeaderboardTracker,
+                                                   ra::ui::viewmodels::PopupLocation::BottomRight);
+        runtime.SetForwardEvents(true);
+
+        constexpr uint32_t nLeaderboards = 20;
+        for (uint32_t i = 1; i <= nLeaderboards; ++i)
+            runtime.MockLeaderboard(i, ra::StringPrintf("STA:0xH00=1::CAN:0xH00=2::SUB:0xH00=3::VAL:0xH01*%u", i));
+
+        // start all of the leaderboards
+        memory.at(0) = 1;
+        memory.at(1) = 1;
+        runtime.DoFrame();
+
+        std::vector<const rc_client_leaderboard_tracker_info_t*> vTrackers;
+        for (const auto* pTracker = runtime.GetClient()->game->leaderboard_trackers; pTracker; pTracker = pTracker->next)
+        {
+            if (pTracker->reference_count == 0)
+                continue;
+
+            auto* pPopup = runtime.mockOverlayManager.GetScoreTracker(pTracker->public_.id);
+            Expects(pPopup != nullptr);
+            pPopup->AddNotifyTarget(pCounter);
+            vTrackers.push_back(pTracker);
+        }
+        Assert::IsFalse(vTrackers.empty());
+        runtime.ResetEvents();
+
+        // every leaderboard changes every frame. each popup should only be updated once per frame,
+        // and should reflect the last value reported for the tracker.
+        constexpr int nFrames = 20;
+        for (int nFrame = 2; nFrame <= nFrames; ++nFrame)
+        {
+            memory.at(1) = gsl::narrow_cast<unsigned char>((nFrame % 250) + 1);
+            pCounter.nChanges = 0;
+            runtime.DoFrame();
+            runtime.ResetEvents();
+
+            Assert::AreEqual(gsl::narrow_cast<int>(vTrackers.size()), pCounter.nChanges);
+        }
+
+        for (const auto* pTracker : vTrackers)
+        {
+            const auto* pPopup = runtime.mockOverlayManager.GetScoreTracker(pTracker->public_.id);
+            Expects(pPopup != nullptr);
+            Assert::AreEqual(ra::Widen(pTracker->public_.display), pPopup->GetDisplayText());
+        }
+    }
+
+    TEST_METHOD(TestDoFrameLeaderboardTrackerUnchanged)
+    {
+        std::array<unsigned char, 5> memory{ 0x00, 0x12, 0x34, 0xAB, 0x56 };
+        DisplayTextChangeCounter pCounter;
+
+        AchievementRuntimeHarness runtime;
+        runtime.mockEmulatorContext.MockMemory(memory);
+        runtime.mockConfiguration.SetFeatureEnabled(ra::services::Feature::Leaderboards, true);
+        runtime.mockConfiguration.SetPopupLocation(ra::ui::viewmodels::Popup::LeaderboardTracker,
+                                                   ra::ui::viewmodels::PopupLocation::BottomRight);
+        runtime.SetForwardEvents(true);
+        runtime.MockLeaderboard(6U, "STA:0xH00=1::CAN:0xH00=2::SUB:0xH00=3::VAL:0xH02");
+
+        memory.at(0) = 1;
+        runtime.DoFrame();
+        runtime.AssertEvent(RC_CLIENT_EVENT_LEADERBOARD_TRACKER_SHOW, 1U);
+        runtime.ResetEvents();
+
+        auto* pPopup = runtime.mockOverlayManager.GetScoreTracker(1U);
+        Expects(pPopup != nullptr);
+        const std::wstring sInitialText = pPopup->GetDisplayText();
+        pPopup->AddNotifyTarget(pCounter);
+
+        memory.at(2) = 33;
+        runtime.DoFrame();
+        runtime.AssertEvent(RC_CLIENT_EVENT_LEADERBOARD_TRACKER_UPDATE, 1U);
+        runtime.ResetEvents();
+        Assert::AreNotEqual(sInitialText, pPopup->GetDisplayText());
+        Assert::AreEqual(1, pCounter.nChanges);
+
+        // an update outside of a frame is applied immediately. if the text hasn't changed, the popup isn't updated
+        rc_client_leaderboard_tracker_t tracker;
+        memset(&tracker, 0, sizeof(tracker));
+        snprintf(tracker.display, sizeof(tracker.display), "%s", ra::Narrow(pPopup->GetDisplayText()).c_str());
+        tracker.id = 1;
+
+        rc_client_event_t event;
+        memset(&event, 0, sizeof(event));
+        event.type = RC_CLIENT_EVENT_LEADERBOARD_TRACKER_UPDATE;
+        event.leaderboard_tracker = &tracker;
+        runtime.RaiseEvent(event);
+        Assert::AreEqual(1, pCounter.nChanges);
+
+        snprintf(tracker.display, sizeof(tracker.display), "1:23.45");
+        runtime.RaiseEvent(event);
+        Assert::AreEqual(std::wstring(L"1:23.45"), pPopup->GetDisplayText());
+        Assert::AreEqual(2, pCounter.nChanges);
+
+        // hiding the tracker discards the displayed text
+        memory.at(0) = 2;
+        runtime.DoFrame();
+        runtime.AssertEvent(RC_CLIENT_EVENT_LEADERBOARD_TRACKER_HIDE, 1U);
+        runtime.ResetEvents();
+        pPopup = runtime.mockOverlayManager.GetScoreTracker(1U);
+        Assert::IsTrue(pPopup == nullptr || pPopup->IsDestroyPending());
+    }
+
     TEST_METHOD(TestActivateRichPresence)
     {
         std::array<unsigned char, 5> memory{ 0x00, 0x12, 0x34, 0xAB, 0x56 };
@@ -1199,6 +1626,35 @@ public:
         Assert::AreEqual(std::wstring(L"13 11"), runtime.GetRichPresenceDisplayString());
     }
 
+    TEST_METHOD(TestRichPresenceDisplayStringCachedPerFrame)
+    {
+        std::array<unsigned char, 5> memory{ 0x00, 0x12, 0x34, 0xAB, 0x56 };
+
+        AchievementRuntimeHarness runtime;
+        runtime.mockEmulatorContext.MockMemory(memory);
+
+        runtime.ActivateRichPresence("Format:Num\nFormatType:Value\n\nDisplay:\n@Num(0xH01)\n");
+        runtime.DoFrame();
+        Assert::AreEqual({ 1U }, runtime.GetFrameCount());
+        Assert::AreEqual(std::wstring(L"18"), runtime.GetRichPresenceDisplayString());
+
+        // modifying the memref outside of a frame should not cause the string to be re-evaluated
+        auto* pMemRef = &runtime.GetClient()->game->runtime.memrefs->memrefs.items[0];
+        pMemRef->value.value = 11;
+        Assert::AreEqual(std::wstring(L"18"), runtime.GetRichPresenceDisplayString());
+
+        // restoring state invalidates the cached value
+        runtime.LoadProgressFromBuffer(nullptr);
+        pMemRef->value.value = 11;
+        Assert::AreEqual(std::wstring(L"11"), runtime.GetRichPresenceDisplayString());
+
+        // processing a frame invalidates the cached value
+        memory.at(1) = 13;
+        runtime.DoFrame();
+        Assert::AreEqual({ 2U }, runtime.GetFrameCount());
+        Assert::AreEqual(std::wstring(L"13"), runtime.GetRichPresenceDisplayString());
+    }
+
     TEST_METHOD(TestActivateRichPresenceChange)
     {
         std::array<unsigned char, 5> memory{ 0x00, 0x12, 0x34, 0xAB, 0x56 };
@@ -58,11 +58,11 @@ public:
         mockFileSystem.CreateDirectory(L".\\RACache\\Data\\");
         SetupExpiration(mockFileSystem, L".\\RACache\\Data\\123.json", tExpire);
         SetupExpiration(mockFileSystem, L".\\RACache\\Data\\123-Rich.txt", tExpire);
-        SetupExpiration(mockFileSystem, L".\\RACache\\Data\\123-Notes.json", tExpire);
+        SetupExpiration(mockFileSystem, L".\\RACache\\Data\\123-Notes.bin", tExpire);
         SetupExpiration(mockFileSystem, L".\\RACache\\Data\\123-User.txt", tExpire);
         SetupExpiration(mockFileSystem, L".\\RACache\\Data\\456.json", tNotExpire);
         SetupExpiration(mockFileSystem, L".\\RACache\\Data\\456-Rich.txt", tNotExpire);
-        SetupExpiration(mockFileSystem, L".\\RACache\\Data\\456-Notes.json", tNotExpire);
+        SetupExpiration(mockFileSystem, L".\\RACache\\Data\\456-Notes.bin", tNotExpire);
         SetupExpiration(mockFileSystem, L".\\RACache\\Data\\456-User.txt", tNotExpire);
 
         mockFileSystem.CreateDirectory(L".\\RACache\\Bookmarks\\");
@@ -90,7 +90,7 @@ public:
         Assert::IsTrue(std::find(vFiles.begin(), vFiles.end(), L"123-User.txt") != vFiles.end()); // user file should not be deleted, regardless of age
         Assert::IsTrue(std::find(vFiles.begin(), vFiles.end(), L"456.json") != vFiles.end());
         Assert::IsTrue(std::find(vFiles.begin(), vFiles.end(), L"456-Rich.txt") != vFiles.end());
-        Assert::IsTrue(std::find(vFiles.begin(), vFiles.end(), L"456-Notes.json") != vFiles.end());
+        Assert::IsTrue(std::find(vFiles.begin(), vFiles.end(), L"456-Notes.bin") != vFiles.end());
         Assert::IsTrue(std::find(vFiles.begin(), vFiles.end(), L"456-User.txt") != vFiles.end());
 
         // bookmarks should never be deleted
@@ -111,7 +111,7 @@ public:
         MockFileSystem mockFileSystem;
         FileLocalStorage storage(mockFileSystem);
         Assert::AreEqual(storage.GetPath(ra::services::StorageItemType::GameData, L"12345"), std::wstring(L".\\RACache\\Data\\12345.json"));
-        Assert::AreEqual(storage.GetPath(ra::services::StorageItemType::CodeNotes, L"12345"), std::wstring(L".\\RACache\\Data\\12345-Notes.json"));
+        Assert::AreEqual(storage.GetPath(ra::services::StorageItemType::CodeNotes, L"12345"), std::wstring(L".\\RACache\\Data\\12345-Notes.bin"));
         Assert::AreEqual(storage.GetPath(ra::services::StorageItemType::RichPresence, L"12345"), std::wstring(L".\\RACache\\Data\\12345-Rich.txt"));
         Assert::AreEqual(storage.GetPath(ra::services::StorageItemType::UserAchievements, L"12345"), std::wstring(L".\\RACache\\Data\\12345-User.txt"));
         Assert::AreEqual(storage.GetPath(ra::services::StorageItemType::Badge, L"12345"), std::wstring(L".\\RACache\\Badge\\12345.png"));
@@ -157,6 +157,54 @@ public:
         pData->Write("{\"Key\": 1}");
         Assert::AreEqual(std::string("{\"Key\": 1}"), mockFileSystem.GetFileContents(L".\\RACache\\Data\\12345.json"));
     }
+
+    TEST_METHOD(TestMove)
+    {
+        MockFileSystem mockFileSystem;
+        FileLocalStorage storage(mockFileSystem);
+
+        mockFileSystem.MockFile(L".\\RACache\\User-history.txt", "old");
+        mockFileSystem.MockFile(L".\\RACache\\User.tmp-history.txt", "new");
+
+        Assert::IsTrue(storage.Move(ra::services::StorageItemType::SessionStats, L"User.tmp", L"User"));
+        Assert::AreEqual(std::string("new"), mockFileSystem.GetFileContents(L".\\RACache\\User-history.txt"));
+        Assert::AreEqual({ -1 }, mockFileSystem.GetFileSize(L".\\RACache\\User.tmp-history.txt"));
+
+        Assert::IsFalse(storage.Move(ra::services::StorageItemType::SessionStats, L"User.tmp", L"User"));
+        Assert::AreEqual(std::string("new"), mockFileSystem.GetFileContents(L".\\RACache\\User-history.txt"));
+    }
+
+    TEST_METHOD(TestGetChangeGeneration)
+    {
+        MockFileSystem mockFileSystem;
+        FileLocalStorage storage(mockFileSystem);
+        const std::wstring sPath = L".\\RACache\\Data\\12345-Rich.txt";
+        const auto tNow = std::chrono::system_clock::now();
+
+        // file doesn't exist
+        Assert::AreEqual({ 0U }, storage.GetChangeGeneration(ra::services::StorageItemType::RichPresence, L"12345"));
+
+        // file created
+        mockFileSystem.MockFile(sPath, "Display:\nHello");
+        mockFileSystem.MockLastModified(sPath, tNow);
+        const auto nGeneration = storage.GetChangeGeneration(ra::services::StorageItemType::RichPresence, L"12345");
+        Assert::AreNotEqual({ 0U }, nGeneration);
+        Assert::AreEqual(nGeneration, storage.GetChangeGeneration(ra::services::StorageItemType::RichPresence, L"12345"));
+
+        // another file in the same directory changed
+        mockFileSystem.MockFile(L".\\RACache\\Data\\12345.json", "{}");
+        Assert::AreEqual(nGeneration, storage.GetChangeGeneration(ra::services::StorageItemType::RichPresence, L"12345"));
+
+        // file modified
+        mockFileSystem.MockLastModified(sPath, tNow + std::chrono::seconds(5));
+        const auto nGeneration2 = storage.GetChangeGeneration(ra::services::StorageItemType::RichPresence, L"12345");
+        Assert::AreNotEqual(nGeneration, nGeneration2);
+        Assert::AreEqual(nGeneration2, storage.GetChangeGeneration(ra::services::StorageItemType::RichPresence, L"12345"));
+
+        // file deleted
+        mockFileSystem.DeleteFile(sPath);
+        Assert::AreNotEqual(nGeneration2, storage.GetChangeGeneration(ra::services::StorageItemType::RichPresence, L"12345"));
+    }
 };
 
 } // namespace tests
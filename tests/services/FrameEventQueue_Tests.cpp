@@ -1,8 +1,11 @@
 #include "services\FrameEventQueue.hh"
 
+#include "..\RA_UnitTestHelpers.h"
+
 #include "tests\ui\UIAsserts.hh"
 #include "tests\mocks\MockDesktop.hh"
 #include "tests\mocks\MockEmulatorContext.hh"
+#include "tests\mocks\MockGameContext.hh"
 #include "tests\mocks\MockWindowManager.hh"
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
@@ -17,12 +20,40 @@ private:
     class FrameEventQueueHarness : public FrameEventQueue
     {
     public:
+        FrameEventQueueHarness() = default;
+        explicit FrameEventQueueHarness(size_t nCapacity) : FrameEventQueue(nCapacity) {}
+
         ra::data::context::mocks::MockEmulatorContext mockEmulatorContext;
         ra::ui::mocks::MockDesktop mockDesktop;
 
-        size_t NumTriggeredTriggers() const noexcept { return m_vTriggeredTriggers.size(); }
-        size_t NumResetTriggers() const noexcept { return m_vResetTriggers.size(); }
-        size_t NumMemoryChanges() const noexcept { return m_vMemChanges.size(); }
+        size_t NumTriggeredTriggers() const { return CountPendingEvents(EventType::TriggerTriggered); }
+        size_t NumResetTriggers() const { return CountPendingEvents(EventType::TriggerReset); }
+        size_t NumFunctions() const { return CountPendingEvents(EventType::Function); }
+
+        size_t NumMemoryChanges() const
+        {
+            std::set<std::wstring> vMemChanges;
+            ForEachPendingEvent([&vMemChanges](const Event& pEvent) {
+                if (pEvent.nType == EventType::MemoryChanged)
+                    vMemChanges.insert(pEvent.sDescription);
+            });
+
+            return vMemChanges.size();
+        }
+
+        using FrameEventQueue::GetOverflowCount;
+
+    private:
+        size_t CountPendingEvents(EventType nType) const
+        {
+            size_t nCount = 0;
+            ForEachPendingEvent([&nCount, nType](const Event& pEvent) {
+                if (pEvent.nType == nType)
+                    ++nCount;
+            });
+
+            return nCount;
+        }
     };
 
 public:
@@ -271,6 +302,257 @@ public:
         Assert::AreEqual({ 0U }, eventQueue.NumResetTriggers());
         Assert::AreEqual({ 0U }, eventQueue.NumTriggeredTriggers());
     }
+
+    TEST_METHOD(TestPauseOnAssetId)
+    {
+        FrameEventQueueHarness eventQueue;
+        ra::data::context::mocks::MockGameContext mockGameContext;
+        int nPaused = 0;
+        eventQueue.mockEmulatorContext.SetPauseFunction([&nPaused]() { ++nPaused; });
+
+        auto& pAchievement = mockGameContext.Assets().NewAchievement();
+        pAchievement.SetName(L"Achievement");
+        auto& pLeaderboard = mockGameContext.Assets().NewLeaderboard();
+        pLeaderboard.SetName(L"Leaderboard");
+
+        bool bSawDialog = false;
+        eventQueue.mockDesktop.ExpectWindow<ra::ui::viewmodels::MessageBoxViewModel>([&bSawDialog](ra::ui::viewmodels::MessageBoxViewModel& vmMessageBox)
+        {
+            bSawDialog = true;
+
+            Assert::AreEqual(std::wstring(L"The emulator has been paused."), vmMessageBox.GetHeader());
+            Assert::AreEqual(std::wstring(
+                L"The following triggers have triggered:\n* Renamed\n* Submit: Leaderboard"
+                L"\nThe following triggers have been reset:\n* Start: Leaderboard\n* Value: Leaderboard\n* Achievement 9999"),
+                vmMessageBox.GetMessage());
+
+            return ra::ui::DialogResult::OK;
+        });
+
+        eventQueue.QueuePauseOnTrigger(pAchievement.GetID());
+        eventQueue.QueuePauseOnTrigger(pLeaderboard.GetID(), ra::data::models::LeaderboardModel::LeaderboardParts::Submit);
+        eventQueue.QueuePauseOnReset(pLeaderboard.GetID(), ra::data::models::LeaderboardModel::LeaderboardParts::Start);
+        eventQueue.QueuePauseOnReset(pLeaderboard.GetID(), ra::data::models::LeaderboardModel::LeaderboardParts::Value);
+        eventQueue.QueuePauseOnReset(9999U); // unknown asset
+        Assert::AreEqual({ 2U }, eventQueue.NumTriggeredTriggers());
+        Assert::AreEqual({ 3U }, eventQueue.NumResetTriggers());
+
+        // names aren't looked up until the frame is processed
+        pAchievement.SetName(L"Renamed");
+
+        eventQueue.DoFrame();
+        Assert::IsTrue(bSawDialog);
+        Assert::AreEqual(1, nPaused);
+        Assert::AreEqual({ 0U }, eventQueue.NumTriggeredTriggers());
+        Assert::AreEqual({ 0U }, eventQueue.NumResetTriggers());
+    }
+
+    TEST_METHOD(TestQueueFunction)
+    {
+        FrameEventQueueHarness eventQueue;
+        std::vector<int> vCalls;
+
+        eventQueue.QueueFunction([&eventQueue, &vCalls]() {
+            vCalls.push_back(1);
+
+            // functions queued while processing the frame are not called until the next frame
+            eventQueue.QueueFunction([&vCalls]() { vCalls.push_back(3); });
+        });
+        eventQueue.QueueFunction([&vCalls]() { vCalls.push_back(2); });
+        Assert::AreEqual({ 2U }, eventQueue.NumFunctions());
+
+        eventQueue.DoFrame();
+        Assert::AreEqual({ 2U }, vCalls.size());
+        Assert::AreEqual(1, vCalls.at(0));
+        Assert::AreEqual(2, vCalls.at(1));
+        Assert::AreEqual({ 1U }, eventQueue.NumFunctions());
+
+        eventQueue.DoFrame();
+        Assert::AreEqual({ 3U }, vCalls.size());
+        Assert::AreEqual(3, vCalls.at(2));
+        Assert::AreEqual({ 0U }, eventQueue.NumFunctions());
+        Assert::IsFalse(eventQueue.mockDesktop.WasDialogShown());
+    }
+
+    TEST_METHOD(TestQueueFunctionMovesFunction)
+    {
+        FrameEventQueueHarness eventQueue;
+        auto pCounter = std::make_shared<int>(0);
+
+        std::function<void(void)> fAction = [pCounter]() { ++(*pCounter); };
+        Assert::AreEqual(2L, pCounter.use_count());
+
+        // the queued function should take ownership of the captured state rather than copying it
+        eventQueue.QueueFunction(std::move(fAction));
+        Assert::AreEqual(2L, pCounter.use_count());
+
+        eventQueue.DoFrame();
+        Assert::AreEqual(1, *pCounter);
+        Assert::AreEqual(1L, pCounter.use_count());
+    }
+
+    TEST_METHOD(TestOverflow)
+    {
+        FrameEventQueueHarness eventQueue(4);
+        bool bPaused = false;
+        eventQueue.mockEmulatorContext.SetPauseFunction([&bPaused]() { bPaused = true; });
+
+        bool bSawDialog = false;
+        eventQueue.mockDesktop.ExpectWindow<ra::ui::viewmodels::MessageBoxViewModel>([&bSawDialog](ra::ui::viewmodels::MessageBoxViewModel& vmMessageBox)
+        {
+            bSawDialog = true;
+
+            Assert::AreEqual(std::wstring(L"The following triggers have triggered:"
+                L"\n* 1\n* 2\n* 3\n* 4\n* 5\n* 6\n* 7\n* 8\n* 9\n* 10"), vmMessageBox.GetMessage());
+
+            return ra::ui::DialogResult::OK;
+        });
+
+        for (int i = 1; i <= 10; ++i)
+            eventQueue.QueuePauseOnTrigger(std::to_wstring(i));
+
+        Assert::AreEqual({ 10U }, eventQueue.NumTriggeredTriggers());
+        Assert::AreEqual({ 6U }, eventQueue.GetOverflowCount());
+
+        eventQueue.DoFrame();
+        Assert::IsTrue(bSawDialog);
+        Assert::IsTrue(bPaused);
+        Assert::AreEqual({ 0U }, eventQueue.NumTriggeredTriggers());
+
+        // ring buffer should be available again
+        for (int i = 1; i <= 4; ++i)
+            eventQueue.QueuePauseOnTrigger(std::to_wstring(i));
+
+        Assert::AreEqual({ 4U }, eventQueue.NumTriggeredTriggers());
+        Assert::AreEqual({ 6U }, eventQueue.GetOverflowCount());
+    }
+
+    TEST_METHOD(TestConcurrentProducers)
+    {
+        constexpr int nProducers = 8;
+        constexpr int nEventsPerProducer = 5000;
+
+        // a large ring buffer never overflows, so each producer's events must be processed in order.
+        // a small ring buffer overflows constantly, so just make sure each event is processed once.
+        for (const size_t nCapacity : { size_t{ nProducers * nEventsPerProducer }, size_t{ 64 } })
+        {
+            FrameEventQueueHarness eventQueue(nCapacity);
+
+            // only accessed by the consumer (this thread)
+            std::array<std::vector<int>, nProducers> vProcessed;
+            std::atomic<int> nProducersRunning{ nProducers };
+
+            std::vector<std::thread> vThreads;
+            for (int nProducer = 0; nProducer < nProducers; ++nProducer)
+            {
+                vThreads.emplace_back([&eventQueue, &vProcessed, &nProducersRunning, nProducer]() {
+                    auto& vEvents = gsl::at(vProcessed, nProducer);
+                    for (int i = 0; i < nEventsPerProducer; ++i)
+                        eventQueue.QueueFunction([&vEvents, i]() { vEvents.push_back(i); });
+
+                    --nProducersRunning;
+                });
+            }
+
+            int nFrames = 0;
+            while (nProducersRunning > 0)
+            {
+                eventQueue.DoFrame();
+                ++nFrames;
+            }
+
+            for (auto& pThread : vThreads)
+                pThread.join();
+
+            eventQueue.DoFrame();
+            Assert::AreEqual({ 0U }, eventQueue.NumFunctions());
+
+            for (auto& vEvents : vProcessed)
+            {
+                Assert::AreEqual(gsl::narrow_cast<size_t>(nEventsPerProducer), vEvents.size());
+
+                if (eventQueue.GetOverflowCount() == 0)
+                {
+                    for (int i = 0; i < nEventsPerProducer; ++i)
+                        Assert::AreEqual(i, vEvents.at(i));
+                }
+                else
+                {
+                    std::sort(vEvents.begin(), vEvents.end());
+                    for (int i = 0; i < nEventsPerProducer; ++i)
+                        Assert::AreEqual(i, vEvents.at(i));
+                }
+            }
+
+            Logger::WriteMessage(ra::StringPrintf("%d producers (capacity %zu): %d events in %d frames, %zu overflowed\n",
+                nProducers, nCapacity, nProducers * nEventsPerProducer, nFrames, eventQueue.GetOverflowCount()).c_str());
+        }
+    }
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(TestPerformance)
+        TEST_IGNORE()
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(TestPerformance)
+    {
+        constexpr int nEventsPerFrame = 100000;
+        constexpr int nFrames = 5;
+
+        ra::data::context::mocks::MockGameContext mockGameContext;
+        std::vector<ra::AchievementID> vIds;
+        std::vector<std::wstring> vNames;
+        for (int i = 0; i < 100; ++i)
+        {
+            auto& pAchievement = mockGameContext.Assets().NewAchievement();
+            pAchievement.SetName(ra::StringPrintf(L"Achievement number %d", i));
+            vIds.push_back(pAchievement.GetID());
+            vNames.push_back(pAchievement.GetName());
+        }
+
+        // by name is how events were queued before they could be queued by ID
+        for (const bool bById : { false, true })
+        {
+            for (const size_t nCapacity : { size_t{ 256 }, size_t{ nEventsPerFrame } })
+            {
+                FrameEventQueueHarness eventQueue(nCapacity);
+                size_t nMessageLength = 0;
+                eventQueue.mockDesktop.ExpectWindow<ra::ui::viewmodels::MessageBoxViewModel>([&nMessageLength](ra::ui::viewmodels::MessageBoxViewModel& vmMessageBox)
+                {
+                    nMessageLength = vmMessageBox.GetMessage().length();
+                    return ra::ui::DialogResult::OK;
+                });
+
+                std::chrono::steady_clock::duration tQueue{}, tDrain{};
+                for (int nFrame = 0; nFrame < nFrames; ++nFrame)
+                {
+                    const auto tStart = std::chrono::steady_clock::now();
+                    for (int i = 0; i < nEventsPerFrame; ++i)
+                    {
+                        if (bById)
+                            eventQueue.QueuePauseOnTrigger(vIds.at(i % vIds.size()));
+                        else
+                            eventQueue.QueuePauseOnTrigger(vNames.at(i % vNames.size()));
+                    }
+                    const auto tQueued = std::chrono::steady_clock::now();
+                    eventQueue.DoFrame();
+                    const auto tDrained = std::chrono::steady_clock::now();
+
+                    tQueue += tQueued - tStart;
+                    tDrain += tDrained - tQueued;
+
+                    Assert::AreEqual({ 0U }, eventQueue.NumTriggeredTriggers());
+                    Assert::IsTrue(nMessageLength > gsl::narrow_cast<size_t>(nEventsPerFrame) * 20);
+                }
+
+                // records that don't fit in the ring buffer have to be allocated. events queued by name also
+                // allocate a copy of the name.
+                Logger::WriteMessage(ra::StringPrintf("%s (capacity %zu): %d events/frame, queue %d us/frame, drain %d us/frame, %zu overflow allocations/frame\n",
+                    bById ? "by ID" : "by name", nCapacity, nEventsPerFrame,
+                    gsl::narrow_cast<int>(std::chrono::duration_cast<std::chrono::microseconds>(tQueue).count() / nFrames),
+                    gsl::narrow_cast<int>(std::chrono::duration_cast<std::chrono::microseconds>(tDrain).count() / nFrames),
+                    eventQueue.GetOverflowCount() / nFrames).c_str());
+            }
+        }
+    }
 };
 
 } // namespace tests
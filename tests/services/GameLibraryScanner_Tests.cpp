@@ -0,0 +1,271 @@
+#include "services\GameLibraryScanner.hh"
+
+#include "RA_md5factory.h"
+
+#include "tests\RA_UnitTestHelpers.h"
+
+#include "tests\mocks\MockFileSystem.hh"
+#include "tests\mocks\MockThreadPool.hh"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using ra::services::mocks::MockFileSystem;
+using ra::services::mocks::MockThreadPool;
+
+namespace ra {
+namespace services {
+namespace tests {
+
+TEST_CLASS(GameLibraryScanner_Tests)
+{
+private:
+    class GameLibraryScannerHarness : public GameLibraryScanner
+    {
+    public:
+        GameLibraryScannerHarness() noexcept
+        {
+            mockThreadPool.SetSynchronous(true);
+        }
+
+        MockFileSystem mockFileSystem;
+        MockThreadPool mockThreadPool;
+
+        std::string MockRom(const std::wstring& sPath, unsigned int nSeed)
+        {
+            std::string sContents;
+            sContents.resize(4096);
+            for (size_t i = 0; i < sContents.size(); ++i)
+                sContents.at(i) = gsl::narrow_cast<char>((i * 7 + nSeed) & 0xFF);
+            memcpy(sContents.data(), &nSeed, sizeof(nSeed));
+
+            mockFileSystem.MockFile(sPath, sContents);
+            mockFileSystem.MockLastModified(sPath, std::chrono::system_clock::time_point(std::chrono::seconds(1600000000 + nSeed)));
+            return RAGenerateMD5(sContents);
+        }
+
+        bool ScanAndWait(const std::wstring& sDirectory)
+        {
+            bool bComplete = false;
+            Scan(sDirectory, { L"gen" }, [&bComplete]() { bComplete = true; });
+
+            // process any queued work (in case synchronous mode was disabled)
+            while (mockThreadPool.PendingTasks() > 0)
+                mockThreadPool.ExecuteNextTask();
+
+            return bComplete;
+        }
+    };
+
+public:
+    TEST_METHOD(TestScanEmptyDirectory)
+    {
+        GameLibraryScannerHarness scanner;
+        scanner.mockFileSystem.CreateDirectory(L"C:\\Roms\\");
+
+        Assert::IsTrue(scanner.ScanAndWait(L"C:\\Roms"));
+        Assert::IsFalse(scanner.IsScanning());
+        Assert::AreEqual({ 0U }, scanner.GetResults().size());
+        Assert::AreEqual({ 0U }, scanner.GetHashedFileCount());
+    }
+
+    TEST_METHOD(TestScanFiltersByExtensionAndSize)
+    {
+        GameLibraryScannerHarness scanner;
+        scanner.mockFileSystem.CreateDirectory(L"C:\\Roms\\");
+        const auto sHash = scanner.MockRom(L"C:\\Roms\\game.gen", 1);
+        scanner.MockRom(L"C:\\Roms\\game.txt", 2);
+        scanner.mockFileSystem.MockFile(L"C:\\Roms\\tiny.gen", "too small");
+
+        Assert::IsTrue(scanner.ScanAndWait(L"C:\\Roms"));
+
+        const auto mResults = scanner.GetResults();
+        Assert::AreEqual({ 1U }, mResults.size());
+        Assert::AreEqual(sHash, mResults.at(L"C:\\Roms\\game.gen"));
+        Assert::AreEqual({ 1U }, scanner.GetHashedFileCount());
+    }
+
+    TEST_METHOD(TestScanExtensionIsCaseInsensitive)
+    {
+        GameLibraryScannerHarness scanner;
+        scanner.mockFileSystem.CreateDirectory(L"C:\\Roms\\");
+        const auto sHash = scanner.MockRom(L"C:\\Roms\\GAME.GEN", 1);
+
+        Assert::IsTrue(scanner.ScanAndWait(L"C:\\Roms\\"));
+
+        const auto mResults = scanner.GetResults();
+        Assert::AreEqual({ 1U }, mResults.size());
+        Assert::AreEqual(sHash, mResults.at(L"C:\\Roms\\GAME.GEN"));
+    }
+
+    TEST_METHOD(TestScanSubdirectories)
+    {
+        GameLibraryScannerHarness scanner;
+        scanner.mockFileSystem.CreateDirectory(L"C:\\Roms\\");
+        scanner.mockFileSystem.CreateDirectory(L"C:\\Roms\\A\\");
+        scanner.mockFileSystem.CreateDirectory(L"C:\\Roms\\A\\B\\");
+        const auto sHash1 = scanner.MockRom(L"C:\\Roms\\1.gen", 1);
+        const auto sHash2 = scanner.MockRom(L"C:\\Roms\\A\\2.gen", 2);
+        const auto sHash3 = scanner.MockRom(L"C:\\Roms\\A\\B\\3.gen", 3);
+
+        Assert::IsTrue(scanner.ScanAndWait(L"C:\\Roms"));
+
+        const auto mResults = scanner.GetResults();
+        Assert::AreEqual({ 3U }, mResults.size());
+        Assert::AreEqual(sHash1, mResults.at(L"C:\\Roms\\1.gen"));
+        Assert::AreEqual(sHash2, mResults.at(L"C:\\Roms\\A\\2.gen"));
+        Assert::AreEqual(sHash3, mResults.at(L"C:\\Roms\\A\\B\\3.gen"));
+    }
+
+    TEST_METHOD(TestRescanOnlyHashesChangedFiles)
+    {
+        GameLibraryScannerHarness scanner;
+        scanner.mockFileSystem.CreateDirectory(L"C:\\Roms\\");
+        scanner.MockRom(L"C:\\Roms\\1.gen", 1);
+        const auto sHash2 = scanner.MockRom(L"C:\\Roms\\2.gen", 2);
+
+        Assert::IsTrue(scanner.ScanAndWait(L"C:\\Roms"));
+        Assert::AreEqual({ 2U }, scanner.GetHashedFileCount());
+
+        Assert::IsTrue(scanner.ScanAndWait(L"C:\\Roms"));
+        Assert::AreEqual({ 0U }, scanner.GetHashedFileCount());
+
+        // same size, new timestamp
+        const auto sHash1 = scanner.MockRom(L"C:\\Roms\\1.gen", 7);
+        const auto sHash3 = scanner.MockRom(L"C:\\Roms\\3.gen", 3);
+        Assert::IsTrue(scanner.ScanAndWait(L"C:\\Roms"));
+        Assert::AreEqual({ 2U }, scanner.GetHashedFileCount());
+
+        const auto mResults = scanner.GetResults();
+        Assert::AreEqual({ 3U }, mResults.size());
+        Assert::AreEqual(sHash1, mResults.at(L"C:\\Roms\\1.gen"));
+        Assert::AreEqual(sHash2, mResults.at(L"C:\\Roms\\2.gen"));
+        Assert::AreEqual(sHash3, mResults.at(L"C:\\Roms\\3.gen"));
+    }
+
+    TEST_METHOD(TestCacheRoundTrip)
+    {
+        std::string sCache;
+        std::string sHash1, sHash2;
+        {
+            GameLibraryScannerHarness scanner;
+            scanner.mockFileSystem.CreateDirectory(L"C:\\Roms\\");
+            sHash1 = scanner.MockRom(L"C:\\Roms\\1.gen", 1);
+            sHash2 = scanner.MockRom(L"C:\\Roms\\2.gen", 2);
+
+            Assert::IsTrue(scanner.ScanAndWait(L"C:\\Roms"));
+            scanner.SaveCache(L"library.txt");
+            sCache = scanner.mockFileSystem.GetFileContents(L"library.txt");
+        }
+
+        GameLibraryScannerHarness scanner;
+        scanner.mockFileSystem.CreateDirectory(L"C:\\Roms\\");
+        scanner.MockRom(L"C:\\Roms\\1.gen", 1);
+        scanner.MockRom(L"C:\\Roms\\2.gen", 2);
+        scanner.mockFileSystem.MockFile(L"library.txt", sCache);
+        scanner.LoadCache(L"library.txt");
+
+        Assert::IsTrue(scanner.ScanAndWait(L"C:\\Roms"));
+        Assert::AreEqual({ 0U }, scanner.GetHashedFileCount());
+
+        const auto mResults = scanner.GetResults();
+        Assert::AreEqual({ 2U }, mResults.size());
+        Assert::AreEqual(sHash1, mResults.at(L"C:\\Roms\\1.gen"));
+        Assert::AreEqual(sHash2, mResults.at(L"C:\\Roms\\2.gen"));
+    }
+
+    TEST_METHOD(TestLoadCacheIgnoresLegacyFormat)
+    {
+        GameLibraryScannerHarness scanner;
+        scanner.mockFileSystem.CreateDirectory(L"C:\\Roms\\");
+        const auto sHash = scanner.MockRom(L"C:\\Roms\\1.gen", 1);
+        scanner.mockFileSystem.MockFile(L"library.txt", "C:\\Roms\\1.gen\n0123456789abcdef0123456789abcdef\n");
+        scanner.LoadCache(L"library.txt");
+
+        Assert::IsTrue(scanner.ScanAndWait(L"C:\\Roms"));
+        Assert::AreEqual({ 1U }, scanner.GetHashedFileCount());
+        Assert::AreEqual(sHash, scanner.GetResults().at(L"C:\\Roms\\1.gen"));
+    }
+
+    TEST_METHOD(TestScanIsBoundedByConcurrency)
+    {
+        GameLibraryScannerHarness scanner;
+        scanner.mockThreadPool.SetSynchronous(false);
+        scanner.SetMaxConcurrency(2);
+        scanner.mockFileSystem.CreateDirectory(L"C:\\Roms\\");
+        for (unsigned int i = 0; i < 10; ++i)
+            scanner.MockRom(ra::StringPrintf(L"C:\\Roms\\%u.gen", i), i);
+
+        bool bComplete = false;
+        scanner.Scan(L"C:\\Roms", { L"gen" }, [&bComplete]() { bComplete = true; });
+        Assert::IsTrue(scanner.IsScanning());
+
+        // enumeration task
+        Assert::AreEqual({ 1U }, scanner.mockThreadPool.PendingTasks());
+        scanner.mockThreadPool.ExecuteNextTask();
+
+        // only two workers should be queued, regardless of how many files need to be hashed
+        Assert::AreEqual({ 2U }, scanner.mockThreadPool.PendingTasks());
+        scanner.mockThreadPool.ExecuteNextTask();
+        Assert::IsFalse(bComplete);
+        scanner.mockThreadPool.ExecuteNextTask();
+        Assert::IsTrue(bComplete);
+
+        Assert::IsFalse(scanner.IsScanning());
+        Assert::AreEqual({ 10U }, scanner.GetHashedFileCount());
+        Assert::AreEqual({ 10U }, scanner.GetResults().size());
+    }
+
+    TEST_METHOD(TestCancel)
+    {
+        GameLibraryScannerHarness scanner;
+        scanner.mockThreadPool.SetSynchronous(false);
+        scanner.mockFileSystem.CreateDirectory(L"C:\\Roms\\");
+        scanner.MockRom(L"C:\\Roms\\1.gen", 1);
+
+        bool bComplete = false;
+        scanner.Scan(L"C:\\Roms", { L"gen" }, [&bComplete]() { bComplete = true; });
+        scanner.Cancel();
+
+        while (scanner.mockThreadPool.PendingTasks() > 0)
+            scanner.mockThreadPool.ExecuteNextTask();
+
+        Assert::IsTrue(bComplete);
+        Assert::IsFalse(scanner.IsScanning());
+        Assert::AreEqual({ 0U }, scanner.GetHashedFileCount());
+    }
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(TestColdAndWarmScanLargeLibrary)
+        TEST_IGNORE()
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(TestColdAndWarmScanLargeLibrary)
+    {
+        GameLibraryScannerHarness scanner;
+        scanner.mockFileSystem.CreateDirectory(L"C:\\Roms\\");
+        for (unsigned int i = 0; i < 50; ++i)
+        {
+            const auto sDirectory = ra::StringPrintf(L"C:\\Roms\\%u\\", i);
+            scanner.mockFileSystem.CreateDirectory(sDirectory);
+            for (unsigned int j = 0; j < 100; ++j)
+                scanner.MockRom(ra::StringPrintf(L"%s%u.gen", sDirectory, j), i * 100 + j);
+        }
+
+        const auto tColdStart = std::chrono::steady_clock::now();
+        Assert::IsTrue(scanner.ScanAndWait(L"C:\\Roms"));
+        const auto tColdElapsed = std::chrono::steady_clock::now() - tColdStart;
+        Assert::AreEqual({ 5000U }, scanner.GetHashedFileCount());
+
+        const auto tWarmStart = std::chrono::steady_clock::now();
+        Assert::IsTrue(scanner.ScanAndWait(L"C:\\Roms"));
+        const auto tWarmElapsed = std::chrono::steady_clock::now() - tWarmStart;
+        Assert::AreEqual({ 0U }, scanner.GetHashedFileCount());
+        Assert::AreEqual({ 5000U }, scanner.GetResults().size());
+
+        Logger::WriteMessage(ra::StringPrintf("5000 files: cold scan %llms, warm scan %llms\n",
+            std::chrono::duration_cast<std::chrono::milliseconds>(tColdElapsed).count(),
+            std::chrono::duration_cast<std::chrono::milliseconds>(tWarmElapsed).count()).c_str());
+    }
+};
+
+} // namespace tests
+} // namespace services
+} // namespace ra
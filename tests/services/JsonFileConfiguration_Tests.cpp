@@ -176,6 +176,11 @@ public:
         TestFeature(ra::services::Feature::PreferDecimal, "Prefer Decimal", false);
     }
 
+    TEST_METHOD(TestPooledHttpConnections)
+    {
+        TestFeature(ra::services::Feature::PooledHttpConnections, "Pooled HTTP Connections", false);
+    }
+
     void TestPopupLocation(ra::ui::viewmodels::Popup nPopup, const std::string& sJsonKey, ra::ui::viewmodels::PopupLocation nDefault)
     {
         MockFileSystem fileSystem;
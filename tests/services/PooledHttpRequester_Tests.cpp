@@ -0,0 +1,736 @@
+#include "CppUnitTest.h"
+
+#include "services\impl\PooledHttpRequester.hh"
+#include "services\impl\StringTextWriter.hh"
+
+#include "tests\mocks\MockHttpRequester.hh"
+#include "tests\mocks\MockThreadPool.hh"
+
+#include <thread>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using ra::services::impl::PooledHttpRequester;
+using ra::services::impl::StringTextWriter;
+using ra::services::impl::TcpSocket;
+using ra::services::mocks::MockHttpRequester;
+using ra::services::mocks::MockThreadPool;
+
+namespace ra {
+namespace services {
+namespace tests {
+
+TEST_CLASS(PooledHttpRequester_Tests)
+{
+private:
+    /// <summary>
+    /// Minimal HTTP/1.1 server running on the loopback interface. Responds to each request with
+    /// the method, path, and body of the request.
+    /// </summary>
+    class LoopbackHttpServer
+    {
+    public:
+        LoopbackHttpServer()
+        {
+            Assert::IsTrue(m_pListener.Listen());
+            m_nPort = m_pListener.GetLocalPort();
+            m_tAcceptThread = std::thread([this]() { AcceptConnections(); });
+        }
+
+        ~LoopbackHttpServer() noexcept
+        {
+            Stop();
+        }
+
+        LoopbackHttpServer(const LoopbackHttpServer&) noexcept = delete;
+        LoopbackHttpServer& operator=(const LoopbackHttpServer&) noexcept = delete;
+        LoopbackHttpServer(LoopbackHttpServer&&) noexcept = delete;
+        LoopbackHttpServer& operator=(LoopbackHttpServer&&) noexcept = delete;
+
+        std::string GetUrl(const char* sPath) const
+        {
+            return ra::StringPrintf("http://127.0.0.1:%u%s", m_nPort, sPath);
+        }
+
+        size_t GetConnectionCount() const noexcept { return m_nConnections; }
+        size_t GetRequestCount() const noexcept { return m_nRequests; }
+
+        /// <summary>
+        /// Closes each connection after it has processed the specified number of requests.
+        /// </summary>
+        /// <param name="bAnnounce">If <c>true</c>, the last response will include a "Connection: close" header.</param>
+        void SetMaxRequestsPerConnection(size_t nValue, bool bAnnounce) noexcept
+        {
+            m_nMaxRequestsPerConnection = nValue;
+            m_bAnnounceClose = bAnnounce;
+        }
+
+        void SetChunked(bool bValue) noexcept { m_bChunked = bValue; }
+
+        void Stop() noexcept
+        {
+            if (m_bStopping.exchange(true))
+                return;
+
+            // wake the accept thread
+            TcpSocket pWake;
+            pWake.Connect("127.0.0.1", m_nPort);
+            if (m_tAcceptThread.joinable())
+                m_tAcceptThread.join();
+
+            std::vector<ConnectionThread> vConnections;
+            {
+                std::lock_guard<std::mutex> lock(m_oMutex);
+                vConnections.swap(m_vConnections);
+            }
+
+            for (auto& pConnection : vConnections)
+            {
+                pConnection.pSocket->Shutdown();
+                pConnection.tThread.join();
+            }
+        }
+
+    private:
+        struct ConnectionThread
+        {
+            std::shared_ptr<TcpSocket> pSocket;
+            std::shared_ptr<std::atomic_bool> bDone;
+            std::thread tThread;
+        };
+
+        void AcceptConnections()
+        {
+            do
+            {
+                auto pSocket = std::make_shared<TcpSocket>(m_pListener.Accept());
+                if (m_bStopping || !pSocket->IsOpen())
+                    break;
+
+                ++m_nConnections;
+
+                std::lock_guard<std::mutex> lock(m_oMutex);
+
+                // clean up threads for connections that have been closed
+                for (auto pIter = m_vConnections.begin(); pIter != m_vConnections.end();)
+                {
+                    if (*pIter->bDone)
+                    {
+                        pIter->tThread.join();
+                        pIter = m_vConnections.erase(pIter);
+                    }
+                    else
+                    {
+                        ++pIter;
+                    }
+                }
+
+                auto& pConnection = m_vConnections.emplace_back();
+                pConnection.pSocket = pSocket;
+                pConnection.bDone = std::make_shared<std::atomic_bool>(false);
+                pConnection.tThread = std::thread([this, pSocket, bDone = pConnection.bDone]() {
+                    ProcessRequests(*pSocket);
+                    *bDone = true;
+                });
+            } while (true);
+        }
+
+        void ProcessRequests(TcpSocket& pSocket)
+        {
+            std::string sBuffer;
+            std::array<char, 4096> pChunk{};
+            size_t nRequests = 0;
+
+            do
+            {
+                auto nHeaderEnd = sBuffer.find("\r\n\r\n");
+                while (nHeaderEnd == std::string::npos)
+                {
+                    const auto nReceived = pSocket.Receive(pChunk.data(), pChunk.size());
+                    if (nReceived <= 0)
+                        return;
+
+                    sBuffer.append(pChunk.data(), gsl::narrow_cast<size_t>(nReceived));
+                    nHeaderEnd = sBuffer.find("\r\n\r\n");
+                }
+
+                const auto sHeaders = sBuffer.substr(0, nHeaderEnd);
+                sBuffer.erase(0, nHeaderEnd + 4);
+
+                size_t nContentLength = 0;
+                const auto nContentLengthIndex = sHeaders.find("\r\nContent-Length: ");
+                if (nContentLengthIndex != std::string::npos)
+                    nContentLength = std::stoul(sHeaders.substr(nContentLengthIndex + 18));
+
+                while (sBuffer.length() < nContentLength)
+                {
+                    const auto nReceived = pSocket.Receive(pChunk.data(), pChunk.size());
+                    if (nReceived <= 0)
+                        return;
+
+                    sBuffer.append(pChunk.data(), gsl::narrow_cast<size_t>(nReceived));
+                }
+
+                const auto sBody = sBuffer.substr(0, nContentLength);
+                sBuffer.erase(0, nContentLength);
+
+                ++m_nRequests;
+                ++nRequests;
+
+                // "POST /path HTTP/1.1" => "POST /path"
+                std::string sContent = sHeaders.substr(0, sHeaders.find(" HTTP/1.1"));
+                if (!sBody.empty())
+                {
+                    sContent.push_back(':');
+                    sContent.append(sBody);
+                }
+
+                const bool bNotFound = (sContent.find(" /missing") != std::string::npos);
+                const bool bClose = (m_nMaxRequestsPerConnection != 0 && nRequests == m_nMaxRequestsPerConnection) ||
+                                    (sHeaders.find("\r\nConnection: close") != std::string::npos);
+
+                std::string sResponse = bNotFound ? "HTTP/1.1 404 Not Found\r\n" : "HTTP/1.1 200 OK\r\n";
+                if (bClose && m_bAnnounceClose)
+                    sResponse.append("Connection: close\r\n");
+
+                if (m_bChunked)
+                {
+                    sResponse.append("Transfer-Encoding: chunked\r\n\r\n");
+                    const auto nHalf = sContent.length() / 2;
+                    sResponse.append(ra::StringPrintf("%x\r\n", nHalf));
+                    sResponse.append(sContent, 0, nHalf);
+                    sResponse.append(ra::StringPrintf("\r\n%x\r\n", sContent.length() - nHalf));
+                    sResponse.append(sContent, nHalf, std::string::npos);
+                    sResponse.append("\r\n0\r\n\r\n");
+                }
+                else
+                {
+                    sResponse.append(ra::StringPrintf("Content-Length: %zu\r\n\r\n", sContent.length()));
+                    sResponse.append(sContent);
+                }
+
+                if (!pSocket.Send(sResponse.data(), sResponse.length()))
+                    break;
+
+                if (bClose)
+                {
+                    // closing the socket with unread data would reset the connection, possibly before the client
+                    // reads the responses. if the client was told the connection is closing, wait for it to close.
+                    if (m_bAnnounceClose)
+                    {
+                        pSocket.SetTimeout(std::chrono::seconds(5));
+                        while (pSocket.Receive(pChunk.data(), pChunk.size()) > 0)
+                            continue;
+                    }
+
+                    break;
+                }
+            } while (true);
+
+            pSocket.Shutdown();
+        }
+
+        TcpSocket m_pListener;
+        unsigned short m_nPort = 0;
+        std::thread m_tAcceptThread;
+        std::atomic_bool m_bStopping{false};
+
+        std::mutex m_oMutex;
+        std::vector<ConnectionThread> m_vConnections;
+
+        std::atomic<size_t> m_nConnections{0};
+        std::atomic<size_t> m_nRequests{0};
+        size_t m_nMaxRequestsPerConnection = 0;
+        bool m_bAnnounceClose = true;
+        bool m_bChunked = false;
+    };
+
+    static constexpr int BENCHMARK_REQUESTS = 1000;
+    static constexpr int BENCHMARK_THREADS = 8;
+
+    static unsigned int Get(const PooledHttpRequester& pRequester, const std::string& sUrl, std::string& sContent)
+    {
+        sContent.clear();
+        StringTextWriter pWriter(sContent);
+        return pRequester.Request(Http::Request(sUrl), pWriter);
+    }
+
+    static unsigned int Post(const PooledHttpRequester& pRequester, const std::string& sUrl,
+                             const std::string& sPostData, std::string& sContent)
+    {
+        Http::Request pRequest(sUrl);
+        pRequest.SetPostData(sPostData);
+
+        sContent.clear();
+        StringTextWriter pWriter(sContent);
+        return pRequester.Request(pRequest, pWriter);
+    }
+
+public:
+    TEST_METHOD(TestGet)
+    {
+        LoopbackHttpServer server;
+        PooledHttpRequester requester;
+
+        std::string sContent;
+        Assert::AreEqual(200U, Get(requester, server.GetUrl("/dorequest.php?r=latestclient&e=0"), sContent));
+        Assert::AreEqual(std::string("GET /dorequest.php?r=latestclient&e=0"), sContent);
+    }
+
+    TEST_METHOD(TestPost)
+    {
+        LoopbackHttpServer server;
+        PooledHttpRequester requester;
+
+        std::string sContent;
+        Assert::AreEqual(200U, Post(requester, server.GetUrl("/dorequest.php"), "r=login&u=User", sContent));
+        Assert::AreEqual(std::string("POST /dorequest.php:r=login&u=User"), sContent);
+    }
+
+    TEST_METHOD(TestNotFound)
+    {
+        LoopbackHttpServer server;
+        PooledHttpRequester requester;
+
+        std::string sContent;
+        Assert::AreEqual(404U, Get(requester, server.GetUrl("/missing.php"), sContent));
+        Assert::AreEqual(std::string("GET /missing.php"), sContent);
+        Assert::AreEqual(std::string("Not Found"), requester.GetStatusCodeText(404));
+        Assert::IsFalse(requester.IsRetryable(404));
+    }
+
+    TEST_METHOD(TestChunkedResponse)
+    {
+        LoopbackHttpServer server;
+        server.SetChunked(true);
+        PooledHttpRequester requester;
+
+        std::string sContent;
+        Assert::AreEqual(200U, Post(requester, server.GetUrl("/dorequest.php"), "r=ping", sContent));
+        Assert::AreEqual(std::string("POST /dorequest.php:r=ping"), sContent);
+
+        // connection should still be usable after the chunked response
+        Assert::AreEqual(200U, Post(requester, server.GetUrl("/dorequest.php"), "r=ping2", sContent));
+        Assert::AreEqual(std::string("POST /dorequest.php:r=ping2"), sContent);
+        Assert::AreEqual({ 1U }, server.GetConnectionCount());
+    }
+
+    TEST_METHOD(TestConnectionReused)
+    {
+        LoopbackHttpServer server;
+        PooledHttpRequester requester;
+
+        std::string sContent;
+        for (int i = 0; i < 5; ++i)
+        {
+            Assert::AreEqual(200U, Post(requester, server.GetUrl("/dorequest.php"), ra::StringPrintf("i=%d", i), sContent));
+            Assert::AreEqual(ra::StringPrintf("POST /dorequest.php:i=%d", i), sContent);
+        }
+
+        Assert::AreEqual({ 1U }, requester.GetConnectionsOpened());
+        Assert::AreEqual({ 1U }, server.GetConnectionCount());
+        Assert::AreEqual({ 5U }, server.GetRequestCount());
+    }
+
+    TEST_METHOD(TestKeepAliveDisabled)
+    {
+        LoopbackHttpServer server;
+        PooledHttpRequester requester;
+        requester.SetKeepAlive(false);
+
+        std::string sContent;
+        for (int i = 0; i < 3; ++i)
+            Assert::AreEqual(200U, Get(requester, server.GetUrl("/index.html"), sContent));
+
+        Assert::AreEqual({ 3U }, requester.GetConnectionsOpened());
+        Assert::AreEqual({ 3U }, server.GetConnectionCount());
+    }
+
+    TEST_METHOD(TestServerAnnouncesClose)
+    {
+        LoopbackHttpServer server;
+        server.SetMaxRequestsPerConnection(2, true);
+        PooledHttpRequester requester;
+
+        std::string sContent;
+        for (int i = 0; i < 5; ++i)
+        {
+            Assert::AreEqual(200U, Get(requester, server.GetUrl(ra::StringPrintf("/%d", i).c_str()), sContent));
+            Assert::AreEqual(ra::StringPrintf("GET /%d", i), sContent);
+        }
+
+        Assert::AreEqual({ 3U }, requester.GetConnectionsOpened());
+        Assert::AreEqual({ 5U }, server.GetRequestCount());
+    }
+
+    TEST_METHOD(TestServerClosesIdleConnection)
+    {
+        LoopbackHttpServer server;
+        server.SetMaxRequestsPerConnection(1, false);
+        PooledHttpRequester requester;
+
+        // server closes the connection without telling the client. the client should discover the
+        // closed connection when it tries to reuse it, and send the request on a new connection.
+        std::string sContent;
+        for (int i = 0; i < 3; ++i)
+        {
+            Assert::AreEqual(200U, Get(requester, server.GetUrl(ra::StringPrintf("/%d", i).c_str()), sContent));
+            Assert::AreEqual(ra::StringPrintf("GET /%d", i), sContent);
+        }
+
+        Assert::AreEqual({ 3U }, requester.GetConnectionsOpened());
+        Assert::AreEqual({ 3U }, server.GetRequestCount());
+    }
+
+    TEST_METHOD(TestServerClosesIdleConnectionPostNotResent)
+    {
+        LoopbackHttpServer server;
+        server.SetMaxRequestsPerConnection(1, false);
+        PooledHttpRequester requester;
+
+        // the server may have processed a POST before closing the connection, so a failure on a reused
+        // connection is reported instead of sending the request again.
+        std::string sContent;
+        Assert::AreEqual(200U, Post(requester, server.GetUrl("/dorequest.php"), "i=0", sContent));
+        Assert::AreNotEqual(200U, Post(requester, server.GetUrl("/dorequest.php"), "i=1", sContent));
+        Assert::AreEqual({ 1U }, server.GetRequestCount());
+
+        // the failed connection is discarded
+        Assert::AreEqual(200U, Post(requester, server.GetUrl("/dorequest.php"), "i=2", sContent));
+        Assert::AreEqual(std::string("POST /dorequest.php:i=2"), sContent);
+        Assert::AreEqual({ 2U }, server.GetRequestCount());
+    }
+
+    TEST_METHOD(TestIdleTimeout)
+    {
+        LoopbackHttpServer server;
+        PooledHttpRequester requester;
+        requester.SetIdleTimeout(std::chrono::milliseconds(0));
+
+        std::string sContent;
+        Assert::AreEqual(200U, Get(requester, server.GetUrl("/1"), sContent));
+        Assert::AreEqual(200U, Get(requester, server.GetUrl("/2"), sContent));
+
+        Assert::AreEqual({ 2U }, requester.GetConnectionsOpened());
+    }
+
+    TEST_METHOD(TestCannotConnect)
+    {
+        std::string sUrl;
+        {
+            LoopbackHttpServer server;
+            sUrl = server.GetUrl("/");
+        }
+
+        PooledHttpRequester requester;
+        std::string sContent;
+        const auto nStatusCode = Get(requester, sUrl, sContent);
+        Assert::AreEqual(PooledHttpRequester::HTTP_ERROR_CANNOT_CONNECT, nStatusCode);
+        Assert::AreEqual(std::string(""), sContent);
+        Assert::IsTrue(requester.IsRetryable(nStatusCode));
+        Assert::AreEqual(std::string("A connection with the server could not be established"), requester.GetStatusCodeText(nStatusCode));
+    }
+
+    TEST_METHOD(TestSecureRequestUsesSecureRequester)
+    {
+        auto pSecureRequester = std::make_unique<MockHttpRequester>([](const Http::Request& request) {
+            return Http::Response(Http::StatusCode::OK, "secure:" + request.GetUrl());
+        });
+        PooledHttpRequester requester(std::move(pSecureRequester));
+        requester.SetUserAgent("Agent/1.0");
+
+        std::string sContent;
+        Assert::AreEqual(200U, Get(requester, "https://retroachievements.org/dorequest.php", sContent));
+        Assert::AreEqual(std::string("secure:https://retroachievements.org/dorequest.php"), sContent);
+        Assert::AreEqual({ 0U }, requester.GetConnectionsOpened());
+        Assert::AreEqual(std::string("err12175"), requester.GetStatusCodeText(12175));
+    }
+
+    TEST_METHOD(TestConnectionLimit)
+    {
+        LoopbackHttpServer server;
+        PooledHttpRequester requester;
+        requester.SetMaxConnectionsPerHost(2);
+
+        std::vector<std::thread> vThreads;
+        std::atomic<int> nSuccess{0};
+        for (int i = 0; i < 8; ++i)
+        {
+            vThreads.emplace_back([&requester, &server, &nSuccess, i]() {
+                std::string sContent;
+                for (int j = 0; j < 10; ++j)
+                {
+                    if (Post(requester, server.GetUrl("/dorequest.php"), ra::StringPrintf("%d.%d", i, j), sContent) == 200 &&
+                        sContent == ra::StringPrintf("POST /dorequest.php:%d.%d", i, j))
+                    {
+                        ++nSuccess;
+                    }
+                }
+            });
+        }
+
+        for (auto& pThread : vThreads)
+            pThread.join();
+
+        Assert::AreEqual(80, nSuccess.load());
+        Assert::IsTrue(requester.GetConnectionsOpened() <= 2);
+        Assert::IsTrue(server.GetConnectionCount() <= 2);
+    }
+
+    TEST_METHOD(TestRequestAsyncPipelined)
+    {
+        LoopbackHttpServer server;
+        MockThreadPool mockThreadPool;
+        PooledHttpRequester requester;
+        requester.SetMaxConnectionsPerHost(1);
+        requester.SetMaxPipelineDepth(4);
+
+        std::vector<std::string> vResponses;
+        for (int i = 0; i < 6; ++i)
+        {
+            Http::Request request(server.GetUrl(ra::StringPrintf("/%d", i).c_str()));
+            Assert::IsTrue(requester.RequestAsync(request, [&vResponses](unsigned int nStatusCode, std::string&& sContent) {
+                Assert::AreEqual(200U, nStatusCode);
+                vResponses.push_back(std::move(sContent));
+            }));
+        }
+
+        // a single connection is allowed, so a single dispatcher handles all of the requests
+        Assert::AreEqual({ 1U }, mockThreadPool.PendingTasks());
+        mockThreadPool.ExecuteNextTask();
+
+        Assert::AreEqual({ 6U }, vResponses.size());
+        for (int i = 0; i < 6; ++i)
+            Assert::AreEqual(ra::StringPrintf("GET /%d", i), vResponses.at(i));
+
+        Assert::AreEqual({ 1U }, requester.GetConnectionsOpened());
+        Assert::AreEqual({ 6U }, server.GetRequestCount());
+    }
+
+    TEST_METHOD(TestRequestAsyncPostsNotPipelined)
+    {
+        LoopbackHttpServer server;
+        server.SetMaxRequestsPerConnection(1, true);
+        MockThreadPool mockThreadPool;
+        PooledHttpRequester requester;
+        requester.SetMaxConnectionsPerHost(1);
+        requester.SetMaxPipelineDepth(4);
+
+        // the server closes the connection after each request. if the POSTs were pipelined, the unanswered
+        // ones would be failed rather than sent again. since each is sent by itself, they all succeed.
+        std::vector<std::string> vResponses;
+        for (int i = 0; i < 3; ++i)
+        {
+            Http::Request request(server.GetUrl("/dorequest.php"));
+            request.SetPostData(ra::StringPrintf("i=%d", i));
+            Assert::IsTrue(requester.RequestAsync(request, [&vResponses](unsigned int nStatusCode, std::string&& sContent) {
+                Assert::AreEqual(200U, nStatusCode);
+                vResponses.push_back(std::move(sContent));
+            }));
+        }
+
+        mockThreadPool.ExecuteNextTask();
+
+        Assert::AreEqual({ 3U }, vResponses.size());
+        for (int i = 0; i < 3; ++i)
+            Assert::AreEqual(ra::StringPrintf("POST /dorequest.php:i=%d", i), vResponses.at(i));
+
+        Assert::AreEqual({ 3U }, requester.GetConnectionsOpened());
+        Assert::AreEqual({ 3U }, server.GetRequestCount());
+    }
+
+    TEST_METHOD(TestRequestAsyncPostNotResent)
+    {
+        LoopbackHttpServer server;
+        server.SetMaxRequestsPerConnection(1, false);
+        MockThreadPool mockThreadPool;
+        PooledHttpRequester requester;
+        requester.SetMaxConnectionsPerHost(1);
+
+        // the server silently closes the connection after the first request. the second request is sent on the
+        // closed connection and fails. it's a POST, so it must not be sent again.
+        std::vector<unsigned int> vStatusCodes;
+        for (int i = 0; i < 2; ++i)
+        {
+            Http::Request request(server.GetUrl("/dorequest.php"));
+            request.SetPostData(ra::StringPrintf("i=%d", i));
+            Assert::IsTrue(requester.RequestAsync(request, [&vStatusCodes](unsigned int nStatusCode, std::string&&) {
+                vStatusCodes.push_back(nStatusCode);
+            }));
+        }
+
+        mockThreadPool.ExecuteNextTask();
+
+        Assert::AreEqual({ 2U }, vStatusCodes.size());
+        Assert::AreEqual(200U, vStatusCodes.at(0));
+        Assert::AreNotEqual(200U, vStatusCodes.at(1));
+        Assert::AreEqual({ 1U }, server.GetRequestCount());
+    }
+
+    TEST_METHOD(TestRequestAsyncRetriesUnansweredRequests)
+    {
+        LoopbackHttpServer server;
+        server.SetMaxRequestsPerConnection(2, true);
+        MockThreadPool mockThreadPool;
+        PooledHttpRequester requester;
+        requester.SetMaxConnectionsPerHost(1);
+        requester.SetMaxPipelineDepth(4);
+
+        // the server will only process two of the pipelined requests before closing the connection.
+        // the remaining requests should be sent again on a new connection.
+        std::vector<std::string> vResponses;
+        for (int i = 0; i < 5; ++i)
+        {
+            Http::Request request(server.GetUrl(ra::StringPrintf("/%d", i).c_str()));
+            Assert::IsTrue(requester.RequestAsync(request, [&vResponses](unsigned int nStatusCode, std::string&& sContent) {
+                Assert::AreEqual(200U, nStatusCode);
+                vResponses.push_back(std::move(sContent));
+            }));
+        }
+
+        mockThreadPool.ExecuteNextTask();
+
+        Assert::AreEqual({ 5U }, vResponses.size());
+        for (int i = 0; i < 5; ++i)
+            Assert::AreEqual(ra::StringPrintf("GET /%d", i), vResponses.at(i));
+
+        Assert::AreEqual({ 3U }, requester.GetConnectionsOpened());
+        Assert::AreEqual({ 5U }, server.GetRequestCount());
+    }
+
+    TEST_METHOD(TestRequestAsyncCannotConnect)
+    {
+        std::string sUrl;
+        {
+            LoopbackHttpServer server;
+            sUrl = server.GetUrl("/");
+        }
+
+        MockThreadPool mockThreadPool;
+        PooledHttpRequester requester;
+
+        unsigned int nResult = 0;
+        Assert::IsTrue(requester.RequestAsync(Http::Request(sUrl), [&nResult](unsigned int nStatusCode, std::string&&) {
+            nResult = nStatusCode;
+        }));
+
+        mockThreadPool.ExecuteNextTask();
+        Assert::AreEqual(PooledHttpRequester::HTTP_ERROR_CANNOT_CONNECT, nResult);
+    }
+
+    TEST_METHOD(TestCallAsyncUsesPipeline)
+    {
+        LoopbackHttpServer server;
+        MockThreadPool mockThreadPool;
+        PooledHttpRequester requester;
+        ra::services::ServiceLocator::ServiceOverride<ra::services::IHttpRequester> svcOverride(&requester);
+
+        std::string sResult;
+        Http::Request request(server.GetUrl("/dorequest.php"));
+        request.SetPostData("r=ping");
+        request.CallAsync([&sResult](const Http::Response& response) {
+            Assert::AreEqual(Http::StatusCode::OK, response.StatusCode());
+            sResult = response.Content();
+        });
+
+        Assert::AreEqual({ 1U }, mockThreadPool.PendingTasks());
+        mockThreadPool.ExecuteNextTask();
+        Assert::AreEqual(std::string("POST /dorequest.php:r=ping"), sResult);
+    }
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(TestFreshVersusPooledConnections)
+        TEST_IGNORE()
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(TestFreshVersusPooledConnections)
+    {
+        const auto fSequential = [](bool bKeepAlive) {
+            LoopbackHttpServer server;
+            PooledHttpRequester requester;
+            requester.SetKeepAlive(bKeepAlive);
+
+            const auto tStart = std::chrono::steady_clock::now();
+            std::string sContent;
+            for (int i = 0; i < BENCHMARK_REQUESTS; ++i)
+                Assert::AreEqual(200U, Post(requester, server.GetUrl("/dorequest.php"), "r=ping", sContent));
+            const auto tElapsed = std::chrono::steady_clock::now() - tStart;
+
+            Assert::AreEqual({ bKeepAlive ? 1U : gsl::narrow_cast<size_t>(BENCHMARK_REQUESTS) }, requester.GetConnectionsOpened());
+            return std::chrono::duration_cast<std::chrono::milliseconds>(tElapsed).count();
+        };
+
+        const auto fConcurrent = [](bool bKeepAlive) {
+            LoopbackHttpServer server;
+            PooledHttpRequester requester;
+            requester.SetKeepAlive(bKeepAlive);
+            requester.SetMaxConnectionsPerHost(BENCHMARK_THREADS);
+
+            std::atomic<int> nSuccess{0};
+            std::vector<std::thread> vThreads;
+            const auto tStart = std::chrono::steady_clock::now();
+            for (int i = 0; i < BENCHMARK_THREADS; ++i)
+            {
+                vThreads.emplace_back([&requester, &server, &nSuccess]() {
+                    std::string sContent;
+                    for (int j = 0; j < BENCHMARK_REQUESTS / BENCHMARK_THREADS; ++j)
+                    {
+                        if (Post(requester, server.GetUrl("/dorequest.php"), "r=ping", sContent) == 200)
+                            ++nSuccess;
+                    }
+                });
+            }
+
+            for (auto& pThread : vThreads)
+                pThread.join();
+            const auto tElapsed = std::chrono::steady_clock::now() - tStart;
+
+            Assert::AreEqual(BENCHMARK_REQUESTS, nSuccess.load());
+            if (bKeepAlive)
+                Assert::IsTrue(requester.GetConnectionsOpened() <= BENCHMARK_THREADS);
+            else
+                Assert::AreEqual({ gsl::narrow_cast<size_t>(BENCHMARK_REQUESTS) }, requester.GetConnectionsOpened());
+
+            return std::chrono::duration_cast<std::chrono::milliseconds>(tElapsed).count();
+        };
+
+        const auto fPipelined = []() {
+            LoopbackHttpServer server;
+            MockThreadPool mockThreadPool;
+            PooledHttpRequester requester;
+
+            int nSuccess = 0;
+            const auto tStart = std::chrono::steady_clock::now();
+            for (int i = 0; i < BENCHMARK_REQUESTS; ++i)
+            {
+                // only GETs are pipelined
+                Http::Request request(server.GetUrl("/dorequest.php?r=ping"));
+                requester.RequestAsync(request, [&nSuccess](unsigned int nStatusCode, std::string&&) {
+                    if (nStatusCode == 200)
+                        ++nSuccess;
+                });
+            }
+
+            while (mockThreadPool.PendingTasks() > 0)
+                mockThreadPool.ExecuteNextTask();
+            const auto tElapsed = std::chrono::steady_clock::now() - tStart;
+
+            Assert::AreEqual(BENCHMARK_REQUESTS, nSuccess);
+            return std::chrono::duration_cast<std::chrono::milliseconds>(tElapsed).count();
+        };
+
+        const auto nSequentialFresh = fSequential(false);
+        const auto nSequentialPooled = fSequential(true);
+        const auto nConcurrentFresh = fConcurrent(false);
+        const auto nConcurrentPooled = fConcurrent(true);
+        const auto nPipelined = fPipelined();
+
+        Logger::WriteMessage(ra::StringPrintf("%d sequential POSTs: fresh %llms, pooled %llms\n",
+            BENCHMARK_REQUESTS, nSequentialFresh, nSequentialPooled).c_str());
+        Logger::WriteMessage(ra::StringPrintf("%d concurrent POSTs: fresh %llms, pooled %llms\n",
+            BENCHMARK_REQUESTS, nConcurrentFresh, nConcurrentPooled).c_str());
+        Logger::WriteMessage(ra::StringPrintf("%d pipelined GETs: %llms\n", BENCHMARK_REQUESTS, nPipelined).c_str());
+    }
+};
+
+} // namespace tests
+} // namespace services
+} // namespace ra
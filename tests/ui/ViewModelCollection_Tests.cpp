@@ -139,6 +139,11 @@ TEST_CLASS(ViewModelCollection_Tests)
             Assert::AreEqual(std::string("~REMOVED~~ADDED~"), m_nChanges[nIndex]);
         }
 
+        void AssertItemRemovedAndChanged(gsl::index nIndex)
+        {
+            Assert::AreEqual(std::string("~REMOVED~~CHANGED~"), m_nChanges[nIndex]);
+        }
+
         void OnViewModelChanged(gsl::index nIndex) override
         {
             m_nChanges[nIndex] += "~CHANGED~";
@@ -168,6 +173,56 @@ TEST_CLASS(ViewModelCollection_Tests)
         std::map<gsl::index, std::string> m_nChanges;
     };
 
+    static void RemoveItems(int nItems)
+    {
+        for (const int nKeepEvery : { 2, 100 })
+        {
+            for (const bool bUseRemoveIf : { false, true })
+            {
+                ViewModelCollection<TestViewModel> vmCollection;
+                vmCollection.BeginUpdate();
+                for (int i = 0; i < nItems; ++i)
+                    vmCollection.Add(i, L"");
+                vmCollection.EndUpdate();
+
+                NotifyTargetHarness oNotify;
+                vmCollection.AddNotifyTarget(oNotify);
+
+                const auto tStart = std::chrono::steady_clock::now();
+                if (bUseRemoveIf)
+                {
+                    vmCollection.RemoveIf([nKeepEvery](const TestViewModel& vmItem) { return (vmItem.GetInt() % nKeepEvery) != 0; });
+                }
+                else
+                {
+                    vmCollection.BeginUpdate();
+                    for (gsl::index nIndex = nItems - 1; nIndex >= 0; --nIndex)
+                    {
+                        if ((nIndex % nKeepEvery) != 0)
+                            vmCollection.RemoveAt(nIndex);
+                    }
+                    vmCollection.EndUpdate();
+                }
+                const auto tElapsed = std::chrono::steady_clock::now() - tStart;
+
+                const auto nExpected = gsl::narrow_cast<size_t>(nItems / nKeepEvery);
+                Assert::AreEqual(nExpected, vmCollection.Count());
+                for (gsl::index nIndex = 0; nIndex < gsl::narrow_cast<gsl::index>(nExpected); ++nIndex)
+                    Assert::AreEqual(gsl::narrow_cast<int>(nIndex) * nKeepEvery, vmCollection.GetItemAt(nIndex)->GetInt());
+
+                // surviving items should not be reported as moved
+                oNotify.AssertItemNotChanged(0);
+                oNotify.AssertItemRemoved(1);
+                oNotify.AssertItemRemoved(nItems - 1);
+
+                const auto nMicroseconds = gsl::narrow_cast<int>(std::chrono::duration_cast<std::chrono::microseconds>(tElapsed).count());
+                Logger::WriteMessage(ra::StringPrintf("Removed %d of %d items via %s in %d microseconds\n",
+                                                      nItems - gsl::narrow_cast<int>(nExpected), nItems,
+                                                      bUseRemoveIf ? "RemoveIf" : "RemoveAt", nMicroseconds).c_str());
+            }
+        }
+    }
+
 public:
     TEST_METHOD(TestAddWithoutSubscription)
     {
@@ -846,6 +901,128 @@ public:
         oNotify.AssertItemChanged(4);
         oNotify.AssertItemChanged(5);
     }
+
+    TEST_METHOD(TestRemoveIf)
+    {
+        ViewModelCollection<TestViewModel> vmCollection;
+        vmCollection.Add(1, L"Test1");
+        vmCollection.Add(2, L"Test2");
+        vmCollection.Add(3, L"Test3");
+        vmCollection.Add(4, L"Test4");
+        auto& pItem5 = vmCollection.Add(5, L"Test5");
+
+        NotifyTargetHarness oNotify;
+        vmCollection.AddNotifyTarget(oNotify);
+
+        Assert::AreEqual({ 2U }, vmCollection.RemoveIf([](const TestViewModel& vmItem) { return vmItem.GetInt() % 2 == 0; }));
+        Assert::AreEqual({ 3U }, vmCollection.Count());
+        Assert::AreEqual(1, vmCollection.GetItemAt(0)->GetInt());
+        Assert::AreEqual(3, vmCollection.GetItemAt(1)->GetInt());
+        Assert::AreEqual(5, vmCollection.GetItemAt(2)->GetInt());
+
+        oNotify.AssertItemNotChanged(0);
+        oNotify.AssertItemRemoved(1);
+        oNotify.AssertItemNotChanged(2);
+        oNotify.AssertItemRemoved(3);
+        oNotify.AssertItemNotChanged(4);
+        oNotify.ResetChanges();
+
+        // remaining items should have been reindexed
+        pItem5.SetString(L"Test5b");
+        oNotify.AssertStringChanged(TestViewModel::StringProperty, 2, L"Test5", L"Test5b");
+
+        Assert::AreEqual({ 0U }, vmCollection.RemoveIf([](const TestViewModel&) { return false; }));
+        Assert::AreEqual({ 3U }, vmCollection.Count());
+        oNotify.AssertItemNotChanged(0);
+
+        Assert::AreEqual({ 3U }, vmCollection.RemoveIf([](const TestViewModel&) { return true; }));
+        Assert::AreEqual({ 0U }, vmCollection.Count());
+        oNotify.AssertItemRemoved(0);
+        oNotify.AssertItemRemoved(1);
+        oNotify.AssertItemRemoved(2);
+    }
+
+    TEST_METHOD(TestRemoveMiddleWhileUpdateSuspended)
+    {
+        ViewModelCollection<TestViewModel> vmCollection;
+        vmCollection.Add(1, L"Test1");
+        vmCollection.Add(2, L"Test2");
+        vmCollection.Add(3, L"Test3");
+        auto& pItem4 = vmCollection.Add(4, L"Test4");
+        vmCollection.Add(5, L"Test5");
+
+        NotifyTargetHarness oNotify;
+        vmCollection.AddNotifyTarget(oNotify);
+        vmCollection.BeginUpdate();
+
+        // remove from the front of the list so later removals are after the empty slots
+        vmCollection.RemoveAt(1);
+        vmCollection.RemoveAt(1);
+        Assert::AreEqual({ 3U }, vmCollection.Count());
+        Assert::AreEqual(4, vmCollection.GetItemAt(1)->GetInt());
+        Assert::AreEqual({ 2 }, vmCollection.FindItemIndex(TestViewModel::IntProperty, 5));
+
+        // item has moved, change event will be raised when the update completes
+        pItem4.SetString(L"Test4b");
+        oNotify.AssertNotChanged();
+
+        vmCollection.MoveItem(0, 2);
+        Assert::AreEqual(4, vmCollection.GetItemAt(0)->GetInt());
+        Assert::AreEqual(5, vmCollection.GetItemAt(1)->GetInt());
+        Assert::AreEqual(1, vmCollection.GetItemAt(2)->GetInt());
+
+        vmCollection.RemoveAt(1);
+        oNotify.AssertItemNotChanged(0);
+
+        vmCollection.EndUpdate();
+        Assert::AreEqual({ 2U }, vmCollection.Count());
+        Assert::AreEqual(4, vmCollection.GetItemAt(0)->GetInt());
+        Assert::AreEqual(1, vmCollection.GetItemAt(1)->GetInt());
+
+        // removing 2, 3 and 5 from the original list leaves [1, 4], which is then reordered to [4, 1]
+        oNotify.AssertItemChanged(0);
+        oNotify.AssertItemRemovedAndChanged(1);
+        oNotify.AssertItemRemoved(2);
+        oNotify.AssertItemNotChanged(3);
+        oNotify.AssertItemRemoved(4);
+        oNotify.AssertNotChanged();
+    }
+
+    TEST_METHOD(TestAddAndRemoveWhileUpdateSuspended)
+    {
+        ViewModelCollection<TestViewModel> vmCollection;
+        vmCollection.Add(1, L"Test1");
+        vmCollection.Add(2, L"Test2");
+
+        NotifyTargetHarness oNotify;
+        vmCollection.AddNotifyTarget(oNotify);
+        vmCollection.BeginUpdate();
+
+        vmCollection.Add(3, L"Test3");
+        vmCollection.RemoveAt(2);
+
+        vmCollection.EndUpdate();
+        Assert::AreEqual({ 2U }, vmCollection.Count());
+
+        // item was never reported as added, so it should not be reported as removed
+        oNotify.AssertItemNotChanged(0);
+        oNotify.AssertItemNotChanged(1);
+        oNotify.AssertItemNotChanged(2);
+        oNotify.AssertItemNotChanged(-1);
+    }
+
+    TEST_METHOD(TestRemoveMany)
+    {
+        RemoveItems(1000);
+    }
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(TestRemovePerformance)
+        TEST_IGNORE()
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(TestRemovePerformance)
+    {
+        RemoveItems(100000);
+    }
 };
 
 } // namespace tests
@@ -0,0 +1,432 @@
+#include "CppUnitTest.h"
+
+#include "ui\drawing\ImageCache.hh"
+
+#include "tests\RA_UnitTestHelpers.h"
+#include "tests\mocks\MockThreadPool.hh"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace ra {
+namespace ui {
+namespace drawing {
+namespace tests {
+
+TEST_CLASS(ImageCache_Tests)
+{
+private:
+    static constexpr size_t ImageBytes = 64 * 64 * 4;
+
+    class FakeDecoder : public ImageCache::Decoder
+    {
+    public:
+        ImageCache::ImageHandle Decode(ImageType, const std::string& sName, size_t& nBytes) override
+        {
+            ++nDecodeCount;
+            if (sName == "missing")
+                return 0;
+
+            nBytes = (sName == "large") ? ImageBytes * 8 : ImageBytes;
+            const auto hImage = ++nLastHandle;
+            vLiveImages.insert(hImage);
+            return hImage;
+        }
+
+        void Release(ImageCache::ImageHandle hImage) noexcept override
+        {
+            vLiveImages.erase(hImage);
+        }
+
+        void OnImageDecoded(ImageType, const std::string& sName) override
+        {
+            vDecoded.push_back(sName);
+        }
+
+        size_t nDecodeCount = 0;
+        ImageCache::ImageHandle nLastHandle = 0;
+        std::set<ImageCache::ImageHandle> vLiveImages;
+        std::vector<std::string> vDecoded;
+    };
+
+    class ImageCacheHarness : public ImageCache
+    {
+    public:
+        explicit ImageCacheHarness(size_t nImages, size_t nShards = 1)
+            : ImageCache(mockDecoder, nImages * ImageBytes, nShards)
+        {
+        }
+
+        ~ImageCacheHarness() noexcept
+        {
+            // the base class is destroyed after the decoder, so release the images while the decoder still exists
+            Clear();
+        }
+
+        ImageCacheHarness(const ImageCacheHarness&) noexcept = delete;
+        ImageCacheHarness& operator=(const ImageCacheHarness&) noexcept = delete;
+        ImageCacheHarness(ImageCacheHarness&&) noexcept = delete;
+        ImageCacheHarness& operator=(ImageCacheHarness&&) noexcept = delete;
+
+        FakeDecoder mockDecoder;
+        ra::services::mocks::MockThreadPool mockThreadPool;
+
+        /// <summary>
+        /// Requests an image, decodes it, and releases it so it's only held by the cache.
+        /// </summary>
+        ImageHandle Load(const std::string& sName)
+        {
+            Assert::AreEqual({ 0U }, Acquire(ImageType::Badge, sName));
+            mockThreadPool.ExecuteNextTask();
+
+            const auto hImage = Acquire(ImageType::Badge, sName);
+            Release(ImageType::Badge, sName);
+            return hImage;
+        }
+
+        bool IsDecoded(const std::string& sName) const { return ImageCache::IsDecoded(ImageType::Badge, sName); }
+    };
+
+public:
+    TEST_METHOD(TestAcquireDecodesInBackground)
+    {
+        ImageCacheHarness cache(4);
+        Assert::AreEqual({ 0U }, cache.Acquire(ImageType::Badge, "12345"));
+        Assert::IsFalse(cache.IsDecoded("12345"));
+        Assert::AreEqual({ 1U }, cache.mockThreadPool.PendingTasks());
+        Assert::AreEqual({ 0U }, cache.mockDecoder.nDecodeCount);
+
+        // asking again while the image is being decoded should not queue another request
+        Assert::AreEqual({ 0U }, cache.Acquire(ImageType::Badge, "12345"));
+        Assert::AreEqual({ 1U }, cache.mockThreadPool.PendingTasks());
+
+        cache.mockThreadPool.ExecuteNextTask();
+        Assert::AreEqual({ 1U }, cache.mockDecoder.nDecodeCount);
+        Assert::IsTrue(cache.IsDecoded("12345"));
+        Assert::AreEqual({ 1U }, cache.mockDecoder.vDecoded.size());
+        Assert::AreEqual(std::string("12345"), cache.mockDecoder.vDecoded.at(0));
+        Assert::AreEqual(ImageBytes, cache.GetMemoryUsage());
+
+        const auto hImage = cache.Acquire(ImageType::Badge, "12345");
+        Assert::AreEqual(cache.mockDecoder.nLastHandle, hImage);
+        Assert::AreEqual({ 0U }, cache.mockThreadPool.PendingTasks());
+        Assert::AreEqual({ 1U }, cache.mockDecoder.nDecodeCount);
+        cache.Release(ImageType::Badge, "12345");
+
+        // releasing the reference does not discard the image
+        Assert::IsTrue(cache.IsDecoded("12345"));
+        Assert::AreEqual(hImage, cache.Acquire(ImageType::Badge, "12345"));
+        cache.Release(ImageType::Badge, "12345");
+    }
+
+    TEST_METHOD(TestAcquireTypesAreDistinct)
+    {
+        ImageCacheHarness cache(4);
+        cache.Load("12345");
+
+        Assert::AreEqual({ 0U }, cache.Acquire(ImageType::Icon, "12345"));
+        Assert::AreEqual({ 1U }, cache.mockThreadPool.PendingTasks());
+        Assert::IsFalse(cache.ImageCache::IsDecoded(ImageType::Icon, "12345"));
+    }
+
+    TEST_METHOD(TestDecodeFailed)
+    {
+        ImageCacheHarness cache(4);
+        Assert::AreEqual({ 0U }, cache.Load("missing"));
+        Assert::AreEqual({ 1U }, cache.mockDecoder.nDecodeCount);
+        Assert::AreEqual({ 0U }, cache.mockDecoder.vDecoded.size());
+        Assert::IsFalse(cache.IsDecoded("missing"));
+        Assert::AreEqual({ 0U }, cache.GetMemoryUsage());
+
+        // failure is remembered so the image isn't decoded every time it's requested
+        Assert::AreEqual({ 0U }, cache.Acquire(ImageType::Badge, "missing"));
+        Assert::AreEqual({ 0U }, cache.mockThreadPool.PendingTasks());
+
+        // until the file changes
+        cache.Invalidate(ImageType::Badge, "missing");
+        Assert::AreEqual({ 0U }, cache.Acquire(ImageType::Badge, "missing"));
+        Assert::AreEqual({ 1U }, cache.mockThreadPool.PendingTasks());
+        cache.mockThreadPool.ExecuteNextTask();
+        Assert::AreEqual({ 2U }, cache.mockDecoder.nDecodeCount);
+    }
+
+    TEST_METHOD(TestAddReference)
+    {
+        ImageCacheHarness cache(1);
+
+        // not decoded, nothing to reference
+        cache.AddReference(ImageType::Badge, "A");
+        Assert::AreEqual({ 0U }, cache.mockThreadPool.PendingTasks());
+
+        cache.Load("A");
+        cache.AddReference(ImageType::Badge, "A");
+
+        // A is referenced, so B is discarded instead when it's no longer needed
+        Assert::AreNotEqual({ 0U }, cache.Load("B"));
+        Assert::IsTrue(cache.IsDecoded("A"));
+        Assert::IsFalse(cache.IsDecoded("B"));
+        Assert::AreEqual({ 1U }, cache.GetEvictionCount());
+
+        // A is within the budget, so releasing it does not discard it
+        cache.Release(ImageType::Badge, "A");
+        Assert::IsTrue(cache.IsDecoded("A"));
+        Assert::AreEqual({ 1U }, cache.GetEvictionCount());
+    }
+
+    TEST_METHOD(TestEvictsLeastRecentlyUsed)
+    {
+        ImageCacheHarness cache(3);
+        const auto hA = cache.Load("A");
+        const auto hB = cache.Load("B");
+        cache.Load("C");
+        Assert::AreEqual(ImageBytes * 3, cache.GetMemoryUsage());
+        Assert::AreEqual({ 3U }, cache.mockDecoder.vLiveImages.size());
+
+        // using A makes B the least recently used
+        Assert::AreEqual(hA, cache.Acquire(ImageType::Badge, "A"));
+        cache.Release(ImageType::Badge, "A");
+
+        cache.Load("D");
+        Assert::IsTrue(cache.IsDecoded("A"));
+        Assert::IsFalse(cache.IsDecoded("B"));
+        Assert::IsTrue(cache.IsDecoded("C"));
+        Assert::IsTrue(cache.IsDecoded("D"));
+        Assert::AreEqual(ImageBytes * 3, cache.GetMemoryUsage());
+        Assert::AreEqual({ 1U }, cache.GetEvictionCount());
+        Assert::AreEqual({ 3U }, cache.mockDecoder.vLiveImages.size());
+        Assert::IsTrue(cache.mockDecoder.vLiveImages.find(hB) == cache.mockDecoder.vLiveImages.end());
+
+        // requesting B again decodes it again
+        Assert::AreNotEqual(hB, cache.Load("B"));
+        Assert::IsFalse(cache.IsDecoded("C"));
+        Assert::AreEqual({ 2U }, cache.GetEvictionCount());
+    }
+
+    TEST_METHOD(TestReferencedImagesNotEvicted)
+    {
+        ImageCacheHarness cache(2);
+        cache.Load("A");
+        cache.Load("B");
+        const auto hA = cache.Acquire(ImageType::Badge, "A");
+        const auto hB = cache.Acquire(ImageType::Badge, "B");
+
+        // everything else is referenced, so the budget is exceeded rather than discarding images that are in use.
+        // the new image is kept too, or it would be discarded before it could be referenced.
+        Assert::AreEqual({ 0U }, cache.Acquire(ImageType::Badge, "C"));
+        cache.mockThreadPool.ExecuteNextTask();
+        Assert::IsTrue(cache.IsDecoded("C"));
+        const auto hC = cache.Acquire(ImageType::Badge, "C");
+        Assert::AreNotEqual({ 0U }, hC);
+        Assert::IsTrue(cache.IsDecoded("A"));
+        Assert::IsTrue(cache.IsDecoded("B"));
+        Assert::AreEqual(ImageBytes * 3, cache.GetMemoryUsage());
+        Assert::AreEqual({ 0U }, cache.GetEvictionCount());
+
+        // when a reference is released, the cache can get back within the budget
+        cache.Release(ImageType::Badge, "A");
+        Assert::IsFalse(cache.IsDecoded("A"));
+        Assert::IsTrue(cache.IsDecoded("B"));
+        Assert::IsTrue(cache.IsDecoded("C"));
+        Assert::AreEqual(ImageBytes * 2, cache.GetMemoryUsage());
+        Assert::AreEqual({ 1U }, cache.GetEvictionCount());
+        Assert::IsTrue(cache.mockDecoder.vLiveImages.find(hA) == cache.mockDecoder.vLiveImages.end());
+
+        // within the budget, releasing the other references does not discard anything
+        cache.Release(ImageType::Badge, "C");
+        cache.Release(ImageType::Badge, "B");
+        Assert::IsTrue(cache.IsDecoded("B"));
+        Assert::IsTrue(cache.IsDecoded("C"));
+        Assert::AreEqual(hB, cache.Acquire(ImageType::Badge, "B"));
+        Assert::AreEqual(hC, cache.Acquire(ImageType::Badge, "C"));
+        cache.Release(ImageType::Badge, "B");
+        cache.Release(ImageType::Badge, "C");
+    }
+
+    TEST_METHOD(TestInvalidate)
+    {
+        ImageCacheHarness cache(4);
+        const auto hA = cache.Load("A");
+        cache.Invalidate(ImageType::Badge, "A");
+        Assert::IsFalse(cache.IsDecoded("A"));
+        Assert::AreEqual({ 0U }, cache.GetMemoryUsage());
+        Assert::AreEqual({ 0U }, cache.mockDecoder.vLiveImages.size());
+
+        Assert::AreNotEqual(hA, cache.Load("A"));
+        Assert::AreEqual({ 2U }, cache.mockDecoder.nDecodeCount);
+    }
+
+    TEST_METHOD(TestInvalidateReferenced)
+    {
+        ImageCacheHarness cache(4);
+        cache.Load("A");
+        const auto hA = cache.Acquire(ImageType::Badge, "A");
+
+        // the handle is still in use, so it can't be freed
+        cache.Invalidate(ImageType::Badge, "A");
+        Assert::IsTrue(cache.IsDecoded("A"));
+        Assert::AreEqual(hA, cache.Acquire(ImageType::Badge, "A"));
+
+        cache.Release(ImageType::Badge, "A");
+        cache.Release(ImageType::Badge, "A");
+    }
+
+    TEST_METHOD(TestInvalidateWhileDecoding)
+    {
+        ImageCacheHarness cache(4);
+        Assert::AreEqual({ 0U }, cache.Acquire(ImageType::Badge, "A"));
+        cache.Invalidate(ImageType::Badge, "A");
+
+        // the first result is out of date, so it's discarded and the image is decoded again
+        cache.mockThreadPool.ExecuteNextTask();
+        Assert::AreEqual({ 2U }, cache.mockDecoder.nDecodeCount);
+        Assert::AreEqual({ 1U }, cache.mockDecoder.vLiveImages.size());
+        Assert::AreEqual({ 1U }, cache.mockDecoder.vDecoded.size());
+        Assert::AreEqual(cache.mockDecoder.nLastHandle, cache.Acquire(ImageType::Badge, "A"));
+        cache.Release(ImageType::Badge, "A");
+    }
+
+    TEST_METHOD(TestClear)
+    {
+        ImageCacheHarness cache(4);
+        cache.Load("A");
+        cache.Load("B");
+        Assert::AreNotEqual({ 0U }, cache.Acquire(ImageType::Badge, "A"));
+
+        // clear releases everything, even if it's referenced
+        cache.Clear();
+        Assert::AreEqual({ 0U }, cache.mockDecoder.vLiveImages.size());
+        Assert::AreEqual({ 0U }, cache.GetMemoryUsage());
+        Assert::IsFalse(cache.IsDecoded("A"));
+        Assert::IsFalse(cache.IsDecoded("B"));
+
+        // release after clear is ignored
+        cache.Release(ImageType::Badge, "A");
+    }
+
+    TEST_METHOD(TestClearWhileDecoding)
+    {
+        ImageCacheHarness cache(4);
+        Assert::AreEqual({ 0U }, cache.Acquire(ImageType::Badge, "A"));
+        cache.Clear();
+
+        // the decoded image has nowhere to go, so it should be released
+        cache.mockThreadPool.ExecuteNextTask();
+        Assert::AreEqual({ 1U }, cache.mockDecoder.nDecodeCount);
+        Assert::AreEqual({ 0U }, cache.mockDecoder.vLiveImages.size());
+        Assert::AreEqual({ 0U }, cache.mockDecoder.vDecoded.size());
+        Assert::IsFalse(cache.IsDecoded("A"));
+    }
+
+    TEST_METHOD(TestDestroyedWhileDecodeQueued)
+    {
+        FakeDecoder mockDecoder;
+        ra::services::mocks::MockThreadPool mockThreadPool;
+        auto pCache = std::make_unique<ImageCache>(mockDecoder, ImageBytes * 4);
+
+        Assert::AreEqual({ 0U }, pCache->Acquire(ImageType::Badge, "A"));
+        pCache.reset();
+
+        mockThreadPool.ExecuteNextTask();
+        Assert::AreEqual({ 0U }, mockDecoder.nDecodeCount);
+        Assert::AreEqual({ 0U }, mockDecoder.vDecoded.size());
+    }
+
+    TEST_METHOD(TestShardedBudget)
+    {
+        // the shards share the budget
+        ImageCacheHarness cache(64, 16);
+        Assert::AreEqual(ImageBytes * 64, cache.GetBudget());
+
+        for (int i = 0; i < 1000; ++i)
+            Assert::AreNotEqual({ 0U }, cache.Load(std::to_string(i)));
+
+        Assert::IsTrue(cache.GetMemoryUsage() <= cache.GetBudget());
+        Assert::AreEqual(cache.GetMemoryUsage() / ImageBytes, cache.mockDecoder.vLiveImages.size());
+        Assert::AreEqual(1000U - cache.mockDecoder.vLiveImages.size(), cache.GetEvictionCount());
+    }
+
+    TEST_METHOD(TestShardedBudgetLargeImage)
+    {
+        // a single image larger than the budget divided by the number of shards is kept
+        ImageCacheHarness cache(16, 16);
+        Assert::AreNotEqual({ 0U }, cache.Load("large"));
+        Assert::IsTrue(cache.IsDecoded("large"));
+        Assert::AreEqual(ImageBytes * 8, cache.GetMemoryUsage());
+
+        Assert::AreNotEqual({ 0U }, cache.Acquire(ImageType::Badge, "large"));
+        cache.Release(ImageType::Badge, "large");
+        Assert::AreEqual({ 1U }, cache.mockDecoder.nDecodeCount);
+        Assert::AreEqual({ 0U }, cache.GetEvictionCount());
+    }
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(TestPerformance)
+        TEST_IGNORE()
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(TestPerformance)
+    {
+        constexpr int nBadges = 10000;
+        constexpr size_t nBudget = 64 * 1024 * 1024;
+        constexpr int nVisible = 100;
+
+        FakeDecoder mockDecoder;
+        ra::services::mocks::MockThreadPool mockThreadPool;
+        mockThreadPool.SetSynchronous(true);
+        ImageCache cache(mockDecoder, nBudget);
+
+        std::vector<std::string> vNames;
+        vNames.reserve(nBadges);
+        for (int i = 0; i < nBadges; ++i)
+            vNames.push_back(ra::StringPrintf("%06d", i));
+
+        // first request decodes the badge, second request picks up the decoded image. keep the most recent
+        // badges referenced, as if they were on screen.
+        const auto tStart = std::chrono::steady_clock::now();
+        for (int i = 0; i < nBadges; ++i)
+        {
+            const auto& sName = vNames.at(i);
+            Assert::AreEqual({ 0U }, cache.Acquire(ImageType::Badge, sName));
+            Assert::AreNotEqual({ 0U }, cache.Acquire(ImageType::Badge, sName));
+
+            if (i >= nVisible)
+                cache.Release(ImageType::Badge, vNames.at(gsl::narrow_cast<size_t>(i) - nVisible));
+        }
+        const auto tLoaded = std::chrono::steady_clock::now();
+
+        Assert::AreEqual(gsl::narrow_cast<size_t>(nBadges), mockDecoder.nDecodeCount);
+        Assert::IsTrue(cache.GetMemoryUsage() <= nBudget);
+        Assert::AreEqual(cache.GetMemoryUsage() / ImageBytes, mockDecoder.vLiveImages.size());
+        Assert::AreEqual(gsl::narrow_cast<size_t>(nBadges) - mockDecoder.vLiveImages.size(), cache.GetEvictionCount());
+
+        // the visible badges are requested every frame
+        constexpr int nFrames = 1000;
+        for (int nFrame = 0; nFrame < nFrames; ++nFrame)
+        {
+            for (int i = nBadges - nVisible; i < nBadges; ++i)
+            {
+                const auto& sName = vNames.at(i);
+                Assert::AreNotEqual({ 0U }, cache.Acquire(ImageType::Badge, sName));
+                cache.Release(ImageType::Badge, sName);
+            }
+        }
+        const auto tFrames = std::chrono::steady_clock::now();
+
+        Assert::AreEqual(gsl::narrow_cast<size_t>(nBadges), mockDecoder.nDecodeCount);
+
+        Logger::WriteMessage(ra::StringPrintf("%d badges under %zu MiB budget: load %d us, %zu cached (%zu KiB), %zu evicted; %d lookups %d us\n",
+            nBadges, nBudget / (1024 * 1024),
+            gsl::narrow_cast<int>(std::chrono::duration_cast<std::chrono::microseconds>(tLoaded - tStart).count()),
+            mockDecoder.vLiveImages.size(), cache.GetMemoryUsage() / 1024, cache.GetEvictionCount(),
+            nFrames * nVisible,
+            gsl::narrow_cast<int>(std::chrono::duration_cast<std::chrono::microseconds>(tFrames - tLoaded).count())).c_str());
+
+        for (int i = nBadges - nVisible; i < nBadges; ++i)
+            cache.Release(ImageType::Badge, vNames.at(i));
+
+        cache.Clear();
+        Assert::AreEqual({ 0U }, mockDecoder.vLiveImages.size());
+    }
+};
+
+} // namespace tests
+} // namespace drawing
+} // namespace ui
+} // namespace ra
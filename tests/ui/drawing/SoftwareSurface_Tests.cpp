@@ -0,0 +1,386 @@
+#include "CppUnitTest.h"
+
+#include "tests\RA_UnitTestHelpers.h"
+#include "tests\mocks\MockFileSystem.hh"
+#include "tests\mocks\SoftwareSurface.hh"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace ra {
+namespace ui {
+namespace drawing {
+namespace mocks {
+namespace tests {
+
+TEST_CLASS(SoftwareSurface_Tests)
+{
+private:
+    static void AssertPixel(const SoftwareSurface& pSurface, int nX, int nY, uint32_t nExpected)
+    {
+        const auto nPixel = pSurface.GetPixel(nX, nY);
+        if (nPixel != nExpected)
+        {
+            Assert::Fail(ra::StringPrintf(L"Pixel %d,%d: expected %08X, found %08X",
+                nX, nY, nExpected, nPixel).c_str());
+        }
+    }
+
+    static size_t CountPixels(const SoftwareSurface& pSurface, uint32_t nColor)
+    {
+        const auto& vPixels = pSurface.GetPixels();
+        return gsl::narrow_cast<size_t>(std::count(vPixels.begin(), vPixels.end(), nColor));
+    }
+
+public:
+    TEST_METHOD(TestCreateSurface)
+    {
+        SoftwareSurfaceFactory pFactory;
+        auto pSurface = pFactory.CreateSurface(40, 30);
+        Assert::AreEqual(40U, pSurface->GetWidth());
+        Assert::AreEqual(30U, pSurface->GetHeight());
+
+        const auto& pSoftwareSurface = dynamic_cast<const SoftwareSurface&>(*pSurface);
+        Assert::IsFalse(pSoftwareSurface.IsTransparent());
+        Assert::AreEqual({ 40U * 30U }, CountPixels(pSoftwareSurface, 0U));
+
+        auto pTransparentSurface = pFactory.CreateTransparentSurface(10, 10);
+        Assert::IsTrue(dynamic_cast<const SoftwareSurface&>(*pTransparentSurface).IsTransparent());
+    }
+
+    TEST_METHOD(TestFillRectangle)
+    {
+        SoftwareSurface pSurface(20, 10, false, std::make_shared<SoftwareResources>());
+        pSurface.FillRectangle(2, 3, 4, 5, Color(0xFF102030));
+
+        Assert::AreEqual({ 20U }, CountPixels(pSurface, 0xFF102030));
+        AssertPixel(pSurface, 1, 3, 0U);
+        AssertPixel(pSurface, 2, 2, 0U);
+        AssertPixel(pSurface, 2, 3, 0xFF102030);
+        AssertPixel(pSurface, 5, 7, 0xFF102030);
+        AssertPixel(pSurface, 6, 7, 0U);
+        AssertPixel(pSurface, 5, 8, 0U);
+    }
+
+    TEST_METHOD(TestFillRectangleClipped)
+    {
+        SoftwareSurface pSurface(20, 10, false, std::make_shared<SoftwareResources>());
+        pSurface.FillRectangle(-5, -5, 10, 10, Color(0xFF0000FF));
+        Assert::AreEqual({ 25U }, CountPixels(pSurface, 0xFF0000FF));
+        AssertPixel(pSurface, 0, 0, 0xFF0000FF);
+        AssertPixel(pSurface, 4, 4, 0xFF0000FF);
+        AssertPixel(pSurface, 5, 5, 0U);
+
+        pSurface.FillRectangle(18, 8, 10, 10, Color(0xFF00FF00));
+        Assert::AreEqual({ 4U }, CountPixels(pSurface, 0xFF00FF00));
+
+        // entirely outside
+        pSurface.FillRectangle(20, 0, 10, 10, Color(0xFFFF0000));
+        pSurface.FillRectangle(0, -10, 10, 10, Color(0xFFFF0000));
+        pSurface.FillRectangle(0, 0, 0, 10, Color(0xFFFF0000));
+        Assert::AreEqual({ 0U }, CountPixels(pSurface, 0xFFFF0000));
+
+        // full surface
+        pSurface.FillRectangle(-1, -1, 100, 100, Color(0xFFFFFFFF));
+        Assert::AreEqual({ 200U }, CountPixels(pSurface, 0xFFFFFFFF));
+    }
+
+    TEST_METHOD(TestLoadFont)
+    {
+        SoftwareSurface pSurface(20, 10, false, std::make_shared<SoftwareResources>());
+        const auto nFont1 = pSurface.LoadFont("Tahoma", 16, FontStyles::Normal);
+        const auto nFont2 = pSurface.LoadFont("Arial", 16, FontStyles::Normal);
+        const auto nFont3 = pSurface.LoadFont("Tahoma", 16, FontStyles::Bold);
+        const auto nFont4 = pSurface.LoadFont("Tahoma", 26, FontStyles::Normal);
+        Assert::AreNotEqual(0, nFont1);
+        Assert::AreEqual(nFont1, nFont2); // face is ignored
+        Assert::AreNotEqual(nFont1, nFont3);
+        Assert::AreNotEqual(nFont1, nFont4);
+    }
+
+    TEST_METHOD(TestMeasureText)
+    {
+        SoftwareSurface pSurface(20, 10, false, std::make_shared<SoftwareResources>());
+
+        const auto nSmall = pSurface.LoadFont("Tahoma", 8, FontStyles::Normal);
+        auto szText = pSurface.MeasureText(nSmall, L"Hello");
+        Assert::AreEqual(30, szText.Width);
+        Assert::AreEqual(8, szText.Height);
+
+        const auto nLarge = pSurface.LoadFont("Tahoma", 16, FontStyles::Normal);
+        szText = pSurface.MeasureText(nLarge, L"Hello");
+        Assert::AreEqual(60, szText.Width);
+        Assert::AreEqual(16, szText.Height);
+
+        const auto nBold = pSurface.LoadFont("Tahoma", 16, FontStyles::Bold);
+        szText = pSurface.MeasureText(nBold, L"Hello");
+        Assert::AreEqual(70, szText.Width);
+        Assert::AreEqual(16, szText.Height);
+
+        szText = pSurface.MeasureText(nLarge, L"");
+        Assert::AreEqual(0, szText.Width);
+
+        szText = pSurface.MeasureText(99, L"Hello");
+        Assert::AreEqual(0, szText.Width);
+        Assert::AreEqual(0, szText.Height);
+    }
+
+    TEST_METHOD(TestWriteText)
+    {
+        SoftwareSurface pSurface(12, 8, false, std::make_shared<SoftwareResources>());
+        const auto nFont = pSurface.LoadFont("Tahoma", 8, FontStyles::Normal);
+        pSurface.WriteText(0, 0, nFont, Color(0xFFFFFFFF), L"I");
+
+        // I = center column, plus top and bottom bars
+        AssertPixel(pSurface, 1, 0, 0xFFFFFFFF);
+        AssertPixel(pSurface, 2, 0, 0xFFFFFFFF);
+        AssertPixel(pSurface, 3, 0, 0xFFFFFFFF);
+        AssertPixel(pSurface, 0, 0, 0U);
+        AssertPixel(pSurface, 4, 0, 0U);
+        AssertPixel(pSurface, 2, 3, 0xFFFFFFFF);
+        AssertPixel(pSurface, 1, 3, 0U);
+        AssertPixel(pSurface, 1, 6, 0xFFFFFFFF);
+        AssertPixel(pSurface, 2, 7, 0U);
+        Assert::AreEqual({ 11U }, CountPixels(pSurface, 0xFFFFFFFF));
+    }
+
+    TEST_METHOD(TestWriteTextClipped)
+    {
+        SoftwareSurface pSurface(12, 8, false, std::make_shared<SoftwareResources>());
+        const auto nFont = pSurface.LoadFont("Tahoma", 8, FontStyles::Normal);
+        pSurface.WriteText(-6, -2, nFont, Color(0xFFFFFFFF), L"IIII");
+
+        // first character is off the left edge, fourth character is off the right edge,
+        // and the top two rows of the other characters are off the top edge
+        AssertPixel(pSurface, 1, 4, 0xFFFFFFFF);
+        AssertPixel(pSurface, 2, 1, 0xFFFFFFFF);
+        AssertPixel(pSurface, 8, 1, 0xFFFFFFFF);
+        Assert::AreEqual({ 7U + 7U }, CountPixels(pSurface, 0xFFFFFFFF));
+    }
+
+    TEST_METHOD(TestWriteTextUnsupportedCharacter)
+    {
+        SoftwareSurface pSurface(6, 8, false, std::make_shared<SoftwareResources>());
+        const auto nFont = pSurface.LoadFont("Tahoma", 8, FontStyles::Normal);
+        pSurface.WriteText(0, 0, nFont, Color(0xFFFFFFFF), L"\x263A");
+
+        // box outline
+        Assert::AreEqual({ 20U }, CountPixels(pSurface, 0xFFFFFFFF));
+        AssertPixel(pSurface, 0, 0, 0xFFFFFFFF);
+        AssertPixel(pSurface, 4, 6, 0xFFFFFFFF);
+        AssertPixel(pSurface, 2, 3, 0U);
+    }
+
+    TEST_METHOD(TestDrawSurfaceOpaque)
+    {
+        auto pResources = std::make_shared<SoftwareResources>();
+        SoftwareSurface pSurface(10, 10, false, pResources);
+        pSurface.FillRectangle(0, 0, 10, 10, Color(0xFF000080));
+
+        SoftwareSurface pSource(4, 4, false, pResources);
+        pSource.FillRectangle(0, 0, 4, 4, Color(0x00FF0000));
+        pSurface.DrawSurface(8, 8, pSource);
+
+        // opaque surfaces are copied, including alpha
+        Assert::AreEqual({ 4U }, CountPixels(pSurface, 0x00FF0000));
+        AssertPixel(pSurface, 8, 8, 0x00FF0000);
+        AssertPixel(pSurface, 7, 8, 0xFF000080);
+    }
+
+    TEST_METHOD(TestDrawSurfaceTransparent)
+    {
+        auto pResources = std::make_shared<SoftwareResources>();
+        SoftwareSurface pSurface(10, 10, false, pResources);
+        pSurface.FillRectangle(0, 0, 10, 10, Color(0xFF000080));
+
+        SoftwareSurface pSource(3, 1, true, pResources);
+        pSource.FillRectangle(0, 0, 1, 1, Color(0x00FF0000));
+        pSource.FillRectangle(1, 0, 1, 1, Color(0xFFFF0000));
+        pSource.FillRectangle(2, 0, 1, 1, Color(0x80FF0000));
+        pSurface.DrawSurface(1, 1, pSource);
+
+        AssertPixel(pSurface, 1, 1, 0xFF000080); // fully transparent is ignored
+        AssertPixel(pSurface, 2, 1, 0xFFFF0000); // fully opaque is copied
+        AssertPixel(pSurface, 3, 1, 0xFF7F0040); // partially transparent is blended
+    }
+
+    TEST_METHOD(TestDrawSurfacePartial)
+    {
+        auto pResources = std::make_shared<SoftwareResources>();
+        SoftwareSurface pSurface(10, 10, false, pResources);
+
+        SoftwareSurface pSource(4, 4, false, pResources);
+        pSource.FillRectangle(0, 0, 2, 4, Color(0xFF0000FF));
+        pSource.FillRectangle(2, 0, 2, 4, Color(0xFF00FF00));
+        pSurface.DrawSurface(0, 0, pSource, 1, 1, 2, 2);
+
+        AssertPixel(pSurface, 0, 0, 0xFF0000FF);
+        AssertPixel(pSurface, 1, 0, 0xFF00FF00);
+        AssertPixel(pSurface, 0, 1, 0xFF0000FF);
+        AssertPixel(pSurface, 1, 1, 0xFF00FF00);
+        AssertPixel(pSurface, 2, 0, 0U);
+        AssertPixel(pSurface, 0, 2, 0U);
+
+        // requested area extends beyond source
+        pSurface.DrawSurface(5, 5, pSource, 3, 3, 4, 4);
+        AssertPixel(pSurface, 5, 5, 0xFF00FF00);
+        AssertPixel(pSurface, 6, 5, 0U);
+        AssertPixel(pSurface, 5, 6, 0U);
+    }
+
+    TEST_METHOD(TestSetOpacity)
+    {
+        SoftwareSurface pSurface(2, 1, true, std::make_shared<SoftwareResources>());
+        pSurface.FillRectangle(0, 0, 1, 1, Color(0xFF123456));
+        pSurface.SetOpacity(0.5);
+
+        AssertPixel(pSurface, 0, 0, 0x7F123456);
+        AssertPixel(pSurface, 1, 0, 0U); // transparent pixels remain transparent
+    }
+
+    TEST_METHOD(TestSetPixels)
+    {
+        SoftwareSurface pSurface(4, 4, false, std::make_shared<SoftwareResources>());
+        std::array<uint32_t, 6> pPixels{ 1, 2, 3, 4, 5, 6 };
+        pSurface.SetPixels(2, 1, 3, 2, pPixels.data());
+
+        // top-down, clipped to surface
+        AssertPixel(pSurface, 2, 1, 1U);
+        AssertPixel(pSurface, 3, 1, 2U);
+        AssertPixel(pSurface, 2, 2, 4U);
+        AssertPixel(pSurface, 3, 2, 5U);
+        Assert::AreEqual({ 12U }, CountPixels(pSurface, 0U));
+    }
+
+    TEST_METHOD(TestDrawImage)
+    {
+        SoftwareSurfaceFactory pFactory;
+        std::array<uint32_t, 4> pPixels{ 0xFF000001, 0xFF000002, 0xFF000003, 0xFF000004 };
+        pFactory.SetImage(ImageType::Badge, "12345", 2, 2, pPixels.data());
+
+        auto pSurface = pFactory.CreateSurface(4, 4);
+        pSurface->DrawImage(1, 1, 2, 2, ImageReference(ImageType::Badge, "12345"));
+
+        const auto& pSoftwareSurface = dynamic_cast<const SoftwareSurface&>(*pSurface);
+        AssertPixel(pSoftwareSurface, 1, 1, 0xFF000001);
+        AssertPixel(pSoftwareSurface, 2, 1, 0xFF000002);
+        AssertPixel(pSoftwareSurface, 1, 2, 0xFF000003);
+        AssertPixel(pSoftwareSurface, 2, 2, 0xFF000004);
+        Assert::AreEqual({ 12U }, CountPixels(pSoftwareSurface, 0U));
+    }
+
+    TEST_METHOD(TestDrawImageStretched)
+    {
+        SoftwareSurfaceFactory pFactory;
+        std::array<uint32_t, 4> pPixels{ 0xFF000001, 0xFF000002, 0xFF000003, 0xFF000004 };
+        pFactory.SetImage(ImageType::Badge, "12345", 2, 2, pPixels.data());
+
+        auto pSurface = pFactory.CreateSurface(4, 4);
+        pSurface->DrawImageStretched(0, 0, 4, 4, ImageReference(ImageType::Badge, "12345"));
+
+        const auto& pSoftwareSurface = dynamic_cast<const SoftwareSurface&>(*pSurface);
+        Assert::AreEqual({ 4U }, CountPixels(pSoftwareSurface, 0xFF000001));
+        Assert::AreEqual({ 4U }, CountPixels(pSoftwareSurface, 0xFF000002));
+        Assert::AreEqual({ 4U }, CountPixels(pSoftwareSurface, 0xFF000003));
+        Assert::AreEqual({ 4U }, CountPixels(pSoftwareSurface, 0xFF000004));
+        AssertPixel(pSoftwareSurface, 1, 1, 0xFF000001);
+        AssertPixel(pSoftwareSurface, 2, 1, 0xFF000002);
+        AssertPixel(pSoftwareSurface, 1, 2, 0xFF000003);
+        AssertPixel(pSoftwareSurface, 3, 3, 0xFF000004);
+    }
+
+    TEST_METHOD(TestDrawImagePlaceholder)
+    {
+        SoftwareSurfaceFactory pFactory;
+        auto pSurface = pFactory.CreateSurface(8, 4);
+        pSurface->DrawImage(0, 0, 4, 4, ImageReference(ImageType::Badge, "12345"));
+        pSurface->DrawImage(4, 0, 4, 4, ImageReference(ImageType::Badge, "54321"));
+
+        // unknown images are drawn as an opaque block whose color is derived from the name
+        const auto& pSoftwareSurface = dynamic_cast<const SoftwareSurface&>(*pSurface);
+        const auto nColor1 = pSoftwareSurface.GetPixel(0, 0);
+        const auto nColor2 = pSoftwareSurface.GetPixel(4, 0);
+        Assert::AreEqual(0xFF000000U, nColor1 & 0xFF000000U);
+        Assert::AreNotEqual(nColor1, nColor2);
+        Assert::AreEqual({ 16U }, CountPixels(pSoftwareSurface, nColor1));
+        Assert::AreEqual({ 16U }, CountPixels(pSoftwareSurface, nColor2));
+
+        // no image
+        pSurface->DrawImage(0, 0, 4, 4, ImageReference());
+        AssertPixel(pSoftwareSurface, 0, 0, nColor1);
+    }
+
+    TEST_METHOD(TestPixelHash)
+    {
+        auto pResources = std::make_shared<SoftwareResources>();
+        SoftwareSurface pSurface1(4, 4, false, pResources);
+        SoftwareSurface pSurface2(4, 4, false, pResources);
+        SoftwareSurface pSurface3(2, 8, false, pResources);
+        Assert::AreEqual(pSurface1.GetPixelHash(), pSurface2.GetPixelHash());
+        Assert::AreNotEqual(pSurface1.GetPixelHash(), pSurface3.GetPixelHash());
+
+        pSurface2.FillRectangle(3, 3, 1, 1, Color(0xFF000001));
+        Assert::AreNotEqual(pSurface1.GetPixelHash(), pSurface2.GetPixelHash());
+    }
+
+    TEST_METHOD(TestGoldenText)
+    {
+        SoftwareSurface pSurface(120, 40, false, std::make_shared<SoftwareResources>());
+        pSurface.FillRectangle(0, 0, 120, 40, Color(0xFF202020));
+
+        const auto nTitle = pSurface.LoadFont("Tahoma", 16, FontStyles::Bold);
+        const auto nDetail = pSurface.LoadFont("Tahoma", 8, FontStyles::Normal);
+        pSurface.WriteText(2, 2, nTitle, Color(0xFFFFFFFF), L"Unlocked!");
+        pSurface.WriteText(2, 24, nDetail, Color(0xFFC0C0C0), L"Collect 100 rings (10)");
+
+        Assert::AreEqual({ 0xAF7C09922958C9D5ULL }, pSurface.GetPixelHash());
+    }
+
+    TEST_METHOD(TestGoldenComposite)
+    {
+        SoftwareSurfaceFactory pFactory;
+        std::array<uint32_t, 4> pPixels{ 0xFFFF0000, 0xFF00FF00, 0xFF0000FF, 0xFFFFFFFF };
+        pFactory.SetImage(ImageType::Badge, "00001", 2, 2, pPixels.data());
+
+        auto pSurface = pFactory.CreateSurface(64, 48);
+        pSurface->FillRectangle(0, 0, 64, 48, Color(0xFF000040));
+
+        auto pPopup = pFactory.CreateTransparentSurface(40, 24);
+        pPopup->FillRectangle(0, 0, 40, 24, Color(0xFF404040));
+        pPopup->DrawImageStretched(2, 2, 20, 20, ImageReference(ImageType::Badge, "00001"));
+        pPopup->DrawImage(24, 2, 14, 14, ImageReference(ImageType::Badge, "99999"));
+        const auto nFont = pPopup->LoadFont("Tahoma", 8, FontStyles::Normal);
+        pPopup->WriteText(24, 16, nFont, Color(0xFFFFFF00), L"Hi");
+        pPopup->SetOpacity(0.75);
+
+        pSurface->DrawSurface(30, 30, *pPopup);
+
+        Assert::AreEqual({ 0x3E7B1E7DF929354BULL }, dynamic_cast<const SoftwareSurface&>(*pSurface).GetPixelHash());
+    }
+
+    TEST_METHOD(TestSaveImage)
+    {
+        ra::services::mocks::MockFileSystem mockFileSystem;
+        SoftwareSurfaceFactory pFactory;
+        auto pSurface = pFactory.CreateSurface(2, 2);
+        pSurface->FillRectangle(0, 0, 1, 1, Color(0xFF112233));
+
+        Assert::IsTrue(pFactory.SaveImage(*pSurface, L"C:\\image.bmp"));
+
+        const auto& sContents = mockFileSystem.GetFileContents(L"C:\\image.bmp");
+        Assert::AreEqual({ 14U + 40U + 16U }, sContents.length());
+        Assert::AreEqual('B', sContents.at(0));
+        Assert::AreEqual('M', sContents.at(1));
+        Assert::AreEqual('\x20', sContents.at(28)); // 32 bits per pixel
+        Assert::AreEqual('\xFE', sContents.at(22)); // -2 height (top-down)
+        Assert::AreEqual('\x33', sContents.at(54)); // first pixel (BGRA)
+        Assert::AreEqual('\x22', sContents.at(55));
+        Assert::AreEqual('\x11', sContents.at(56));
+        Assert::AreEqual('\xFF', sContents.at(57));
+    }
+};
+
+} // namespace tests
+} // namespace mocks
+} // namespace drawing
+} // namespace ui
+} // namespace ra
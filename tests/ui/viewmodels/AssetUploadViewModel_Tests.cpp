@@ -16,6 +16,8 @@
 #include "tests\mocks\MockThreadPool.hh"
 #include "tests\mocks\MockUserContext.hh"
 
+#include "services\impl\ThreadPool.hh"
+
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
 namespace ra {
@@ -220,13 +222,132 @@ private:
             Assert::IsTrue(bDialogSeen);
         }
 
+        using AssetUploadViewModel::MaxUploadAttempts;
+
+        mutable int nLastRestAttempt = 0;
+
     protected:
-        void Rest() const noexcept override {}
+        void Rest(int nAttempt) const noexcept override { nLastRestAttempt = nAttempt; }
 
     private:
         ra::data::context::GameAssets m_pAssets;
     };
 
+    static void UploadAssets(int nAchievements, int nLeaderboards)
+    {
+        AssetUploadViewModelHarness vmUpload;
+        vmUpload.mockGameContext.SetGameId(AssetUploadViewModelHarness::GameId);
+
+        // use real threads so the requests are actually processed in parallel
+        ra::services::impl::ThreadPool pThreadPool;
+        pThreadPool.Initialize(AssetUploadViewModel::MaxConcurrentTasks + 1);
+        ra::services::ServiceLocator::ServiceOverride<ra::services::IThreadPool> pThreadPoolOverride(&pThreadPool);
+
+        // one in nine achievements has a new image, stored for two different games
+        const int nAssets = nAchievements + nLeaderboards;
+        std::set<std::wstring> vImages;
+        for (int i = 0; i < nAchievements; ++i)
+        {
+            std::wstring sBadge = L"12345";
+            if (i % 9 == 0)
+            {
+                sBadge = ra::StringPrintf(L"local\\%d-%08x.png", 22 + (i % 2), i / 18);
+                vImages.insert(sBadge);
+            }
+
+            auto& pAchievement = vmUpload.AddAchievement(AssetCategory::Core, 5, ra::StringPrintf(L"Title%d", i),
+                                                         L"Desc", sBadge, "0xH1234=1");
+            vmUpload.QueueAsset(pAchievement);
+        }
+        for (int i = 0; i < nLeaderboards; ++i)
+        {
+            auto& pLeaderboard = vmUpload.AddLeaderboard(AssetCategory::Core, ra::StringPrintf(L"Leaderboard%d", i),
+                L"Desc", "0xH1234=1", "0xH1234=2", "0xH1234=3", "0xH2345", ra::data::ValueFormat::Value);
+            vmUpload.QueueAsset(pLeaderboard);
+        }
+
+        // every request takes 2ms, and one in ten requests is throttled
+        constexpr auto tLatency = std::chrono::milliseconds(2);
+        std::atomic<int> nRequests = 0;
+        std::atomic<int> nImagesUploaded = 0;
+        std::atomic<int> nBadgeUploadsInProgress = 0;
+        std::atomic<int> nErrors = 0;
+        vmUpload.mockServer.HandleRequest<ra::api::UploadBadge>([&nRequests, &nImagesUploaded, &nBadgeUploadsInProgress, &nErrors, tLatency]
+                (const ra::api::UploadBadge::Request& pRequest, ra::api::UploadBadge::Response& pResponse)
+        {
+            // badge uploads should never overlap
+            if (++nBadgeUploadsInProgress != 1)
+                ++nErrors;
+
+            std::this_thread::sleep_for(tLatency);
+            --nBadgeUploadsInProgress;
+
+            if (++nRequests % 10 == 0)
+            {
+                pResponse.Result = ra::api::ApiResult::Incomplete;
+                return true;
+            }
+
+            ++nImagesUploaded;
+            pResponse.BadgeId = ra::Narrow(pRequest.ImageFilePath.substr(pRequest.ImageFilePath.find(L'-') + 1, 8));
+            pResponse.Result = ra::api::ApiResult::Success;
+            return true;
+        });
+
+        vmUpload.mockServer.HandleRequest<ra::api::UpdateAchievement>([&nRequests, &nErrors, tLatency]
+                (const ra::api::UpdateAchievement::Request& pRequest, ra::api::UpdateAchievement::Response& pResponse)
+        {
+            std::this_thread::sleep_for(tLatency);
+            if (++nRequests % 10 == 0)
+            {
+                pResponse.Result = ra::api::ApiResult::Incomplete;
+                return true;
+            }
+
+            // achievements should not be uploaded until their badge has been uploaded
+            if (ra::StringStartsWith(pRequest.Badge, "local\\"))
+                ++nErrors;
+
+            pResponse.AchievementId = pRequest.AchievementId;
+            pResponse.Result = ra::api::ApiResult::Success;
+            return true;
+        });
+
+        vmUpload.mockServer.HandleRequest<ra::api::UpdateLeaderboard>([&nRequests, tLatency]
+                (const ra::api::UpdateLeaderboard::Request& pRequest, ra::api::UpdateLeaderboard::Response& pResponse)
+        {
+            std::this_thread::sleep_for(tLatency);
+            if (++nRequests % 10 == 0)
+            {
+                pResponse.Result = ra::api::ApiResult::Incomplete;
+                return true;
+            }
+
+            pResponse.LeaderboardId = pRequest.LeaderboardId;
+            pResponse.Result = ra::api::ApiResult::Success;
+            return true;
+        });
+
+        const auto tStart = std::chrono::steady_clock::now();
+        vmUpload.SetIsVisible(true);
+
+        const auto tTimeout = tStart + std::chrono::seconds(30);
+        while (vmUpload.GetDialogResult() == DialogResult::None && std::chrono::steady_clock::now() < tTimeout)
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+        const auto tElapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - tStart);
+        Assert::AreEqual(DialogResult::OK, vmUpload.GetDialogResult());
+
+        Assert::AreEqual(0, nErrors.load());
+        Assert::AreEqual(gsl::narrow_cast<int>(vImages.size()), nImagesUploaded.load());
+        vmUpload.AssertSuccess(nAssets);
+
+        const auto nElapsed = std::max(gsl::narrow_cast<int>(tElapsed.count()), 1);
+        Logger::WriteMessage(ra::StringPrintf("%d assets (%d requests) uploaded in %dms (%d assets/sec, %dms if serial)\n",
+                                              nAssets, nRequests.load(), nElapsed, nAssets * 1000 / nElapsed,
+                                              nRequests.load() * gsl::narrow_cast<int>(tLatency.count())).c_str());
+    }
+
 public:
     TEST_METHOD(TestSingleUnofficialAchievement)
     {
@@ -843,6 +964,57 @@ public:
         vmUpload.AssertSuccess(2);
     }
 
+    TEST_METHOD(TestSingleCoreAchievement429GiveUp)
+    {
+        AssetUploadViewModelHarness vmUpload;
+        auto& pAchievement = vmUpload.AddAchievement(AssetCategory::Core, 5, L"Title1", L"Desc1", L"12345", "0xH1234=1");
+
+        vmUpload.QueueAsset(pAchievement);
+
+        int nApiCount = 0;
+        vmUpload.mockServer.HandleRequest<ra::api::UpdateAchievement>([&nApiCount]
+                (const ra::api::UpdateAchievement::Request&, ra::api::UpdateAchievement::Response& pResponse)
+        {
+            ++nApiCount;
+            pResponse.Result = ra::api::ApiResult::Incomplete;
+            return true;
+        });
+
+        vmUpload.DoUpload();
+
+        Assert::AreEqual(AssetUploadViewModelHarness::MaxUploadAttempts, nApiCount);
+        Assert::AreEqual(AssetUploadViewModelHarness::MaxUploadAttempts - 1, vmUpload.nLastRestAttempt);
+        Assert::AreEqual(AssetChanges::Unpublished, pAchievement.GetChanges());
+
+        vmUpload.AssertFailed(0, 1, L"* Title1: Server is busy. Please try again later.");
+    }
+
+    TEST_METHOD(TestSingleCoreAchievementWithImage429GiveUp)
+    {
+        AssetUploadViewModelHarness vmUpload;
+        auto& pAchievement = vmUpload.AddAchievement(AssetCategory::Core, 5, L"Title1", L"Desc1", L"local\\12345", "0xH1234=1");
+
+        vmUpload.QueueAsset(pAchievement);
+
+        int nImagesUploaded = 0;
+        vmUpload.mockServer.HandleRequest<ra::api::UploadBadge>([&nImagesUploaded]
+                (const ra::api::UploadBadge::Request&, ra::api::UploadBadge::Response& pResponse)
+        {
+            ++nImagesUploaded;
+            pResponse.Result = ra::api::ApiResult::Incomplete;
+            pResponse.ErrorMessage = "HTTP error code: 503";
+            return true;
+        });
+        vmUpload.mockServer.ExpectUncalled<ra::api::UpdateAchievement>();
+
+        vmUpload.DoUpload();
+
+        Assert::AreEqual(AssetUploadViewModelHarness::MaxUploadAttempts, nImagesUploaded);
+        Assert::AreEqual(std::wstring(L"local\\12345"), pAchievement.GetBadge());
+
+        vmUpload.AssertFailed(0, 1, L"* Title1: HTTP error code: 503");
+    }
+
     TEST_METHOD(TestMultipleCoreAchievementsWithSameImage)
     {
         AssetUploadViewModelHarness vmUpload;
@@ -893,6 +1065,102 @@ public:
         vmUpload.AssertSuccess(2);
     }
 
+    TEST_METHOD(TestMultipleCoreAchievementsWithSameImageDifferentGames)
+    {
+        AssetUploadViewModelHarness vmUpload;
+        auto& pAchievement1 = vmUpload.AddAchievement(AssetCategory::Core, 5, L"Title1", L"Desc1", L"local\\22-0123456789abcdef.png", "0xH1234=1");
+        auto& pAchievement2 = vmUpload.AddAchievement(AssetCategory::Core, 5, L"Title2", L"Desc2", L"local\\23-0123456789abcdef.png", "0xH1234=1");
+        auto& pAchievement3 = vmUpload.AddAchievement(AssetCategory::Core, 5, L"Title3", L"Desc3", L"local\\22-fedcba9876543210.png", "0xH1234=1");
+
+        vmUpload.QueueAsset(pAchievement1);
+        vmUpload.QueueAsset(pAchievement2);
+        vmUpload.QueueAsset(pAchievement3);
+        Assert::AreEqual({ 2U }, vmUpload.TaskCount()); // images have the same contents, only upload once
+
+        int nImagesUploaded = 0;
+        vmUpload.mockServer.HandleRequest<ra::api::UploadBadge>([&nImagesUploaded]
+                (const ra::api::UploadBadge::Request& pRequest, ra::api::UploadBadge::Response& pResponse)
+        {
+            ++nImagesUploaded;
+
+            if (pRequest.ImageFilePath == L"RACache\\Badges\\local\\22-0123456789abcdef.png")
+                pResponse.BadgeId = "76543";
+            else
+                pResponse.BadgeId = "55555";
+
+            pResponse.Result = ra::api::ApiResult::Success;
+            return true;
+        });
+
+        int nAchievementsUploaded = 0;
+        vmUpload.mockServer.HandleRequest<ra::api::UpdateAchievement>([&nAchievementsUploaded]
+                (const ra::api::UpdateAchievement::Request& pRequest, ra::api::UpdateAchievement::Response& pResponse)
+        {
+            ++nAchievementsUploaded;
+            pResponse.AchievementId = pRequest.AchievementId;
+            pResponse.Result = ra::api::ApiResult::Success;
+            return true;
+        });
+
+        vmUpload.DoUpload();
+
+        Assert::AreEqual(2, nImagesUploaded);
+        Assert::AreEqual(3, nAchievementsUploaded);
+        Assert::AreEqual(std::wstring(L"76543"), pAchievement1.GetBadge());
+        Assert::AreEqual(std::wstring(L"76543"), pAchievement2.GetBadge());
+        Assert::AreEqual(std::wstring(L"55555"), pAchievement3.GetBadge());
+
+        vmUpload.AssertSuccess(3);
+    }
+
+    TEST_METHOD(TestMultipleCoreAchievementsWithImagesPipelined)
+    {
+        AssetUploadViewModelHarness vmUpload;
+        auto& pAchievement1 = vmUpload.AddAchievement(AssetCategory::Core, 5, L"Title1", L"Desc1", L"local\\12345", "0xH1234=1");
+        auto& pAchievement2 = vmUpload.AddAchievement(AssetCategory::Core, 5, L"Title2", L"Desc2", L"local\\22222", "0xH1234=1");
+        auto& pAchievement3 = vmUpload.AddAchievement(AssetCategory::Core, 5, L"Title3", L"Desc3", L"12345", "0xH1234=1");
+
+        vmUpload.QueueAsset(pAchievement1);
+        vmUpload.QueueAsset(pAchievement2);
+        vmUpload.QueueAsset(pAchievement3);
+        Assert::AreEqual({ 3U }, vmUpload.TaskCount());
+
+        std::vector<std::wstring> vCalls;
+        vmUpload.mockServer.HandleRequest<ra::api::UploadBadge>([&vCalls]
+                (const ra::api::UploadBadge::Request& pRequest, ra::api::UploadBadge::Response& pResponse)
+        {
+            vCalls.push_back(pRequest.ImageFilePath);
+            pResponse.BadgeId = (pRequest.ImageFilePath == L"RACache\\Badges\\local\\12345") ? "76543" : "55555";
+            pResponse.Result = ra::api::ApiResult::Success;
+            return true;
+        });
+
+        vmUpload.mockServer.HandleRequest<ra::api::UpdateAchievement>([&vCalls]
+                (const ra::api::UpdateAchievement::Request& pRequest, ra::api::UpdateAchievement::Response& pResponse)
+        {
+            vCalls.push_back(pRequest.Title);
+            pResponse.AchievementId = pRequest.AchievementId;
+            pResponse.Result = ra::api::ApiResult::Success;
+            return true;
+        });
+
+        vmUpload.DoUpload();
+
+        // achievements waiting on an image are queued as soon as the image is uploaded
+        Assert::AreEqual({ 5U }, vCalls.size());
+        Assert::AreEqual(std::wstring(L"RACache\\Badges\\local\\12345"), vCalls.at(0));
+        Assert::AreEqual(std::wstring(L"RACache\\Badges\\local\\22222"), vCalls.at(1));
+        Assert::AreEqual(std::wstring(L"Title3"), vCalls.at(2));
+        Assert::AreEqual(std::wstring(L"Title1"), vCalls.at(3));
+        Assert::AreEqual(std::wstring(L"Title2"), vCalls.at(4));
+
+        Assert::AreEqual(AssetChanges::None, pAchievement1.GetChanges());
+        Assert::AreEqual(AssetChanges::None, pAchievement2.GetChanges());
+        Assert::AreEqual(AssetChanges::None, pAchievement3.GetChanges());
+
+        vmUpload.AssertSuccess(3);
+    }
+
     TEST_METHOD(TestMultipleCoreAchievementsWithFailedImages)
     {
         AssetUploadViewModelHarness vmUpload;
@@ -1478,6 +1746,19 @@ public:
 
         vmUpload.AssertSuccess(2);
     }
+
+    TEST_METHOD(TestUploadConcurrent)
+    {
+        UploadAssets(45, 5);
+    }
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(TestUploadThroughput)
+        TEST_IGNORE()
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(TestUploadThroughput)
+    {
+        UploadAssets(450, 50);
+    }
 };
 
 } // namespace tests
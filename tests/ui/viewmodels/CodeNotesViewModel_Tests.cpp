@@ -119,6 +119,45 @@ private:
         Assert::AreEqual(nAddress, pRow->nAddress);
     }
 
+    void AssertApplyFilter(unsigned nNoteCount)
+    {
+        CodeNotesViewModelHarness notes;
+        notes.mockGameContext.SetGameId(1U);
+
+        const wchar_t* sWords[] = { L"Health", L"Item", L"Quantity", L"Score", L"Timer", L"Lives", L"Flag", L"Counter" };
+        std::vector<std::wstring> vNotes;
+        vNotes.reserve(nNoteCount);
+        for (unsigned i = 0; i < nNoteCount; ++i)
+        {
+            vNotes.push_back(ra::StringPrintf(L"[16-bit] %s %s %u", gsl::at(sWords, i % 8), gsl::at(sWords, (i / 8) % 8), i));
+            notes.mockGameContext.SetCodeNote(i * 4, vNotes.back());
+        }
+
+        notes.SetIsVisible(true);
+        Assert::AreEqual({ nNoteCount }, notes.Notes().Count());
+
+        for (const auto* sFilter : { L"e", L"liv", L"lives ti" })
+        {
+            notes.ResetFilter();
+            notes.SetFilterValue(sFilter);
+
+            const auto tStart = std::chrono::steady_clock::now();
+            notes.ApplyFilter();
+            const auto tElapsed = std::chrono::steady_clock::now() - tStart;
+
+            size_t nExpected = 0;
+            for (const auto& sNote : vNotes)
+            {
+                if (ra::StringContainsCaseInsensitive(sNote, sFilter))
+                    ++nExpected;
+            }
+            Assert::AreEqual(nExpected, notes.Notes().Count());
+
+            Logger::WriteMessage(ra::StringPrintf("\"%s\": %zu/%u notes in %llus\n", ra::Narrow(sFilter), nExpected, nNoteCount,
+                std::chrono::duration_cast<std::chrono::microseconds>(tElapsed).count()).c_str());
+        }
+    }
+
 public:
     TEST_METHOD(TestInitialValues)
     {
@@ -201,6 +240,137 @@ public:
         AssertRow(notes, 2, 0x0040, L"0x0040\n- 0x0049", L"[10 bytes] Inventory");
     }
 
+    TEST_METHOD(TestApplyFilterIndexed)
+    {
+        CodeNotesViewModelHarness notes;
+        notes.PopulateNotes();
+        notes.SetIsVisible(true);
+        Assert::AreEqual({ 14U }, notes.Notes().Count());
+
+        // filters of three or more characters use the index
+        notes.SetFilterValue(L"SCORE");
+        notes.ApplyFilter();
+        Assert::AreEqual({ 5U }, notes.Notes().Count());
+        Assert::AreEqual(std::wstring(L"5/14"), notes.GetResultCount());
+        AssertRow(notes, 0, 0x0010, L"0x0010", L"Score X000");
+        AssertRow(notes, 4, 0x0016, L"0x0016", L"[32-bit] Score");
+
+        notes.ResetFilter();
+
+        notes.SetFilterValue(L"tem 1 qua");
+        notes.ApplyFilter();
+        Assert::AreEqual({ 1U }, notes.Notes().Count());
+        Assert::AreEqual(std::wstring(L"1/14"), notes.GetResultCount());
+        AssertRow(notes, 0, 0x0030, L"0x0030", L"Item 1 Quantity");
+
+        notes.ResetFilter();
+
+        // every word matches, but not in sequence
+        notes.SetFilterValue(L"item quantity");
+        notes.ApplyFilter();
+        Assert::AreEqual({ 0U }, notes.Notes().Count());
+        Assert::AreEqual(std::wstring(L"0/14"), notes.GetResultCount());
+
+        notes.ResetFilter();
+
+        // matching items are moved up over the non-matching items
+        notes.SetFilterValue(L"-bit]");
+        notes.ApplyFilter();
+        Assert::AreEqual({ 3U }, notes.Notes().Count());
+        AssertRow(notes, 0, 0x0016, L"0x0016", L"[32-bit] Score");
+        AssertRow(notes, 1, 0x0020, L"0x0020", L"[16-bit] Max HP");
+        AssertRow(notes, 2, 0x0022, L"0x0022", L"[16-bit] Current HP");
+        Assert::AreEqual(4U, notes.Notes().GetItemAt(0)->nBytes);
+        Assert::AreEqual(2U, notes.Notes().GetItemAt(1)->nBytes);
+    }
+
+    TEST_METHOD(TestApplyFilterIndexedAfterUpdate)
+    {
+        CodeNotesViewModelHarness notes;
+        notes.PopulateNotes();
+        notes.SetIsVisible(true);
+
+        notes.mockGameContext.UpdateCodeNote(0x0030, L"Sword");
+        notes.mockGameContext.UpdateCodeNote(0x0024, L"Shield");
+        notes.mockGameContext.UpdateCodeNote(0x0040, L"");
+        Assert::AreEqual({ 15U }, notes.Notes().Count());
+
+        notes.SetFilterValue(L"item");
+        notes.ApplyFilter();
+        Assert::AreEqual({ 4U }, notes.Notes().Count());
+        AssertRow(notes, 0, 0x0031, L"0x0031", L"Item 2 Quantity");
+
+        notes.ResetFilter();
+        notes.SetFilterValue(L"ord");
+        notes.ApplyFilter();
+        Assert::AreEqual({ 1U }, notes.Notes().Count());
+        AssertRow(notes, 0, 0x0030, L"0x0030", L"Sword");
+
+        notes.ResetFilter();
+        notes.SetFilterValue(L"shi");
+        notes.ApplyFilter();
+        Assert::AreEqual({ 1U }, notes.Notes().Count());
+        AssertRow(notes, 0, 0x0024, L"0x0024", L"Shield");
+
+        notes.ResetFilter();
+        notes.SetFilterValue(L"inventory");
+        notes.ApplyFilter();
+        Assert::AreEqual({ 0U }, notes.Notes().Count());
+    }
+
+    TEST_METHOD(TestApplyFilterIndexedDeleted)
+    {
+        CodeNotesViewModelHarness notes;
+        notes.PopulateNotes();
+        notes.SetIsVisible(true);
+
+        // unpublished deleted notes are displayed as [Deleted], and can be found by that text
+        notes.mockGameContext.Assets().FindCodeNotes()->SetCodeNote(0x0020, L"");
+        AssertRow(notes, 6, 0x0020, L"0x0020", L"[Deleted]");
+
+        notes.SetFilterValue(L"delete");
+        notes.ApplyFilter();
+        Assert::AreEqual({ 1U }, notes.Notes().Count());
+        AssertRow(notes, 0, 0x0020, L"0x0020", L"[Deleted]");
+    }
+
+    TEST_METHOD(TestApplyFilterIndexedGameChanged)
+    {
+        CodeNotesViewModelHarness notes;
+        notes.PopulateNotes();
+        notes.SetIsVisible(true);
+
+        notes.SetFilterValue(L"score");
+        notes.ApplyFilter();
+        Assert::AreEqual({ 5U }, notes.Notes().Count());
+
+        // index should be rebuilt for the new notes
+        notes.mockGameContext.SetGameId(2U);
+        notes.mockGameContext.InitializeCodeNotes();
+        notes.mockGameContext.SetCodeNote(0x0100, L"Score");
+        notes.mockGameContext.SetCodeNote(0x0200, L"Timer");
+        notes.mockGameContext.NotifyActiveGameChanged();
+        Assert::AreEqual({ 2U }, notes.Notes().Count());
+
+        notes.SetFilterValue(L"score");
+        notes.ApplyFilter();
+        Assert::AreEqual({ 1U }, notes.Notes().Count());
+        AssertRow(notes, 0, 0x0100, L"0x0100", L"Score");
+    }
+
+    TEST_METHOD(TestApplyFilterManyNotes)
+    {
+        AssertApplyFilter(500);
+    }
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(TestApplyFilterPerformance)
+        TEST_IGNORE()
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(TestApplyFilterPerformance)
+    {
+        AssertApplyFilter(50000);
+    }
+
     TEST_METHOD(TestAddNoteUnfiltered)
     {
         CodeNotesViewModelHarness notes;
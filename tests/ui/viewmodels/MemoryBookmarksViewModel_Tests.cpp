@@ -1298,6 +1298,46 @@ public:
         Assert::AreEqual(0U, bookmark5.GetChanges());
     }
 
+    TEST_METHOD(TestOnEditMemoryRange)
+    {
+        MemoryBookmarksViewModelHarness bookmarks;
+        bookmarks.SetIsVisible(true);
+        bookmarks.mockGameContext.SetGameId(3U);
+
+        std::array<uint8_t, 64> memory = {};
+        for (uint8_t i = 0; i < memory.size(); ++i)
+            memory.at(i) = i;
+        bookmarks.mockEmulatorContext.MockMemory(memory);
+
+        bookmarks.mockGameContext.NotifyActiveGameChanged();
+        bookmarks.AddBookmark(0, MemSize::SixteenBit);
+        bookmarks.AddBookmark(1, MemSize::ThirtyTwoBit);
+        bookmarks.AddBookmark(6, MemSize::EightBit);
+        bookmarks.AddBookmark(7, MemSize::EightBit);
+
+        // a single range covering several bookmarks updates each bookmark once
+        const std::array<uint8_t, 4> pBytes{ 0x40, 0x50, 0x60, 0x70 };
+        bookmarks.mockEmulatorContext.WriteMemory(3U, pBytes.data(), pBytes.size());
+
+        auto& bookmark0 = *bookmarks.Bookmarks().GetItemAt(0);
+        Assert::AreEqual(std::wstring(L"0100"), bookmark0.GetCurrentValue()); // range starts after bookmark
+        Assert::AreEqual(0U, bookmark0.GetChanges());
+
+        auto& bookmark1 = *bookmarks.Bookmarks().GetItemAt(1);
+        Assert::AreEqual(std::wstring(L"50400201"), bookmark1.GetCurrentValue()); // range starts inside bookmark
+        Assert::AreEqual(std::wstring(L"04030201"), bookmark1.GetPreviousValue());
+        Assert::AreEqual(1U, bookmark1.GetChanges());
+
+        auto& bookmark6 = *bookmarks.Bookmarks().GetItemAt(2);
+        Assert::AreEqual(std::wstring(L"70"), bookmark6.GetCurrentValue()); // range ends at bookmark
+        Assert::AreEqual(std::wstring(L"06"), bookmark6.GetPreviousValue());
+        Assert::AreEqual(1U, bookmark6.GetChanges());
+
+        auto& bookmark7 = *bookmarks.Bookmarks().GetItemAt(3);
+        Assert::AreEqual(std::wstring(L"07"), bookmark7.GetCurrentValue()); // range ends before bookmark
+        Assert::AreEqual(0U, bookmark7.GetChanges());
+    }
+
     TEST_METHOD(TestUpdateCurrentValueOnSizeChange)
     {
         MemoryBookmarksViewModelHarness bookmarks;
@@ -1917,6 +1957,44 @@ public:
         Assert::AreEqual({8}, pBookmark2->GetAddress()); // address updated
         Assert::AreEqual({0}, memory.at(8));             // but not memory
     }
+
+    TEST_METHOD(TestDoFrameFrozenBookmarksEventCount)
+    {
+        // each frozen value should be reported to listeners once rather than once per byte
+        MemoryBookmarksViewModelHarness bookmarks;
+        std::vector<uint8_t> memory(400);
+        bookmarks.mockEmulatorContext.MockMemory(memory.data(), memory.size());
+
+        for (ra::ByteAddress nAddress = 0; nAddress < memory.size(); nAddress += 4)
+            bookmarks.AddBookmark(nAddress, MemSize::ThirtyTwoBit);
+        for (gsl::index nIndex = 0; ra::to_unsigned(nIndex) < bookmarks.Bookmarks().Count(); ++nIndex)
+            bookmarks.Bookmarks().GetItemAt(nIndex)->SetBehavior(MemoryBookmarksViewModel::BookmarkBehavior::Frozen);
+
+        class CountingNotifyTarget : public ra::data::context::EmulatorContext::NotifyTarget
+        {
+        public:
+            void OnByteWritten(ra::ByteAddress, uint8_t) noexcept override { ++nEvents; }
+            void OnBytesWritten(ra::ByteAddress, const uint8_t[], size_t) noexcept override { ++nEvents; }
+
+            size_t nEvents = 0;
+        };
+
+        std::array<CountingNotifyTarget, 5> vTargets;
+        for (auto& pTarget : vTargets)
+            bookmarks.mockEmulatorContext.AddNotifyTarget(pTarget);
+
+        std::fill(memory.begin(), memory.end(), gsl::narrow_cast<uint8_t>(0xFF));
+
+        bookmarks.DoFrame();
+
+        Assert::AreEqual({ 0 }, memory.at(0));
+        Assert::AreEqual({ 0 }, memory.at(399));
+        for (const auto& pTarget : vTargets)
+            Assert::AreEqual({ 100U }, pTarget.nEvents);
+
+        for (auto& pTarget : vTargets)
+            bookmarks.mockEmulatorContext.RemoveNotifyTarget(pTarget);
+    }
 };
 
 } // namespace tests
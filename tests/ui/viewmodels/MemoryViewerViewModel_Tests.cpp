@@ -1923,6 +1923,47 @@ public:
         viewer.MockRender();
     }
 
+    TEST_METHOD(TestOnBytesWritten)
+    {
+        MemoryViewerViewModelHarness viewer;
+        viewer.InitializeMemory(1024);
+        viewer.SetFirstAddress(512);
+        viewer.MockRender();
+        Assert::IsFalse(viewer.NeedsRedraw());
+
+        std::array<uint8_t, 16> pBytes{};
+        pBytes.fill(0xCC);
+
+        // range ends before the visible memory
+        viewer.mockEmulatorContext.WriteMemory(496U, pBytes.data(), pBytes.size());
+        Assert::IsFalse(viewer.NeedsRedraw());
+        Assert::AreEqual({ 0x00 }, viewer.GetByte(512U));
+
+        // range starts before the visible memory
+        viewer.mockEmulatorContext.WriteMemory(508U, pBytes.data(), pBytes.size());
+        Assert::IsTrue(viewer.NeedsRedraw());
+        Assert::AreEqual({ 0xCC }, viewer.GetByte(512U));
+        Assert::AreEqual({ 0xCC }, viewer.GetByte(523U));
+        Assert::AreEqual({ 0x0C }, viewer.GetByte(524U));
+        Assert::AreEqual({ COLOR_BLACK | COLOR_REDRAW }, viewer.GetColor(523U));
+        Assert::AreEqual(COLOR_BLACK, viewer.GetColor(524U));
+
+        // range ends after the visible memory
+        viewer.MockRender();
+        viewer.mockEmulatorContext.WriteMemory(636U, pBytes.data(), pBytes.size());
+        Assert::IsTrue(viewer.NeedsRedraw());
+        Assert::AreEqual({ 0x7B }, viewer.GetByte(635U));
+        Assert::AreEqual({ 0xCC }, viewer.GetByte(636U));
+        Assert::AreEqual({ 0xCC }, viewer.GetByte(639U));
+        Assert::AreEqual({ COLOR_BLACK | COLOR_REDRAW }, viewer.GetColor(639U));
+        Assert::AreEqual(COLOR_BLACK, viewer.GetColor(635U));
+
+        // range starts after the visible memory
+        viewer.MockRender();
+        viewer.mockEmulatorContext.WriteMemory(640U, pBytes.data(), pBytes.size());
+        Assert::IsFalse(viewer.NeedsRedraw());
+    }
+
     TEST_METHOD(TestIncreaseCurrentValueByOne)
     {
         MemoryViewerViewModelHarness viewer;
@@ -12,10 +12,12 @@
 #include "tests\mocks\MockGameContext.hh"
 #include "tests\mocks\MockImageRepository.hh"
 #include "tests\mocks\MockOverlayTheme.hh"
+#include "tests\mocks\MockSessionTracker.hh"
 #include "tests\mocks\MockSurface.hh"
 #include "tests\mocks\MockThreadPool.hh"
 #include "tests\mocks\MockUserContext.hh"
 #include "tests\mocks\MockWindowManager.hh"
+#include "tests\mocks\SoftwareSurface.hh"
 
 #include "tests\ui\UIAsserts.hh"
 
@@ -100,6 +102,111 @@ private:
         ra::services::ServiceLocator::ServiceOverride<OverlayManager> m_Override;
     };
 
+    class RecordingSurface : public ra::ui::drawing::mocks::SoftwareSurface
+    {
+    public:
+        RecordingSurface(int nWidth, int nHeight)
+            : SoftwareSurface(nWidth, nHeight, false, std::make_shared<ra::ui::drawing::mocks::SoftwareResources>())
+        {
+        }
+
+        void DrawSurface(int nX, int nY, const ISurface& pSurface) noexcept override
+        {
+            m_nBlittedPixels += gsl::narrow_cast<size_t>(pSurface.GetWidth()) * pSurface.GetHeight();
+            SoftwareSurface::DrawSurface(nX, nY, pSurface);
+        }
+
+        void DrawSurface(int nX, int nY, const ISurface& pSurface, int nSurfaceX, int nSurfaceY, int nWidth, int nHeight) noexcept override
+        {
+            m_nBlittedPixels += gsl::narrow_cast<size_t>(nWidth) * nHeight;
+            SoftwareSurface::DrawSurface(nX, nY, pSurface, nSurfaceX, nSurfaceY, nWidth, nHeight);
+        }
+
+        size_t GetBlittedPixels() const noexcept { return m_nBlittedPixels; }
+
+    private:
+        size_t m_nBlittedPixels = 0;
+    };
+
+    static constexpr int RENDER_BENCHMARK_FRAMES = 600;
+    static constexpr int RENDER_BENCHMARK_HASH_INTERVAL = 10;
+
+    static void RenderBenchmark(std::vector<uint64_t>& vHashes, std::vector<std::chrono::microseconds>& vFrameTimes)
+    {
+        OverlayManagerHarness overlay;
+        ra::data::context::mocks::MockSessionTracker mockSessionTracker;
+        ra::ui::drawing::mocks::SoftwareSurfaceFactory pSurfaceFactory;
+        ra::services::ServiceLocator::ServiceOverride<ra::ui::drawing::ISurfaceFactory> pSurfaceFactoryOverride(&pSurfaceFactory);
+
+        overlay.mockConfiguration.SetPopupLocation(ra::ui::viewmodels::Popup::LeaderboardTracker, ra::ui::viewmodels::PopupLocation::BottomRight);
+        overlay.mockConfiguration.SetPopupLocation(ra::ui::viewmodels::Popup::Challenge, ra::ui::viewmodels::PopupLocation::BottomRight);
+        overlay.mockConfiguration.SetPopupLocation(ra::ui::viewmodels::Popup::Progress, ra::ui::viewmodels::PopupLocation::BottomRight);
+
+        overlay.mockAchievementRuntime.MockGame();
+        for (uint32_t i = 1; i <= 1000; ++i)
+        {
+            auto* pAchievement = overlay.mockAchievementRuntime.MockAchievement(i, ra::StringPrintf("Achievement %u", i).c_str());
+            pAchievement->public_.description = "Do something interesting";
+            pAchievement->public_.points = (i % 10) + 1;
+            snprintf(pAchievement->public_.badge_name, sizeof(pAchievement->public_.badge_name), "%05u", i);
+            if (i % 3 == 0)
+            {
+                pAchievement->public_.state = RC_CLIENT_ACHIEVEMENT_STATE_UNLOCKED;
+                pAchievement->public_.unlocked = RC_CLIENT_ACHIEVEMENT_UNLOCKED_BOTH;
+            }
+        }
+
+        auto pSurface = pSurfaceFactory.CreateSurface(800, 600);
+        const auto& pSoftwareSurface = dynamic_cast<const ra::ui::drawing::mocks::SoftwareSurface&>(*pSurface);
+
+        std::vector<ScoreTrackerViewModel*> vTrackers;
+        for (uint32_t i = 1; i <= 4; ++i)
+            vTrackers.push_back(&overlay.AddScoreTracker(i));
+        overlay.AddChallengeIndicator(7, ra::ui::ImageType::Badge, "00007");
+
+        vHashes.clear();
+        vFrameTimes.clear();
+        vFrameTimes.reserve(RENDER_BENCHMARK_FRAMES);
+
+        for (int nFrame = 0; nFrame < RENDER_BENCHMARK_FRAMES; ++nFrame)
+        {
+            if (nFrame % 120 == 0)
+            {
+                const auto nId = (nFrame / 120) % 1000 + 1;
+                overlay.QueueMessage(L"Achievement Unlocked", ra::StringPrintf(L"Achievement %d", nId),
+                    ra::ui::ImageType::Badge, ra::StringPrintf("%05d", nId));
+            }
+
+            // first tracker is a timer, the others change occasionally
+            vTrackers.at(0)->SetDisplayText(ra::StringPrintf(L"%d:%02d.%02d", nFrame / 3600, (nFrame / 60) % 60, nFrame % 60));
+            if (nFrame % 60 == 0)
+            {
+                for (size_t i = 1; i < vTrackers.size(); ++i)
+                    vTrackers.at(i)->SetDisplayText(ra::StringPrintf(L"%d", nFrame * gsl::narrow_cast<int>(i)));
+            }
+
+            if (nFrame % 200 == 100)
+                overlay.UpdateProgressTracker(ra::ui::ImageType::Badge, "00012_lock", ra::StringPrintf(L"%d/20", (nFrame / 200) % 20));
+
+            if (nFrame == 300)
+                overlay.ShowOverlay();
+            else if (nFrame == 450)
+                overlay.HideOverlay();
+
+            overlay.mockClock.AdvanceTime(std::chrono::milliseconds(16));
+
+            // emulator draws the frame, then the overlay is drawn over it
+            pSurface->FillRectangle(0, 0, 800, 600, ra::ui::Color(0xFF103050));
+
+            const auto tStart = std::chrono::steady_clock::now();
+            overlay.Render(*pSurface, true);
+            vFrameTimes.push_back(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - tStart));
+
+            if (nFrame % RENDER_BENCHMARK_HASH_INTERVAL == 0)
+                vHashes.push_back(pSoftwareSurface.GetPixelHash());
+        }
+    }
+
 public:
     TEST_METHOD(TestQueueMessageTitleDesc)
     {
@@ -709,6 +816,113 @@ public:
         Assert::IsTrue(overlay.WasRenderRequested());
         Assert::IsTrue(overlay.WasHideRequested());
     }
+
+    TEST_METHOD(TestRenderDirtyRects)
+    {
+        OverlayManagerHarness overlay;
+        ra::ui::drawing::mocks::SoftwareSurfaceFactory pSurfaceFactory;
+        ra::services::ServiceLocator::ServiceOverride<ra::ui::drawing::ISurfaceFactory> pSurfaceFactoryOverride(&pSurfaceFactory);
+
+        overlay.mockConfiguration.SetPopupLocation(ra::ui::viewmodels::Popup::LeaderboardTracker, ra::ui::viewmodels::PopupLocation::BottomRight);
+        overlay.mockConfiguration.SetPopupLocation(ra::ui::viewmodels::Popup::Challenge, ra::ui::viewmodels::PopupLocation::BottomRight);
+
+        constexpr int nWidth = 800;
+        constexpr int nHeight = 600;
+        RecordingSurface pDirtySurface(nWidth, nHeight);
+        pDirtySurface.FillRectangle(0, 0, nWidth, nHeight, ra::ui::Color::Transparent);
+        RecordingSurface pFullSurface(nWidth, nHeight);
+
+        std::vector<ScoreTrackerViewModel*> vTrackers;
+        for (uint32_t i = 1; i <= 20; ++i)
+        {
+            vTrackers.push_back(&overlay.AddScoreTracker(i));
+            vTrackers.back()->SetDisplayText(L"0");
+        }
+        for (ra::AchievementID i = 1; i <= 10; ++i)
+            overlay.AddChallengeIndicator(i, ra::ui::ImageType::Badge, ra::StringPrintf("%05u", i));
+
+        // message slides in, pauses, and slides out while everything else stays put
+        overlay.QueueMessage(L"Achievement Unlocked", L"Description");
+
+        for (int nFrame = 0; nFrame < 400; ++nFrame)
+        {
+            if (nFrame % 40 == 20)
+                vTrackers.at(nFrame / 40)->SetDisplayText(ra::StringPrintf(L"%d", nFrame));
+
+            if (nFrame == 200)
+            {
+                overlay.RemoveScoreTracker(20);
+                overlay.RemoveChallengeIndicator(5);
+            }
+
+            overlay.mockClock.AdvanceTime(std::chrono::milliseconds(16));
+            overlay.Render(pDirtySurface, false);
+
+            const auto& vDirtyRects = overlay.GetDirtyRects();
+            for (size_t i = 0; i < vDirtyRects.size(); ++i)
+            {
+                const auto& pRect = vDirtyRects.at(i);
+                Assert::IsTrue(pRect.X >= 0 && pRect.Y >= 0 && pRect.Width > 0 && pRect.Height > 0);
+                Assert::IsTrue(pRect.X + pRect.Width <= nWidth && pRect.Y + pRect.Height <= nHeight);
+
+                for (size_t j = i + 1; j < vDirtyRects.size(); ++j)
+                {
+                    const auto& pOther = vDirtyRects.at(j);
+                    const bool bOverlaps = pRect.X < pOther.X + pOther.Width && pOther.X < pRect.X + pRect.Width &&
+                                           pRect.Y < pOther.Y + pOther.Height && pOther.Y < pRect.Y + pRect.Height;
+                    Assert::IsFalse(bOverlaps, ra::StringPrintf(L"Frame %d has overlapping dirty rects", nFrame).c_str());
+                }
+            }
+
+            // no time has elapsed, so this just draws the current state on a blank surface
+            pFullSurface.FillRectangle(0, 0, nWidth, nHeight, ra::ui::Color::Transparent);
+            overlay.Render(pFullSurface, true);
+
+            if (pDirtySurface.GetPixels() != pFullSurface.GetPixels())
+                Assert::Fail(ra::StringPrintf(L"Frame %d does not match full redraw", nFrame).c_str());
+        }
+
+        Logger::WriteMessage(ra::StringPrintf("Blitted pixels: %zu dirty, %zu full redraw\n",
+            pDirtySurface.GetBlittedPixels(), pFullSurface.GetBlittedPixels()).c_str());
+        Assert::IsTrue(pDirtySurface.GetBlittedPixels() * 4 < pFullSurface.GetBlittedPixels());
+    }
+
+    TEST_METHOD(TestRenderPerformance)
+    {
+        std::vector<uint64_t> vHashes;
+        std::vector<std::chrono::microseconds> vFrameTimes;
+        RenderBenchmark(vHashes, vFrameTimes);
+
+        Assert::AreEqual({ RENDER_BENCHMARK_FRAMES }, vFrameTimes.size());
+        Assert::AreEqual({ RENDER_BENCHMARK_FRAMES / RENDER_BENCHMARK_HASH_INTERVAL }, vHashes.size());
+
+        // something other than the background should have been drawn
+        std::set<uint64_t> vUniqueHashes(vHashes.begin(), vHashes.end());
+        Assert::IsTrue(vUniqueHashes.size() > 30);
+
+        // rendering the same scenario again should produce the same output
+        std::vector<uint64_t> vHashes2;
+        std::vector<std::chrono::microseconds> vFrameTimes2;
+        RenderBenchmark(vHashes2, vFrameTimes2);
+        Assert::AreEqual(vHashes.size(), vHashes2.size());
+        for (size_t i = 0; i < vHashes.size(); ++i)
+        {
+            if (vHashes.at(i) != vHashes2.at(i))
+                Assert::Fail(ra::StringPrintf(L"Frame %zu rendered differently", i * RENDER_BENCHMARK_HASH_INTERVAL).c_str());
+        }
+
+        std::chrono::microseconds tTotal{ 0 };
+        for (const auto tFrame : vFrameTimes)
+            tTotal += tFrame;
+        std::sort(vFrameTimes.begin(), vFrameTimes.end());
+        const auto GetPercentile = [&vFrameTimes](int nPercentile) {
+            return gsl::narrow_cast<int>(vFrameTimes.at(vFrameTimes.size() * nPercentile / 100).count());
+        };
+
+        Logger::WriteMessage(ra::StringPrintf("%d frames: %dms total, p50 %dus, p95 %dus, p99 %dus, max %dus\n",
+            RENDER_BENCHMARK_FRAMES, gsl::narrow_cast<int>(tTotal.count() / 1000), GetPercentile(50),
+            GetPercentile(95), GetPercentile(99), gsl::narrow_cast<int>(vFrameTimes.back().count())).c_str());
+    }
 };
 
 } // namespace tests
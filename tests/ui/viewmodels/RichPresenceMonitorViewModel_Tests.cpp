@@ -118,6 +118,31 @@ TEST_CLASS(RichPresenceMonitorViewModel_Tests)
         Assert::AreEqual(std::wstring(L"Rich Presence Monitor (local)"), vmRichPresence.GetWindowTitle());
     }
 
+    TEST_METHOD(TestUpdateDisplayStringSteadyState)
+    {
+        RichPresenceMonitorViewModelHarness vmRichPresence;
+        vmRichPresence.mockGameContext.SetGameId(1U);
+        vmRichPresence.mockLocalStorage.MockStoredData(ra::services::StorageItemType::RichPresence, L"1",
+                                                       "Display:\nHello, world!");
+
+        vmRichPresence.UpdateDisplayString();
+        Assert::AreEqual(std::wstring(L"Hello, world!"), vmRichPresence.GetDisplayString());
+
+        // file hasn't changed, it shouldn't be examined or reloaded
+        const auto nFileAccessCount = vmRichPresence.mockLocalStorage.GetFileAccessCount();
+        for (int i = 0; i < 10; ++i)
+            vmRichPresence.UpdateDisplayString();
+        Assert::AreEqual(std::wstring(L"Hello, world!"), vmRichPresence.GetDisplayString());
+        Assert::AreEqual(nFileAccessCount, vmRichPresence.mockLocalStorage.GetFileAccessCount());
+
+        // file changed, it should be reloaded
+        vmRichPresence.mockLocalStorage.MockStoredData(ra::services::StorageItemType::RichPresence, L"1",
+                                                       "Display:\nHello, world 2!");
+        vmRichPresence.UpdateDisplayString();
+        Assert::AreEqual(std::wstring(L"Hello, world 2!"), vmRichPresence.GetDisplayString());
+        Assert::IsTrue(vmRichPresence.mockLocalStorage.GetFileAccessCount() > nFileAccessCount);
+    }
+
     TEST_METHOD(TestUpdateDisplayStringNewFileHardcore)
     {
         RichPresenceMonitorViewModelHarness vmRichPresence;
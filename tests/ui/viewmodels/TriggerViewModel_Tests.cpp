@@ -111,6 +111,68 @@ private:
         TriggerViewModel* m_vmTrigger;
     };
 
+    void UpdateHitsEachFrame(int nFrames)
+    {
+        // 500 conditions. every fifth condition ends a hit chain started by the two conditions before it.
+        constexpr int nConditions = 500;
+
+        std::string sTrigger;
+        for (int i = 0; i < nConditions; ++i)
+        {
+            if (!sTrigger.empty())
+                sTrigger.push_back('_');
+
+            if (i % 5 < 2)
+                sTrigger.append(ra::StringPrintf("C:0xH%04x=%d", i, i % 7));
+            else
+                sTrigger.append(ra::StringPrintf("0xH%04x=%d.100.", i, i % 7));
+        }
+
+        TriggerViewModelHarness vmTrigger;
+        Parse(vmTrigger, sTrigger);
+        Assert::AreEqual(gsl::narrow_cast<size_t>(nConditions), vmTrigger.Conditions().Count());
+
+        std::vector<rc_condition_t*> vConditions;
+        for (auto* pCondition = vmTrigger.Groups().GetItemAt(0)->m_pConditionSet->conditions; pCondition; pCondition = pCondition->next)
+            vConditions.push_back(pCondition);
+
+        // change 1% of the hit counts each frame
+        for (const int nChangesPerFrame : { nConditions / 100, nConditions })
+        {
+            const auto tStart = std::chrono::steady_clock::now();
+            unsigned nSeed = 12345;
+            for (int nFrame = 0; nFrame < nFrames; ++nFrame)
+            {
+                for (int i = 0; i < nChangesPerFrame; ++i)
+                {
+                    nSeed = nSeed * 1103515245 + 12345;
+                    const auto nIndex = (nChangesPerFrame == nConditions) ? i : gsl::narrow_cast<int>((nSeed >> 8) % nConditions);
+                    gsl::at(vConditions, nIndex)->current_hits++;
+                }
+
+                vmTrigger.DoFrame();
+            }
+            const auto tElapsed = std::chrono::steady_clock::now() - tStart;
+
+            int nExpectedTotal = 0;
+            for (gsl::index nIndex = 0; nIndex < nConditions; ++nIndex)
+            {
+                const auto* vmCondition = vmTrigger.Conditions().GetItemAt(nIndex);
+                Assert::AreEqual(gsl::at(vConditions, nIndex)->current_hits, vmCondition->GetCurrentHits());
+
+                nExpectedTotal += gsl::narrow_cast<int>(gsl::at(vConditions, nIndex)->current_hits);
+                if (nIndex % 5 == 2)
+                    Assert::AreEqual(nExpectedTotal, vmCondition->GetTotalHits());
+                if (nIndex % 5 >= 2)
+                    nExpectedTotal = 0;
+            }
+
+            Logger::WriteMessage(ra::StringPrintf("%d conditions, %d changed per frame: %d frames in %d microseconds\n",
+                nConditions, nChangesPerFrame, nFrames,
+                gsl::narrow_cast<int>(std::chrono::duration_cast<std::chrono::microseconds>(tElapsed).count())).c_str());
+        }
+    }
+
 public:
     TEST_METHOD(TestInitialState)
     {
@@ -1524,6 +1586,106 @@ public:
         Assert::AreEqual(0U, vmTrigger.Conditions().GetItemAt(1)->GetCurrentHits());
         Assert::AreEqual(2, vmTrigger.Conditions().GetItemAt(1)->GetTotalHits());
     }
+
+    class ConditionsNotifyHarness : public ViewModelCollectionBase::NotifyTarget
+    {
+    public:
+        int nUpdates = 0;
+        int nHitsChanged = 0;
+        int nTotalHitsChanged = 0;
+
+    protected:
+        void OnBeginViewModelCollectionUpdate() noexcept override { ++nUpdates; }
+
+        void OnViewModelIntValueChanged(gsl::index, const IntModelProperty::ChangeArgs& args) noexcept override
+        {
+            if (args.Property == TriggerConditionViewModel::CurrentHitsProperty)
+                ++nHitsChanged;
+            else if (args.Property == TriggerConditionViewModel::TotalHitsProperty)
+                ++nTotalHitsChanged;
+        }
+    };
+
+    TEST_METHOD(TestDoFrameOnlyUpdatesChangedHits)
+    {
+        TriggerViewModelHarness vmTrigger;
+        Parse(vmTrigger, "0=0.5._C:0=0.10._0=0.20._C:0=0.30._0=0.40.");
+        Assert::AreEqual({ 1U }, vmTrigger.Groups().Count());
+
+        auto* cond = vmTrigger.Groups().GetItemAt(0)->m_pConditionSet->conditions;
+        cond->current_hits = 1; cond = cond->next;  //         0=0 (5)
+        cond->current_hits = 2; cond = cond->next;  // AddHits 0=0 (10)
+        cond->current_hits = 3; cond = cond->next;  //         0=0 (20)
+        cond->current_hits = 4; cond = cond->next;  // AddHits 0=0 (30)
+        cond->current_hits = 5;                     //         0=0 (40)
+        vmTrigger.DoFrame();
+        Assert::AreEqual(5, vmTrigger.Conditions().GetItemAt(2)->GetTotalHits()); // 2+3
+        Assert::AreEqual(9, vmTrigger.Conditions().GetItemAt(4)->GetTotalHits()); // 4+5
+
+        ConditionsNotifyHarness pNotify;
+        vmTrigger.Conditions().AddNotifyTarget(pNotify);
+
+        // nothing changed. collection should not be touched.
+        vmTrigger.DoFrame();
+        Assert::AreEqual(0, pNotify.nUpdates);
+        Assert::AreEqual(0, pNotify.nHitsChanged);
+        Assert::AreEqual(0, pNotify.nTotalHitsChanged);
+
+        // one hit count in the second hit chain changed
+        vmTrigger.Groups().GetItemAt(0)->m_pConditionSet->conditions->next->next->next->current_hits = 7;
+        vmTrigger.DoFrame();
+        Assert::AreEqual(1, pNotify.nUpdates);
+        Assert::AreEqual(1, pNotify.nHitsChanged);
+        Assert::AreEqual(1, pNotify.nTotalHitsChanged);
+        Assert::AreEqual(7U, vmTrigger.Conditions().GetItemAt(3)->GetCurrentHits());
+        Assert::AreEqual(5, vmTrigger.Conditions().GetItemAt(2)->GetTotalHits());
+        Assert::AreEqual(12, vmTrigger.Conditions().GetItemAt(4)->GetTotalHits()); // 7+5
+
+        // condition outside of any hit chain changed
+        vmTrigger.Groups().GetItemAt(0)->m_pConditionSet->conditions->current_hits = 6;
+        vmTrigger.DoFrame();
+        Assert::AreEqual(2, pNotify.nUpdates);
+        Assert::AreEqual(2, pNotify.nHitsChanged);
+        Assert::AreEqual(1, pNotify.nTotalHitsChanged);
+        Assert::AreEqual(6U, vmTrigger.Conditions().GetItemAt(0)->GetCurrentHits());
+
+        vmTrigger.Conditions().RemoveNotifyTarget(pNotify);
+    }
+
+    TEST_METHOD(TestDoFrameAfterGroupChange)
+    {
+        TriggerViewModelHarness vmTrigger;
+        Parse(vmTrigger, "1=1SC:0xH1234=1_0=1.10.S0xH2345=1_0=1.10.");
+        Assert::AreEqual({ 3U }, vmTrigger.Groups().Count());
+
+        vmTrigger.SetSelectedGroupIndex(1);
+        vmTrigger.Groups().GetItemAt(1)->m_pConditionSet->conditions->current_hits = 2;
+        vmTrigger.DoFrame();
+        Assert::AreEqual(2U, vmTrigger.Conditions().GetItemAt(0)->GetCurrentHits());
+        Assert::AreEqual(2, vmTrigger.Conditions().GetItemAt(1)->GetTotalHits());
+
+        // selecting another group should start monitoring its hits instead
+        vmTrigger.Groups().GetItemAt(2)->m_pConditionSet->conditions->current_hits = 2;
+        vmTrigger.SetSelectedGroupIndex(2);
+        vmTrigger.Groups().GetItemAt(2)->m_pConditionSet->conditions->next->current_hits = 3;
+        vmTrigger.DoFrame();
+        Assert::AreEqual(2U, vmTrigger.Conditions().GetItemAt(0)->GetCurrentHits());
+        Assert::AreEqual(3U, vmTrigger.Conditions().GetItemAt(1)->GetCurrentHits());
+        Assert::AreEqual(0, vmTrigger.Conditions().GetItemAt(1)->GetTotalHits()); // not a hit chain
+    }
+
+    TEST_METHOD(TestDoFrameManyConditions)
+    {
+        UpdateHitsEachFrame(100);
+    }
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(TestDoFramePerformance)
+        TEST_IGNORE()
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(TestDoFramePerformance)
+    {
+        UpdateHitsEachFrame(10000);
+    }
 };
 
 } // namespace tests